@@ -35,9 +35,11 @@ win32 {
 
 #=================  ANALYSIS  ===================
 HEADERS = src/analysis/Cluster.h \
+			src/analysis/ConnectionLivelinessThread.h \
 			src/analysis/LivelinessTimeStepThread.h \
 			src/analysis/WeightlessLivelinessAnalyzer.h
 SOURCES = src/analysis/Cluster.cpp \
+			src/analysis/ConnectionLivelinessThread.cpp \
 			src/analysis/LivelinessTimeStepThread.cpp \
 			src/analysis/WeightlessLivelinessAnalyzer.cpp
 
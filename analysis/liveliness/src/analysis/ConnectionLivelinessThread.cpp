@@ -0,0 +1,57 @@
+//SpikeStream includes
+#include "ConnectionLivelinessThread.h"
+#include "SpikeStreamException.h"
+#include "WeightlessLivelinessAnalyzer.h"
+using namespace spikestream;
+
+//Qt includes
+#include <QMutexLocker>
+
+
+/*! Constructor */
+ConnectionLivelinessThread::ConnectionLivelinessThread(WeightlessLivelinessAnalyzer* analyzer, int firstNeuronIndex, int neuronIndexStep, double* neuronLivelinessArray, const bool* stop){
+	this->analyzer = analyzer;
+	this->firstNeuronIndex = firstNeuronIndex;
+	this->neuronIndexStep = neuronIndexStep;
+	this->neuronLivelinessArray = neuronLivelinessArray;
+	this->stop = stop;
+	numberOfNeuronsCompleted = 0;
+	error = false;
+}
+
+
+/*! Destructor */
+ConnectionLivelinessThread::~ConnectionLivelinessThread(){
+}
+
+
+/*-------------------------------------------------------------*/
+/*-------                 PUBLIC METHODS                 ------*/
+/*-------------------------------------------------------------*/
+
+/*! Returns the number of neurons whose liveliness has been calculated so far */
+int ConnectionLivelinessThread::getNumberOfNeuronsCompleted(){
+	QMutexLocker locker(&progressMutex);
+	return numberOfNeuronsCompleted;
+}
+
+
+/*! Run method inherited from QThread.
+	Calculates the liveliness of the connections to every Nth weightless neuron. */
+void ConnectionLivelinessThread::run(){
+	error = false;
+	errorMessage = "";
+
+	try{
+		for(int toIndex = firstNeuronIndex; toIndex < analyzer->numberOfTargetNeurons && !*stop; toIndex += neuronIndexStep){
+			neuronLivelinessArray[toIndex] = analyzer->calculateNeuronLiveliness(toIndex);
+
+			QMutexLocker locker(&progressMutex);
+			++numberOfNeuronsCompleted;
+		}
+	}
+	catch(SpikeStreamException& ex){
+		error = true;
+		errorMessage = ex.getMessage();
+	}
+}
@@ -0,0 +1,60 @@
+#ifndef CONNECTIONLIVELINESSTHREAD_H
+#define CONNECTIONLIVELINESSTHREAD_H
+
+//Qt includes
+#include <QMutex>
+#include <QString>
+#include <QThread>
+
+namespace spikestream {
+
+	class WeightlessLivelinessAnalyzer;
+
+	/*! Calculates the liveliness of the connections to some of the weightless neurons analyzed by a
+		WeightlessLivelinessAnalyzer. Several of these threads work through the neurons of the same time step,
+		each taking every Nth neuron, and write their results into different rows of the analyzer's arrays. */
+	class ConnectionLivelinessThread : public QThread {
+		Q_OBJECT
+
+		public:
+			ConnectionLivelinessThread(WeightlessLivelinessAnalyzer* analyzer, int firstNeuronIndex, int neuronIndexStep, double* neuronLivelinessArray, const bool* stop);
+			~ConnectionLivelinessThread();
+			QString getErrorMessage() { return errorMessage; }
+			int getNumberOfNeuronsCompleted();
+			bool isError() { return error; }
+			void run();
+
+		private:
+			//=========================  VARIABLES  ===========================
+			/*! Analyzer holding the neurons and the connection arrays */
+			WeightlessLivelinessAnalyzer* analyzer;
+
+			/*! Local index of the first neuron analyzed by this thread */
+			int firstNeuronIndex;
+
+			/*! Number of neurons between each neuron analyzed by this thread */
+			int neuronIndexStep;
+
+			/*! Array in which the liveliness of each neuron is stored, indexed by the local index of the neuron */
+			double* neuronLivelinessArray;
+
+			/*! Stops the thread when set to true. Shared with the thread that launched this one */
+			const bool* stop;
+
+			/*! Number of neurons whose liveliness has been calculated */
+			int numberOfNeuronsCompleted;
+
+			/*! Controls access to numberOfNeuronsCompleted */
+			QMutex progressMutex;
+
+			/*! Records if an error has occurred */
+			bool error;
+
+			/*! Error message associated with an error */
+			QString errorMessage;
+
+	};
+
+}
+
+#endif//CONNECTIONLIVELINESSTHREAD_H
@@ -11,6 +11,7 @@ using namespace spikestream;
 
 /*! Constructor */
 LivelinessTimeStepThread::LivelinessTimeStepThread(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo) : AbstractAnalysisTimeStepThread(netDBInfo, archDBInfo, anaDBInfo) {
+	livelinessDao = NULL;
 }
 
 
@@ -20,40 +21,44 @@ LivelinessTimeStepThread::~LivelinessTimeStepThread(){
 
 
 /*-------------------------------------------------------------*/
-/*-------                 PUBLIC METHODS                 ------*/
+/*-------               PROTECTED METHODS                ------*/
 /*-------------------------------------------------------------*/
 
-/*! Run method inherited from QThread */
-void LivelinessTimeStepThread::run(){
-	stop = false;
-
+/*! Analyzes the liveliness of the current time step */
+void LivelinessTimeStepThread::analyzeTimeStep(){
 	//Start timer
 	PerformanceTimer timer;
 
-	//Reset error state
-	clearError();
-
-	try{
-		//Check that network is all weightless neurons
-		NetworkDao netDao(networkDBInfo);
-		if(netDao.isWeightlessNetwork(analysisInfo.getNetworkID())){
-			WeightlessLivelinessAnalyzer* weiLivAna = new WeightlessLivelinessAnalyzer(networkDBInfo, archiveDBInfo, analysisDBInfo, analysisInfo, timeStep);
-			connect(weiLivAna, SIGNAL(newResultsFound()), this, SLOT(updateResults()), Qt::DirectConnection);
-			connect(weiLivAna, SIGNAL(progress(const QString&, unsigned int, unsigned int, unsigned int)), this, SLOT(updateProgress(const QString&, unsigned int, unsigned int, unsigned int)), Qt::DirectConnection);
-			weiLivAna->runCalculation(&stop);
-			delete weiLivAna;
-		}
-		else{
-			setError("Network contains non-weightless neurons. Only weightless neurons are supported at present.");
-		}
-	}
-	catch(SpikeStreamException& ex){
-		setError(ex.getMessage());
+	//Check that network is all weightless neurons - the analysis runner only shares weightless networks
+	if(weightlessNetwork.isNull() && !networkDao->isWeightlessNetwork(analysisInfo.getNetworkID())){
+		setError("Network contains non-weightless neurons. Only weightless neurons are supported at present.");
+		return;
 	}
 
+	WeightlessLivelinessAnalyzer weiLivAna(networkDao, archiveDao, livelinessDao, analysisInfo, timeStep, weightlessNetwork);
+	weiLivAna.setNumberOfThreads(threadsPerTimeStep);
+	connect(&weiLivAna, SIGNAL(newResultsFound()), this, SLOT(updateResults()), Qt::DirectConnection);
+	connect(&weiLivAna, SIGNAL(progress(const QString&, unsigned int, unsigned int, unsigned int)), this, SLOT(updateProgress(const QString&, unsigned int, unsigned int, unsigned int)), Qt::DirectConnection);
+	weiLivAna.runCalculation(&stop);
+
 	//Show time taken for the analysis
 	timer.printTime("Liveliness Analysis time step " + QString::number(timeStep));
+}
+
 
-	stop = true;
+/*! Creates the data access objects used for all of the time steps analyzed by the thread */
+void LivelinessTimeStepThread::createDaos(){
+	AbstractAnalysisTimeStepThread::createDaos();
+	livelinessDao = new LivelinessDao(analysisDBInfo);
+}
+
+
+/*! Deletes the data access objects */
+void LivelinessTimeStepThread::deleteDaos(){
+	if(livelinessDao != NULL){
+		delete livelinessDao;
+		livelinessDao = NULL;
+	}
+	AbstractAnalysisTimeStepThread::deleteDaos();
 }
 
@@ -3,6 +3,7 @@
 
 //SpikeStream includes
 #include "AbstractAnalysisTimeStepThread.h"
+#include "LivelinessDao.h"
 
 namespace spikestream {
 
@@ -12,7 +13,16 @@ namespace spikestream {
 		public:
 			LivelinessTimeStepThread(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo);
 			~LivelinessTimeStepThread();
-			void run();
+
+		protected:
+			void analyzeTimeStep();
+			void createDaos();
+			void deleteDaos();
+
+		private:
+			//========================  VARIABLES  ========================
+			/*! Wrapper around the analysis database, used for every time step analyzed by the thread */
+			LivelinessDao* livelinessDao;
 
 		};
 
@@ -1,4 +1,5 @@
 //SpikeStream includes
+#include "ConnectionLivelinessThread.h"
 #include "Util.h"
 #include "WeightlessLivelinessAnalyzer.h"
 #include "SpikeStreamAnalysisException.h"
@@ -6,18 +7,25 @@ using namespace spikestream;
 
 
 /*! Constructor */
-WeightlessLivelinessAnalyzer::WeightlessLivelinessAnalyzer(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo, const AnalysisInfo& anaInfo, unsigned int timeStep){
+WeightlessLivelinessAnalyzer::WeightlessLivelinessAnalyzer(NetworkDao* networkDao, ArchiveDao* archiveDao, LivelinessDao* livelinessDao, const AnalysisInfo& anaInfo, unsigned int timeStep, WeightlessNetworkSnapshotPtr weiNetwork){
 	//Store variables
 	this->analysisInfo = anaInfo;
 	this->timeStep = timeStep;
+	this->weightlessNetwork = weiNetwork;
 
-	//Create data access objects
-	networkDao = new NetworkDao(netDBInfo);
-	archiveDao = new ArchiveDao(archDBInfo);
-	livelinessDao = new LivelinessDao(anaDBInfo);
+	//Store data access objects, which are reused by the calling thread for other time steps
+	this->networkDao = networkDao;
+	this->archiveDao = archiveDao;
+	this->livelinessDao = livelinessDao;
 
 	//Initialize variables
+	numberOfThreads = 1;
 	numberOfProgressSteps = 0;
+	numberOfTargetNeurons = 0;
+	numberOfConnections = 0;
+	connectionStartArray = NULL;
+	connectionFromArray = NULL;
+	connectionLivelinessArray = NULL;
 }
 
 
@@ -39,18 +47,19 @@ WeightlessLivelinessAnalyzer::WeightlessLivelinessAnalyzer(){
 	//Set up progress so that it does not affect tests
 	progressCounter = 0;
 	numberOfProgressSteps = 0xffff;
+
+	//Initialize connection arrays
+	numberOfThreads = 1;
+	numberOfTargetNeurons = 0;
+	numberOfConnections = 0;
+	connectionStartArray = NULL;
+	connectionFromArray = NULL;
+	connectionLivelinessArray = NULL;
 }
 
 
-/*! Destructor */
+/*! Destructor. The data access objects are deleted by the calling class */
 WeightlessLivelinessAnalyzer::~WeightlessLivelinessAnalyzer(){
-	if(networkDao != NULL)
-		delete networkDao;
-	if(archiveDao != NULL)
-		delete archiveDao;
-	if(livelinessDao != NULL)
-		delete livelinessDao;
-
 	deleteWeightlessNeurons();
 }
 
@@ -74,64 +83,92 @@ void WeightlessLivelinessAnalyzer::runCalculation(const bool * const stop){
 
 	//Work through the stages in the analysis
 	calculateConnectionLiveliness();
-	saveNeuronLiveliness();
 	identifyClusters();
 
 }
 
 
 
-/*! Identifies the liveliness of each connection and optionally stores it in the tmp
-	weight field of the network database */
+/*! Identifies the liveliness of each connection and the liveliness of each neuron, which is the
+	sum of the liveliness of the connections to it. The liveliness of the connections is stored in
+	compressed sparse rows indexed by the local index of each neuron.
+	The rows are laid out first, so that the neuron indexes do not change while the liveliness is
+	being calculated, and then the neurons are shared out between the threads of the analysis. */
 void WeightlessLivelinessAnalyzer::calculateConnectionLiveliness(){
 	//Reset previous results
-	fromConnectionLivelinessMap.clear();
-	toConnectionLivelinessMap.clear();
 	neuronLivelinessMap.clear();
+	resetNeuronIndexes();
+
+	//Allocate space for the connections to all of the weightless neurons
+	int numConnections = 0;
+	for(QHash<unsigned int, WeightlessNeuron*>::iterator weiNeurIter = weightlessNeuronMap.begin(); weiNeurIter != weightlessNeuronMap.end(); ++weiNeurIter)
+		numConnections += weiNeurIter.value()->getConnectionMap().size();
+	allocateConnectionArrays(numConnections);
+
+	//Lay out the rows in the same order that calculateNeuronLiveliness works through the connections
+	int conIndex = 0;
+	for(int toIndex=0; toIndex<numberOfTargetNeurons; ++toIndex){
+		connectionStartArray[toIndex] = conIndex;
+		const QHash<unsigned int, QList<unsigned int> >& tmpConMap = weightlessNeuronMap[neuronIDList.at(toIndex)]->getConnectionMap();
+		for(QHash<unsigned int, QList<unsigned int> >::const_iterator conIter = tmpConMap.constBegin(); conIter != tmpConMap.constEnd(); ++conIter){
+			connectionFromArray[conIndex] = getNeuronIndex(conIter.key());
+			connectionLivelinessArray[conIndex] = 0.0;
+			++conIndex;
+		}
+	}
+	connectionStartArray[numberOfTargetNeurons] = conIndex;
+
+	//Calculate the liveliness of each neuron. Neurons that are not reached when the analysis is stopped have zero liveliness
+	double* neuronLivelinessArray = new double[numberOfTargetNeurons];
+	for(int i=0; i<numberOfTargetNeurons; ++i)
+		neuronLivelinessArray[i] = 0.0;
+	if(numberOfThreads <= 1 || numberOfTargetNeurons <= 1){
+		for(int toIndex=0; toIndex<numberOfTargetNeurons && !*stop; ++toIndex){
+			neuronLivelinessArray[toIndex] = calculateNeuronLiveliness(toIndex);
+
+			//Inform other classes about progress
+			updateProgress("Neuron " + QString::number(neuronIDList.at(toIndex)) + " liveliness calculation complete.");
+		}
+	}
+	else{
+		//Share the neurons out between the threads. Each thread only writes to the rows of its own neurons
+		QList<ConnectionLivelinessThread*> threadList;
+		for(unsigned int i=0; i<numberOfThreads && (int)i<numberOfTargetNeurons; ++i){
+			ConnectionLivelinessThread* newThread = new ConnectionLivelinessThread(this, i, numberOfThreads, neuronLivelinessArray, stop);
+			threadList.append(newThread);
+			newThread->start();
+		}
 
-	//Work through each weightless neuron
-	for(QHash<unsigned int, WeightlessNeuron*>::iterator weiNeurIter = weightlessNeuronMap.begin(); !*stop && weiNeurIter != weightlessNeuronMap.end(); ++weiNeurIter){
-		WeightlessNeuron* tmpWeiNeur = weiNeurIter.value();
-		QHash<unsigned int, QList<unsigned int> > tmpConMap = tmpWeiNeur->getConnectionMap();
-
-		//Initialize its liveliness value to zero
-		neuronLivelinessMap[tmpWeiNeur->getID()] = 0.0;
-
-		//Create input byte array that reflects the firing state of the connected neurons
-		byte* inPatArr;
-		int inPatArrLen;
-		fillInputArray(tmpWeiNeur, inPatArr, inPatArrLen);
-
-		//Work through all the connections to the neuron
-		for(QHash<unsigned int, QList<unsigned int> >::iterator conIter = tmpConMap.begin(); !*stop && conIter != tmpConMap.end(); ++conIter){
-
-			//Get firing probability with neuron in its current state. Firing state is set to 1, but could equally well be zero
-			double firingProb1 = tmpWeiNeur->getFiringStateProbability(inPatArr, inPatArrLen, 1);
-
-			//Flip the bits corresponding to the neuron under test
-			flipBits(inPatArr, inPatArrLen, conIter.value());
-
-			//Get probability again
-			double firingProb2 = tmpWeiNeur->getFiringStateProbability(inPatArr, inPatArrLen, 1);
-
-			//If probability has changed, neuron is lively
-			if(firingProb1 != firingProb2){
-				setConnectionLiveliness(conIter.key(), tmpWeiNeur->getID(), 1.0);
-			}
-			else{
-				setConnectionLiveliness(conIter.key(), tmpWeiNeur->getID(), 0.0);
+		//Report progress until all of the threads have finished
+		unsigned int startProgressCounter = progressCounter;
+		QString errorMessage;
+		foreach(ConnectionLivelinessThread* thread, threadList){
+			bool finished = false;
+			while(!finished){
+				finished = thread->wait(200);
+				unsigned int neuronsCompleted = 0;
+				foreach(ConnectionLivelinessThread* tmpThread, threadList)
+					neuronsCompleted += tmpThread->getNumberOfNeuronsCompleted();
+				while(progressCounter < startProgressCounter + neuronsCompleted)
+					updateProgress("Connection liveliness calculation in progress.");
 			}
-
-			//Flip bit back ready to test next neuron in connection set
-			flipBits(inPatArr, inPatArrLen, conIter.value());
+			if(thread->isError() && errorMessage.isEmpty())
+				errorMessage = thread->getErrorMessage();
 		}
 
-		//Clean up array
-		delete [] inPatArr;
-
-		//Inform other classes about progress
-		updateProgress("Neuron " + QString::number(tmpWeiNeur->getID()) + " liveliness calculation complete.");
+		//Clean up threads
+		foreach(ConnectionLivelinessThread* thread, threadList)
+			delete thread;
+		if(!errorMessage.isEmpty()){
+			delete [] neuronLivelinessArray;
+			throw SpikeStreamAnalysisException(errorMessage);
+		}
 	}
+
+	//Store the liveliness of the neurons
+	for(int toIndex=0; toIndex<numberOfTargetNeurons; ++toIndex)
+		neuronLivelinessMap[neuronIDList.at(toIndex)] = neuronLivelinessArray[toIndex];
+	delete [] neuronLivelinessArray;
 }
 
 
@@ -150,8 +187,8 @@ void WeightlessLivelinessAnalyzer::fillInputArray(WeightlessNeuron* weiNeuron, b
 		inPatArr[i] = 0;
 
 	//Fill input array according to firing patterns of other neurons
-	QHash<unsigned int, QList<unsigned int> > conMap = weiNeuron->getConnectionMap();
-	for(QHash<unsigned int, QList<unsigned int> >::iterator conIter = conMap.begin(); conIter != conMap.end(); ++conIter){
+	const QHash<unsigned int, QList<unsigned int> >& conMap = weiNeuron->getConnectionMap();
+	for(QHash<unsigned int, QList<unsigned int> >::const_iterator conIter = conMap.constBegin(); conIter != conMap.constEnd(); ++conIter){
 		//Connected neuron is firing
 		if(firingNeuronMap.contains(conIter.key())){
 			//Set all indexes associated with this neuron to 1
@@ -166,7 +203,7 @@ void WeightlessLivelinessAnalyzer::fillInputArray(WeightlessNeuron* weiNeuron, b
 
 
 /*! Flips the bits corresponding to the indexes associated with a neuron */
-void WeightlessLivelinessAnalyzer::flipBits(byte inPatArr [], int inPatArrLen, QList<unsigned int>& indexList){
+void WeightlessLivelinessAnalyzer::flipBits(byte inPatArr [], int inPatArrLen, const QList<unsigned int>& indexList){
 	//Flip the bits for each index entry for this neuron
 	foreach(int indx, indexList){
 		if(indx/8 >= inPatArrLen)
@@ -176,97 +213,131 @@ void WeightlessLivelinessAnalyzer::flipBits(byte inPatArr [], int inPatArrLen, Q
 }
 
 
+/*! Returns the liveliness of each connection. The key of the outer map is the neuron that the
+	connection is from; the key of the inner map is the neuron that the connection is to. */
+QHash<unsigned int, QHash<unsigned int, double> > WeightlessLivelinessAnalyzer::getFromConnectionLivelinessMap(){
+	QHash<unsigned int, QHash<unsigned int, double> > conLivMap;
+	for(int toIndex=0; connectionStartArray != NULL && toIndex<numberOfTargetNeurons; ++toIndex){
+		for(int conIndex = connectionStartArray[toIndex]; conIndex < connectionStartArray[toIndex+1]; ++conIndex)
+			conLivMap[neuronIDList.at(connectionFromArray[conIndex])][neuronIDList.at(toIndex)] = connectionLivelinessArray[conIndex];
+	}
+	return conLivMap;
+}
+
+
+/*! Identifies clusters of neurons joined by lively connections and stores them in the database if
+	they contain more than one neuron and their liveliness is at least minimum_cluster_liveliness.
+	The direction of the connections is ignored, so each cluster is a connected component of the
+	graph of lively connections, which is found with a single union-find pass over the connections.
+	NOTE: The previous search expanded clusters from each neuron in turn and abandoned an expansion
+	if it reached a neuron that was already in a cluster. Since clusters are complete connected
+	components this could not happen with consistent connection data, and the clusters are the same. */
 void WeightlessLivelinessAnalyzer::identifyClusters(){
 	//Get a local copy of the minimum value of liveliness
 	double minClusterLiveliness = analysisInfo.getParameter("minimum_cluster_liveliness");
 
-	//Map containing all neurons that have been added to a cluster
-	QHash<unsigned int, bool> addedNeuronsMap;
+	//Each neuron starts out in a cluster of its own
+	int numberOfNeurons = neuronIDList.size();
+	int* parentArray = new int[numberOfNeurons];
+	for(int i=0; i<numberOfNeurons; ++i)
+		parentArray[i] = i;
+
+	//Merge the clusters joined by each lively connection. The root of a cluster is always its lowest index
+	for(int toIndex=0; connectionStartArray != NULL && toIndex<numberOfTargetNeurons && !*stop; ++toIndex){
+		for(int conIndex = connectionStartArray[toIndex]; conIndex < connectionStartArray[toIndex+1]; ++conIndex){
+			if(connectionLivelinessArray[conIndex] > 0){
+				int fromRoot = findClusterRoot(parentArray, connectionFromArray[conIndex]);
+				int toRoot = findClusterRoot(parentArray, toIndex);
+				if(fromRoot < toRoot)
+					parentArray[toRoot] = fromRoot;
+				else if(toRoot < fromRoot)
+					parentArray[fromRoot] = toRoot;
+			}
+		}
 
-	//List of neurons to expand in the current cluster
-	QList<unsigned int> expansionList;
+		//Inform other classes about progress
+		updateProgress("Neuron " + QString::number(neuronIDList.at(toIndex)) + " cluster identification complete.");
+	}
 
-	//Map to filter duplicates in the expansion list
-	QHash<unsigned int, bool> expansionListMap;
+	//Gather the neurons in each cluster
+	QHash<int, QList<unsigned int> > clusterNeuronMap;
+	QList<int> clusterRootList;
+	for(int i=0; i<numberOfNeurons && !*stop; ++i){
+		int root = findClusterRoot(parentArray, i);
+		if(root == i)
+			clusterRootList.append(i);
+		clusterNeuronMap[root].append(neuronIDList.at(i));
+	}
+	delete [] parentArray;
+
+	//The clusters are incomplete if the analysis was stopped part way through, so they are not stored
+	if(*stop)
+		return;
+
+	//Clusters must have more than one neuron and sufficient liveliness
+	QList<Cluster> clusterList;
+	foreach(int root, clusterRootList){
+		QList<unsigned int>& clusterNeuronIDs = clusterNeuronMap[root];
+		if(clusterNeuronIDs.size() > 1){
+			double clstrLiveliness = getClusterLiveliness(clusterNeuronIDs);
+			if(clstrLiveliness >= minClusterLiveliness)
+				clusterList.append(Cluster(0, timeStep, clstrLiveliness, clusterNeuronIDs));
+		}
+	}
 
-	//Work through each weightless neuron
-	for(QHash<unsigned int, WeightlessNeuron*>::iterator weiNeurIter = weightlessNeuronMap.begin(); !*stop && weiNeurIter != weightlessNeuronMap.end(); ++weiNeurIter){
-		expansionListMap.clear();
-		expansionList.clear();
+	//Store the neuron and cluster liveliness of this time step in one transaction and inform user that they have been found
+	livelinessDao->addTimeStepResults(analysisInfo.getID(), timeStep, neuronLivelinessMap, clusterList);
+	emit newResultsFound();
+}
 
-		//Add seed neuron to list of neurons that are to be expanded
-		if( !addedNeuronsMap.contains( weiNeurIter.key() ) ){
-			expansionList.append(weiNeurIter.key());
-			expansionListMap[weiNeurIter.key()] = true;
-		}
 
-		//Expand the connections to all the neurons in current cluster
-		for(int clstrIndx=0; clstrIndx<expansionList.size(); ++clstrIndx){
-			unsigned int expNeurID = expansionList.at(clstrIndx);
-
-			//Add neurons that are connected FROM this neuron that are not in the current cluster
-			if(fromConnectionLivelinessMap.contains(expNeurID)){
-				for(QHash<unsigned int, double>::iterator conIter = fromConnectionLivelinessMap[expNeurID].begin(); conIter != fromConnectionLivelinessMap[expNeurID].end(); ++conIter){
-
-					//Positive liveliness between this neuron and the other neuron
-					if(conIter.value() > 0){
-
-						//Abandon expansion if neuron is in a cluster we already have
-						if(addedNeuronsMap.contains(conIter.key())){
-							expansionList.clear();
-							break;
-						}
-
-						//Add neuron to expansion list if it is not already in it
-						else if(!expansionListMap.contains(conIter.key())){
-							expansionList.append(conIter.key());
-							expansionListMap[conIter.key()] = true;
-						}
-					}
-				}
-			}
+/*! Sets the number of threads used to calculate the liveliness of the connections */
+void WeightlessLivelinessAnalyzer::setNumberOfThreads(unsigned int numThreads){
+	if(numThreads < 1)
+		numThreads = 1;
+	this->numberOfThreads = numThreads;
+}
 
-			//Add neurons that connect TO this neuron that are not in the current cluster
-			if(toConnectionLivelinessMap.contains(expNeurID) && !expansionList.isEmpty()){
-				for(QHash<unsigned int, double>::iterator conIter = toConnectionLivelinessMap[expNeurID].begin(); conIter != toConnectionLivelinessMap[expNeurID].end(); ++conIter){
-
-					//Positive liveliness between this neuron and the other neuron
-					if(conIter.value() > 0){
-
-						//Abandon expansion if neuron is in a cluster we already have
-						if(addedNeuronsMap.contains(conIter.key())){
-							expansionList.clear();
-							break;
-						}
-
-						//Add neuron to expansion list if it is not already in it
-						else if(!expansionListMap.contains(conIter.key())){
-							expansionList.append(conIter.key());
-							expansionListMap[conIter.key()] = true;
-						}
-					}
-				}
-			}
-		}
 
-		//Store cluster if there is more than one neuron in it and if the liveliness is greater than the threshold
-		if(expansionList.size() > 1){
-			double clstrLiveliness = getClusterLiveliness(expansionList);
-			if(clstrLiveliness >= minClusterLiveliness){
-				livelinessDao->addCluster(analysisInfo.getID(), timeStep, expansionList, clstrLiveliness);
+/*! Sets the liveliness of the connections. The key of the outer map is the neuron that the connection
+	is from; the key of the inner map is the neuron that the connection is to, which must be one of the
+	weightless neurons. Used for testing. */
+void WeightlessLivelinessAnalyzer::setFromConnectionLivelinessMap(const QHash<unsigned int, QHash<unsigned int, double> >& conLivMap){
+	resetNeuronIndexes();
+
+	//Count the connections to each weightless neuron
+	int* rowSizeArray = new int[numberOfTargetNeurons];
+	for(int i=0; i<numberOfTargetNeurons; ++i)
+		rowSizeArray[i] = 0;
+	int numConnections = 0;
+	for(QHash<unsigned int, QHash<unsigned int, double> >::const_iterator fromIter = conLivMap.begin(); fromIter != conLivMap.end(); ++fromIter){
+		for(QHash<unsigned int, double>::const_iterator toIter = fromIter.value().begin(); toIter != fromIter.value().end(); ++toIter){
+			int toIndex = neuronIndexMap.value(toIter.key(), -1);
+			if(toIndex < 0 || toIndex >= numberOfTargetNeurons){
+				delete [] rowSizeArray;
+				throw SpikeStreamAnalysisException("Connection liveliness can only be set for connections to weightless neurons. Neuron ID: " + QString::number(toIter.key()));
 			}
-
-			//Add neurons to map of all expanded neurons
-			foreach(unsigned int neurID, expansionList)
-				addedNeuronsMap[neurID] = true;
+			++rowSizeArray[toIndex];
+			++numConnections;
 		}
-
-		//Inform other classes about progress
-		updateProgress("Neuron " + QString::number(weiNeurIter.key()) + " cluster expansion complete.");
 	}
 
-	//Inform user that clusters have been found
-	emit newResultsFound();
+	//Set the start of each row and then fill the rows
+	allocateConnectionArrays(numConnections);
+	connectionStartArray[0] = 0;
+	for(int i=0; i<numberOfTargetNeurons; ++i){
+		connectionStartArray[i+1] = connectionStartArray[i] + rowSizeArray[i];
+		rowSizeArray[i] = connectionStartArray[i];//Now holds the next free position in the row
+	}
+	for(QHash<unsigned int, QHash<unsigned int, double> >::const_iterator fromIter = conLivMap.begin(); fromIter != conLivMap.end(); ++fromIter){
+		int fromIndex = getNeuronIndex(fromIter.key());
+		for(QHash<unsigned int, double>::const_iterator toIter = fromIter.value().begin(); toIter != fromIter.value().end(); ++toIter){
+			int conIndex = rowSizeArray[neuronIndexMap[toIter.key()]]++;
+			connectionFromArray[conIndex] = fromIndex;
+			connectionLivelinessArray[conIndex] = toIter.value();
+		}
+	}
+	delete [] rowSizeArray;
 }
 
 
@@ -274,18 +345,115 @@ void WeightlessLivelinessAnalyzer::identifyClusters(){
 /*-------                 PRIVATE METHODS                ------*/
 /*-------------------------------------------------------------*/
 
-/*! Deletes all of the weightless neurons currently stored in this class */
+/*! Allocates the connection arrays with space for the specified number of connections.
+	The neuron indexes must have been reset before this method is called. */
+void WeightlessLivelinessAnalyzer::allocateConnectionArrays(int numConnections){
+	deleteConnectionArrays();
+	connectionStartArray = new int[numberOfTargetNeurons + 1];
+	connectionFromArray = new int[numConnections];
+	connectionLivelinessArray = new double[numConnections];
+	numberOfConnections = numConnections;
+	for(int i=0; i<=numberOfTargetNeurons; ++i)
+		connectionStartArray[i] = 0;
+}
+
+
+/*! Calculates the liveliness of the connections to the weightless neuron with the specified local index
+	and returns the liveliness of the neuron. The probability of firing in the current state is calculated once
+	and compared with the probability when the bits of each connected neuron are flipped in turn.
+	The row of the neuron must have been laid out by calculateConnectionLiveliness. Only the row of this neuron
+	is changed, so different neurons can be calculated at the same time by different threads. */
+double WeightlessLivelinessAnalyzer::calculateNeuronLiveliness(int toIndex){
+	WeightlessNeuron* tmpWeiNeur = weightlessNeuronMap.value(neuronIDList.at(toIndex));
+	const QHash<unsigned int, QList<unsigned int> >& tmpConMap = tmpWeiNeur->getConnectionMap();
+
+	//Create input byte array that reflects the firing state of the connected neurons
+	byte* inPatArr;
+	int inPatArrLen;
+	fillInputArray(tmpWeiNeur, inPatArr, inPatArrLen);
+
+	//Get firing probability with neuron in its current state. Firing state is set to 1, but could equally well be zero
+	double firingProb1 = tmpWeiNeur->getFiringStateProbability(inPatArr, inPatArrLen, 1);
+
+	//Work through all the connections to the neuron
+	double neuronLiveliness = 0.0;
+	int conIndex = connectionStartArray[toIndex];
+	try{
+		for(QHash<unsigned int, QList<unsigned int> >::const_iterator conIter = tmpConMap.constBegin(); conIter != tmpConMap.constEnd(); ++conIter){
+			//Flip the bits corresponding to the neuron under test
+			flipBits(inPatArr, inPatArrLen, conIter.value());
+
+			//Get probability again. If probability has changed, connection is lively
+			double firingProb2 = tmpWeiNeur->getFiringStateProbability(inPatArr, inPatArrLen, 1);
+			double conLiveliness = 0.0;
+			if(firingProb1 != firingProb2)
+				conLiveliness = 1.0;
+			connectionLivelinessArray[conIndex] = conLiveliness;
+			neuronLiveliness += conLiveliness;
+			++conIndex;
+
+			//Flip bit back ready to test next neuron in connection set
+			flipBits(inPatArr, inPatArrLen, conIter.value());
+		}
+	}
+	catch(...){
+		delete [] inPatArr;
+		throw;
+	}
+
+	//Clean up array
+	delete [] inPatArr;
+	return neuronLiveliness;
+}
+
+
+/*! Deletes the arrays holding the liveliness of the connections */
+void WeightlessLivelinessAnalyzer::deleteConnectionArrays(){
+	if(connectionStartArray != NULL){
+		delete [] connectionStartArray;
+		connectionStartArray = NULL;
+	}
+	if(connectionFromArray != NULL){
+		delete [] connectionFromArray;
+		connectionFromArray = NULL;
+	}
+	if(connectionLivelinessArray != NULL){
+		delete [] connectionLivelinessArray;
+		connectionLivelinessArray = NULL;
+	}
+	numberOfConnections = 0;
+}
+
+
+/*! Deletes all of the weightless neurons currently stored in this class.
+	Neurons belonging to a snapshot are left for the snapshot to delete. */
 void WeightlessLivelinessAnalyzer::deleteWeightlessNeurons(){
-	for(QHash<unsigned int, WeightlessNeuron*>::iterator iter = weightlessNeuronMap.begin(); iter != weightlessNeuronMap.end(); ++iter){
-		delete iter.value();
+	if(weightlessNetwork.isNull()){
+		for(QHash<unsigned int, WeightlessNeuron*>::iterator iter = weightlessNeuronMap.begin(); iter != weightlessNeuronMap.end(); ++iter){
+			delete iter.value();
+		}
 	}
 	weightlessNeuronMap.clear();
-	fromConnectionLivelinessMap.clear();
-	toConnectionLivelinessMap.clear();
+	weightlessNetwork.clear();
+	deleteConnectionArrays();
+	neuronIDList.clear();
+	neuronIndexMap.clear();
+	numberOfTargetNeurons = 0;
 	neuronLivelinessMap.clear();
 }
 
 
+/*! Returns the root of the cluster containing the neuron with the specified index.
+	The path to the root is compressed along the way. */
+int WeightlessLivelinessAnalyzer::findClusterRoot(int* parentArray, int index){
+	while(parentArray[index] != index){
+		parentArray[index] = parentArray[parentArray[index]];
+		index = parentArray[index];
+	}
+	return index;
+}
+
+
 /*! Returns the liveliness of a cluster.
 	This is the sum of the liveliness of each neuron in the cluster multiplied by
 	this same sum divided by the maximum possible liveliness */
@@ -305,6 +473,17 @@ double WeightlessLivelinessAnalyzer::getClusterLiveliness(QList<unsigned int>& n
 }
 
 
+/*! Returns the local index of a neuron, adding the neuron to the list of neurons if it is not already in it. */
+int WeightlessLivelinessAnalyzer::getNeuronIndex(unsigned int neuronID){
+	QHash<unsigned int, int>::const_iterator iter = neuronIndexMap.constFind(neuronID);
+	if(iter != neuronIndexMap.constEnd())
+		return iter.value();
+	neuronIDList.append(neuronID);
+	neuronIndexMap[neuronID] = neuronIDList.size() - 1;
+	return neuronIDList.size() - 1;
+}
+
+
 /*! Loads up the neurons firing at this time step. */
 void WeightlessLivelinessAnalyzer::loadFiringNeurons(){
 	if(archiveDao == NULL){
@@ -319,38 +498,38 @@ void WeightlessLivelinessAnalyzer::loadFiringNeurons(){
 }
 
 
-/*! Loads up all of the weightless neurons */
+/*! Loads up all of the weightless neurons.
+	The snapshot shared by the analysis runner is used if one was supplied to the constructor,
+	otherwise a snapshot of the network is loaded from the database. */
 void WeightlessLivelinessAnalyzer::loadWeightlessNeurons(){
-	if(networkDao == NULL){
-		throw SpikeStreamAnalysisException("Network dao has not been set. Empty constructor should only be used for unit testing.");
-	}
-
-	//Clean up any previous data
+	//Keep the shared snapshot, but clean up any other previous data
+	WeightlessNetworkSnapshotPtr sharedNetwork = weightlessNetwork;
 	deleteWeightlessNeurons();
+	if(!sharedNetwork.isNull()){
+		weightlessNetwork = sharedNetwork;
+		weightlessNeuronMap = weightlessNetwork->getWeightlessNeuronMap();
+		return;
+	}
 
 	//Load weightless neurons
-	QList<unsigned int> neuronIDList = networkDao->getNeuronIDs(analysisInfo.getNetworkID());
-	foreach(unsigned int neurID, neuronIDList){
-		//Store neuron
-		weightlessNeuronMap[neurID] = networkDao->getWeightlessNeuron(neurID);
-
-		//Set parameters in neuron
-		weightlessNeuronMap[neurID]->setGeneralization(analysisInfo.getParameter("generalization"));
+	if(networkDao == NULL){
+		throw SpikeStreamAnalysisException("Network dao has not been set. Empty constructor should only be used for unit testing.");
 	}
+	weightlessNetwork = WeightlessNetworkSnapshotPtr(networkDao->getWeightlessNetworkSnapshot(analysisInfo.getNetworkID()));
+	weightlessNetwork->setGeneralization(analysisInfo.getParameter("generalization"));
+	weightlessNeuronMap = weightlessNetwork->getWeightlessNeuronMap();
 }
 
 
-/*! Stores the connection liveliness in the database if requested, or just adds it to a map. */
-void WeightlessLivelinessAnalyzer::setConnectionLiveliness(unsigned int fromNeurID, unsigned int toNeurID, double liveliness){
-	//Store in the database if requested FIXME
-//	if(analysisInfo.getParameter("store_connection_liveliness_as_temporary_weights") == 1.0){
-//		networkDao->setTempWeight(fromNeurID, toNeurID, liveliness);
-//	}
-
-	//Store in maps for analysis of clusters and neurons
-	fromConnectionLivelinessMap[fromNeurID][toNeurID] = liveliness;
-	toConnectionLivelinessMap[toNeurID][fromNeurID] = liveliness;
-	neuronLivelinessMap[toNeurID] += liveliness;
+/*! Clears the connection arrays and gives each weightless neuron a local index in order of its ID */
+void WeightlessLivelinessAnalyzer::resetNeuronIndexes(){
+	deleteConnectionArrays();
+	neuronIDList = weightlessNeuronMap.keys();
+	qSort(neuronIDList);
+	neuronIndexMap.clear();
+	for(int i=0; i<neuronIDList.size(); ++i)
+		neuronIndexMap[neuronIDList.at(i)] = i;
+	numberOfTargetNeurons = neuronIDList.size();
 }
 
 
@@ -364,11 +543,4 @@ void WeightlessLivelinessAnalyzer::updateProgress(const QString& msg){
 }
 
 
-/*! Writes the liveliness of each neuron to the database */
-void WeightlessLivelinessAnalyzer::saveNeuronLiveliness(){
-	for(QHash<unsigned int, double>::iterator iter = neuronLivelinessMap.begin(); iter != neuronLivelinessMap.end(); ++iter){
-		livelinessDao->setNeuronLiveliness(analysisInfo.getID(), timeStep, iter.key(), iter.value());
-	}
-}
-
 
@@ -7,6 +7,7 @@
 #include "NetworkDao.h"
 #include "ArchiveDao.h"
 #include "LivelinessDao.h"
+#include "WeightlessNetworkSnapshot.h"
 
 //Qt includes
 #include <QObject>
@@ -21,23 +22,25 @@ namespace spikestream {
 	class WeightlessLivelinessAnalyzer : public QObject {
 		Q_OBJECT
 
+		friend class ConnectionLivelinessThread;
+
 		public:
-			WeightlessLivelinessAnalyzer(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo, const AnalysisInfo& anaInfo, unsigned int timeStep);
+			WeightlessLivelinessAnalyzer(NetworkDao* networkDao, ArchiveDao* archiveDao, LivelinessDao* livelinessDao, const AnalysisInfo& anaInfo, unsigned int timeStep, WeightlessNetworkSnapshotPtr weiNetwork);
 			WeightlessLivelinessAnalyzer();
 			~WeightlessLivelinessAnalyzer();
 			void calculateConnectionLiveliness();
 			void fillInputArray(WeightlessNeuron* weiNeuron, byte*& inPatArr, int& inPatArrLen);
-			void flipBits(byte inPatArr[], int inPatArrLen, QList<unsigned int>& indexList);
-			QHash<unsigned int, QHash<unsigned int, double> > getFromConnectionLivelinessMap() { return fromConnectionLivelinessMap; }
+			void flipBits(byte inPatArr[], int inPatArrLen, const QList<unsigned int>& indexList);
+			QHash<unsigned int, QHash<unsigned int, double> > getFromConnectionLivelinessMap();
 			QHash<unsigned int, double> getNeuronLivelinessMap() { return neuronLivelinessMap; }
 			void identifyClusters();
 			void runCalculation(const bool * const stop);
 			void setAnalysisInfo(const AnalysisInfo& anaInfo) { this->analysisInfo = anaInfo; }
-			void setFromConnectionLivelinessMap(QHash<unsigned int, QHash<unsigned int, double> > conLivMap) { this->fromConnectionLivelinessMap = conLivMap; }
-			void setToConnectionLivelinessMap(QHash<unsigned int, QHash<unsigned int, double> > conLivMap) { this->toConnectionLivelinessMap = conLivMap; }
+			void setFromConnectionLivelinessMap(const QHash<unsigned int, QHash<unsigned int, double> >& conLivMap);
 			void setFiringNeuronMap(QHash<unsigned int, bool> firingNeuronMap) { this->firingNeuronMap = firingNeuronMap; }
 			void setLivelinessDao(LivelinessDao* livelinessDao) { this->livelinessDao = livelinessDao; }
 			void setNeuronLivelinessMap(QHash<unsigned int, double>& neurLivMap) { this->neuronLivelinessMap = neurLivMap; }
+			void setNumberOfThreads(unsigned int numThreads);
 			void setWeightlessNeuronMap(QHash<unsigned int, WeightlessNeuron*> weiNeurMap) { this->weightlessNeuronMap = weiNeurMap; }
 
 		signals:
@@ -46,7 +49,7 @@ namespace spikestream {
 
 		private:
 			//========================  VARIABLES  =============================
-			/*! Wrapper around the network database */
+			/*! Wrapper around the network database. Data access objects belong to the calling class */
 			NetworkDao* networkDao;
 
 			/*! Wrapper around the archive database */
@@ -67,11 +70,34 @@ namespace spikestream {
 			/*! Map containing all of the weightless neurons in the network */
 			QHash<unsigned int, WeightlessNeuron*> weightlessNeuronMap;
 
-			/*! Map containing the liveliness of each connection FROM the neuron which is the key. */
-			QHash<unsigned int, QHash<unsigned int, double> > fromConnectionLivelinessMap;
+			/*! Snapshot that owns the weightless neurons in the map.
+				Null when the neurons have been supplied with setWeightlessNeuronMap, in which case they belong to this class. */
+			WeightlessNetworkSnapshotPtr weightlessNetwork;
+
+			/*! IDs of the neurons in the analysis. The position of an ID in this list is the
+				local index of the neuron. Weightless neurons come first in order of their ID, followed
+				by any other neurons that connect to them. */
+			QList<unsigned int> neuronIDList;
+
+			/*! Local index of each neuron ID */
+			QHash<unsigned int, int> neuronIndexMap;
+
+			/*! Number of weightless neurons, which are the neurons with connections to them in the connection arrays */
+			int numberOfTargetNeurons;
 
-			/*! Map containing the liveliness of each connection TO the neuron which is the key. */
-			QHash<unsigned int, QHash<unsigned int, double> > toConnectionLivelinessMap;
+			/*! Connections are stored in compressed sparse rows, with one row for each weightless neuron.
+				The connections to the neuron with index i are stored from connectionStartArray[i] up to,
+				but not including, connectionStartArray[i+1]. The array has numberOfTargetNeurons + 1 entries. */
+			int* connectionStartArray;
+
+			/*! Local index of the neuron that each connection comes from */
+			int* connectionFromArray;
+
+			/*! Liveliness of each connection */
+			double* connectionLivelinessArray;
+
+			/*! Number of entries in the connection arrays */
+			int numberOfConnections;
 
 			/*! Map containing the liveliness of each neuron */
 			QHash<unsigned int, double>  neuronLivelinessMap;
@@ -79,6 +105,9 @@ namespace spikestream {
 			/*! Map of the neurons firing at this time step */
 			QHash<unsigned int, bool> firingNeuronMap;
 
+			/*! Number of threads used to calculate the liveliness of the connections */
+			unsigned int numberOfThreads;
+
 			/*! Number of steps in the calculation */
 			unsigned int numberOfProgressSteps;
 
@@ -87,12 +116,16 @@ namespace spikestream {
 
 
 			//=======================  METHODS  ==========================
+			void allocateConnectionArrays(int numConnections);
+			double calculateNeuronLiveliness(int toIndex);
+			void deleteConnectionArrays();
 			void deleteWeightlessNeurons();
+			int findClusterRoot(int* parentArray, int index);
 			double getClusterLiveliness(QList<unsigned int>& neuronIDs);
+			int getNeuronIndex(unsigned int neuronID);
 			void loadFiringNeurons();
 			void loadWeightlessNeurons();
-			void setConnectionLiveliness(unsigned int fromNeurID, unsigned int toNeurID, double liveliness);
-			void saveNeuronLiveliness();
+			void resetNeuronIndexes();
 			void updateProgress(const QString& msg);
 	};
 
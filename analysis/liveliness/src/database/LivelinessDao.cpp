@@ -39,6 +39,43 @@ void LivelinessDao::addCluster(unsigned int analysisID, int timeStep, QList<unsi
 }
 
 
+/*! Adds a list of clusters to the database in a single transaction.
+	The time step of each cluster is taken from the cluster and its ID is ignored. */
+void LivelinessDao::addClusters(unsigned int analysisID, const QList<Cluster>& clusterList){
+	if(clusterList.isEmpty())
+		return;
+
+	startTransaction();
+	try{
+		insertClusters(analysisID, clusterList);
+	}
+	catch(...){
+		rollbackTransaction();
+		throw;
+	}
+	commitTransaction();
+}
+
+
+/*! Stores all of the results of a time step in a single transaction: the liveliness of each neuron,
+	which is updated if it has already been set, and the clusters. */
+void LivelinessDao::addTimeStepResults(unsigned int analysisID, int timeStep, const QHash<unsigned int, double>& neuronLivelinessMap, const QList<Cluster>& clusterList){
+	if(neuronLivelinessMap.isEmpty() && clusterList.isEmpty())
+		return;
+
+	startTransaction();
+	try{
+		insertNeuronLiveliness(analysisID, timeStep, neuronLivelinessMap);
+		insertClusters(analysisID, clusterList);
+	}
+	catch(...){
+		rollbackTransaction();
+		throw;
+	}
+	commitTransaction();
+}
+
+
 /*! Deletes cluster and neuron data for the supplied range of time steps.
 	The range is inclusive, so start and end time steps will both be deleted. */
 void LivelinessDao::deleteTimeSteps(unsigned int analysisID, unsigned int firstTimeStep, unsigned int lastTimeStep){
@@ -141,4 +178,60 @@ void LivelinessDao::setNeuronLiveliness(unsigned int analysisID, int timeStep, u
 }
 
 
+/*! Sets the liveliness of all of the neurons in the map for a given time step and analysis in a single transaction.
+	Neurons whose liveliness has already been set are updated. */
+void LivelinessDao::setNeuronLiveliness(unsigned int analysisID, int timeStep, const QHash<unsigned int, double>& neuronLivelinessMap){
+	if(neuronLivelinessMap.isEmpty())
+		return;
+
+	startTransaction();
+	try{
+		insertNeuronLiveliness(analysisID, timeStep, neuronLivelinessMap);
+	}
+	catch(...){
+		rollbackTransaction();
+		throw;
+	}
+	commitTransaction();
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                PRIVATE METHODS                 -----*/
+/*----------------------------------------------------------*/
+
+/*! Inserts the clusters with multi-row inserts. Transactions are handled by the calling method. */
+void LivelinessDao::insertClusters(unsigned int analysisID, const QList<Cluster>& clusterList){
+	if(clusterList.isEmpty())
+		return;
+
+	//Store the values of each row
+	QList<QVariant> valueList;
+	foreach(const Cluster& clstr, clusterList){
+		valueList.append(analysisID);
+		valueList.append(clstr.getTimeStep());
+		valueList.append(clstr.getLiveliness());
+		valueList.append(clstr.getNeuronIDString());
+	}
+	executeBatchInsert("INSERT INTO ClusterLiveliness (AnalysisID, TimeStep, Liveliness, Neurons) VALUES", 4, valueList);
+}
+
+
+/*! Inserts or updates the liveliness of the neurons with multi-row inserts. Transactions are handled by the calling method. */
+void LivelinessDao::insertNeuronLiveliness(unsigned int analysisID, int timeStep, const QHash<unsigned int, double>& neuronLivelinessMap){
+	if(neuronLivelinessMap.isEmpty())
+		return;
+
+	//Store the values of each row
+	QList<QVariant> valueList;
+	for(QHash<unsigned int, double>::const_iterator iter = neuronLivelinessMap.begin(); iter != neuronLivelinessMap.end(); ++iter){
+		valueList.append(iter.key());
+		valueList.append(analysisID);
+		valueList.append(timeStep);
+		valueList.append(iter.value());
+	}
+	executeBatchInsert("INSERT INTO NeuronLiveliness (NeuronID, AnalysisID, TimeStep, Liveliness) VALUES", 4, valueList, "ON DUPLICATE KEY UPDATE Liveliness=VALUES(Liveliness)");
+}
+
+
 
@@ -15,12 +15,20 @@ namespace spikestream {
 			LivelinessDao();
 			virtual ~LivelinessDao();
 			virtual void addCluster(unsigned int analysisID, int timeStep, QList<unsigned int>& neuronIDList, double liveliness);
+			virtual void addClusters(unsigned int analysisID, const QList<Cluster>& clusterList);
+			virtual void addTimeStepResults(unsigned int analysisID, int timeStep, const QHash<unsigned int, double>& neuronLivelinessMap, const QList<Cluster>& clusterList);
 			bool containsAnalysisData(unsigned int analysisID, unsigned int firstTimeStep, unsigned int lastTimeStep);
 			void deleteTimeSteps(unsigned int analysisID, unsigned int firstTimeStep, unsigned int lastTimeStep);
 			QList<Cluster> getClusters(unsigned int analysisID);
 			double getNeuronLiveliness(unsigned int analysisID, unsigned int timeStep, unsigned int neuronID);
 			double getMaxNeuronLiveliness(unsigned int analysisID);
 			void setNeuronLiveliness(unsigned int analysisID, int timeStep,unsigned int neuronID, double liveliness);
+			void setNeuronLiveliness(unsigned int analysisID, int timeStep, const QHash<unsigned int, double>& neuronLivelinessMap);
+
+		private:
+			//=========================  METHODS  ===========================
+			void insertClusters(unsigned int analysisID, const QList<Cluster>& clusterList);
+			void insertNeuronLiveliness(unsigned int analysisID, int timeStep, const QHash<unsigned int, double>& neuronLivelinessMap);
 	};
 
 }
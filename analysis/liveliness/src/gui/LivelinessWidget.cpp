@@ -55,6 +55,7 @@ LivelinessWidget::LivelinessWidget(QWidget *parent) : AbstractAnalysisWidget(par
 
 	//Set up analysis runner with function to create threads to analyze for liveliness
 	analysisRunner->setTimeStepThreadCreationFunction(&createAnalysisTimeStepThread);
+	analysisRunner->setLoadWeightlessNetwork(true);
 
 	//Add tool bar to top of widget
 	toolBar = getDefaultToolBar();
@@ -15,12 +15,9 @@ LivelinessDaoDuck::~LivelinessDaoDuck(){
 }
 
 
-/*! Instead of storing cluster in database the complex is stored in a list for testing */
-void LivelinessDaoDuck::addCluster(unsigned int, int, QList<unsigned int>& neuronIDList, double liveliness){
-	Cluster clstr;
-	clstr.setNeuronIDs(neuronIDList);
-	clstr.setLiveliness(liveliness);
-	clusterList.append(clstr);
+/*! Instead of storing the results in database the clusters are stored in a list for testing */
+void LivelinessDaoDuck::addTimeStepResults(unsigned int, int, const QHash<unsigned int, double>&, const QList<Cluster>& newClusterList){
+	clusterList.append(newClusterList);
 }
 
 /*! Resets information stored in the class */
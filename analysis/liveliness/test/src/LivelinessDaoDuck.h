@@ -15,7 +15,7 @@ class LivelinessDaoDuck : public LivelinessDao {
 	public:
 		LivelinessDaoDuck();
 		virtual ~LivelinessDaoDuck();
-		void addCluster(unsigned int analysisID, int timeStep, QList<unsigned int>& neuronIDList, double liveliness);
+		void addTimeStepResults(unsigned int analysisID, int timeStep, const QHash<unsigned int, double>& neuronLivelinessMap, const QList<Cluster>& clusterList);
 		QList<Cluster>& getClusterList() { return clusterList; }
 		void reset();
 
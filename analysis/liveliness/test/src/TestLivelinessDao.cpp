@@ -29,6 +29,63 @@ void TestLivelinessDao::testAddCluster(){
 }
 
 
+void TestLivelinessDao::testAddClusters(){
+	//Add test analysis
+	addTestAnalysis1();
+
+	//Build enough clusters to need more than one insert statement
+	QList<Cluster> clusterList;
+	for(unsigned int i=0; i<300; ++i){
+		QList<unsigned int> neuronIDList;
+		neuronIDList.append(i);
+		clusterList.append(Cluster(0, i % 3, i * 0.5, neuronIDList));
+	}
+
+	//Create class to be tested and test it
+	LivelinessDao livelinessDao(analysisDBInfo);
+	livelinessDao.addClusters(testAnalysis1ID, clusterList);
+	QSqlQuery query = getAnalysisQuery("SELECT COUNT(*) FROM ClusterLiveliness WHERE AnalysisID=" + QString::number(testAnalysis1ID));
+	executeQuery(query);
+	query.next();
+	QCOMPARE(query.value(0).toInt(), (int)300);
+
+	//Check the last cluster, which is added by the final statement
+	query = getAnalysisQuery("SELECT TimeStep, Liveliness FROM ClusterLiveliness WHERE Neurons='299'");
+	executeQuery(query);
+	query.next();
+	QCOMPARE(query.size(), (int)1);
+	QCOMPARE(query.value(0).toUInt(), (unsigned int)2);
+	QCOMPARE(query.value(1).toDouble(), 149.5);
+}
+
+
+void TestLivelinessDao::testAddTimeStepResults(){
+	//Add test analysis
+	addTestAnalysis1();
+
+	//Results for a single time step
+	QHash<unsigned int, double> neurLivMap;
+	neurLivMap[testNeurIDList[0]] = 2.5;
+	neurLivMap[testNeurIDList[1]] = 3.5;
+	QList<unsigned int> neuronIDList;
+	neuronIDList.append(testNeurIDList[0]);
+	neuronIDList.append(testNeurIDList[1]);
+	QList<Cluster> clusterList;
+	clusterList.append(Cluster(0, 4, 6.0, neuronIDList));
+
+	//Create class to be tested and test it
+	LivelinessDao livelinessDao(analysisDBInfo);
+	livelinessDao.addTimeStepResults(testAnalysis1ID, 4, neurLivMap, clusterList);
+	QCOMPARE(livelinessDao.getNeuronLiveliness(testAnalysis1ID, 4, testNeurIDList[0]), 2.5);
+	QCOMPARE(livelinessDao.getNeuronLiveliness(testAnalysis1ID, 4, testNeurIDList[1]), 3.5);
+	QSqlQuery query = getAnalysisQuery("SELECT Liveliness FROM ClusterLiveliness WHERE TimeStep=4 AND AnalysisID=" + QString::number(testAnalysis1ID));
+	executeQuery(query);
+	QCOMPARE(query.size(), (int)1);
+	query.next();
+	QCOMPARE(query.value(0).toDouble(), 6.0);
+}
+
+
 void TestLivelinessDao::testContainsAnalysisData(){
 	//Add test analysis and data
 	addTestAnalysis1();
@@ -150,6 +207,27 @@ void TestLivelinessDao::testSetNeuronLiveliness(){
 }
 
 
+void TestLivelinessDao::testSetNeuronLivelinessMap(){
+	//Add test analysis and data
+	addTestAnalysis1();
+	addTestAnalysis1Data();
+
+	//Update one neuron that is already in the database and add another
+	QHash<unsigned int, double> neurLivMap;
+	neurLivMap[testNeurIDList[2]] = 7.22;
+	neurLivMap[testNeurIDList[0]] = 2.5;
+
+	//Invoke test method
+	LivelinessDao livelinessDao(analysisDBInfo);
+	livelinessDao.setNeuronLiveliness(testAnalysis1ID, 2, neurLivMap);
+	QCOMPARE(livelinessDao.getNeuronLiveliness(testAnalysis1ID, 2, testNeurIDList[2]), 7.22);
+	QCOMPARE(livelinessDao.getNeuronLiveliness(testAnalysis1ID, 2, testNeurIDList[0]), 2.5);
+
+	//Other time steps should be unchanged
+	QCOMPARE(livelinessDao.getNeuronLiveliness(testAnalysis1ID, 1, testNeurIDList[2]), 1.3);
+}
+
+
 /*! Adds test data to analysis 1 */
 void TestLivelinessDao::addTestAnalysis1Data(){
 	//Create strings with actual neuron ids
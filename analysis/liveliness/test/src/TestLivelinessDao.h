@@ -13,12 +13,15 @@ class TestLivelinessDao : public TestDao {
 
 	private slots:
 		void testAddCluster();
+		void testAddClusters();
+		void testAddTimeStepResults();
 		void testContainsAnalysisData();
 		void testDeleteTimeSteps();
 		void testGetClusters();
 		void testGetNeuronLiveliness();
 		void testGetMaxNeuronLiveliness();
 		void testSetNeuronLiveliness();
+		void testSetNeuronLivelinessMap();
 
 	private:
 		void addTestAnalysis1Data();
@@ -109,6 +109,20 @@ void TestWeightlessLivelinessAnalyzer::testCalculateConnectionLiveliness(){
 		QCOMPARE(neurLiveMap.size(), (int)4);
 		QVERIFY(neurLiveMap.contains(4));
 		QCOMPARE(neurLiveMap[4], 3.0);
+
+		//Results should be the same when the neurons are shared out between several threads
+		firingNeuronMap[1] = true;
+		weiLivAna.setFiringNeuronMap(firingNeuronMap);
+		weiLivAna.setNumberOfThreads(3);
+		weiLivAna.calculateConnectionLiveliness();
+		conLiveMap = weiLivAna.getFromConnectionLivelinessMap();
+		neurLiveMap = weiLivAna.getNeuronLivelinessMap();
+		QCOMPARE(conLiveMap[1][4], 1.0);
+		QCOMPARE(conLiveMap[2][4], 1.0);
+		QCOMPARE(conLiveMap[3][4], 1.0);
+		QCOMPARE(neurLiveMap.size(), (int)4);
+		QCOMPARE(neurLiveMap[1], 0.0);
+		QCOMPARE(neurLiveMap[4], 3.0);
 	}
 	catch(SpikeStreamException& ex){
 		QFAIL(ex.getMessage().toAscii());
@@ -197,31 +211,26 @@ void TestWeightlessLivelinessAnalyzer::testIdentifyClusters(){
 	weiLivAna.setWeightlessNeuronMap(weiNeurMap);
 
 	//Inject duck dao so we can access results
-	LivelinessDaoDuck* daoDuck = new LivelinessDaoDuck();
-	weiLivAna.setLivelinessDao(daoDuck);
+	LivelinessDaoDuck daoDuck;
+	weiLivAna.setLivelinessDao(&daoDuck);
 
 	try{
 		// Build lively connections 1->2, 3->4, 4->5
 		QHash<unsigned int, QHash<unsigned int, double> > fromConLivMap;
-		QHash<unsigned int, QHash<unsigned int, double> > toConLivMap;
 		fromConLivMap[1][2] = 1.0;
 		fromConLivMap[3][4] = 1.0;
 		fromConLivMap[4][5] = 1.0;
-		toConLivMap[1][2] = 1.0;
-		toConLivMap[3][4] = 1.0;
-		toConLivMap[4][5] = 1.0;
 		neurLivMap[1] = 0.0;
 		neurLivMap[2] = 1.0;
 		neurLivMap[3] = 0.0;
 		neurLivMap[4] = 1.0;
 		neurLivMap[5] = 1.0;
 		weiLivAna.setFromConnectionLivelinessMap(fromConLivMap);
-		weiLivAna.setToConnectionLivelinessMap(toConLivMap);
 		weiLivAna.setNeuronLivelinessMap(neurLivMap);
 
 		//Run analysis and check results
 		weiLivAna.identifyClusters();
-		checkClusters(daoDuck->getClusterList(), "1,2;3,4,5", "0.25;0.444");
+		checkClusters(daoDuck.getClusterList(), "1,2;3,4,5", "0.25;0.444");
 
 		/* Build lively connections 1<->2, 2<->3, 3<->1, 4<->5
 			Connections are symmetrical so only need to use one map */
@@ -241,57 +250,70 @@ void TestWeightlessLivelinessAnalyzer::testIdentifyClusters(){
 		neurLivMap[4] = 1.0;
 		neurLivMap[5] = 1.0;
 		weiLivAna.setFromConnectionLivelinessMap(fromConLivMap);
-		weiLivAna.setToConnectionLivelinessMap(fromConLivMap);
 		weiLivAna.setNeuronLivelinessMap(neurLivMap);
 
 		//Run analysis and check results
-		daoDuck->reset();
+		daoDuck.reset();
 		weiLivAna.identifyClusters();
-		checkClusters(daoDuck->getClusterList(), "1,2,3;4,5", "4.0;1.0");
+		checkClusters(daoDuck.getClusterList(), "1,2,3;4,5", "4.0;1.0");
 
 		// Build lively connections 1->2, 3->4
 		fromConLivMap.clear();
-		toConLivMap.clear();
 		neurLivMap.clear();
 		fromConLivMap[1][2] = 1.0;
 		fromConLivMap[3][4] = 1.0;
-		toConLivMap[2][1] = 1.0;
-		toConLivMap[4][3] = 1.0;
 		neurLivMap[1] = 0.0;
 		neurLivMap[2] = 1.0;
 		neurLivMap[3] = 0.0;
 		neurLivMap[4] = 1.0;
 		neurLivMap[5] = 0.0;
 		weiLivAna.setFromConnectionLivelinessMap(fromConLivMap);
-		weiLivAna.setToConnectionLivelinessMap(toConLivMap);
 		weiLivAna.setNeuronLivelinessMap(neurLivMap);
 
 		//Run analysis and check results
-		daoDuck->reset();
+		daoDuck.reset();
 		weiLivAna.identifyClusters();
-		checkClusters(daoDuck->getClusterList(), "1,2;3,4", "0.25;0.25");
+		checkClusters(daoDuck.getClusterList(), "1,2;3,4", "0.25;0.25");
 
 		// Build lively connections 2->1, 2->3
 		fromConLivMap.clear();
-		toConLivMap.clear();
 		neurLivMap.clear();
 		fromConLivMap[2][1] = 1.0;
 		fromConLivMap[2][3] = 1.0;
-		toConLivMap[1][2] = 1.0;
-		toConLivMap[3][2] = 1.0;
 		neurLivMap[1] = 1.0;
 		neurLivMap[2] = 0.0;
 		neurLivMap[3] = 1.0;
 		neurLivMap[4] = 0.0;
 		neurLivMap[5] = 0.0;
 		weiLivAna.setFromConnectionLivelinessMap(fromConLivMap);
-		weiLivAna.setToConnectionLivelinessMap(toConLivMap);
 		weiLivAna.setNeuronLivelinessMap(neurLivMap);
 
 		//Run analysis and check results
-		daoDuck->reset();
+		daoDuck.reset();
+		weiLivAna.identifyClusters();
+		checkClusters(daoDuck.getClusterList(), "1,2,3", "0.444");
+
+		//Clusters with liveliness less than the minimum should not be stored
+		AnalysisInfo anaInfo;
+		anaInfo.setParameter("minimum_cluster_liveliness", 0.5);
+		weiLivAna.setAnalysisInfo(anaInfo);
+		fromConLivMap.clear();
+		neurLivMap.clear();
+		fromConLivMap[1][2] = 1.0;
+		fromConLivMap[4][3] = 1.0;
+		fromConLivMap[5][4] = 1.0;
+		neurLivMap[1] = 0.0;
+		neurLivMap[2] = 1.0;
+		neurLivMap[3] = 1.0;
+		neurLivMap[4] = 1.0;
+		neurLivMap[5] = 1.0;
+		weiLivAna.setFromConnectionLivelinessMap(fromConLivMap);
+		weiLivAna.setNeuronLivelinessMap(neurLivMap);
+
+		//Run analysis and check results
+		daoDuck.reset();
 		weiLivAna.identifyClusters();
-		checkClusters(daoDuck->getClusterList(), "1,2,3", "0.444");
+		checkClusters(daoDuck.getClusterList(), "3,4,5", "1.0");
 
 	}
 	catch(SpikeStreamException& ex){
@@ -16,6 +16,7 @@ using namespace std;
 
 /*! Constructor */
 PhiAnalysisTimeStepThread::PhiAnalysisTimeStepThread(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo) : AbstractAnalysisTimeStepThread(netDBInfo, archDBInfo, anaDBInfo) {
+	stateDao = NULL;
 }
 
 
@@ -24,39 +25,44 @@ PhiAnalysisTimeStepThread::~PhiAnalysisTimeStepThread(){
 }
 
 /*-------------------------------------------------------------*/
-/*-------                 PUBLIC METHODS                 ------*/
+/*-------               PROTECTED METHODS                ------*/
 /*-------------------------------------------------------------*/
 
-/*! Run method inherited from QThread */
-void PhiAnalysisTimeStepThread::run(){
-	stop = false;
-	clearError();
-
+/*! Analyzes the current time step for state-based phi */
+void PhiAnalysisTimeStepThread::analyzeTimeStep(){
 	//Start timer
 	PerformanceTimer timer;
 
-	try{
-		//Check that network is all weightless neurons
-		NetworkDao netDao(networkDBInfo);
-		if(netDao.isWeightlessNetwork(analysisInfo.getNetworkID())){
-			//Create the calculator to run the phi calculation on the time step
-			SubsetManager* subsetManager = new SubsetManager(networkDBInfo, archiveDBInfo, analysisDBInfo, analysisInfo, timeStep);
-			connect(subsetManager, SIGNAL(complexFound()), this, SLOT(updateResults()), Qt::DirectConnection);
-			connect(subsetManager, SIGNAL(progress(const QString&, unsigned int, unsigned int, unsigned int)), this, SLOT(updateProgress(const QString&, unsigned int, unsigned int, unsigned int)), Qt::DirectConnection);
-			subsetManager->runCalculation(&stop);
-			delete subsetManager;
-		}
-		else{
-			setError("Network contains non-weightless neurons. Only weightless neurons are supported at present.");
-		}
-	}
-	catch(SpikeStreamException& ex){
-		setError(ex.getMessage());
+	//Check that network is all weightless neurons - the analysis runner only shares weightless networks
+	if(weightlessNetwork.isNull() && !networkDao->isWeightlessNetwork(analysisInfo.getNetworkID())){
+		setError("Network contains non-weightless neurons. Only weightless neurons are supported at present.");
+		return;
 	}
 
+	//Create the calculator to run the phi calculation on the time step
+	SubsetManager subsetManager(networkDao, archiveDao, stateDao, analysisInfo, timeStep, weightlessNetwork);
+	connect(&subsetManager, SIGNAL(complexFound()), this, SLOT(updateResults()), Qt::DirectConnection);
+	connect(&subsetManager, SIGNAL(progress(const QString&, unsigned int, unsigned int, unsigned int)), this, SLOT(updateProgress(const QString&, unsigned int, unsigned int, unsigned int)), Qt::DirectConnection);
+	subsetManager.runCalculation(&stop);
+
 	//Show time taken for the analysis
 	timer.printTime("State-based phi time step " + QString::number(timeStep));
+}
+
 
-	stop = true;
+/*! Creates the data access objects used for all of the time steps analyzed by the thread */
+void PhiAnalysisTimeStepThread::createDaos(){
+	AbstractAnalysisTimeStepThread::createDaos();
+	stateDao = new StateBasedPhiAnalysisDao(analysisDBInfo);
+}
+
+
+/*! Deletes the data access objects */
+void PhiAnalysisTimeStepThread::deleteDaos(){
+	if(stateDao != NULL){
+		delete stateDao;
+		stateDao = NULL;
+	}
+	AbstractAnalysisTimeStepThread::deleteDaos();
 }
 
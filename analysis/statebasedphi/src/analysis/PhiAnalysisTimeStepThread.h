@@ -3,6 +3,7 @@
 
 //SpikeStream includes
 #include "AbstractAnalysisTimeStepThread.h"
+#include "StateBasedPhiAnalysisDao.h"
 
 
 namespace spikestream {
@@ -13,7 +14,16 @@ namespace spikestream {
 		public:
 			PhiAnalysisTimeStepThread(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo);
 			~PhiAnalysisTimeStepThread();
-			void run();
+
+		protected:
+			void analyzeTimeStep();
+			void createDaos();
+			void deleteDaos();
+
+		private:
+			//========================  VARIABLES  ========================
+			/*! Wrapper around the analysis database, used for every time step analyzed by the thread */
+			StateBasedPhiAnalysisDao* stateDao;
 
 		};
 
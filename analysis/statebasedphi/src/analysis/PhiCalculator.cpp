@@ -12,19 +12,26 @@ using namespace std;
 
 
 /*! Standard constructor */
-PhiCalculator::PhiCalculator(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo, const AnalysisInfo& anaInfo, unsigned int timeStep, const bool* stop){
+PhiCalculator::PhiCalculator(NetworkDao* networkDao, ArchiveDao* archiveDao, StateBasedPhiAnalysisDao* stateDao, const AnalysisInfo& anaInfo, unsigned int timeStep, const bool* stop, WeightlessNetworkSnapshotPtr weiNetwork){
 	//Store variables
 	this->analysisInfo = anaInfo;
 	this->timeStep = timeStep;
 	this->stop = stop;
 
-	//Create data access objects
-	networkDao = new NetworkDao(netDBInfo);
-	archiveDao = new ArchiveDao(archDBInfo);
-	stateDao = new StateBasedPhiAnalysisDao(anaDBInfo);
+	//Store data access objects, which are reused by the calling thread for other time steps
+	this->networkDao = networkDao;
+	this->archiveDao = archiveDao;
+	this->stateDao = stateDao;
 
-	//Load up the complete set of weightless neurons and the neurons firing at this time step
-	loadWeightlessNeurons();
+	/* Use the weightless neurons shared by the analysis runner if they are available,
+	   otherwise load them from the database. Then load the neurons firing at this time step */
+	if(weiNetwork.isNull()){
+		loadWeightlessNeurons();
+	}
+	else{
+		weightlessNetwork = weiNetwork;
+		weightlessNeuronMap = weightlessNetwork->getWeightlessNeuronMap();
+	}
 	loadFiringNeurons();
 }
 
@@ -43,17 +50,9 @@ PhiCalculator::PhiCalculator(){
 }
 
 
-/*! Destructor */
+/*! Destructor. The data access objects are deleted by the calling class */
 PhiCalculator::~PhiCalculator(){
 	deleteWeightlessNeurons();
-
-	//Clean up databases
-	if(networkDao != NULL)
-		delete networkDao;
-	if(archiveDao != NULL)
-		delete archiveDao;
-	if(stateDao != NULL)
-		delete stateDao;
 }
 
 
@@ -308,12 +307,16 @@ double PhiCalculator::getPartitionPhi(QList<unsigned int>& aPartition, QList<uns
 }
 
 
-/*! Deletes all of the weightless neurons currently stored in this class */
+/*! Deletes all of the weightless neurons currently stored in this class.
+	Neurons belonging to a snapshot are left for the snapshot to delete. */
 void PhiCalculator::deleteWeightlessNeurons(){
-	for(QHash<unsigned int, WeightlessNeuron*>::iterator iter = weightlessNeuronMap.begin(); iter != weightlessNeuronMap.end(); ++iter){
-		delete iter.value();
+	if(weightlessNetwork.isNull()){
+		for(QHash<unsigned int, WeightlessNeuron*>::iterator iter = weightlessNeuronMap.begin(); iter != weightlessNeuronMap.end(); ++iter){
+			delete iter.value();
+		}
 	}
 	weightlessNeuronMap.clear();
+	weightlessNetwork.clear();
 }
 
 
@@ -331,21 +334,16 @@ void PhiCalculator::loadFiringNeurons(){
 }
 
 
-/*! Loads up all of the weightless neurons */
+/*! Loads up all of the weightless neurons in a single snapshot of the network */
 void PhiCalculator::loadWeightlessNeurons(){
 	if(networkDao == NULL){
 		throw SpikeStreamAnalysisException("Network dao has not been set. Empty constructor should only be used for unit testing.");
 	}
 
 	deleteWeightlessNeurons();
-	QList<unsigned int> neuronIDList = networkDao->getNeuronIDs(analysisInfo.getNetworkID());
-	foreach(unsigned int neurID, neuronIDList){
-		//Store neuron
-		weightlessNeuronMap[neurID] = networkDao->getWeightlessNeuron(neurID);
-
-		//Set parameters in neuron
-		weightlessNeuronMap[neurID]->setGeneralization(analysisInfo.getParameter("generalization"));
-	}
+	weightlessNetwork = WeightlessNetworkSnapshotPtr(networkDao->getWeightlessNetworkSnapshot(analysisInfo.getNetworkID()));
+	weightlessNetwork->setGeneralization(analysisInfo.getParameter("generalization"));
+	weightlessNeuronMap = weightlessNetwork->getWeightlessNeuronMap();
 }
 
 
@@ -9,6 +9,7 @@
 #include "ArchiveDao.h"
 #include "StateBasedPhiAnalysisDao.h"
 #include "ProbabilityTable.h"
+#include "WeightlessNetworkSnapshot.h"
 #include "WeightlessNeuron.h"
 using namespace spikestream;
 
@@ -21,7 +22,7 @@ namespace spikestream {
 	Q_OBJECT
 
 	public:
-	    PhiCalculator(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo, const AnalysisInfo& anaInfo, unsigned int timeStep, const bool* stop);
+	    PhiCalculator(NetworkDao* networkDao, ArchiveDao* archiveDao, StateBasedPhiAnalysisDao* stateDao, const AnalysisInfo& anaInfo, unsigned int timeStep, const bool* stop, WeightlessNetworkSnapshotPtr weiNetwork);
 	    PhiCalculator();
 	    ~PhiCalculator();
 	    void calculateReverseProbability(ProbabilityTable& causalTable, ProbabilityTable& reverseTable);
@@ -42,7 +43,7 @@ namespace spikestream {
 
 	private:
 	    //========================  VARIABLES  ========================
-	    /*! Wrapper around the network database */
+	    /*! Wrapper around the network database. Data access objects belong to the calling class */
 	    NetworkDao* networkDao;
 
 	    /*! Wrapper around the archive database */
@@ -63,6 +64,10 @@ namespace spikestream {
 	    /*! Map containing all of the weightless neurons in the network */
 	    QHash<unsigned int, WeightlessNeuron*> weightlessNeuronMap;
 
+	    /*! Snapshot that owns the weightless neurons in the map.
+		Null when the neurons have been supplied with setWeightlessNeuronMap, in which case they belong to this class. */
+	    WeightlessNetworkSnapshotPtr weightlessNetwork;
+
 	    /*! Map of the neurons firing at this time step */
 	    QHash<unsigned int, bool> firingNeuronMap;
 
@@ -18,18 +18,23 @@ using namespace std;
 //#define DEBUG_SUBSETS
 
 /*! Standard Constructor */
-SubsetManager::SubsetManager(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo, const AnalysisInfo& anaInfo, unsigned int timeStep) : QObject() {
+SubsetManager::SubsetManager(NetworkDao* networkDao, ArchiveDao* archiveDao, StateBasedPhiAnalysisDao* stateDao, const AnalysisInfo& anaInfo, unsigned int timeStep, WeightlessNetworkSnapshotPtr weiNetwork) : QObject() {
 	//Store variables
 	this->analysisInfo = anaInfo;
 	this->timeStep = timeStep;
+	this->weightlessNetwork = weiNetwork;
 
-	//Create data access objects
-	networkDao = new NetworkDao(netDBInfo);
-	archiveDao = new ArchiveDao(archDBInfo);
-	stateDao = new StateBasedPhiAnalysisDao(anaDBInfo);
+	//Store data access objects, which are reused by the calling thread for other time steps
+	this->networkDao = networkDao;
+	this->archiveDao = archiveDao;
+	this->stateDao = stateDao;
+
+	//Adjacency matrix is built when it is needed
+	adjacencyMatrix = NULL;
+	adjacencyRowLength = 0;
 
 	//Create phi calculator
-	phiCalculator = new PhiCalculator(netDBInfo, archDBInfo, anaDBInfo, anaInfo, timeStep, stop);
+	phiCalculator = new PhiCalculator(networkDao, archiveDao, stateDao, anaInfo, timeStep, stop, weiNetwork);
 }
 
 
@@ -40,6 +45,8 @@ SubsetManager::SubsetManager(){
 	archiveDao = NULL;
 	stateDao = NULL;
 	phiCalculator = NULL;
+	adjacencyMatrix = NULL;
+	adjacencyRowLength = 0;
 
 	//Fix stop variable so that class is always running
 	bool* tmpStop = new bool;
@@ -52,18 +59,13 @@ SubsetManager::SubsetManager(){
 }
 
 
-/*! Destructor */
+/*! Destructor. The data access objects are deleted by the calling class */
 SubsetManager::~SubsetManager(){
 	deleteSubsets();
+	deleteAdjacencyMatrix();
 
 	if(phiCalculator != NULL)
 		delete phiCalculator;
-	if(networkDao != NULL)
-		delete networkDao;
-	if(archiveDao != NULL)
-		delete archiveDao;
-	if(stateDao != NULL)
-		delete stateDao;
 }
 
 
@@ -71,9 +73,9 @@ SubsetManager::~SubsetManager(){
 /*-------                 PUBLIC METHODS                 ------*/
 /*-------------------------------------------------------------*/
 
-/*! Builds a complete list of the possible subsets
-	NOTE: It would be better to only consider connected subsets because disconnected subsets will have zero phi.
-	However, identifying the connected subsets looked complicated, so brute force is used for now. */
+/*! Builds a complete list of the possible subsets.
+	When disconnected subsets are being ignored only the connected subsets are generated, since
+	disconnected subsets will have zero phi. Otherwise brute force is used to generate every subset. */
 void SubsetManager::buildSubsetList(){
 	int networkSize = neuronIDList.size();
 
@@ -91,10 +93,23 @@ void SubsetManager::buildSubsetList(){
 		#endif//DEBUG_SUBSETS
 		for(int i=0; i<networkSize; ++i)
 			subsetSelectionArray[i] = true;
+
+		//A disconnected network has zero phi
+		if(analysisInfo.getParameter("ignore_disconnected_subsets") && !subsetConnected(neuronIDList))
+			return;
 		addSubset(subsetSelectionArray, networkSize);
 		return;
 	}
 
+	//Grow connected subsets instead of filtering the complete list
+	if(analysisInfo.getParameter("ignore_disconnected_subsets")){
+		#ifdef DEBUG_SUBSETS
+			qDebug()<<"Analyzing connected subsets of network.";
+		#endif//DEBUG_SUBSETS
+		buildConnectedSubsetList();
+		return;
+	}
+
 	#ifdef DEBUG_SUBSETS
 		qDebug()<<"Full analysis of network, including all subsets.";
 	#endif//DEBUG_SUBSETS
@@ -141,6 +156,9 @@ void SubsetManager::identifyComplexes(){
 	//Get a local copy of the minimum value of phi
 	double minComplexPhi = analysisInfo.getParameter("minimum_complex_phi");
 
+	//Complexes are stored together once all of the subsets have been checked
+	QList<Complex> complexList;
+
 	//Check each subset to see if it contained within another subset of higher phi
 	for(int tstIndx=0; tstIndx<subsetList.size() && !*stop; ++tstIndx){
 
@@ -171,18 +189,20 @@ void SubsetManager::identifyComplexes(){
 			/* All the other subsets have been checked. If no enclosing subset has been found with higher
 				phi, then the current subset is a complex */
 			if(isComplex){
-				//Store complex in database
 				QList<unsigned int> subNeurIDs = subsetList[tstIndx]->getNeuronIDs();
-				stateDao->addComplex(analysisInfo.getID(), timeStep, subNeurIDs, subsetList[tstIndx]->getPhi());
-
-				//Inform other classes that a complex has been found
-				emit complexFound();
+				complexList.append(Complex(0, timeStep, subsetList[tstIndx]->getPhi(), subNeurIDs));
 			}
 		}
 
 		//Inform main application about progress
 		updateProgress("Identifying complexes. " + QString::number(tstIndx + 1) + " out of " + QString::number(subsetList.size()));
 	}
+
+	//Store complexes in database and inform other classes that they have been found
+	if(!complexList.isEmpty()){
+		stateDao->addComplexes(analysisInfo.getID(), complexList);
+		emit complexFound();
+	}
 }
 
 
@@ -192,13 +212,21 @@ void SubsetManager::runCalculation(const bool * const stop){
 	this->stop = stop;
 	phiCalculator->setStop(stop);
 
-	//Get a complete list of the neuron IDs in the network
-	neuronIDList = networkDao->getNeuronIDs(analysisInfo.getNetworkID());
-
-	//Get a complete map of the connections in the network, if required
-	if( analysisInfo.getParameter("ignore_disconnected_subsets") ){
-		networkDao->getAllFromConnections(analysisInfo.getNetworkID(), fromConnectionMap);
-		networkDao->getAllToConnections(analysisInfo.getNetworkID(), toConnectionMap);
+	/* Get a complete list of the neuron IDs in the network and a complete map of its connections, if required.
+	   These are taken from the shared snapshot of the network when one has been supplied */
+	if(weightlessNetwork.isNull()){
+		neuronIDList = networkDao->getNeuronIDs(analysisInfo.getNetworkID());
+		if( analysisInfo.getParameter("ignore_disconnected_subsets") ){
+			networkDao->getAllFromConnections(analysisInfo.getNetworkID(), fromConnectionMap);
+			networkDao->getAllToConnections(analysisInfo.getNetworkID(), toConnectionMap);
+		}
+	}
+	else{
+		neuronIDList = weightlessNetwork->getNeuronIDs();
+		if( analysisInfo.getParameter("ignore_disconnected_subsets") ){
+			weightlessNetwork->getAllFromConnections(fromConnectionMap);
+			weightlessNetwork->getAllToConnections(toConnectionMap);
+		}
 	}
 
 	//Record the number of steps that need to be completed and initialize progress counter
@@ -230,26 +258,60 @@ void SubsetManager::runCalculation(const bool * const stop){
 }
 
 
-/*! Returns true if all of the neurons have at least one connection to the other neurons in the subset.
-	FIXME: THIS ONLY IDENTIFIES INDIVIDUAL ISOLATED NEURONS, NOT TWO CLUSTERS SEPARATE FROM EACH OTHER. */
+/*! Returns true if every neuron in the subset can be reached from every other neuron through connections
+	within the subset, ignoring the direction of the connections. Subsets with fewer than two neurons are not connected.
+	Runs a breadth first search over bit masks of the positions in the neuron ID list. */
 bool SubsetManager::subsetConnected(QList<unsigned int> neuronIDs){
-	//Work through each neuron id
-	foreach(unsigned int neuronID, neuronIDs){
-		//Check that neuron is connected from or to at least one other member of the subset
-		bool neuronConnected = false;
-		foreach(unsigned int tstNeurID, neuronIDs){
-			if(tstNeurID != neuronID){//Being connected to itself does not count
-				if(fromConnectionMap[neuronID].contains(tstNeurID) || toConnectionMap[neuronID].contains(tstNeurID)){
-					neuronConnected = true;
-					break;
-				}
+	int subsetSize = neuronIDs.size();
+	if(subsetSize < 2)
+		return false;
+
+	//Bit masks of the neurons that have been reached and the neurons whose connections still have to be followed
+	int maskLength = (subsetSize + 31) / 32;
+	unsigned int reachedArray[maskLength];
+	unsigned int frontierArray[maskLength];
+	for(int i=0; i<maskLength; ++i){
+		reachedArray[i] = 0;
+		frontierArray[i] = 0;
+	}
+	reachedArray[0] = 1;
+	frontierArray[0] = 1;
+	int reachedCount = 1;
+
+	//Expand out from the first neuron until there is nothing left to expand
+	while(true){
+		//Get the next neuron from the frontier
+		int neurIndx = -1;
+		for(int wordIndx=0; wordIndx<maskLength && neurIndx<0; ++wordIndx){
+			if(frontierArray[wordIndx]){
+				int bitIndx = 0;
+				while( !(frontierArray[wordIndx] & (1u<<bitIndx)) )
+					++bitIndx;
+				frontierArray[wordIndx] &= ~(1u<<bitIndx);
+				neurIndx = wordIndx*32 + bitIndx;
+			}
+		}
+		if(neurIndx < 0)
+			break;
+
+		//Add unreached neurons that are connected to or from this neuron
+		unsigned int neuronID = neuronIDs.at(neurIndx);
+		QHash<unsigned int, bool> fromMap = fromConnectionMap.value(neuronID);
+		QHash<unsigned int, bool> toMap = toConnectionMap.value(neuronID);
+		for(int tstIndx=0; tstIndx<subsetSize; ++tstIndx){
+			if(reachedArray[tstIndx/32] & (1u<<(tstIndx%32)))
+				continue;
+			unsigned int tstNeurID = neuronIDs.at(tstIndx);
+			if(fromMap.contains(tstNeurID) || toMap.contains(tstNeurID)){
+				reachedArray[tstIndx/32] |= 1u<<(tstIndx%32);
+				frontierArray[tstIndx/32] |= 1u<<(tstIndx%32);
+				++reachedCount;
 			}
 		}
-		//No connection exists from or to this neuron with other neurons in the subset
-		if(!neuronConnected)
-			return false;
 	}
-	return true;
+
+	//Subset is connected if the search reached every neuron
+	return reachedCount == subsetSize;
 }
 
 
@@ -269,16 +331,115 @@ void SubsetManager::addSubset(bool subsetSelectionArray[], int arrayLength){
 			tmpSubset->addNeuronIndex(i);
 	}
 
-	if(analysisInfo.getParameter("ignore_disconnected_subsets")){
-		if( subsetConnected(tmpSubset->getNeuronIDs()) ){
-			//Store subset in class
-			subsetList.append(tmpSubset);
+	//Store subset in class
+	subsetList.append(tmpSubset);
+}
+
+
+/*! Adds the subset whose neuron indexes are set in the bit array to the subset list.
+	The bit array has the same layout as a row of the adjacency matrix. */
+void SubsetManager::addSubset(const unsigned int* subsetBitArray){
+	Subset* tmpSubset = new Subset(&neuronIDList);
+	int networkSize = neuronIDList.size();
+	for(int i=0; i<networkSize; ++i){
+		if(subsetBitArray[i/32] & (1u<<(i%32)))
+			tmpSubset->addNeuronIndex(i);
+	}
+	subsetList.append(tmpSubset);
+}
+
+
+/*! Builds the undirected adjacency bit matrix of the neurons in the neuron ID list
+	from the from and to connection maps. Self connections are ignored. */
+void SubsetManager::buildAdjacencyMatrix(){
+	deleteAdjacencyMatrix();
+
+	//Create and initialize matrix
+	int networkSize = neuronIDList.size();
+	adjacencyRowLength = (networkSize + 31) / 32;
+	adjacencyMatrix = new unsigned int[networkSize * adjacencyRowLength];
+	for(int i=0; i<networkSize * adjacencyRowLength; ++i)
+		adjacencyMatrix[i] = 0;
+
+	//Map linking neuron IDs to their index in the neuron ID list
+	QHash<unsigned int, int> neuronIndexMap;
+	for(int i=0; i<networkSize; ++i)
+		neuronIndexMap[neuronIDList.at(i)] = i;
+
+	//Set the bits for each connection in both directions
+	for(int fromIndx=0; fromIndx<networkSize; ++fromIndx){
+		unsigned int neuronID = neuronIDList.at(fromIndx);
+		QList<unsigned int> conNeurIDs = fromConnectionMap.value(neuronID).keys() + toConnectionMap.value(neuronID).keys();
+		foreach(unsigned int conNeurID, conNeurIDs){
+			if(conNeurID == neuronID || !neuronIndexMap.contains(conNeurID))
+				continue;
+			int toIndx = neuronIndexMap[conNeurID];
+			adjacencyMatrix[fromIndx*adjacencyRowLength + toIndx/32] |= 1u<<(toIndx%32);
+			adjacencyMatrix[toIndx*adjacencyRowLength + fromIndx/32] |= 1u<<(fromIndx%32);
 		}
 	}
-	else{
-		//Store subset in class
-		subsetList.append(tmpSubset);
+}
+
+
+/*! Builds a list of the connected subsets of the network by growing subsets outwards from each seed neuron.
+	Each connected subset is generated exactly once: subsets only grow into neurons with a higher index
+	than the seed and a neuron only joins the extension set when it first becomes adjacent to the subset
+	(the ESU algorithm, Wernicke 2006). */
+void SubsetManager::buildConnectedSubsetList(){
+	int networkSize = neuronIDList.size();
+	buildAdjacencyMatrix();
+
+	//Working bit arrays. Each level of recursion uses three rows of the scratch array.
+	unsigned int* subsetBitArray = new unsigned int[adjacencyRowLength];
+	unsigned int* seedMaskArray = new unsigned int[adjacencyRowLength];
+	unsigned int* extensionBitArray = new unsigned int[adjacencyRowLength];
+	unsigned int* closedBitArray = new unsigned int[adjacencyRowLength];
+	unsigned int* scratchArray = new unsigned int[3 * (networkSize + 1) * adjacencyRowLength];
+
+	//The last neuron cannot seed a subset because it has no neighbours with a higher index
+	for(int seedIndx=0; seedIndx<networkSize-1 && !*stop; ++seedIndx){
+		//Initialize arrays for this seed
+		const unsigned int* seedRow = &adjacencyMatrix[seedIndx * adjacencyRowLength];
+		int seedWord = seedIndx / 32;
+		int seedBit = seedIndx % 32;
+		for(int i=0; i<adjacencyRowLength; ++i){
+			subsetBitArray[i] = 0;
+			if(i < seedWord)
+				seedMaskArray[i] = 0;
+			else if(i > seedWord)
+				seedMaskArray[i] = 0xffffffff;
+			else if(seedBit == 31)
+				seedMaskArray[i] = 0;
+			else
+				seedMaskArray[i] = 0xffffffff << (seedBit + 1);
+			extensionBitArray[i] = seedRow[i] & seedMaskArray[i];
+			closedBitArray[i] = seedRow[i];
+		}
+		subsetBitArray[seedWord] |= 1u<<seedBit;
+		closedBitArray[seedWord] |= 1u<<seedBit;
+
+		//Add all of the connected subsets that have this neuron as their lowest index
+		extendConnectedSubset(subsetBitArray, extensionBitArray, closedBitArray, seedMaskArray, scratchArray);
+
+		//Inform other classes about progress
+		updateProgress("Building subset list. " + QString::number(seedIndx + 1) + " out of " + QString::number(networkSize-1));
 	}
+
+	//Clean up
+	delete [] subsetBitArray;
+	delete [] seedMaskArray;
+	delete [] extensionBitArray;
+	delete [] closedBitArray;
+	delete [] scratchArray;
+}
+
+
+/*! Deletes the adjacency matrix */
+void SubsetManager::deleteAdjacencyMatrix(){
+	if(adjacencyMatrix != NULL)
+		delete [] adjacencyMatrix;
+	adjacencyMatrix = NULL;
+	adjacencyRowLength = 0;
 }
 
 
@@ -290,6 +451,42 @@ void SubsetManager::deleteSubsets(){
 }
 
 
+/*! Adds each neuron in the extension set to the current subset, stores the enlarged subset
+	and then extends it recursively. The closed array holds the subset and all of its neighbours, so
+	only neurons that are new neighbours of the added neuron are added to the extension set. */
+void SubsetManager::extendConnectedSubset(unsigned int* subsetBitArray, const unsigned int* extensionBitArray, const unsigned int* closedBitArray, const unsigned int* seedMaskArray, unsigned int* scratchArray){
+	//Arrays for this level of recursion
+	unsigned int* remainingBitArray = scratchArray;
+	unsigned int* newExtensionBitArray = &scratchArray[adjacencyRowLength];
+	unsigned int* newClosedBitArray = &scratchArray[2 * adjacencyRowLength];
+	for(int i=0; i<adjacencyRowLength; ++i)
+		remainingBitArray[i] = extensionBitArray[i];
+
+	//Work through the extension set, removing each neuron as it is added
+	for(int wordIndx=0; wordIndx<adjacencyRowLength && !*stop; ++wordIndx){
+		while(remainingBitArray[wordIndx] && !*stop){
+			int bitIndx = 0;
+			while( !(remainingBitArray[wordIndx] & (1u<<bitIndx)) )
+				++bitIndx;
+			remainingBitArray[wordIndx] &= ~(1u<<bitIndx);
+			const unsigned int* neighbourRow = &adjacencyMatrix[(wordIndx*32 + bitIndx) * adjacencyRowLength];
+
+			//Exclusive neighbours of the added neuron extend the search
+			for(int i=0; i<adjacencyRowLength; ++i){
+				newExtensionBitArray[i] = remainingBitArray[i] | (neighbourRow[i] & ~closedBitArray[i] & seedMaskArray[i]);
+				newClosedBitArray[i] = closedBitArray[i] | neighbourRow[i];
+			}
+
+			//Store the enlarged subset and grow it further
+			subsetBitArray[wordIndx] |= 1u<<bitIndx;
+			addSubset(subsetBitArray);
+			extendConnectedSubset(subsetBitArray, newExtensionBitArray, newClosedBitArray, seedMaskArray, &scratchArray[3 * adjacencyRowLength]);
+			subsetBitArray[wordIndx] &= ~(1u<<bitIndx);
+		}
+	}
+}
+
+
 /*! Works out the maximum size of the subset list. Used for indicating progress with the calculation. */
 unsigned int SubsetManager::getMaxSubsetListSize(int numberOfNeurons){
 
@@ -20,7 +20,7 @@ namespace spikestream {
 	Q_OBJECT
 
 	public:
-	    SubsetManager(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo, const AnalysisInfo& anaInfo, unsigned int timeStep);
+	    SubsetManager(NetworkDao* networkDao, ArchiveDao* archiveDao, StateBasedPhiAnalysisDao* stateDao, const AnalysisInfo& anaInfo, unsigned int timeStep, WeightlessNetworkSnapshotPtr weiNetwork);
 	    SubsetManager();
 	    ~SubsetManager();
 	    void buildSubsetList();
@@ -44,7 +44,7 @@ namespace spikestream {
 
 	private:
 	    //========================  VARIABLES  ========================
-	    /*! Wrapper around the network database */
+	    /*! Wrapper around the network database. Data access objects belong to the calling class */
 	    NetworkDao* networkDao;
 
 	    /*! Wrapper around the archive database */
@@ -62,6 +62,9 @@ namespace spikestream {
 	    /*! Pointer to the stop variable in the controlling thread. */
 	    const bool* stop;
 
+	    /*! Weightless neurons shared by the threads in the analysis. Null if the network is loaded from the database. */
+	    WeightlessNetworkSnapshotPtr weightlessNetwork;
+
 	    /*! List of all of the neuron IDs in the network */
 	    QList<unsigned int> neuronIDList;
 
@@ -73,6 +76,15 @@ namespace spikestream {
 		Used for filtering out subsets with a disconnected neuron, which have zero phi */
 	    QHash<unsigned int, QHash<unsigned int, bool> > toConnectionMap;
 
+	    /*! Undirected adjacency bit matrix over the neuron indexes in neuronIDList.
+		Each row holds adjacencyRowLength 32 bit words; bit j of row i is set if neuron i
+		is connected to or from neuron j. Built from the connection maps when disconnected
+		subsets are being ignored. */
+	    unsigned int* adjacencyMatrix;
+
+	    /*! Number of 32 bit words in each row of the adjacency matrix */
+	    int adjacencyRowLength;
+
 	    /*! Complete list of possible subsets */
 	    QList<Subset*> subsetList;
 
@@ -87,7 +99,12 @@ namespace spikestream {
 
 	    //========================  METHODS  ============================
 	    void addSubset(bool subsetSelectionArray[], int arrayLength);
+	    void addSubset(const unsigned int* subsetBitArray);
+	    void buildAdjacencyMatrix();
+	    void buildConnectedSubsetList();
+	    void deleteAdjacencyMatrix();
 	    void deleteSubsets();
+	    void extendConnectedSubset(unsigned int* subsetBitArray, const unsigned int* extensionBitArray, const unsigned int* closedBitArray, const unsigned int* seedMaskArray, unsigned int* scratchArray);
 	    unsigned int getMaxSubsetListSize(int numberOfNeurons);
 	    void updateProgress(const QString& msg);
     };
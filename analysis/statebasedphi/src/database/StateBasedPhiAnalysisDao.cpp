@@ -37,6 +37,36 @@ void StateBasedPhiAnalysisDao::addComplex(unsigned int analysisID, int timeStep,
 }
 
 
+/*! Adds a list of complexes to the database in a single transaction.
+	The time step of each complex is taken from the complex and its ID is ignored. */
+void StateBasedPhiAnalysisDao::addComplexes(unsigned int analysisID, const QList<Complex>& complexList){
+	if(complexList.isEmpty())
+		return;
+
+	//Store the values of each row
+	QList<QVariant> valueList;
+	foreach(const Complex& cmplx, complexList){
+		if(cmplx.getNeuronIDs().size() < 2)
+			throw SpikeStreamException("A complex must contain at least 2 neurons.");
+		valueList.append(analysisID);
+		valueList.append(cmplx.getTimeStep());
+		valueList.append(cmplx.getPhi());
+		valueList.append(cmplx.getNeuronIDString());
+	}
+
+	//Add the complexes
+	startTransaction();
+	try{
+		executeBatchInsert("INSERT INTO StateBasedPhiData (AnalysisID, TimeStep, Phi, Neurons) VALUES", 4, valueList);
+	}
+	catch(...){
+		rollbackTransaction();
+		throw;
+	}
+	commitTransaction();
+}
+
+
 /*! Deletes time steps covering the specified range.
 	This range is inclusive, so first and last time steps will be deleted */
 void StateBasedPhiAnalysisDao::deleteTimeSteps(unsigned int analysisID, unsigned int firstTimeStep, unsigned int lastTimeStep){
@@ -15,6 +15,7 @@ namespace spikestream {
 		StateBasedPhiAnalysisDao();
 		virtual ~StateBasedPhiAnalysisDao();
 		virtual void addComplex(unsigned int analysisID, int timeStep, QList<unsigned int>& neuronIDList, double phi);
+		virtual void addComplexes(unsigned int analysisID, const QList<Complex>& complexList);
 		void deleteTimeSteps(unsigned int analysisID, unsigned int firstTimeStep, unsigned int lastTimeStep);
 		unsigned int getComplexCount(unsigned int analysisID, unsigned int firstTimeStep, unsigned int lastTimeStep);
 		QList<Complex> getComplexes(unsigned int analysisID);
@@ -58,6 +58,7 @@ StateBasedPhiWidget::StateBasedPhiWidget(QWidget *parent) : AbstractAnalysisWidg
 
 	//Set up analysis runner with function to create threads to analyze for state-based phi
 	analysisRunner->setTimeStepThreadCreationFunction(&createAnalysisTimeStepThread);
+	analysisRunner->setLoadWeightlessNetwork(true);
 
 	//Add tool bar to top of widget
 	toolBar = getDefaultToolBar();
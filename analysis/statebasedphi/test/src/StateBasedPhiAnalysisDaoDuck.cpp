@@ -19,12 +19,9 @@ StateBasedPhiAnalysisDaoDuck::~StateBasedPhiAnalysisDaoDuck(){
 }
 
 
-/*! Instead of storing complex in database the complex is stored in a list for testing */
-void StateBasedPhiAnalysisDaoDuck::addComplex(unsigned int, int, QList<unsigned int>& neuronIDList, double phi){
-    Complex cmplx;
-    cmplx.setNeuronIDs(neuronIDList);
-    cmplx.setPhi(phi);
-    complexList.append(cmplx);
+/*! Instead of storing complexes in database the complexes are stored in a list for testing */
+void StateBasedPhiAnalysisDaoDuck::addComplexes(unsigned int, const QList<Complex>& newComplexList){
+    complexList.append(newComplexList);
 }
 
 /*! Resets information stored in the class */
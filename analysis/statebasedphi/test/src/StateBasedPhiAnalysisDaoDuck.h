@@ -15,7 +15,7 @@ class StateBasedPhiAnalysisDaoDuck : public StateBasedPhiAnalysisDao {
 	public:
 		StateBasedPhiAnalysisDaoDuck();
 		virtual ~StateBasedPhiAnalysisDaoDuck();
-		void addComplex(unsigned int analysisID, int timeStep, QList<unsigned int>& neuronIDList, double phi);
+		void addComplexes(unsigned int analysisID, const QList<Complex>& complexList);
 		QList<Complex> getComplexList() { return complexList; }
 		void reset();
 
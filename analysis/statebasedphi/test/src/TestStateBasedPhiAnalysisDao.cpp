@@ -1,5 +1,6 @@
 #include "TestStateBasedPhiAnalysisDao.h"
 #include "StateBasedPhiAnalysisDao.h"
+#include "SpikeStreamException.h"
 using namespace spikestream;
 
 void TestStateBasedPhiAnalysisDao::testAddComplex(){
@@ -27,6 +28,49 @@ void TestStateBasedPhiAnalysisDao::testAddComplex(){
 }
 
 
+void TestStateBasedPhiAnalysisDao::testAddComplexes(){
+	//Add test analysis
+	addTestAnalysis1();
+
+	//Build enough complexes to need more than one insert statement
+	QList<Complex> complexList;
+	for(unsigned int i=0; i<300; ++i){
+		QList<unsigned int> neuronIDList;
+		neuronIDList.append(i);
+		neuronIDList.append(i+1);
+		complexList.append(Complex(0, i % 3, i * 0.5, neuronIDList));
+	}
+
+	//Create class to be tested and test it
+	StateBasedPhiAnalysisDao anaDao(analysisDBInfo);
+	anaDao.addComplexes(testAnalysis1ID, complexList);
+	QCOMPARE(anaDao.getComplexCount(testAnalysis1ID, 0, 2), (unsigned int)300);
+	QCOMPARE(anaDao.getComplexCount(testAnalysis1ID, 1, 1), (unsigned int)100);
+
+	//Check the last complex, which is added by the final statement
+	QSqlQuery query = getAnalysisQuery("SELECT AnalysisID, TimeStep, Phi FROM StateBasedPhiData WHERE Neurons='299,300'");
+	executeQuery(query);
+	query.next();
+	QCOMPARE(query.size(), (int)1);
+	QCOMPARE(query.value(0).toUInt(), (unsigned int)testAnalysis1ID);
+	QCOMPARE(query.value(1).toUInt(), (unsigned int)2);
+	QCOMPARE(query.value(2).toDouble(), 149.5);
+
+	//Complexes with less than two neurons should be rejected without adding anything
+	QList<unsigned int> singleNeuronList;
+	singleNeuronList.append(5);
+	complexList.clear();
+	complexList.append(Complex(0, 7, 1.0, singleNeuronList));
+	try{
+		anaDao.addComplexes(testAnalysis1ID, complexList);
+		QFAIL("Exception should have been thrown.");
+	}
+	catch(SpikeStreamException& ex){
+	}
+	QCOMPARE(anaDao.getComplexCount(testAnalysis1ID, 7, 7), (unsigned int)0);
+}
+
+
 void TestStateBasedPhiAnalysisDao::testDeleteTimeSteps(){
 	//Add test analysis and data
 	addTestAnalysis1();
@@ -13,6 +13,7 @@ class TestStateBasedPhiAnalysisDao : public TestDao {
 
 	private slots:
 	    void testAddComplex();
+	    void testAddComplexes();
 	    void testDeleteTimeSteps();
 	    void testGetComplexCount();
 	    void testGetComplexes();
@@ -55,13 +55,76 @@ void TestSubsetManager::testBuildSubsetList(){
 }
 
 
+void TestSubsetManager::testBuildConnectedSubsetList(){
+	/* Build connections as follows
+	1->2   3->2   4->5   6 */
+	QHash<unsigned int, QHash<unsigned int, bool> > fromConMap;
+	QHash<unsigned int, QHash<unsigned int, bool> > toConMap;
+	fromConMap[1][2] = true;
+	fromConMap[3][2] = true;
+	fromConMap[4][5] = true;
+	toConMap[2][1] = true;
+	toConMap[2][3] = true;
+	toConMap[5][4] = true;
+
+	//Create test class
+	SubsetManager subsetManager;
+	subsetManager.setPhiCalculator(new PhiCalculator());
+	AnalysisInfo info = getAnalysisInfo();
+	info.getParameterMap()["ignore_disconnected_subsets"] = 1.0;
+	subsetManager.setAnalysisInfo(info);
+	subsetManager.setFromConnectionMap(fromConMap);
+	subsetManager.setToConnectionMap(toConMap);
+
+	try{
+		QList<unsigned int> neuronIDList;
+		for(unsigned int i=1; i<=6; ++i)
+			neuronIDList.append(i);
+		subsetManager.setNeuronIDList(neuronIDList);
+
+		//Only the connected subsets should be built
+		subsetManager.buildSubsetList();
+		QList<Subset*> subsetList = subsetManager.getSubsetList();
+		QCOMPARE(subsetList.size(), (int)4);
+		QVERIFY(subsetContains(subsetList,"1,2"));
+		QVERIFY(subsetContains(subsetList,"2,3"));
+		QVERIFY(subsetContains(subsetList,"1,2,3"));
+		QVERIFY(subsetContains(subsetList,"4,5"));
+
+		//Ring of 9 neurons has 9 connected subsets at each size from 2 to 8 plus the whole ring
+		fromConMap.clear();
+		toConMap.clear();
+		neuronIDList.clear();
+		for(unsigned int i=20; i<29; ++i){
+			neuronIDList.append(i);
+			unsigned int nextID = i == 28 ? 20 : i + 1;
+			fromConMap[i][nextID] = true;
+			toConMap[nextID][i] = true;
+		}
+		subsetManager.setNeuronIDList(neuronIDList);
+		subsetManager.setFromConnectionMap(fromConMap);
+		subsetManager.setToConnectionMap(toConMap);
+		subsetManager.buildSubsetList();
+		subsetList = subsetManager.getSubsetList();
+		QCOMPARE(subsetList.size(), (int)64);
+		QVERIFY(subsetContains(subsetList,"27,28"));
+		QVERIFY(subsetContains(subsetList,"28,20,21"));
+		QVERIFY(subsetContains(subsetList,"20,21,22,23,24,25,26,27,28"));
+		QVERIFY(!subsetContains(subsetList,"21,28"));
+	}
+	catch(SpikeStreamException& ex){
+		QFAIL(ex.getMessage().toAscii());
+	}
+}
+
+
 void TestSubsetManager::testIdentifyComplexes(){
     //Create test class
     SubsetManager subsetManager;
     PhiCalculator* phiCalc = PhiUtil::buildPhiTestNetwork1();
     subsetManager.setPhiCalculator(phiCalc);
-    StateBasedPhiAnalysisDaoDuck* stateDaoDuck = new StateBasedPhiAnalysisDaoDuck();
-    subsetManager.setStateDao(stateDaoDuck);
+    StateBasedPhiAnalysisDaoDuck stateDaoDuck;
+    subsetManager.setStateDao(&stateDaoDuck);
     subsetManager.setAnalysisInfo(getAnalysisInfo());
     QList<unsigned int> neuronIDList;
 
@@ -76,7 +139,7 @@ void TestSubsetManager::testIdentifyComplexes(){
 		subsetManager.identifyComplexes();
 
 		//Check complexes are correct
-		QList<Complex> complexList = stateDaoDuck->getComplexList();
+		QList<Complex> complexList = stateDaoDuck.getComplexList();
 		QVERIFY( complexExists(complexList, "1,2", 2.0) );
 		QVERIFY( complexExists(complexList, "3,4", 2.0) );
 
@@ -86,7 +149,7 @@ void TestSubsetManager::testIdentifyComplexes(){
 		//Set up test class for network 2
 		PhiCalculator* phiCalc = PhiUtil::buildPhiTestNetwork2();
 		subsetManager.setPhiCalculator(phiCalc);
-		stateDaoDuck->reset();
+		stateDaoDuck.reset();
 		neuronIDList.clear();
 		for(unsigned int i=1; i<=6; ++i)
 			neuronIDList.append(i);
@@ -96,7 +159,7 @@ void TestSubsetManager::testIdentifyComplexes(){
 		subsetManager.identifyComplexes();
 
 		//Check complexes exist
-		complexList = stateDaoDuck->getComplexList();
+		complexList = stateDaoDuck.getComplexList();
 		QVERIFY( complexExists(complexList, "1,2,3", 3.0) );
 		QVERIFY( complexExists(complexList, "3,6", 1.0) );
 		QVERIFY( complexExists(complexList, "2,5", 1.0) );
@@ -120,11 +183,13 @@ void TestSubsetManager::testSubsetConnected(){
     QHash<unsigned int, QHash<unsigned int, bool> > toConMap;
 
     /* Build connections as follows
-	1->2   3->2 */
+	1->2   3->2   5->6 */
     fromConMap[1][2] = true;
     fromConMap[3][2] = true;
+    fromConMap[5][6] = true;
     toConMap[2][1] = true;
     toConMap[2][3] = true;
+    toConMap[6][5] = true;
 
     //Create test class and set connection maps
     SubsetManager subsetManager;
@@ -147,11 +212,19 @@ void TestSubsetManager::testSubsetConnected(){
     subset3.append(1);
     subset3.append(3);
 
+    //Two clusters that are not connected to each other
+    QList<unsigned int> subset4;
+    subset4.append(1);
+    subset4.append(2);
+    subset4.append(5);
+    subset4.append(6);
+
     //Test the method
 	try{
 		QCOMPARE( subsetManager.subsetConnected(subset1), true);
 		QCOMPARE( subsetManager.subsetConnected(subset2), false);
 		QCOMPARE( subsetManager.subsetConnected(subset3), false);
+		QCOMPARE( subsetManager.subsetConnected(subset4), false);
 	}
 	catch(SpikeStreamException& ex){
 		QFAIL(ex.getMessage().toAscii());
@@ -15,6 +15,7 @@ class TestSubsetManager : public QObject {
 
     private slots:
 		void testBuildSubsetList();
+		void testBuildConnectedSubsetList();
 		void testIdentifyComplexes();
 		void testSubsetConnected();
 
@@ -0,0 +1,65 @@
+//SpikeStream includes
+#include "SpikeTrainData.h"
+#include "SpikeStreamAnalysisException.h"
+using namespace spikestream;
+
+//Other includes
+#include <cstring>
+
+
+/*! Constructor */
+SpikeTrainData::SpikeTrainData(){
+	spikeArray = NULL;
+	numberOfNeurons = 0;
+	numberOfTimeSteps = 0;
+	wordsPerNeuron = 0;
+}
+
+
+/*! Destructor */
+SpikeTrainData::~SpikeTrainData(){
+	if(spikeArray != NULL)
+		delete [] spikeArray;
+}
+
+
+/*----------------------------------------------------------*/
+/*------                PUBLIC METHODS                ------*/
+/*----------------------------------------------------------*/
+
+/*! Records a spike for the neuron at the specified index at the time step.
+	The time step is relative to the first time step that was loaded. */
+void SpikeTrainData::addSpike(unsigned neuronIndex, unsigned timeStep){
+	if(neuronIndex >= numberOfNeurons)
+		throw SpikeStreamAnalysisException("Neuron index out of range: " + QString::number(neuronIndex));
+	if(timeStep >= numberOfTimeSteps)
+		throw SpikeStreamAnalysisException("Time step out of range: " + QString::number(timeStep));
+	spikeArray[neuronIndex * wordsPerNeuron + (timeStep >> 6)] |= (uint64_t)1 << (timeStep & 63);
+}
+
+
+/*! Returns the packed spike train of the neuron at the specified index.
+	Individual time steps can be read from it with getSpike(). */
+const uint64_t* SpikeTrainData::getSpikeTrain(unsigned neuronIndex) const{
+	if(neuronIndex >= numberOfNeurons)
+		throw SpikeStreamAnalysisException("Neuron index out of range: " + QString::number(neuronIndex));
+	return &spikeArray[neuronIndex * wordsPerNeuron];
+}
+
+
+/*! Clears the data and sets up empty spike trains for the specified number of neurons and time steps */
+void SpikeTrainData::reset(unsigned numberOfNeurons, unsigned numberOfTimeSteps){
+	if(spikeArray != NULL){
+		delete [] spikeArray;
+		spikeArray = NULL;
+	}
+
+	this->numberOfNeurons = numberOfNeurons;
+	this->numberOfTimeSteps = numberOfTimeSteps;
+	wordsPerNeuron = (numberOfTimeSteps + 63) / 64;
+
+	if(numberOfNeurons * wordsPerNeuron > 0){
+		spikeArray = new uint64_t[numberOfNeurons * wordsPerNeuron];
+		memset(spikeArray, 0, numberOfNeurons * wordsPerNeuron * sizeof(uint64_t));
+	}
+}
@@ -0,0 +1,49 @@
+#ifndef SPIKETRAINDATA_H
+#define SPIKETRAINDATA_H
+
+//Other includes
+#include <stdint.h>
+
+namespace spikestream {
+
+	/*! Holds the firing of a set of neurons over a range of time steps.
+		Each neuron's spike train is packed into 64 bit words with one bit per time step,
+		so the data for a large archive can be loaded once and shared between threads. */
+	class SpikeTrainData {
+		public:
+			SpikeTrainData();
+			~SpikeTrainData();
+			void addSpike(unsigned neuronIndex, unsigned timeStep);
+			unsigned getNumberOfNeurons() const { return numberOfNeurons; }
+			unsigned getNumberOfTimeSteps() const { return numberOfTimeSteps; }
+			const uint64_t* getSpikeTrain(unsigned neuronIndex) const;
+			void reset(unsigned numberOfNeurons, unsigned numberOfTimeSteps);
+
+			/*! Returns 1 if the spike train contains a spike at the time step and 0 otherwise */
+			static inline unsigned getSpike(const uint64_t* spikeTrain, unsigned timeStep) {
+				return (spikeTrain[timeStep >> 6] >> (timeStep & 63)) & 1;
+			}
+
+		private:
+			//===========================  VARIABLES  ===========================
+			/*! Spike trains of all of the neurons. Each spike train occupies wordsPerNeuron words */
+			uint64_t* spikeArray;
+
+			/*! Number of neurons whose spike trains are stored */
+			unsigned numberOfNeurons;
+
+			/*! Number of time steps in each spike train. Time step 0 is the first time step that was loaded */
+			unsigned numberOfTimeSteps;
+
+			/*! Number of 64 bit words in each spike train */
+			unsigned wordsPerNeuron;
+
+
+			//============================  METHODS  ============================
+			SpikeTrainData(const SpikeTrainData&);
+			SpikeTrainData& operator=(const SpikeTrainData&);
+	};
+
+}
+
+#endif//SPIKETRAINDATA_H
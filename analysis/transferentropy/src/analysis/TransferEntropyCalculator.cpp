@@ -1,6 +1,7 @@
 //SpikeStream includes
 #include "TransferEntropyCalculator.h"
 #include "SpikeStreamAnalysisException.h"
+#include "SpikeTrainData.h"
 using namespace spikestream;
 
 //Qt includes
@@ -8,17 +9,16 @@ using namespace spikestream;
 
 //Other includes
 #include <cmath>
+#include <cstring>
+#include <stdint.h>
 #include <iostream>
 using namespace std;
 
 /*! Number of bits in an unsigned variable */
 #define NUM_BITS 32
 
-/*! Output debug information about probabilities */
-//#define DEBUG_PROBABILITIES
-
-/*! Output debug information about the calculation of the sum */
-#define DEBUG_EQUATION
+/*! Maximum value of k + l + 1. Limits the size of the largest histogram */
+#define MAX_PATTERN_BITS 24
 
 
 /*! Constructor */
@@ -30,16 +30,59 @@ TransferEntropyCalculator::TransferEntropyCalculator(unsigned k_param, unsigned
 		throw SpikeStreamAnalysisException("k_param must be greater than or equal to l_param");
 	if(k_param > timeWindow)
 		throw SpikeStreamAnalysisException("k_param must be less or equal to the time window");
+	if(k_param + l_param + 1 > MAX_PATTERN_BITS)
+		throw SpikeStreamAnalysisException("k_param + l_param + 1 cannot be greater than " + QString::number(MAX_PATTERN_BITS));
 
 	//Store parameters
 	this->k_param = k_param;
 	this->l_param = l_param;
 	this->timeWindow = timeWindow;
+	debug = false;
+
+	//Create histograms, which are indexed by the pattern of bits
+	I_k_counts = new unsigned[1<<k_param];
+	I_k_plus_1_counts = new unsigned[1<<(k_param + 1)];
+	I_k_J_l_counts = new unsigned[1<<(k_param + l_param)];
+	I_k_plus_1_J_l_counts = new unsigned[1<<(k_param + 1 + l_param)];
+	I_k_total = I_k_plus_1_total = I_k_J_l_total = I_k_plus_1_J_l_total = 0;
+	countsModified = true;
+	clearCounts();
+
+	//There cannot be more distinct sequences than positions in the time window
+	occupiedKeys = new unsigned[timeWindow];
+	numberOfOccupiedKeys = 0;
+
+	//Precompute logs of the counts. A sliding window briefly holds one more sequence than the time window.
+	logTable = new double[timeWindow + 2];
+	logTable[0] = 0.0;
+	for(unsigned i=1; i<=timeWindow + 1; ++i)
+		logTable[i] = log10((double)i);
+
+	//Sums of squared joint counts used by the sliding window
+	I_k_squares = new uint64_t[1<<k_param];
+	I_k_plus_1_squares = new uint64_t[1<<(k_param + 1)];
+	I_k_J_l_squares = new uint64_t[1<<(k_param + l_param)];
+
+	//Sliding window is not set up until startSlidingWindow is called
+	slidingITrain = NULL;
+	slidingJTrain = NULL;
+	slidingTrainLength = 0;
+	slidingStartTimeStep = 0;
+	I_k_plus_1_J_l_sum = I_k_sum = I_k_plus_1_sum = I_k_J_l_sum = 0.0;
 }
 
 
 /*! Destructor */
 TransferEntropyCalculator::~TransferEntropyCalculator(){
+	delete [] I_k_counts;
+	delete [] I_k_plus_1_counts;
+	delete [] I_k_J_l_counts;
+	delete [] I_k_plus_1_J_l_counts;
+	delete [] occupiedKeys;
+	delete [] logTable;
+	delete [] I_k_squares;
+	delete [] I_k_plus_1_squares;
+	delete [] I_k_J_l_squares;
 }
 
 
@@ -49,7 +92,9 @@ TransferEntropyCalculator::~TransferEntropyCalculator(){
 
 /*! Calculates the transfer entropy between the two sets of data for the time window specified.
 	fromNeuronData contains list of unsigned 1s and 0s indicating the spike activity in J.
-	toNeuronData contains list of unsigned 1s and 0s indicating the spike activity in I. */
+	toNeuronData contains list of unsigned 1s and 0s indicating the spike activity in I.
+	All four histograms are filled in a single pass through the data. The sum over the time steps
+	is then worked out from the distinct sequences, weighting each by the number of times it occurred. */
 double TransferEntropyCalculator::getTransferEntropy(unsigned startTimeStep, vector<unsigned>& iVector, vector<unsigned>& jVector){
 	//Run checks
 	if(startTimeStep + timeWindow > iVector.size())
@@ -59,141 +104,124 @@ double TransferEntropyCalculator::getTransferEntropy(unsigned startTimeStep, vec
 	if(startTimeStep + k_param >= iVector.size() || startTimeStep + l_param >= jVector.size())
 		throw SpikeStreamAnalysisException("StartTimeStep + parameter window is greater than vector size.");
 
-	//Load all probabilities for the time sequence into hash maps
-	load_I_k_probabilities(startTimeStep, iVector);
-	load_I_k_plus_1_probabilities(startTimeStep, iVector);
-	load_I_k_J_l_probabilities(startTimeStep, iVector, jVector);
-	load_I_k_plus_1_J_l_probabilities(startTimeStep, iVector, jVector);
-
-
-	//----------------------------------------------------------------
-	//  Bit masks - these methods are copied from the load methods
-	//----------------------------------------------------------------
-	unsigned i_k_bitmask = 1<<k_param;
-	--i_k_bitmask;
-
-	unsigned i_k_plus_1_bitmask = 1<<(k_param+1);
-	--i_k_plus_1_bitmask;
-
-	unsigned i_k_j_l_bitmask = 1<<(k_param+l_param);
-	--i_k_j_l_bitmask;
-	i_k_j_l_bitmask ^= (1<<l_param);
-
-	unsigned i_k_plus_1_j_l_bitmask = 1<<(k_param + 1 + l_param);
-	--i_k_plus_1_j_l_bitmask;
-	i_k_plus_1_j_l_bitmask ^= (1<<l_param);
+	//Data has been checked, so it can be accessed directly
+	const unsigned* iData = &iVector[0];
+	const unsigned* jData = &jVector[0];
+	clearCounts();
 
+	//Bit masks
+	unsigned i_k_bitmask = (1<<k_param) - 1;
+	unsigned j_l_bitmask = (1<<l_param) - 1;
 
-	//----------------------------------------------------------------------------------
-	//  Starting versions of numbers - these methods are copied from the load methods
-	//----------------------------------------------------------------------------------
-	//Load in first i_k number
+	//Load in first sequences, which both end at startTimeStep + k_param - 1
 	unsigned i_k = 0;
 	for(unsigned b = startTimeStep; b < startTimeStep+k_param; ++b){
 		i_k <<= 1;
-		i_k |= iVector.at(b);
-	}
-
-	//Load in first i_k_plus_1 number
-	unsigned i_k_plus_1 = 0;
-	for(unsigned b = startTimeStep; b < startTimeStep+k_param+1; ++b){
-		i_k_plus_1 <<= 1;
-		i_k_plus_1 |= iVector.at(b);
-	}
-
-	//Load in first i_k_j_l number
-	unsigned i_k_j_l = 0;
-	for(unsigned b = startTimeStep; b < startTimeStep+k_param; ++b){
-		i_k_j_l <<= 1;
-		i_k_j_l |= iVector.at(b);
+		i_k |= iData[b];
 	}
+	unsigned j_l = 0;
 	for(unsigned b = startTimeStep + k_param - l_param; b < startTimeStep+k_param; ++b){
-		i_k_j_l <<= 1;
-		i_k_j_l |= jVector.at(b);
+		j_l <<= 1;
+		j_l |= jData[b];
 	}
 
-	//Load in first i_k_plus_1_j_l number
-	unsigned i_k_plus_1_j_l = 0;
-	for(unsigned b = startTimeStep; b < startTimeStep + k_param + 1; ++b){
-		i_k_plus_1_j_l <<= 1;
-		i_k_plus_1_j_l |= iVector.at(b);
+	//Count the sequences ending at each time step. The k+1 sequences end one step after the others.
+	unsigned lastTimeStep = startTimeStep + timeWindow - 1;
+	for(unsigned n = startTimeStep + k_param - 1; ; ++n){
+		++I_k_counts[i_k];
+		++I_k_J_l_counts[(i_k<<l_param) | j_l];
+		if(n == lastTimeStep)
+			break;
+
+		unsigned i_k_plus_1 = (i_k<<1) | iData[n+1];
+		++I_k_plus_1_counts[i_k_plus_1];
+		unsigned i_k_plus_1_j_l = (i_k_plus_1<<l_param) | j_l;
+		if(I_k_plus_1_J_l_counts[i_k_plus_1_j_l]++ == 0){
+			occupiedKeys[numberOfOccupiedKeys] = i_k_plus_1_j_l;
+			++numberOfOccupiedKeys;
+		}
+
+		//Advance sequences
+		i_k = i_k_plus_1 & i_k_bitmask;
+		j_l = ((j_l<<1) | jData[n+1]) & j_l_bitmask;
 	}
-	for(unsigned b = startTimeStep + k_param - l_param; b < startTimeStep+k_param; ++b){
-		i_k_plus_1_j_l <<= 1;
-		i_k_plus_1_j_l |= jVector.at(b);
+	last_I_k_key = i_k;
+	last_I_k_J_l_key = (i_k<<l_param) | j_l;
+	I_k_total = I_k_J_l_total = timeWindow - k_param + 1;
+	I_k_plus_1_total = I_k_plus_1_J_l_total = timeWindow - k_param;
+
+	/* Work through the distinct sequences and calculate transfer entropy.
+	   Each time step adds p(i_n+1, i_n^k, j_n^l) * log10( p(i_n+1 | i_n^k, j_n^l) / p(i_n+1 | i_n^k) ).
+	   The totals cancel inside the log because I_k_total == I_k_J_l_total and I_k_plus_1_total == I_k_plus_1_J_l_total,
+	   so the log is the log of a ratio of counts. */
+	double sum = 0.0;
+	for(unsigned keyIndx=0; keyIndx<numberOfOccupiedKeys; ++keyIndx){
+		unsigned i_k_plus_1_j_l = occupiedKeys[keyIndx];
+		unsigned i_k_plus_1 = i_k_plus_1_j_l >> l_param;
+		unsigned i_k_j_l = ((i_k_plus_1 >> 1) << l_param) | (i_k_plus_1_j_l & j_l_bitmask);
+		unsigned c_i_k_plus_1_j_l = I_k_plus_1_J_l_counts[i_k_plus_1_j_l];
+		unsigned c_i_k = I_k_counts[i_k_plus_1 >> 1];
+		unsigned c_i_k_j_l = I_k_J_l_counts[i_k_j_l];
+		unsigned c_i_k_plus_1 = I_k_plus_1_counts[i_k_plus_1];
+
+		//Ratio of one gives exactly zero
+		double total = 0.0;
+		if( (uint64_t)c_i_k_plus_1_j_l * c_i_k != (uint64_t)c_i_k_j_l * c_i_k_plus_1 ){
+			total = ((double)c_i_k_plus_1_j_l / I_k_plus_1_J_l_total) *
+					(logTable[c_i_k_plus_1_j_l] + logTable[c_i_k] - logTable[c_i_k_j_l] - logTable[c_i_k_plus_1]);
+		}
+
+		//Sequence contributes once for every time step on which it occurred
+		sum += c_i_k_plus_1_j_l * total;
+
+		if(debug){
+			cout<<"i_k_plus_1_j_l: "<<i_k_plus_1_j_l<<"/"<<getBitString(i_k_plus_1_j_l).toStdString()<<" occurred "<<c_i_k_plus_1_j_l<<" times"<<endl;
+			cout<<"i_k: "<<getBitString(i_k_plus_1 >> 1).toStdString()<<"="<<(double)c_i_k / I_k_total<<endl;
+			cout<<"i_k_plus_1: "<<getBitString(i_k_plus_1).toStdString()<<"="<<(double)c_i_k_plus_1 / I_k_plus_1_total<<endl;
+			cout<<"i_k_j_l: "<<getBitString(i_k_j_l).toStdString()<<"="<<(double)c_i_k_j_l / I_k_J_l_total<<endl;
+			cout<<"i_k_plus_1_j_l: "<<getBitString(i_k_plus_1_j_l).toStdString()<<"="<<(double)c_i_k_plus_1_j_l / I_k_plus_1_J_l_total<<endl;
+			cout<<"TOTAL: "<<total<<endl<<endl;
+		}
 	}
 
+	//Return sum
+	return sum;
+}
 
-	//---------------------------------------------------------
-	//  Work through sequence and calculate transfer entropy
-	//---------------------------------------------------------
-	double p1, p2, p3, sum=0.0;
-	for(unsigned b = (startTimeStep+k_param); b < startTimeStep+timeWindow; ++b){
-
-		#ifdef DEBUG_EQUATION
-			cout<<"n="<<b-1<<endl;
-			cout<<"i_k: "<<i_k<<"/"<<getBitString(i_k).toStdString()<<"="<<I_k_probs[i_k]<<endl;
-			cout<<"i_k_plus_1: "<<i_k_plus_1<<"/"<<getBitString(i_k_plus_1).toStdString()<<"="<<I_k_plus_1_probs[i_k_plus_1]<<endl;
-			cout<<"i_k_j_l: "<<i_k_j_l<<"/"<<getBitString(i_k_j_l).toStdString()<<"="<<I_k_J_l_probs[i_k_j_l]<<endl;
-			cout<<"i_k_plus_1_j_l: "<<i_k_plus_1_j_l<<"/"<<getBitString(i_k_plus_1_j_l).toStdString()<<"="<<I_k_plus_1_J_1_probs[i_k_plus_1_j_l]<<endl;
-		#endif//DEBUG_EQUATION
-
-		//Get joint probability p(i_n+1, i_n^k, j_n^l)
-		p1 = I_k_plus_1_J_1_probs[i_k_plus_1_j_l];
-
-		// Calculate conditional probability p(i_n+1 | i_n^k, j_n^l): p(A|B) = p(A and B)/P(B); p(i_n+1 | i_n^k, j_n^l) = p(i_n+1, i_n^k, j_n^l) / p(i_n^k, j_n^l)
-		p2 = p1/I_k_J_l_probs[i_k_j_l];//Should not =0 because sequence will have occurred at least once
 
-		// Get conditional probability p(i_n+1 | i_n^k) = p( i_n+1, i_n^k) / p(i_n^k)
-		p3 = I_k_plus_1_probs[i_k_plus_1]/I_k_probs[i_k];//Should not =0 because sequence will have occurred at least once
+/*! Returns map of probabilites p(i_n^k) from the last calculation. */
+QHash<unsigned, double> TransferEntropyCalculator::getI_k_probs(){
+	return getProbabilityMap(I_k_counts, 1<<k_param, I_k_total);
+}
 
-		//Update sum using probabilities
-		//sum += p1 * log10 (p2 / p3);
 
-		double total = I_k_plus_1_J_1_probs[i_k_plus_1_j_l] * log10 ( (I_k_plus_1_J_1_probs[i_k_plus_1_j_l] * I_k_probs[i_k]) / (I_k_J_l_probs[i_k_j_l] * I_k_plus_1_probs[i_k_plus_1])  );
-		sum += total;
+/*! Returns map of probabilites p(i_n+1^k) from the last calculation. */
+QHash<unsigned, double> TransferEntropyCalculator::getI_k_plus_1_probs(){
+	return getProbabilityMap(I_k_plus_1_counts, 1<<(k_param + 1), I_k_plus_1_total);
+}
 
-		#ifdef DEBUG_EQUATION
-			cout<<"TOTAL: "<<total<<endl<<endl;
-			//cout<<"p1: "<<p1<<"; p2: "<<p2<<"; p3: "<<p3<<"; result="<<(p1 * log10 (p2 / p3))<<endl<<endl;
-			//cout<< I_k_plus_1_J_1_probs[i_k_plus_1_j_l] * log10 ( (I_k_plus_1_J_1_probs[i_k_plus_1_j_l] * I_k_probs[i_k]) / (I_k_J_l_probs[i_k_j_l] * I_k_plus_1_probs[i_k_plus_1])
-		#endif//DEBUG_EQUATION
 
-		//Avoid final advance in numbers, which could put data vectors out of bounds
-		if(b == startTimeStep+timeWindow-1)
-			break;
+/*! Returns map of probabilites p(i_n^k, j_n^l) from the last calculation. */
+QHash<unsigned, double> TransferEntropyCalculator::getI_k_J_l_probs(){
+	return getProbabilityMap(I_k_J_l_counts, 1<<(k_param + l_param), I_k_J_l_total);
+}
 
-		//Advance numbers
-		i_k <<= 1;
-		i_k |= iVector.at(b);
-		i_k &= i_k_bitmask;
-
-		i_k_plus_1 <<= 1;
-		i_k_plus_1 |= iVector.at(b+1);
-		i_k_plus_1 &= i_k_plus_1_bitmask;
-
-		i_k_j_l <<= 1;
-		i_k_j_l &= i_k_j_l_bitmask;
-		i_k_j_l |= (iVector.at(b)<<l_param);
-		i_k_j_l |= jVector.at(b);
-
-		i_k_plus_1_j_l <<= 1;
-		i_k_plus_1_j_l &= i_k_plus_1_j_l_bitmask;
-		i_k_plus_1_j_l |= (iVector.at(b+1)<<l_param);
-		i_k_plus_1_j_l |= jVector.at(b);
-	}
 
-	//Return sum
-	return sum;
+/*! Returns map of probabilites p(i_n+1, i_n^k, j_n^l) from the last calculation. */
+QHash<unsigned, double> TransferEntropyCalculator::getI_k_plus_1_J_l_probs(){
+	return getProbabilityMap(I_k_plus_1_J_l_counts, 1<<(k_param + 1 + l_param), I_k_plus_1_J_l_total);
 }
 
 
-/*! Loads probabilites, p(i_n^k), into I_k_probs hash map.
-	Works through entire sequence, totals the number of times that each pattern occurs, and converts this into a probability.
+/*! Loads counts of the sequences used for probabilites p(i_n^k) into I_k_counts.
+	Works through entire sequence and totals the number of times that each pattern occurs.
 	Made public to facilitate unit testing. */
 void TransferEntropyCalculator::load_I_k_probabilities(unsigned startTimeStep, vector<unsigned>& iVector){
-	unsigned patternCount = 0;
-	I_k_probs.clear();
+	if(startTimeStep + timeWindow > iVector.size())
+		throw SpikeStreamAnalysisException("Analysis time window range is greater than size of vectors with data");
+
+	countsModified = true;
+	memset(I_k_counts, 0, (1<<k_param) * sizeof(unsigned));
 
 	//Mask to clear bits after shift
 	unsigned clearEndBits = 1<<k_param;
@@ -203,41 +231,33 @@ void TransferEntropyCalculator::load_I_k_probabilities(unsigned startTimeStep, v
 	unsigned tmpNum = 0;
 	for(unsigned b = startTimeStep; b < startTimeStep+k_param; ++b){
 		tmpNum <<= 1;
-		tmpNum |= iVector.at(b);
+		tmpNum |= iVector[b];
 	}
-	I_k_probs[tmpNum] = 1.0;
-	++patternCount;
+	++I_k_counts[tmpNum];
 
 	//Load in subsequent numbers
 	for(unsigned b = startTimeStep+k_param; b < startTimeStep+timeWindow; ++b){
 		tmpNum <<= 1;
-		tmpNum |= iVector.at(b);
+		tmpNum |= iVector[b];
 		tmpNum &= clearEndBits;
-
-		//Add to hash map
-		if(!I_k_probs.contains(tmpNum))
-			I_k_probs[tmpNum] = 1.0;
-		else
-			++I_k_probs[tmpNum];
-		++patternCount;//Could work this out, but safer just to add
+		++I_k_counts[tmpNum];
 	}
+	I_k_total = timeWindow - k_param + 1;
 
-	//Convert count of instances into probabilites
-	for(QHash<unsigned, double>::iterator iter = I_k_probs.begin(); iter != I_k_probs.end(); ++iter)
-		iter.value() /= patternCount;
-
-	#ifdef DEBUG_PROBABILITIES
-		printMap(I_k_probs, "I_k_probs");
-	#endif//DEBUG_PROBABILITIES
+	if(debug)
+		printMap(getI_k_probs(), "I_k_probs");
 }
 
 
-/*! Loads probabilites, p(i_n+1^k), into I_k_plus_1_probs hash map.
-	Works through entire sequence, totals the number of times that each pattern occurs, and converts this into a probability.
+/*! Loads counts of the sequences used for probabilites p(i_n+1^k) into I_k_plus_1_counts.
+	Works through entire sequence and totals the number of times that each pattern occurs.
 	Made public to facilitate unit testing. */
 void TransferEntropyCalculator::load_I_k_plus_1_probabilities(unsigned startTimeStep, vector<unsigned>& iVector){
-	unsigned patternCount = 0;
-	I_k_plus_1_probs.clear();
+	if(startTimeStep + timeWindow > iVector.size())
+		throw SpikeStreamAnalysisException("Analysis time window range is greater than size of vectors with data");
+
+	countsModified = true;
+	memset(I_k_plus_1_counts, 0, (1<<(k_param + 1)) * sizeof(unsigned));
 
 	//Mask to clear bits after shift
 	unsigned clearEndBits = 1<<(k_param+1);
@@ -247,37 +267,26 @@ void TransferEntropyCalculator::load_I_k_plus_1_probabilities(unsigned startTime
 	unsigned tmpNum = 0;
 	for(unsigned b = startTimeStep; b < startTimeStep+k_param+1; ++b){
 		tmpNum <<= 1;
-		tmpNum |= iVector.at(b);
+		tmpNum |= iVector[b];
 	}
-	I_k_plus_1_probs[tmpNum] = 1.0;
-	++patternCount;
+	++I_k_plus_1_counts[tmpNum];
 
 	//Load in subsequent numbers
 	for(unsigned b = startTimeStep+k_param+1; b < startTimeStep+timeWindow; ++b){
 		tmpNum <<= 1;
-		tmpNum |= iVector.at(b);
+		tmpNum |= iVector[b];
 		tmpNum &= clearEndBits;
-
-		//Add to hash map
-		if(!I_k_plus_1_probs.contains(tmpNum))
-			I_k_plus_1_probs[tmpNum] = 1.0;
-		else
-			++I_k_plus_1_probs[tmpNum];
-		++patternCount;//Could work this out, but safer just to add
+		++I_k_plus_1_counts[tmpNum];
 	}
+	I_k_plus_1_total = timeWindow - k_param;
 
-	//Convert count of instances into probabilites
-	for(QHash<unsigned, double>::iterator iter = I_k_plus_1_probs.begin(); iter != I_k_plus_1_probs.end(); ++iter)
-		iter.value() /= patternCount;
-
-	#ifdef DEBUG_PROBABILITIES
-		printMap(I_k_plus_1_probs, "I_k_plus_1_probs");
-	#endif//DEBUG_PROBABILITIES
+	if(debug)
+		printMap(getI_k_plus_1_probs(), "I_k_plus_1_probs");
 }
 
 
-/*! Loads probabilities p(i_n^k, j_n^l) into I_k_J_l_probs hash map.
-	Works through the entire sequence, totals the number of times that each pattern occurs and converts this into a probability.
+/*! Loads counts of the sequences used for probabilities p(i_n^k, j_n^l) into I_k_J_l_counts.
+	Works through the entire sequence and totals the number of times that each pattern occurs.
 	Made publicly accessible to facilitate unit testing. */
 void TransferEntropyCalculator::load_I_k_J_l_probabilities(unsigned startTimeStep, vector<unsigned>& iVector, vector<unsigned>& jVector){
 	if(startTimeStep + k_param >= iVector.size() || startTimeStep + l_param >= jVector.size())
@@ -285,8 +294,8 @@ void TransferEntropyCalculator::load_I_k_J_l_probabilities(unsigned startTimeSte
 	if(startTimeStep+timeWindow > iVector.size() || startTimeStep+timeWindow > jVector.size())
 		throw SpikeStreamAnalysisException("Analysis time window range is greater than size of vectors with data");
 
-	unsigned patternCount = 0;
-	I_k_J_l_probs.clear();
+	countsModified = true;
+	memset(I_k_J_l_counts, 0, (1<<(k_param + l_param)) * sizeof(unsigned));
 
 	//Mask to clear bits after shift. Needs to clear end bits as well as the least significant bit in i
 	unsigned clearBits = 1<<(k_param+l_param);
@@ -297,16 +306,15 @@ void TransferEntropyCalculator::load_I_k_J_l_probabilities(unsigned startTimeSte
 	unsigned tmpNum = 0;
 	for(unsigned b = startTimeStep; b < startTimeStep+k_param; ++b){
 		tmpNum <<= 1;
-		tmpNum |= iVector.at(b);
+		tmpNum |= iVector[b];
 	}
 
 	//Add first number from j, need to offset this if l_param < k_param (cannot be >=)
 	for(unsigned b = startTimeStep + k_param - l_param; b < startTimeStep+k_param; ++b){
 		tmpNum <<= 1;
-		tmpNum |= jVector.at(b);
+		tmpNum |= jVector[b];
 	}
-	I_k_J_l_probs[tmpNum] = 1.0;
-	++patternCount;
+	++I_k_J_l_counts[tmpNum];
 
 	//Load in subsequent numbers. Both iVector and jVector are stepped through adding a 1 or 0 to the pattern and shaving off the end
 	for(unsigned b = startTimeStep+k_param; b < startTimeStep+timeWindow; ++b){
@@ -314,31 +322,22 @@ void TransferEntropyCalculator::load_I_k_J_l_probabilities(unsigned startTimeSte
 		tmpNum &= clearBits;
 
 		//Add in i value
-		tmpNum |= (iVector.at(b)<<l_param);
+		tmpNum |= (iVector[b]<<l_param);
 
 		//Add in j value
-		tmpNum |= jVector.at(b);
+		tmpNum |= jVector[b];
 
-		//Add to hash map
-		if(!I_k_J_l_probs.contains(tmpNum))
-			I_k_J_l_probs[tmpNum] = 1.0;
-		else
-			++I_k_J_l_probs[tmpNum];
-		++patternCount;//Could work this out, but add for the moment
+		++I_k_J_l_counts[tmpNum];
 	}
+	I_k_J_l_total = timeWindow - k_param + 1;
 
-	//Convert count of instances into probabilites
-	for(QHash<unsigned, double>::iterator iter = I_k_J_l_probs.begin(); iter != I_k_J_l_probs.end(); ++iter)
-		iter.value() /= patternCount;
-
-	#ifdef DEBUG_PROBABILITIES
-		printMap(I_k_J_l_probs, "I_k_J_l_probs");
-	#endif//DEBUG_PROBABILITIES
+	if(debug)
+		printMap(getI_k_J_l_probs(), "I_k_J_l_probs");
 }
 
 
-/*! Loads probabilities p(i_n+1, i_n^k, j_n^l) into I_k_plus_1_J_1_probs hash map.
-	Works through the entire sequence, totals the number of times that each pattern occurs and converts this into a probability.
+/*! Loads counts of the sequences used for probabilities p(i_n+1, i_n^k, j_n^l) into I_k_plus_1_J_l_counts.
+	Works through the entire sequence and totals the number of times that each pattern occurs.
 	Made publicly accessible to facilitate unit testing. */
 void TransferEntropyCalculator::load_I_k_plus_1_J_l_probabilities(unsigned startTimeStep, vector<unsigned>& iVector, vector<unsigned>& jVector){
 	if(startTimeStep + k_param + 1 >= iVector.size() || startTimeStep + l_param >= jVector.size())
@@ -346,8 +345,8 @@ void TransferEntropyCalculator::load_I_k_plus_1_J_l_probabilities(unsigned start
 	if(startTimeStep+timeWindow > iVector.size() || startTimeStep+timeWindow > jVector.size())
 		throw SpikeStreamAnalysisException("Analysis time window range is greater than size of vectors with data");
 
-	unsigned patternCount = 0;
-	I_k_plus_1_J_1_probs.clear();
+	countsModified = true;
+	memset(I_k_plus_1_J_l_counts, 0, (1<<(k_param + 1 + l_param)) * sizeof(unsigned));
 
 	//Mask to clear bits after shift. Needs to clear end bits as well as the least significant bit in i
 	unsigned clearBits = 1<<(k_param + 1 + l_param);
@@ -358,16 +357,15 @@ void TransferEntropyCalculator::load_I_k_plus_1_J_l_probabilities(unsigned start
 	unsigned tmpNum = 0;
 	for(unsigned b = startTimeStep; b < startTimeStep + k_param + 1; ++b){
 		tmpNum <<= 1;
-		tmpNum |= iVector.at(b);
+		tmpNum |= iVector[b];
 	}
 
 	//Add first number from j. Offset it if k_param > l_param
 	for(unsigned b = startTimeStep + k_param - l_param; b < startTimeStep+k_param; ++b){
 		tmpNum <<= 1;
-		tmpNum |= jVector.at(b);
+		tmpNum |= jVector[b];
 	}
-	I_k_plus_1_J_1_probs[tmpNum] = 1.0;
-	++patternCount;
+	++I_k_plus_1_J_l_counts[tmpNum];
 
 	//Load in subsequent numbers.
 	for(unsigned b = startTimeStep + k_param + 1; b < startTimeStep+timeWindow; ++b){
@@ -375,26 +373,69 @@ void TransferEntropyCalculator::load_I_k_plus_1_J_l_probabilities(unsigned start
 		tmpNum &= clearBits;
 
 		//Add in next i value
-		tmpNum |= (iVector.at(b)<<l_param);
+		tmpNum |= (iVector[b]<<l_param);
 
 		//Add in j value - this is one step back from the current i index
-		tmpNum |= jVector.at(b-1);//the '-1' compensates for the fact that we are reading in the next i+1
+		tmpNum |= jVector[b-1];//the '-1' compensates for the fact that we are reading in the next i+1
 
-		//Add to hash map
-		if(!I_k_plus_1_J_1_probs.contains(tmpNum))
-			I_k_plus_1_J_1_probs[tmpNum] = 1.0;
-		else
-			++I_k_plus_1_J_1_probs[tmpNum];
-		++patternCount;//Could work this out, but add for the moment
+		++I_k_plus_1_J_l_counts[tmpNum];
 	}
+	I_k_plus_1_J_l_total = timeWindow - k_param;
+
+	if(debug)
+		printMap(getI_k_plus_1_J_l_probs(), "I_k_plus_1_J_1_probs");
+}
+
+
+/*! Moves the sliding window forward by one time step and returns the transfer entropy within the new window.
+	The sequences ending at the new time step are added and the sequences ending at the
+	first time step of the old window are removed, so only a handful of histogram entries change. */
+double TransferEntropyCalculator::slideWindow(){
+	if(slidingITrain == NULL)
+		throw SpikeStreamAnalysisException("Sliding window has not been started.");
+	if(slidingStartTimeStep + timeWindow >= slidingTrainLength)
+		throw SpikeStreamAnalysisException("Sliding window cannot move beyond the end of the spike trains.");
+
+	addSlidingTimeStep(slidingStartTimeStep + timeWindow, false);
+	removeSlidingTimeStep(slidingStartTimeStep + k_param - 1);
+	++slidingStartTimeStep;
+
+	return getSlidingTransferEntropy();
+}
+
 
-	//Convert count of instances into probabilites
-	for(QHash<unsigned, double>::iterator iter = I_k_plus_1_J_1_probs.begin(); iter != I_k_plus_1_J_1_probs.end(); ++iter)
-		iter.value() /= patternCount;
+/*! Fills the histograms with the time window starting at startTimeStep and returns the transfer entropy within it.
+	iTrain and jTrain are packed spike trains in the format used by SpikeTrainData, each with trainLength time steps.
+	The window can then be moved along the spike trains with slideWindow().
+	The spike trains are not copied and must remain valid whilst the window is sliding. */
+double TransferEntropyCalculator::startSlidingWindow(unsigned startTimeStep, const uint64_t* iTrain, const uint64_t* jTrain, unsigned trainLength){
+	if(startTimeStep + timeWindow > trainLength)
+		throw SpikeStreamAnalysisException("Start time step + time window exceeds available data");
 
-	#ifdef DEBUG_PROBABILITIES
-		printMap(I_k_plus_1_J_1_probs, "I_k_plus_1_J_1_probs");
-	#endif//DEBUG_PROBABILITIES
+	//Store information about the spike trains
+	slidingITrain = iTrain;
+	slidingJTrain = jTrain;
+	slidingTrainLength = trainLength;
+	slidingStartTimeStep = startTimeStep;
+
+	//Start with empty histograms
+	countsModified = true;
+	clearCounts();
+	memset(I_k_squares, 0, (1<<k_param) * sizeof(uint64_t));
+	memset(I_k_plus_1_squares, 0, (1<<(k_param + 1)) * sizeof(uint64_t));
+	memset(I_k_J_l_squares, 0, (1<<(k_param + l_param)) * sizeof(uint64_t));
+	I_k_plus_1_J_l_sum = I_k_sum = I_k_plus_1_sum = I_k_J_l_sum = 0.0;
+
+	//Add the sequences ending at each time step in the window
+	for(unsigned n = startTimeStep + k_param - 1; n < startTimeStep + timeWindow; ++n)
+		addSlidingTimeStep(n, n == startTimeStep + k_param - 1);
+	I_k_total = I_k_J_l_total = timeWindow - k_param + 1;
+	I_k_plus_1_total = I_k_plus_1_J_l_total = timeWindow - k_param;
+
+	//Entries are added and removed as the window slides, so occupiedKeys cannot be used to clear the histograms
+	countsModified = true;
+
+	return getSlidingTransferEntropy();
 }
 
 
@@ -425,8 +466,130 @@ QString TransferEntropyCalculator::getBitString(unsigned num){
 /*------                PRIVATE METHODS               ------*/
 /*----------------------------------------------------------*/
 
+/*! Adds the sequences ending at the specified time step to the end of the sliding window.
+	The previous final time step is followed by this one, so its k+1 sequences are added as well. */
+void TransferEntropyCalculator::addSlidingTimeStep(unsigned timeStep, bool firstTimeStep){
+	unsigned j_l_bitmask = (1<<l_param) - 1;
+	unsigned old_i_k = last_I_k_key;
+	unsigned old_j_l = last_I_k_J_l_key & j_l_bitmask;
+
+	//Add the sequences ending at this time step
+	unsigned i_k = getSequence(slidingITrain, timeStep, k_param);
+	unsigned i_k_j_l = (i_k<<l_param) | getSequence(slidingJTrain, timeStep, l_param);
+	changeSlidingCount(I_k_counts, I_k_squares, i_k, 1, I_k_sum);
+	changeSlidingCount(I_k_J_l_counts, I_k_J_l_squares, i_k_j_l, 1, I_k_J_l_sum);
+	last_I_k_key = i_k;
+	last_I_k_J_l_key = i_k_j_l;
+	if(firstTimeStep)
+		return;
+
+	//The old final sequence is now followed by the spike at this time step
+	unsigned i_k_plus_1 = (old_i_k<<1) | SpikeTrainData::getSpike(slidingITrain, timeStep);
+	changeSlidingCount(I_k_plus_1_counts, I_k_plus_1_squares, i_k_plus_1, 1, I_k_plus_1_sum);
+	changeSlidingJointCount((i_k_plus_1<<l_param) | old_j_l, 1);
+}
+
+
+/*! Changes the count of a sequence in I_k_counts, I_k_plus_1_counts or I_k_J_l_counts and updates the sum
+	that depends on the log of the count. */
+void TransferEntropyCalculator::changeSlidingCount(unsigned* counts, const uint64_t* squares, unsigned key, int change, double& sum){
+	unsigned oldCount = counts[key];
+	counts[key] += change;
+	sum += squares[key] * (logTable[counts[key]] - logTable[oldCount]);
+}
+
+
+/*! Changes the count of a sequence in I_k_plus_1_J_l_counts.
+	The sequence's term in I_k_plus_1_J_l_sum is updated along with the sums of squares of the shorter sequences that it contains. */
+void TransferEntropyCalculator::changeSlidingJointCount(unsigned i_k_plus_1_j_l, int change){
+	uint64_t oldCount = I_k_plus_1_J_l_counts[i_k_plus_1_j_l];
+	uint64_t newCount = oldCount + change;
+	I_k_plus_1_J_l_counts[i_k_plus_1_j_l] = newCount;
+	I_k_plus_1_J_l_sum += newCount * newCount * logTable[newCount] - oldCount * oldCount * logTable[oldCount];
+
+	//Update the sums of squares. Unsigned arithmetic gives the right result when the square decreases
+	uint64_t squareChange = newCount * newCount - oldCount * oldCount;
+	double squareChangeDbl = (double)(newCount * newCount) - (double)(oldCount * oldCount);
+	unsigned i_k_plus_1 = i_k_plus_1_j_l >> l_param;
+	unsigned i_k = i_k_plus_1 >> 1;
+	unsigned i_k_j_l = (i_k<<l_param) | (i_k_plus_1_j_l & ((1<<l_param) - 1));
+
+	I_k_squares[i_k] += squareChange;
+	I_k_sum += squareChangeDbl * logTable[I_k_counts[i_k]];
+
+	I_k_plus_1_squares[i_k_plus_1] += squareChange;
+	I_k_plus_1_sum += squareChangeDbl * logTable[I_k_plus_1_counts[i_k_plus_1]];
+
+	I_k_J_l_squares[i_k_j_l] += squareChange;
+	I_k_J_l_sum += squareChangeDbl * logTable[I_k_J_l_counts[i_k_j_l]];
+}
+
+
+/*! Sets all of the counts in the histograms to zero.
+	After a transfer entropy calculation only the entries that were used are cleared. */
+void TransferEntropyCalculator::clearCounts(){
+	if(countsModified){
+		memset(I_k_counts, 0, (1<<k_param) * sizeof(unsigned));
+		memset(I_k_plus_1_counts, 0, (1<<(k_param + 1)) * sizeof(unsigned));
+		memset(I_k_J_l_counts, 0, (1<<(k_param + l_param)) * sizeof(unsigned));
+		memset(I_k_plus_1_J_l_counts, 0, (1<<(k_param + 1 + l_param)) * sizeof(unsigned));
+		countsModified = false;
+	}
+	else{
+		unsigned j_l_bitmask = (1<<l_param) - 1;
+		for(unsigned keyIndx=0; keyIndx<numberOfOccupiedKeys; ++keyIndx){
+			unsigned i_k_plus_1_j_l = occupiedKeys[keyIndx];
+			unsigned i_k_plus_1 = i_k_plus_1_j_l >> l_param;
+			I_k_plus_1_J_l_counts[i_k_plus_1_j_l] = 0;
+			I_k_plus_1_counts[i_k_plus_1] = 0;
+			I_k_counts[i_k_plus_1 >> 1] = 0;
+			I_k_J_l_counts[((i_k_plus_1 >> 1) << l_param) | (i_k_plus_1_j_l & j_l_bitmask)] = 0;
+		}
+		I_k_counts[last_I_k_key] = 0;
+		I_k_J_l_counts[last_I_k_J_l_key] = 0;
+	}
+	numberOfOccupiedKeys = 0;
+	last_I_k_key = 0;
+	last_I_k_J_l_key = 0;
+}
+
+
+/*! Converts the non zero entries in a histogram into a map of probabilities */
+QHash<unsigned, double> TransferEntropyCalculator::getProbabilityMap(unsigned* counts, unsigned numberOfEntries, unsigned total){
+	QHash<unsigned, double> probMap;
+	for(unsigned i=0; i<numberOfEntries; ++i){
+		if(counts[i] > 0)
+			probMap[i] = (double)counts[i] / total;
+	}
+	return probMap;
+}
+
+
+/*! Returns the sequence of the specified length that ends at lastTimeStep in a packed spike train.
+	The earliest time step is the most significant bit. */
+unsigned TransferEntropyCalculator::getSequence(const uint64_t* train, unsigned lastTimeStep, unsigned length){
+	unsigned sequence = 0;
+	for(unsigned t = lastTimeStep + 1 - length; t <= lastTimeStep; ++t){
+		sequence <<= 1;
+		sequence |= SpikeTrainData::getSpike(train, t);
+	}
+	return sequence;
+}
+
+
+/*! Returns the transfer entropy of the sliding window from the running sums.
+	getTransferEntropy() adds p(i_n+1, i_n^k, j_n^l) * log(...) for every time step, so each distinct sequence contributes
+	c(i_n+1, i_n^k, j_n^l)^2 / N * log( c(i_n+1, i_n^k, j_n^l) * c(i_n^k) / (c(i_n^k, j_n^l) * c(i_n+1, i_n^k)) ), where N is the number of k+1 sequences.
+	Grouping the logs by the shorter sequences gives the four running sums. */
+double TransferEntropyCalculator::getSlidingTransferEntropy(){
+	if(timeWindow == k_param)
+		return 0.0;
+	return (I_k_plus_1_J_l_sum + I_k_sum - I_k_J_l_sum - I_k_plus_1_sum) / (timeWindow - k_param);
+}
+
+
 /*! Prints out a map for debugging purposes */
-void TransferEntropyCalculator::printMap(QHash<unsigned, double> &map, QString name){
+void TransferEntropyCalculator::printMap(QHash<unsigned, double> map, QString name){
 	cout<<"-------------------"<<name.toStdString()<<"-------------------------"<<endl;
 	for(QHash<unsigned, double>::iterator iter = map.begin(); iter != map.end(); ++iter){
 		cout<<"Key: "<<iter.key()<<"/"<<getBitString(iter.key()).toStdString()<<"; value: "<<iter.value()<<endl;
@@ -434,3 +597,16 @@ void TransferEntropyCalculator::printMap(QHash<unsigned, double> &map, QString n
 	cout<<endl;
 }
 
+
+/*! Removes the sequences ending at the specified time step from the start of the sliding window.
+	The time step must not be the final one in the window, so its k+1 sequences are removed as well. */
+void TransferEntropyCalculator::removeSlidingTimeStep(unsigned timeStep){
+	unsigned i_k = getSequence(slidingITrain, timeStep, k_param);
+	unsigned j_l = getSequence(slidingJTrain, timeStep, l_param);
+	unsigned i_k_plus_1 = (i_k<<1) | SpikeTrainData::getSpike(slidingITrain, timeStep + 1);
+
+	changeSlidingJointCount((i_k_plus_1<<l_param) | j_l, -1);
+	changeSlidingCount(I_k_counts, I_k_squares, i_k, -1, I_k_sum);
+	changeSlidingCount(I_k_J_l_counts, I_k_J_l_squares, (i_k<<l_param) | j_l, -1, I_k_J_l_sum);
+	changeSlidingCount(I_k_plus_1_counts, I_k_plus_1_squares, i_k_plus_1, -1, I_k_plus_1_sum);
+}
@@ -8,25 +8,34 @@
 #include <QHash>
 
 //Other includes
+#include <stdint.h>
 #include <vector>
 using namespace std;
 
 namespace spikestream {
 
+	/*! Calculates the transfer entropy from one sequence of 1s and 0s (J) to another (I).
+		Sequences are counted in dense histograms indexed by the pattern of bits, which are allocated
+		once in the constructor and reused for every calculation.
+		The calculator can also slide a time window along a pair of packed spike trains, updating
+		the histograms and the terms of the sum as each time step enters and leaves the window. */
 	class TransferEntropyCalculator {
 		public:
 			TransferEntropyCalculator(unsigned k_param, unsigned l_param, unsigned timeWindow);
 			~TransferEntropyCalculator();
 			QString getBitString(unsigned num);
-			QHash<unsigned, double>& getI_k_probs() { return I_k_probs; }
-			QHash<unsigned, double>& getI_k_plus_1_probs() { return I_k_plus_1_probs; }
-			QHash<unsigned, double>& getI_k_J_l_probs() { return I_k_J_l_probs; }
-			QHash<unsigned, double>& getI_k_plus_1_J_l_probs() { return I_k_plus_1_J_1_probs; }
+			QHash<unsigned, double> getI_k_probs();
+			QHash<unsigned, double> getI_k_plus_1_probs();
+			QHash<unsigned, double> getI_k_J_l_probs();
+			QHash<unsigned, double> getI_k_plus_1_J_l_probs();
 			double getTransferEntropy(unsigned startTimeStep, vector<unsigned>& iVector, vector<unsigned>& jVector);
 			void load_I_k_probabilities(unsigned startTimeStep, vector<unsigned>& iVector);
 			void load_I_k_plus_1_probabilities(unsigned startTimeStep, vector<unsigned>& iVector);
 			void load_I_k_J_l_probabilities(unsigned startTimeStep, vector<unsigned>& iVector, vector<unsigned>& jVector);
 			void load_I_k_plus_1_J_l_probabilities(unsigned startTimeStep, vector<unsigned>& iVector, vector<unsigned>& jSVector);
+			void setDebug(bool debug) { this->debug = debug; }
+			double slideWindow();
+			double startSlidingWindow(unsigned startTimeStep, const uint64_t* iTrain, const uint64_t* jTrain, unsigned trainLength);
 
 		private:
 			//=============================  VARIABLES  ============================
@@ -39,21 +48,96 @@ namespace spikestream {
 			/*! time window of analysis */
 			unsigned timeWindow;
 
-			/*! Map of probabilities of sequences of length k in I */
-			QHash<unsigned, double> I_k_probs;
+			/*! Number of occurrences of each sequence of length k in I */
+			unsigned* I_k_counts;
 
-			/*! Map of probabilities of sequences of length k+1 in I */
-			QHash<unsigned, double> I_k_plus_1_probs;
+			/*! Number of occurrences of each sequence of length k+1 in I */
+			unsigned* I_k_plus_1_counts;
 
-			/*! Map of combined probabilities of sequences of length k in I and sequences of length l in J */
-			QHash<unsigned, double> I_k_J_l_probs;
+			/*! Number of occurrences of each sequence of length k in I combined with a sequence of length l in J */
+			unsigned* I_k_J_l_counts;
 
-			/*! Map of combined probabilities of sequences of length k+1 in I and sequences of length l in J */
-			QHash<unsigned, double> I_k_plus_1_J_1_probs;
+			/*! Number of occurrences of each sequence of length k+1 in I combined with a sequence of length l in J */
+			unsigned* I_k_plus_1_J_l_counts;
+
+			/*! Total number of sequences counted in I_k_counts */
+			unsigned I_k_total;
+
+			/*! Total number of sequences counted in I_k_plus_1_counts */
+			unsigned I_k_plus_1_total;
+
+			/*! Total number of sequences counted in I_k_J_l_counts */
+			unsigned I_k_J_l_total;
+
+			/*! Total number of sequences counted in I_k_plus_1_J_l_counts */
+			unsigned I_k_plus_1_J_l_total;
+
+			/*! Sequences in I_k_plus_1_J_l_counts with a non zero count. Every other non zero entry in the histograms
+				can be derived from these, apart from the final I_k and I_k_J_l sequences. */
+			unsigned* occupiedKeys;
+
+			/*! Number of entries in occupiedKeys */
+			unsigned numberOfOccupiedKeys;
+
+			/*! Final entry in I_k_counts when the histograms were last filled by getTransferEntropy */
+			unsigned last_I_k_key;
+
+			/*! Final entry in I_k_J_l_counts when the histograms were last filled by getTransferEntropy */
+			unsigned last_I_k_J_l_key;
+
+			/*! Set when the histograms have been filled by one of the load methods, so occupiedKeys cannot be used to clear them */
+			bool countsModified;
+
+			/*! Table holding log10 of each count that can occur within the time window */
+			double* logTable;
+
+			/*! Prints out the terms of the transfer entropy sum when set to true */
+			bool debug;
+
+			/*! Spike train of I used by the sliding window */
+			const uint64_t* slidingITrain;
+
+			/*! Spike train of J used by the sliding window */
+			const uint64_t* slidingJTrain;
+
+			/*! Number of time steps in the spike trains used by the sliding window */
+			unsigned slidingTrainLength;
+
+			/*! First time step of the sliding window */
+			unsigned slidingStartTimeStep;
+
+			/*! For each entry in I_k_counts, the sum of the squares of the entries in I_k_plus_1_J_l_counts that contain it */
+			uint64_t* I_k_squares;
+
+			/*! For each entry in I_k_plus_1_counts, the sum of the squares of the entries in I_k_plus_1_J_l_counts that contain it */
+			uint64_t* I_k_plus_1_squares;
+
+			/*! For each entry in I_k_J_l_counts, the sum of the squares of the entries in I_k_plus_1_J_l_counts that contain it */
+			uint64_t* I_k_J_l_squares;
+
+			/*! Sum of count^2 * log(count) over the entries in I_k_plus_1_J_l_counts */
+			double I_k_plus_1_J_l_sum;
+
+			/*! Sum of squares * log(count) over the entries in I_k_counts */
+			double I_k_sum;
+
+			/*! Sum of squares * log(count) over the entries in I_k_plus_1_counts */
+			double I_k_plus_1_sum;
+
+			/*! Sum of squares * log(count) over the entries in I_k_J_l_counts */
+			double I_k_J_l_sum;
 
 
 			//=============================  METHODS  ==============================
-			void printMap(QHash<unsigned, double>& map, QString name);
+			void addSlidingTimeStep(unsigned timeStep, bool firstTimeStep);
+			void changeSlidingCount(unsigned* counts, const uint64_t* squares, unsigned key, int change, double& sum);
+			void changeSlidingJointCount(unsigned i_k_plus_1_j_l, int change);
+			void clearCounts();
+			QHash<unsigned, double> getProbabilityMap(unsigned* counts, unsigned numberOfEntries, unsigned total);
+			unsigned getSequence(const uint64_t* train, unsigned lastTimeStep, unsigned length);
+			double getSlidingTransferEntropy();
+			void printMap(QHash<unsigned, double> map, QString name);
+			void removeSlidingTimeStep(unsigned timeStep);
 
 	};
 
@@ -0,0 +1,69 @@
+//SpikeStream includes
+#include "SpikeStreamException.h"
+#include "TransferEntropyCalculator.h"
+#include "TransferEntropyPairThread.h"
+using namespace spikestream;
+
+//Qt includes
+#include <QMutexLocker>
+
+
+/*! Constructor */
+TransferEntropyPairThread::TransferEntropyPairThread(const SpikeTrainData& spikeTrainData, const QList< QPair<unsigned, unsigned> >& pairList, unsigned firstPairIndex, unsigned pairIndexStep, unsigned k_param, unsigned l_param, unsigned timeWindow, bool* stop) : spikeTrainData(spikeTrainData), pairList(pairList) {
+	this->firstPairIndex = firstPairIndex;
+	this->pairIndexStep = pairIndexStep;
+	this->k_param = k_param;
+	this->l_param = l_param;
+	this->timeWindow = timeWindow;
+	this->stop = stop;
+	error = false;
+}
+
+
+/*! Destructor */
+TransferEntropyPairThread::~TransferEntropyPairThread(){
+}
+
+
+/*-------------------------------------------------------------*/
+/*-------                 PUBLIC METHODS                 ------*/
+/*-------------------------------------------------------------*/
+
+/*! Run method inherited from QThread.
+	Slides a time window along the spike trains of each pair, storing the transfer entropy
+	from the first neuron to the second at every position of the window. */
+void TransferEntropyPairThread::run(){
+	error = false;
+	errorMessage = "";
+
+	try{
+		TransferEntropyCalculator calculator(k_param, l_param, timeWindow);
+		unsigned numberOfTimeSteps = spikeTrainData.getNumberOfTimeSteps();
+		unsigned numberOfWindows = numberOfTimeSteps - timeWindow + 1;
+		for(unsigned pairIndex = firstPairIndex; pairIndex < (unsigned)pairList.size() && !*stop; pairIndex += pairIndexStep){
+			const uint64_t* jTrain = spikeTrainData.getSpikeTrain(pairList.at(pairIndex).first);
+			const uint64_t* iTrain = spikeTrainData.getSpikeTrain(pairList.at(pairIndex).second);
+
+			QList<double> transferEntropyList;
+			transferEntropyList.append(calculator.startSlidingWindow(0, iTrain, jTrain, numberOfTimeSteps));
+			for(unsigned window = 1; window < numberOfWindows; ++window)
+				transferEntropyList.append(calculator.slideWindow());
+
+			QMutexLocker locker(&resultsMutex);
+			resultsMap[pairIndex] = transferEntropyList;
+		}
+	}
+	catch(SpikeStreamException& ex){
+		error = true;
+		errorMessage = ex.getMessage();
+	}
+}
+
+
+/*! Moves the results that have been calculated since the last call into the supplied map */
+void TransferEntropyPairThread::takeResults(QHash<unsigned, QList<double> >& resultsMap){
+	QMutexLocker locker(&resultsMutex);
+	for(QHash<unsigned, QList<double> >::iterator iter = this->resultsMap.begin(); iter != this->resultsMap.end(); ++iter)
+		resultsMap[iter.key()] = iter.value();
+	this->resultsMap.clear();
+}
@@ -0,0 +1,72 @@
+#ifndef TRANSFERENTROPYPAIRTHREAD_H
+#define TRANSFERENTROPYPAIRTHREAD_H
+
+//SpikeStream includes
+#include "SpikeTrainData.h"
+
+//Qt includes
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QThread>
+
+namespace spikestream {
+
+	/*! Calculates the transfer entropy between pairs of neurons whose spike trains are held in a shared SpikeTrainData.
+		Several of these threads work through the same list of pairs, each taking every Nth pair, and the results
+		are collected by the thread that launched them with takeResults(). */
+	class TransferEntropyPairThread : public QThread {
+		Q_OBJECT
+
+		public:
+			TransferEntropyPairThread(const SpikeTrainData& spikeTrainData, const QList< QPair<unsigned, unsigned> >& pairList, unsigned firstPairIndex, unsigned pairIndexStep, unsigned k_param, unsigned l_param, unsigned timeWindow, bool* stop);
+			~TransferEntropyPairThread();
+			QString getErrorMessage() { return errorMessage; }
+			bool isError() { return error; }
+			void run();
+			void takeResults(QHash<unsigned, QList<double> >& resultsMap);
+
+		private:
+			//=========================  VARIABLES  ===========================
+			/*! Spike trains of the neurons being analyzed */
+			const SpikeTrainData& spikeTrainData;
+
+			/*! Indexes in spikeTrainData of the from (J) and to (I) neurons of each pair */
+			const QList< QPair<unsigned, unsigned> >& pairList;
+
+			/*! Index of the first pair analyzed by this thread */
+			unsigned firstPairIndex;
+
+			/*! Number of pairs between each pair analyzed by this thread */
+			unsigned pairIndexStep;
+
+			/*! k parameter of analysis */
+			unsigned k_param;
+
+			/*! l parameter of analysis */
+			unsigned l_param;
+
+			/*! Time window of analysis */
+			unsigned timeWindow;
+
+			/*! Stops the thread when set to true. Shared with the thread that launched this one */
+			bool* stop;
+
+			/*! Transfer entropy of each time window for pairs that have not yet been collected, indexed by pair */
+			QHash<unsigned, QList<double> > resultsMap;
+
+			/*! Controls access to resultsMap */
+			QMutex resultsMutex;
+
+			/*! Records if an error has occurred */
+			bool error;
+
+			/*! Error message associated with an error */
+			QString errorMessage;
+
+	};
+
+}
+
+#endif//TRANSFERENTROPYPAIRTHREAD_H
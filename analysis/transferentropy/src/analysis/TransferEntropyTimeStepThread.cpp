@@ -1,7 +1,8 @@
 //SpikeStream includes
 #include "Globals.h"
+#include "PerformanceTimer.h"
 #include "TransferEntropyTimeStepThread.h"
-#include "SpikeStreamException.h"
+#include "SpikeStreamAnalysisException.h"
 using namespace spikestream;
 
 //Qt includes
@@ -9,6 +10,7 @@ using namespace spikestream;
 
 /*! Constructor */
 TransferEntropyTimeStepThread::TransferEntropyTimeStepThread(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo) : AbstractAnalysisTimeStepThread(netDBInfo, archDBInfo, anaDBInfo) {
+	transferEntropyDao = NULL;
 }
 
 
@@ -18,16 +20,175 @@ TransferEntropyTimeStepThread::~TransferEntropyTimeStepThread(){
 
 
 /*-------------------------------------------------------------*/
-/*-------                 PUBLIC METHODS                 ------*/
+/*-------               PROTECTED METHODS                ------*/
 /*-------------------------------------------------------------*/
 
-/*! Run method inherited from QThread */
-void TransferEntropyTimeStepThread::run(){
-	stop = false;
+/*! Runs the transfer entropy analysis on the current time step on its own */
+void TransferEntropyTimeStepThread::analyzeTimeStep(){
+	analyzeTimeSteps(timeStep, timeStep);
+}
+
+
+/*! Runs the transfer entropy analysis over the range of time steps, sliding the time window along the spike trains.
+	Progress and results are reported against the first time step. */
+void TransferEntropyTimeStepThread::analyzeTimeSteps(int firstTimeStepInt, int lastTimeStepInt){
+	//Start timer
+	PerformanceTimer timer;
+
+	timeStep = firstTimeStepInt;
+	QList<TransferEntropyPairThread*> pairThreadList;
+	try{
+		//Get the parameters of the analysis
+		if(firstTimeStepInt < 0 || lastTimeStepInt < firstTimeStepInt)
+			throw SpikeStreamAnalysisException("Invalid range of time steps: " + QString::number(firstTimeStepInt) + " to " + QString::number(lastTimeStepInt));
+		unsigned k_param = (unsigned)analysisInfo.getParameter("k");
+		unsigned l_param = (unsigned)analysisInfo.getParameter("l");
+		unsigned timeWindow = (unsigned)analysisInfo.getParameter("time_window");
+		unsigned firstTimeStep = firstTimeStepInt;
+		unsigned lastTimeStep = lastTimeStepInt;
+		if(lastTimeStep < firstTimeStep + timeWindow - 1)
+			throw SpikeStreamAnalysisException("Time window must not be greater than the range of time steps.");
+
+		//Build the list of pairs of neurons
+		QList<neurid_t> fromNeuronIDList = getNeuronIDs((unsigned)analysisInfo.getParameter("from_neuron_group_id"));
+		QList<neurid_t> toNeuronIDList = getNeuronIDs((unsigned)analysisInfo.getParameter("to_neuron_group_id"));
+		QHash<neurid_t, unsigned> neuronIndexMap;
+		neuronIDList.clear();
+		pairList.clear();
+		foreach(neurid_t fromNeuronID, fromNeuronIDList){
+			unsigned fromIndex = addNeuron(fromNeuronID, neuronIndexMap);
+			foreach(neurid_t toNeuronID, toNeuronIDList){
+				if(fromNeuronID != toNeuronID)
+					pairList.append(qMakePair(fromIndex, addNeuron(toNeuronID, neuronIndexMap)));
+			}
+		}
+
+		//Load the firing of all the neurons
+		loadSpikeTrains(firstTimeStep, lastTimeStep, neuronIndexMap);
+
+		//Share the pairs out between the threads
+		unsigned numberOfThreads = analysisInfo.getNumberOfThreads();
+		if(numberOfThreads == 0)
+			numberOfThreads = 1;
+		for(unsigned i=0; i<numberOfThreads && !stop; ++i){
+			TransferEntropyPairThread* pairThread = new TransferEntropyPairThread(spikeTrainData, pairList, i, numberOfThreads, k_param, l_param, timeWindow, &stop);
+			pairThreadList.append(pairThread);
+			pairThread->start();
+		}
+
+		//Store results as they come in until all of the threads have finished
+		unsigned pairsCompleted = 0;
+		foreach(TransferEntropyPairThread* pairThread, pairThreadList){
+			while(!pairThread->wait(200)){
+				pairsCompleted += storeResults(pairThreadList, firstTimeStep);
+				emit progress("Calculating transfer entropy", timeStep, pairsCompleted, pairList.size());
+			}
+			if(pairThread->isError())
+				setError(pairThread->getErrorMessage());
+		}
+		pairsCompleted += storeResults(pairThreadList, firstTimeStep);
+		emit progress("Calculating transfer entropy", timeStep, pairsCompleted, pairList.size());
+	}
+	catch(SpikeStreamException& ex){
+		setError(ex.getMessage());
+	}
+
+	//Clean up threads, which will have been told to stop if there was an error
+	foreach(TransferEntropyPairThread* pairThread, pairThreadList){
+		pairThread->wait();
+		delete pairThread;
+	}
+
+	//Show time taken for the analysis
+	timer.printTime("Transfer entropy analysis of " + QString::number(pairList.size()) + " pairs");
+	if(!stop && !error)
+		emit timeStepComplete(firstTimeStepInt);
+}
+
+
+/*! Creates the data access objects used by the analysis */
+void TransferEntropyTimeStepThread::createDaos(){
+	AbstractAnalysisTimeStepThread::createDaos();
+	transferEntropyDao = new TransferEntropyDao(analysisDBInfo);
+}
+
+
+/*! Deletes the data access objects */
+void TransferEntropyTimeStepThread::deleteDaos(){
+	if(transferEntropyDao != NULL){
+		delete transferEntropyDao;
+		transferEntropyDao = NULL;
+	}
+	AbstractAnalysisTimeStepThread::deleteDaos();
+}
+
+
+/*-------------------------------------------------------------*/
+/*-------                 PRIVATE METHODS                ------*/
+/*-------------------------------------------------------------*/
+
+/*! Returns the index of the neuron in spikeTrainData, adding it to the analysis if it has not been added already */
+unsigned TransferEntropyTimeStepThread::addNeuron(neurid_t neuronID, QHash<neurid_t, unsigned>& neuronIndexMap){
+	if(!neuronIndexMap.contains(neuronID)){
+		neuronIndexMap[neuronID] = neuronIDList.size();
+		neuronIDList.append(neuronID);
+	}
+	return neuronIndexMap[neuronID];
+}
+
 
-	//Reset error state
-	clearError();
+/*! Returns the IDs of the neurons in the neuron group or all of the neurons in the network if the neuron group ID is zero. */
+QList<neurid_t> TransferEntropyTimeStepThread::getNeuronIDs(unsigned neuronGroupID){
+	if(neuronGroupID == 0)
+		return networkDao->getNeuronIDs(analysisInfo.getNetworkID());
 
-	stop = true;
+	//Neuron IDs within a group are consecutive
+	QList<NeuronGroupInfo> neurGrpInfoList;
+	networkDao->getNeuronGroupsInfo(analysisInfo.getNetworkID(), neurGrpInfoList);
+	foreach(NeuronGroupInfo neurGrpInfo, neurGrpInfoList){
+		if(neurGrpInfo.getID() == neuronGroupID){
+			neurid_t startNeuronID = networkDao->getStartNeuronID(neuronGroupID);
+			unsigned neuronCount = networkDao->getNeuronCount(neurGrpInfo);
+			QList<neurid_t> neuronIDs;
+			for(unsigned i=0; i<neuronCount; ++i)
+				neuronIDs.append(startNeuronID + i);
+			return neuronIDs;
+		}
+	}
+	throw SpikeStreamAnalysisException("Neuron group " + QString::number(neuronGroupID) + " cannot be found in network " + QString::number(analysisInfo.getNetworkID()));
 }
 
+
+/*! Loads the firing of the neurons in the analysis from the archive into spikeTrainData.
+	Each time step is read from the database once, whatever the number of pairs. */
+void TransferEntropyTimeStepThread::loadSpikeTrains(unsigned firstTimeStep, unsigned lastTimeStep, const QHash<neurid_t, unsigned>& neuronIndexMap){
+	unsigned numberOfTimeSteps = lastTimeStep - firstTimeStep + 1;
+	spikeTrainData.reset(neuronIDList.size(), numberOfTimeSteps);
+
+	for(unsigned t = firstTimeStep; t <= lastTimeStep && !stop; ++t){
+		QList<neurid_t> firingNeuronIDs = archiveDao->getFiringNeuronIDs(analysisInfo.getArchiveID(), t);
+		foreach(neurid_t neuronID, firingNeuronIDs){
+			if(neuronIndexMap.contains(neuronID))
+				spikeTrainData.addSpike(neuronIndexMap[neuronID], t - firstTimeStep);
+		}
+		emit progress("Loading spike trains", timeStep, t - firstTimeStep + 1, numberOfTimeSteps);
+	}
+}
+
+
+/*! Adds the results that the pair threads have finished to the database.
+	Returns the number of pairs that have been stored. */
+unsigned TransferEntropyTimeStepThread::storeResults(QList<TransferEntropyPairThread*>& pairThreadList, unsigned firstTimeStep){
+	QHash<unsigned, QList<double> > resultsMap;
+	foreach(TransferEntropyPairThread* pairThread, pairThreadList)
+		pairThread->takeResults(resultsMap);
+
+	for(QHash<unsigned, QList<double> >::iterator iter = resultsMap.begin(); iter != resultsMap.end(); ++iter){
+		const QPair<unsigned, unsigned>& neuronPair = pairList.at(iter.key());
+		transferEntropyDao->addTransferEntropy(analysisInfo.getID(), neuronIDList.at(neuronPair.first), neuronIDList.at(neuronPair.second), firstTimeStep, iter.value());
+	}
+
+	if(!resultsMap.isEmpty())
+		emit newResultsFound();
+	return resultsMap.size();
+}
@@ -3,16 +3,49 @@
 
 //SpikeStream includes
 #include "AbstractAnalysisTimeStepThread.h"
+#include "SpikeTrainData.h"
+#include "TransferEntropyDao.h"
+#include "TransferEntropyPairThread.h"
 
 namespace spikestream {
 
+	/*! Calculates the transfer entropy between every pair of neurons in two neuron groups.
+		The runner hands the whole range of time steps to a single thread as one chunk, which
+		is analyzed as a whole by analyzeTimeSteps(). Spike trains are loaded from the
+		archive once and the pairs are shared out between a number of TransferEntropyPairThreads. */
 	class TransferEntropyTimeStepThread : public AbstractAnalysisTimeStepThread {
 		Q_OBJECT
 
 		public:
 			TransferEntropyTimeStepThread(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo);
 			~TransferEntropyTimeStepThread();
-			void run();
+
+		protected:
+			void analyzeTimeStep();
+			void analyzeTimeSteps(int firstTimeStep, int lastTimeStep);
+			void createDaos();
+			void deleteDaos();
+
+		private:
+			//========================  VARIABLES  ========================
+			/*! Wrapper around the analysis database */
+			TransferEntropyDao* transferEntropyDao;
+
+			/*! Spike trains of all of the neurons in the analysis */
+			SpikeTrainData spikeTrainData;
+
+			/*! IDs of the neurons in the analysis. The position of each ID is its index in spikeTrainData */
+			QList<neurid_t> neuronIDList;
+
+			/*! Indexes in spikeTrainData of the from and to neurons of each pair */
+			QList< QPair<unsigned, unsigned> > pairList;
+
+
+			//=========================  METHODS  =========================
+			unsigned addNeuron(neurid_t neuronID, QHash<neurid_t, unsigned>& neuronIndexMap);
+			QList<neurid_t> getNeuronIDs(unsigned neuronGroupID);
+			void loadSpikeTrains(unsigned firstTimeStep, unsigned lastTimeStep, const QHash<neurid_t, unsigned>& neuronIndexMap);
+			unsigned storeResults(QList<TransferEntropyPairThread*>& pairThreadList, unsigned firstTimeStep);
 
 		};
 
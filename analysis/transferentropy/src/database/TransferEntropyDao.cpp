@@ -0,0 +1,101 @@
+#include "TransferEntropyDao.h"
+#include "SpikeStreamException.h"
+#include "SpikeStreamDBException.h"
+#include "Util.h"
+using namespace spikestream;
+
+/*! Standard Constructor */
+TransferEntropyDao::TransferEntropyDao(const DBInfo& dbInfo) : AnalysisDao(dbInfo){
+}
+
+
+/*! Empty constructor for unit testing */
+TransferEntropyDao::TransferEntropyDao(){
+}
+
+
+/*! Destructor */
+TransferEntropyDao::~TransferEntropyDao(){
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                PUBLIC METHODS                  -----*/
+/*----------------------------------------------------------*/
+
+/*! Adds the transfer entropy from one neuron to another for a series of time windows.
+	The first entry in the list is for the window starting at firstTimeStep, the second
+	for the window starting at firstTimeStep + 1, etc. Rows are added in batches to
+	reduce the number of queries. */
+void TransferEntropyDao::addTransferEntropy(unsigned int analysisID, unsigned int fromNeuronID, unsigned int toNeuronID, unsigned int firstTimeStep, const QList<double>& transferEntropyList){
+	if(transferEntropyList.isEmpty())
+		return;
+
+	//Store the values of each row
+	QList<QVariant> valueList;
+	for(int i=0; i<transferEntropyList.size(); ++i){
+		valueList.append(analysisID);
+		valueList.append(fromNeuronID);
+		valueList.append(toNeuronID);
+		valueList.append(firstTimeStep + i);
+		valueList.append(transferEntropyList.at(i));
+	}
+
+	//Add the rows
+	startTransaction();
+	try{
+		executeBatchInsert("INSERT INTO TransferEntropy (AnalysisID, FromNeuronID, ToNeuronID, TimeStep, TransferEntropy) VALUES", 5, valueList);
+	}
+	catch(...){
+		rollbackTransaction();
+		throw;
+	}
+	commitTransaction();
+}
+
+
+/*! Checks to see if there is already analysis data for this range of time steps.
+	Range includes start and end time step. */
+bool TransferEntropyDao::containsAnalysisData(unsigned int analysisID, unsigned int firstTimeStep, unsigned int lastTimeStep){
+	QString queryString = "SELECT COUNT(*) FROM TransferEntropy WHERE AnalysisID=" + QString::number(analysisID);
+	queryString += " AND TimeStep >= " + QString::number(firstTimeStep) + " AND TimeStep <= " + QString::number(lastTimeStep);
+	QSqlQuery query = getQuery(queryString);
+	executeQuery(query);
+	query.next();
+
+	//Return true if we have found analysis data
+	if(query.value(0).toUInt() != 0)
+		return true;
+	return false;
+}
+
+
+/*! Deletes transfer entropy data for windows starting within the supplied range of time steps.
+	The range is inclusive, so start and end time steps will both be deleted. */
+void TransferEntropyDao::deleteTimeSteps(unsigned int analysisID, unsigned int firstTimeStep, unsigned int lastTimeStep){
+	executeQuery("DELETE FROM TransferEntropy WHERE AnalysisID=" + QString::number(analysisID) + " AND TimeStep >= " + QString::number(firstTimeStep) + " AND TimeStep <= " + QString::number(lastTimeStep));
+}
+
+
+/*! Returns the maximum transfer entropy in the analysis */
+double TransferEntropyDao::getMaxTransferEntropy(unsigned int analysisID){
+	QSqlQuery query = getQuery("SELECT MAX(TransferEntropy) FROM TransferEntropy WHERE AnalysisID=" + QString::number(analysisID));
+	executeQuery(query);
+	query.next();
+	return Util::getDouble(query.value(0).toString());
+}
+
+
+/*! Returns the transfer entropy from one neuron to another, indexed by the first time step of each window */
+QMap<unsigned int, double> TransferEntropyDao::getTransferEntropy(unsigned int analysisID, unsigned int fromNeuronID, unsigned int toNeuronID){
+	QString queryStr = "SELECT TimeStep, TransferEntropy FROM TransferEntropy WHERE AnalysisID=" + QString::number(analysisID);
+	queryStr += " AND FromNeuronID=" + QString::number(fromNeuronID) + " AND ToNeuronID=" + QString::number(toNeuronID);
+	QSqlQuery query = getQuery(queryStr);
+	executeQuery(query);
+
+	QMap<unsigned int, double> transferEntropyMap;
+	while(query.next()){
+		transferEntropyMap[Util::getUInt(query.value(0).toString())] = Util::getDouble(query.value(1).toString());
+	}
+	return transferEntropyMap;
+}
@@ -0,0 +1,29 @@
+#ifndef TRANSFERENTROPYDAO_H
+#define TRANSFERENTROPYDAO_H
+
+#include "AnalysisDao.h"
+#include "DBInfo.h"
+using namespace spikestream;
+
+//Qt includes
+#include <QMap>
+
+
+namespace spikestream {
+
+	/*! Stores and retrieves the results of transfer entropy analyses */
+	class TransferEntropyDao : public AnalysisDao {
+		public:
+			TransferEntropyDao(const DBInfo& dbInfo);
+			TransferEntropyDao();
+			virtual ~TransferEntropyDao();
+			virtual void addTransferEntropy(unsigned int analysisID, unsigned int fromNeuronID, unsigned int toNeuronID, unsigned int firstTimeStep, const QList<double>& transferEntropyList);
+			bool containsAnalysisData(unsigned int analysisID, unsigned int firstTimeStep, unsigned int lastTimeStep);
+			void deleteTimeSteps(unsigned int analysisID, unsigned int firstTimeStep, unsigned int lastTimeStep);
+			double getMaxTransferEntropy(unsigned int analysisID);
+			QMap<unsigned int, double> getTransferEntropy(unsigned int analysisID, unsigned int fromNeuronID, unsigned int toNeuronID);
+	};
+
+}
+
+#endif//TRANSFERENTROPYDAO_H
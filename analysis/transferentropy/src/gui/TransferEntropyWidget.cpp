@@ -1,10 +1,8 @@
 //SpikeStream includes
-#include "ArchiveDao.h"
 #include "Globals.h"
 #include "GlobalVariables.h"
 #include "SpikeStreamException.h"
 #include "TransferEntropyWidget.h"
-#include "TransferEntropyCalculator.h"
 #include "TransferEntropyTimeStepThread.h"
 #include "Util.h"
 using namespace spikestream;
@@ -46,19 +44,37 @@ AbstractAnalysisTimeStepThread* createAnalysisTimeStepThread(const DBInfo& netDB
 TransferEntropyWidget::TransferEntropyWidget(QWidget *parent) : AbstractAnalysisWidget(parent){
 	QVBoxLayout *mainVBox = new QVBoxLayout(this);
 
+	//Create a transfer entropy dao to be used by this class
+	transferEntropyDao = new TransferEntropyDao(Globals::getAnalysisDao()->getDBInfo());
+
 	//Initialize analysis parameters and other variables
 	initializeAnalysisInfo();
 
+	//Set up analysis runner with function to create threads to analyze for transfer entropy
+	analysisRunner->setTimeStepThreadCreationFunction(&createAnalysisTimeStepThread);
+
 	//Add tool bar to top of widget
 	toolBar = getDefaultToolBar();
 	checkToolBarEnabled();//Can only carry out analysis if a network and archive are loaded
 	mainVBox->addWidget(toolBar);
 
+	//Create a tabbed widget to hold progress and results
+	QTabWidget* tabWidget = new QTabWidget(this);
+
 	//Add status display area
 	statusTextEdit = new QTextEdit(this);
 	statusTextEdit->setReadOnly(true);
-	statusTextEdit->append("Hello world");
-	mainVBox->addWidget(statusTextEdit);
+	tabWidget->addTab(statusTextEdit, "Results");
+
+	//Add widget displaying progress
+	progressWidget = new ProgressWidget(this);
+	connect(analysisRunner, SIGNAL(progress(const QString&, unsigned int, unsigned int, unsigned int)), progressWidget, SLOT(updateProgress(const QString&, unsigned int, unsigned int, unsigned int)), Qt::QueuedConnection);
+	connect(analysisRunner, SIGNAL(timeStepComplete(unsigned int)), progressWidget, SLOT(timeStepComplete(unsigned int)), Qt::QueuedConnection);
+	progressWidget->setMinimumSize(500, 500);
+	QScrollArea* progressScrollArea = new QScrollArea(this);
+	progressScrollArea->setWidget(progressWidget);
+	tabWidget->addTab(progressScrollArea, "Progress");
+	mainVBox->addWidget(tabWidget);
 
 	mainVBox->addStretch(5);
 
@@ -67,6 +83,7 @@ TransferEntropyWidget::TransferEntropyWidget(QWidget *parent) : AbstractAnalysis
 
 /*! Destructor */
 TransferEntropyWidget::~TransferEntropyWidget(){
+	delete transferEntropyDao;
 }
 
 
@@ -94,6 +111,10 @@ void TransferEntropyWidget::newAnalysis(){
 
 	//Clear analysis id
 	Globals::setAnalysisID(getAnalysisName(), 0);
+
+	//Reset results and progress
+	statusTextEdit->clear();
+	progressWidget->reset();
 }
 
 
@@ -102,7 +123,9 @@ void TransferEntropyWidget::plotGraphs(){
 
 
 
-/*! Starts the analysis of the network for transfer entropy */
+/*! Starts the analysis of the network for transfer entropy.
+	The whole range of time steps is analyzed by a single TransferEntropyTimeStepThread,
+	which slides the time window along the spike trains of each pair of neurons. */
 void TransferEntropyWidget::startAnalysis(){
 	//Double check that both a network and an analysis are loaded
 	if(!Globals::networkLoaded() || !Globals::archiveLoaded()){
@@ -110,80 +133,70 @@ void TransferEntropyWidget::startAnalysis(){
 		return;
 	}
 
-	//Store parameters for the analysis
-	storeParameters();
-
-	//Get time steps to be analyzed
-	unsigned firstTimeStep = getFirstTimeStep();
-	unsigned lastTimeStep = getLastTimeStep();
+	//Get time steps to be analyzed and check parameters
+	int firstTimeStep = getFirstTimeStep();
+	int lastTimeStep = getLastTimeStep();
+	if(!checkParameters(firstTimeStep, lastTimeStep))
+		return;
 
-	//Check time window is less than range of time steps
-	if(timeWindow > firstTimeStep - lastTimeStep){
-		qCritical()<<"Time window must be less than the range of time steps.";
-	}
+	//Create a new analysis in the database if one is not loaded
+	try {
+		if(!Globals::isAnalysisLoaded(getAnalysisName())){
+			Globals::getAnalysisDao()->addAnalysis(analysisInfo);
 
-	try{
-		statusTextEdit->append("Starting analysis.");
-		ArchiveDao archiveDao(Globals::getArchiveDao()->getDBInfo());
-
-		//Vectors holding neuron data
-		vector<unsigned> fromNeuronData;
-		vector<unsigned> toNeuronData;
-
-		statusTextEdit->append("Loading neuron data.");
-		for(unsigned timeStep = firstTimeStep; timeStep <= lastTimeStep; ++timeStep){
-			QList<neurid_t> firingNeuronIDs = archiveDao.getFiringNeuronIDs(analysisInfo.getArchiveID(), timeStep);
-
-			//Look for from and to neuron ids in the data for this time step
-			bool fromIDFound = false, toIDFound = false;
-			for(int i=0; i<firingNeuronIDs.size(); ++i){
-				if(firingNeuronIDs.at(i) == fromNeuronID){
-					fromNeuronData.push_back(1);
-					fromIDFound = true;
-				}
-				else if(firingNeuronIDs.at(i) == toNeuronID){
-					toNeuronData.push_back(1);
-					toIDFound = true;
-				}
+			//Analysis id in analysisInfo should now be set
+			if(analysisInfo.getID() == 0){
+				qCritical()<<"Analysis has not been added correctly";
+				return;
 			}
 
-			//Add zeros if no firing activity is found for this time step
-			if(!fromIDFound)
-				fromNeuronData.push_back(0);
-			if(!toIDFound)
-				toNeuronData.push_back(0);
+			//Store analysis ID in Globals to indicate that it is now loaded
+			Globals::setAnalysisID(getAnalysisName(), analysisInfo.getID());
 		}
 
-		//Check vectors are the correct length
-		if(fromNeuronData.size() != lastTimeStep - firstTimeStep + 1 || fromNeuronData.size() != toNeuronData.size()){
-			qCritical()<<"Error loading neuron data - vectors are the incorrect length";
-			return;
+		//Check for a time step conflict
+		if(timeStepsAlreadyAnalyzed(firstTimeStep, lastTimeStep)){
+			//Check to see if user wants to overwrite time steps fully or partly analyzed
+			QString confirmMsg = "Some or all of the time steps from " + QString::number(firstTimeStep);
+			confirmMsg += " to " + QString::number(lastTimeStep) + " have already been fully or partly analyzed.\n";
+			confirmMsg += "Do you want to overwrite the current results for these time steps in the database?";
+			QMessageBox::StandardButton response = QMessageBox::warning(this, "Time step conflict", confirmMsg, QMessageBox::Ok | QMessageBox::Cancel);
+			if(response != QMessageBox::Ok)
+				return;
+
+			//Delete time steps from the database
+			transferEntropyDao->deleteTimeSteps(analysisInfo.getID(), firstTimeStep, lastTimeStep);
+			updateResults();
 		}
 
-		//Work through data and analyze it for transfer entropy
-		statusTextEdit->append("Calculating transfer entropy.");
-		TransferEntropyCalculator transferEntropyCalculator(k_param, l_param, timeWindow);
-		double tmpTransEnt, total=0.0;
-		unsigned count = 0;
-		for(unsigned startTimeStep=0; startTimeStep<fromNeuronData.size()-timeWindow; ++startTimeStep){
-			tmpTransEnt = transferEntropyCalculator.getTransferEntropy(startTimeStep, toNeuronData, fromNeuronData);
-			total += tmpTransEnt;
-			++count;
-			statusTextEdit->append("Start time step: " + QString::number(startTimeStep) + "; Transfer entropy: " + QString::number(tmpTransEnt));
-		}
-		statusTextEdit->append("Analysis finished. Total transfer entropy: " + QString::number(total) + "; Average transfer entropy: " + QString::number(total/count));
+		//Initialize classes to run analysis. The time steps are handed out as a single chunk, so one thread handles all of them
+		progressWidget->reset();
+		statusTextEdit->append("Starting analysis of time steps " + QString::number(firstTimeStep) + " to " + QString::number(lastTimeStep) + ".");
+		analysisRunner->prepareAnalysisTask(analysisInfo, firstTimeStep, lastTimeStep);
+		analysisRunner->setTimeStepChunkSize(lastTimeStep - firstTimeStep + 1);
+		currentTask = ANALYSIS_TASK;
+		analysisRunner->start();
+		Globals::getEventRouter()->analysisStarted();
 	}
 	catch(SpikeStreamException& ex){
 		qCritical()<<ex.getMessage();
-	}
-	catch(...){
-		qCritical()<<"Unknown exception occurred.";
+
+		//We don't know if analysis runner has started or not, so set error just in case
+		analysisRunner->setError("Exception thrown starting task or adding analysis to database.");
 	}
 }
 
 
-/*! Updates results table by reloading it from the database */
+/*! Updates results by reloading them from the database */
 void TransferEntropyWidget::updateResults(){
+	if(!Globals::isAnalysisLoaded(getAnalysisName()))
+		return;
+	try{
+		statusTextEdit->append("Maximum transfer entropy: " + QString::number(transferEntropyDao->getMaxTransferEntropy(analysisInfo.getID())));
+	}
+	catch(SpikeStreamException& ex){
+		qCritical()<<ex.getMessage();
+	}
 }
 
 
@@ -208,16 +221,16 @@ void TransferEntropyWidget::initializeAnalysisInfo(){
 	else
 		analysisInfo.setArchiveID(0);
 
-	//Set the type of analysis, 3 corresponds to a liveliness analysis
+	//Set the type of analysis, 3 corresponds to a transfer entropy analysis
 	//FIXME: ACCESS THIS USING A STRING NOT A DATABASE ID
-	analysisInfo.setAnalysisType(0);
+	analysisInfo.setAnalysisType(3);
 
-	//Set parameters
+	//Set parameters. Neuron group IDs of zero select all of the neurons in the network
 	analysisInfo.getParameterMap()["time_window"] = 100;
 	analysisInfo.getParameterMap()["k"] = 5;
 	analysisInfo.getParameterMap()["l"] = 5;
-	analysisInfo.getParameterMap()["from_neuron_ID"] = 0;
-	analysisInfo.getParameterMap()["to_neuron_ID"] = 0;
+	analysisInfo.getParameterMap()["from_neuron_group_id"] = 0;
+	analysisInfo.getParameterMap()["to_neuron_group_id"] = 0;
 }
 
 
@@ -225,29 +238,36 @@ void TransferEntropyWidget::initializeAnalysisInfo(){
 /*-------                 PRIVATE METHODS                ------*/
 /*-------------------------------------------------------------*/
 
-/*! Extracts parameters and checks that they are valid. */
-void TransferEntropyWidget::storeParameters(){
-	//From and to neuron ids.
-	fromNeuronID = analysisInfo.getParameterMap()["from_neuron_ID"];
-	toNeuronID = analysisInfo.getParameterMap()["to_neuron_ID"];
-	if(fromNeuronID == 0 || toNeuronID == 0){
-		qCritical()<<"From and/or to neuron id has not been set.";
-		return;
-	}
-	if(fromNeuronID == toNeuronID){
-		qCritical()<<"From neuron ID should not equal to neuron id.";
-		return;
-	}
-
-	//Time window
-	timeWindow = analysisInfo.getParameterMap()["time_window"];
-	k_param = analysisInfo.getParameterMap()["k"];
-	l_param = analysisInfo.getParameterMap()["l"];
+/*! Checks that the parameters are valid for the range of time steps. */
+bool TransferEntropyWidget::checkParameters(int firstTimeStep, int lastTimeStep){
+	unsigned timeWindow = (unsigned)analysisInfo.getParameterMap()["time_window"];
+	unsigned k_param = (unsigned)analysisInfo.getParameterMap()["k"];
+	unsigned l_param = (unsigned)analysisInfo.getParameterMap()["l"];
 
-	if(k_param < l_param)
+	if(k_param == 0 || l_param == 0){
+		qCritical()<<"k_param and l_param must be greater than zero";
+		return false;
+	}
+	if(k_param < l_param){
 		qCritical()<<"k_param must be greater than or equal to l_param";
-	if(timeWindow <= k_param)
+		return false;
+	}
+	if(timeWindow <= k_param){
 		qCritical()<<"TimeWindow must be greater than k_param";
-
+		return false;
+	}
+	if(firstTimeStep < 0 || (int)timeWindow > lastTimeStep - firstTimeStep + 1){
+		qCritical()<<"Time window must not be greater than the range of time steps.";
+		return false;
+	}
+	return true;
 }
 
+
+/*! Checks to see if any of the specified range of time steps already exist in the database */
+bool TransferEntropyWidget::timeStepsAlreadyAnalyzed(int firstTimeStep, int lastTimeStep){
+	if(!Globals::isAnalysisLoaded(getAnalysisName())){
+		return false;
+	}
+	return transferEntropyDao->containsAnalysisData(analysisInfo.getID(), firstTimeStep, lastTimeStep);
+}
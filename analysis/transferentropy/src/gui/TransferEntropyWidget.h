@@ -4,7 +4,9 @@
 //SpikeStream includes
 #include "AbstractAnalysisWidget.h"
 #include "GlobalVariables.h"
+#include "ProgressWidget.h"
 #include "SpikeStreamTypes.h"
+#include "TransferEntropyDao.h"
 using namespace spikestream;
 
 //Qt includes
@@ -39,23 +41,15 @@ namespace spikestream {
 			/*! Displays information about analysis */
 			QTextEdit* statusTextEdit;
 
-			/*! From neuron */
-			neurid_t fromNeuronID;
+			/*! Displays progress of the analysis */
+			ProgressWidget* progressWidget;
 
-			/*! To neuron id */
-			neurid_t toNeuronID;
-
-			/*! Time window within which the transfer entropy is calculated */
-			unsigned timeWindow;
-
-			/*! k parameter of analysis */
-			unsigned k_param;
-
-			/*! l parameter of analysis */
-			unsigned l_param;
+			/*! Data access object for the results of the analysis */
+			TransferEntropyDao* transferEntropyDao;
 
 			//=====================  METHODS  =======================
-			void storeParameters();
+			bool checkParameters(int firstTimeStep, int lastTimeStep);
+			bool timeStepsAlreadyAnalyzed(int firstTimeStep, int lastTimeStep);
 
    };
 
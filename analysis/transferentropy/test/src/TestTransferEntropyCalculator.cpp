@@ -2,10 +2,9 @@
 #include "TransferEntropyCalculator.h"
 #include "SpikeStreamException.h"
 #include "SpikeStreamAnalysisException.h"
+#include "SpikeTrainData.h"
 using namespace spikestream;
 
-#include "transferentropycalc.h"
-
 //Qt includes
 #include <QDebug>
 
@@ -57,7 +56,7 @@ void TestTransferEntropyCalculator::testLoad_I_k_probabilities(){
 		testCalculator.load_I_k_probabilities(2, testIData);
 
 		//Check that the appropriate probabilities have been stored
-		QHash<unsigned, double>& probMap = testCalculator.getI_k_probs();
+		QHash<unsigned, double> probMap = testCalculator.getI_k_probs();
 		QCOMPARE(probMap.size(), 4);
 
 		QVERIFY(probMap.contains(19));
@@ -110,7 +109,7 @@ void TestTransferEntropyCalculator::testLoad_I_k_plus_1_probabilities(){
 		testCalculator.load_I_k_plus_1_probabilities(1, testIData);
 
 		//Check that the appropriate probabilities have been stored
-		QHash<unsigned, double>& probMap = testCalculator.getI_k_plus_1_probs();
+		QHash<unsigned, double> probMap = testCalculator.getI_k_plus_1_probs();
 		QCOMPARE(probMap.size(), 4);
 
 		QVERIFY(probMap.contains(6));
@@ -173,7 +172,7 @@ void TestTransferEntropyCalculator::testLoad_I_k_J_k_probabilities(){
 		testCalculator.load_I_k_J_l_probabilities(0, testIData, testJData);
 
 		//Check that the appropriate probabilities have been stored
-		QHash<unsigned, double>& probMap = testCalculator.getI_k_J_l_probs();
+		QHash<unsigned, double> probMap = testCalculator.getI_k_J_l_probs();
 		QCOMPARE(probMap.size(), 5);
 
 		QVERIFY(probMap.contains(41));
@@ -267,7 +266,7 @@ void TestTransferEntropyCalculator::testLoad_I_k_plus_1_J_l_probabilities(){
 		testCalculator.load_I_k_plus_1_J_l_probabilities(2, testIData, testJData);
 
 		//Check that the appropriate probabilities have been stored
-		QHash<unsigned, double>& probMap = testCalculator.getI_k_plus_1_J_l_probs();
+		QHash<unsigned, double> probMap = testCalculator.getI_k_plus_1_J_l_probs();
 		QCOMPARE(probMap.size(), 6);
 
 		QVERIFY(probMap.contains(27));
@@ -453,10 +452,10 @@ void TestTransferEntropyCalculator::testPresentationData(){
 		testCalculator.load_I_k_plus_1_J_l_probabilities(0, testIData, testJData);
 
 		//Check that the appropriate probabilities have been stored
-		QHash<unsigned, double>& I_k_probs = testCalculator.getI_k_probs();
-		QHash<unsigned, double>& I_k_plus_1_probs = testCalculator.getI_k_plus_1_probs();
-		QHash<unsigned, double>& I_k_J_l_probs = testCalculator.getI_k_J_l_probs();
-		QHash<unsigned, double>& I_k_plus_1_J_l_probs = testCalculator.getI_k_plus_1_J_l_probs();
+		QHash<unsigned, double> I_k_probs = testCalculator.getI_k_probs();
+		QHash<unsigned, double> I_k_plus_1_probs = testCalculator.getI_k_plus_1_probs();
+		QHash<unsigned, double> I_k_J_l_probs = testCalculator.getI_k_J_l_probs();
+		QHash<unsigned, double> I_k_plus_1_J_l_probs = testCalculator.getI_k_plus_1_J_l_probs();
 
 		//Check the entries in the probability map are correct
 		QVERIFY(I_k_probs.contains(0));
@@ -913,78 +912,55 @@ void TestTransferEntropyCalculator::testPresentationData(){
 }
 
 
-void TestTransferEntropyCalculator::testZafeiriosCode(){
+void TestTransferEntropyCalculator::testSlidingWindow(){
 	try{
-
-		//Create iVector
-		QVector<unsigned> testIData;
-		testIData.push_back(1);
-		testIData.push_back(1);
-		testIData.push_back(1);
-		testIData.push_back(0);
-		testIData.push_back(1);
-
-		testIData.push_back(1);
-		testIData.push_back(0);
-		testIData.push_back(1);
-		testIData.push_back(0);
-		testIData.push_back(0);
-
-		testIData.push_back(1);
-		testIData.push_back(1);
-		testIData.push_back(0);
-		testIData.push_back(0);
-		testIData.push_back(1);
-
-		testIData.push_back(1);
-		testIData.push_back(1);
-		testIData.push_back(0);
-		testIData.push_back(1);
-		testIData.push_back(1);
-
-		testIData.push_back(0);
-		testIData.push_back(1);
-
-		//Create jVector
-		QVector<unsigned> testJData;
-		testJData.push_back(1);
-		testJData.push_back(0);
-		testJData.push_back(1);
-		testJData.push_back(0);
-		testJData.push_back(1);
-
-		testJData.push_back(0);
-		testJData.push_back(1);
-		testJData.push_back(0);
-		testJData.push_back(1);
-		testJData.push_back(1);
-
-		testJData.push_back(0);
-		testJData.push_back(1);
-		testJData.push_back(1);
-		testJData.push_back(0);
-		testJData.push_back(1);
-
-		testJData.push_back(1);
-		testJData.push_back(0);
-		testJData.push_back(1);
-		testJData.push_back(1);
-		testJData.push_back(0);
-
-		testJData.push_back(0);
-		testJData.push_back(1);
-
-		//Test method
-		TransferEntropyCalc calc(1,1);
-		double tranEnt = calc.getTrEn(testIData, testJData);
-		cout<<"Zafeirios result: "<<tranEnt<<endl;
-
+		//Create spike trains with some dependence of I on the previous time step of J
+		unsigned numTimeSteps = 300;
+		vector<unsigned> testIData, testJData;
+		SpikeTrainData spikeTrainData;
+		spikeTrainData.reset(2, numTimeSteps);
+		qsrand(123);
+		for(unsigned t=0; t<numTimeSteps; ++t){
+			testJData.push_back(qrand() % 3 == 0 ? 1 : 0);
+			if(t > 0 && testJData[t-1] == 1)
+				testIData.push_back(qrand() % 4 == 0 ? 0 : 1);
+			else
+				testIData.push_back(qrand() % 5 == 0 ? 1 : 0);
+			if(testIData[t])
+				spikeTrainData.addSpike(0, t);
+			if(testJData[t])
+				spikeTrainData.addSpike(1, t);
+		}
+
+		//Sliding window should give the same result as the full calculation for every window
+		unsigned paramArray[3][3] = { {1, 1, 20}, {3, 2, 50}, {4, 4, 100} };
+		for(int p=0; p<3; ++p){
+			TransferEntropyCalculator fullCalculator(paramArray[p][0], paramArray[p][1], paramArray[p][2]);
+			TransferEntropyCalculator slidingCalculator(paramArray[p][0], paramArray[p][1], paramArray[p][2]);
+			unsigned timeWindow = paramArray[p][2];
+			double slidingResult = slidingCalculator.startSlidingWindow(0, spikeTrainData.getSpikeTrain(0), spikeTrainData.getSpikeTrain(1), numTimeSteps);
+			for(unsigned startTimeStep = 0; startTimeStep + timeWindow < numTimeSteps; ++startTimeStep){
+				if(startTimeStep > 0)
+					slidingResult = slidingCalculator.slideWindow();
+				double fullResult = fullCalculator.getTransferEntropy(startTimeStep, testIData, testJData);
+				QCOMPARE(round(slidingResult, 8), round(fullResult, 8));
+			}
+		}
+
+		//Window cannot slide beyond the end of the data
+		TransferEntropyCalculator testCalculator(2, 1, 10);
+		testCalculator.startSlidingWindow(numTimeSteps - 10, spikeTrainData.getSpikeTrain(0), spikeTrainData.getSpikeTrain(1), numTimeSteps);
+		try{
+			testCalculator.slideWindow();
+			QFAIL("Exception should have been thrown sliding window beyond end of data.");
+		}
+		catch(SpikeStreamAnalysisException& ex){
+		}
+	}
+	catch(SpikeStreamException& ex){
+		QFAIL(ex.getMessage().toAscii());
 	}
 	catch(...){
 		QFAIL("An unknown exception occurred");
 	}
 }
-
-
-
-
@@ -16,7 +16,7 @@ namespace spikestream {
 
 		private slots:
 			void testPresentationData();
-			void testZafeiriosCode();
+			void testSlidingWindow();
 		private:
 			void testGetBitString();
 			void testLoad_I_k_probabilities();
@@ -16,7 +16,6 @@ CONFIG += qtestlib console
 #----------------------------------------------#
 INCLUDEPATH += src \
 				$${SPIKESTREAM_ROOT_DIR}/library/include \
-				$${SPIKESTREAM_ROOT_DIR}/testlibrary/include \
 				$${SPIKESTREAM_ROOT_DIR}/analysis/transferentropy/src/analysis
 
 
@@ -24,10 +23,10 @@ INCLUDEPATH += src \
 #---               LIBRARIES                ---#
 #----------------------------------------------#
 unix {
-	LIBS += -ltransferentropy -L$${SPIKESTREAM_ROOT_DIR}/plugins/analysis -lspikestreamtest -lspikestreamapplication -lspikestream -L$${SPIKESTREAM_ROOT_DIR}/lib
+	LIBS += -ltransferentropy -L$${SPIKESTREAM_ROOT_DIR}/plugins/analysis -lspikestreamapplication -lspikestream -L$${SPIKESTREAM_ROOT_DIR}/lib
 }
 win32 {
-	LIBS += -ltransferentropy0 -L$${SPIKESTREAM_ROOT_DIR}/plugins/analysis -lspikestreamtest0 -lspikestream0 -L$${SPIKESTREAM_ROOT_DIR}/lib
+	LIBS += -ltransferentropy0 -L$${SPIKESTREAM_ROOT_DIR}/plugins/analysis -lspikestreamapplication0 -lspikestream0 -L$${SPIKESTREAM_ROOT_DIR}/lib
 }
 
 
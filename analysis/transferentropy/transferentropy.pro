@@ -16,6 +16,7 @@ QT += xml opengl sql
 #----------------------------------------------#
 INCLUDEPATH += src \
 				src/analysis \
+				src/database \
 				$${SPIKESTREAM_ROOT_DIR}/library/include \
 				$${SPIKESTREAM_ROOT_DIR}/applicationlibrary/include
 
@@ -37,17 +38,21 @@ win32 {
 #=================  ANALYSIS  ===================
 HEADERS += src/analysis/TransferEntropyTimeStepThread.h \
 			src/analysis/TransferEntropyCalculator.h \
-			src/analysis/transferentropycalc.h
+			src/analysis/TransferEntropyPairThread.h \
+			src/analysis/SpikeTrainData.h
 SOURCES += src/analysis/TransferEntropyTimeStepThread.cpp \
 			src/analysis/TransferEntropyCalculator.cpp \
-			src/analysis/transferentropycalc.cpp
-			
+			src/analysis/TransferEntropyPairThread.cpp \
+			src/analysis/SpikeTrainData.cpp
+
 
 #====================  GUI  =====================
 HEADERS += src/gui/TransferEntropyWidget.h 
 SOURCES += src/gui/TransferEntropyWidget.cpp 
 
 #==================  DATABASE  ===================
+HEADERS += src/database/TransferEntropyDao.h
+SOURCES += src/database/TransferEntropyDao.cpp
 
 #==================  MODELS  =====================
 
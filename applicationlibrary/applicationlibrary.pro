@@ -150,7 +150,8 @@ HEADERS += include/NeuronGroupModel.h \
 			include/TruthTableModel.h \
 			include/NeuronParametersModel.h \
 			include/SynapseParametersModel.h \
-			include/NeuronGroupSelectionModel.h
+			include/NeuronGroupSelectionModel.h \
+			include/RasterModel.h
 SOURCES += src/models/NeuronGroupModel.cpp \
 			src/models/ConnectionGroupModel.cpp \
 			src/models/ConnectionsModel.cpp \
@@ -158,7 +159,8 @@ SOURCES += src/models/NeuronGroupModel.cpp \
 			src/models/TruthTableModel.cpp \
 			src/models/NeuronParametersModel.cpp \
 			src/models/SynapseParametersModel.cpp \
-			src/models/NeuronGroupSelectionModel.cpp
+			src/models/NeuronGroupSelectionModel.cpp \
+			src/models/RasterModel.cpp
 
 
 #----------------------------------------------#
@@ -184,7 +186,8 @@ HEADERS += include/NeuronGroupTableView.h \
 			include/TruthTableView.h \
 			include/NeuronParametersView.h \
 			include/SynapseParametersView.h \
-			include/NeuronGroupSelectionView.h
+			include/NeuronGroupSelectionView.h \
+			include/RasterView.h
 SOURCES += src/views/NeuronGroupTableView.cpp \
 			src/views/ConnectionGroupTableView.cpp \
 			src/views/ConnectionsTableView.cpp \
@@ -192,7 +195,8 @@ SOURCES += src/views/NeuronGroupTableView.cpp \
 			src/views/TruthTableView.cpp \
 			src/views/NeuronParametersView.cpp \
 			src/views/SynapseParametersView.cpp \
-			src/views/NeuronGroupSelectionView.cpp
+			src/views/NeuronGroupSelectionView.cpp \
+			src/views/RasterView.cpp
 
 
 #----------------------------------------------#
@@ -6,14 +6,21 @@
 #include "NetworkDao.h"
 #include "ArchiveDao.h"
 #include "AnalysisInfo.h"
+#include "WeightlessNetworkSnapshot.h"
 
 //Qt includes
 #include <QThread>
 
 namespace spikestream {
 
+	class AnalysisRunner;
+
 	/*! Abstract class with functions common to all analysis threads designed to analyze
-		a particular time step. */
+		a particular time step.
+		The thread is a worker in the pool run by AnalysisRunner: it takes time steps from the runner
+		until there are none left and analyzes each of them with analyzeTimeStep(). The data access
+		objects are created once when the thread starts and are reused for every time step.
+		Analyses that cover a range of time steps as a whole can override analyzeTimeSteps() instead. */
 	class AbstractAnalysisTimeStepThread : public QThread {
 		Q_OBJECT
 
@@ -24,13 +31,17 @@ namespace spikestream {
 			QString getErrorMessage() { return errorMessage; }
 			int getTimeStep() { return timeStep; }
 			bool isError() { return error; }
+			void prepareAnalysis(const AnalysisInfo& anaInfo, AnalysisRunner* analysisRunner);
 			virtual void prepareTimeStepAnalysis(const AnalysisInfo& anaInfo, int timeStep);
-			virtual void run() = 0;
+			void run();
+			void setThreadsPerTimeStep(unsigned int numThreads);
+			void setWeightlessNetwork(WeightlessNetworkSnapshotPtr weiNetwork) { this->weightlessNetwork = weiNetwork; }
 			void stopThread();
 
 		signals:
 			void newResultsFound();
 			void progress(const QString& msg, unsigned int timeStep, unsigned int stepsCompleted, unsigned int totalSteps);
+			void timeStepComplete(unsigned int timeStep);
 
 		protected slots:
 			void updateResults();
@@ -56,6 +67,20 @@ namespace spikestream {
 			/*! The time step that is being analyzed by this thread */
 			int timeStep;
 
+			/*! Number of threads that can be used within the analysis of a single time step.
+				The runner shares out any threads of the analysis that are not needed for workers. */
+			unsigned int threadsPerTimeStep;
+
+			/*! Weightless neurons in the network, shared with the other threads in the analysis.
+				Null if the analysis runner has not loaded the network. */
+			WeightlessNetworkSnapshotPtr weightlessNetwork;
+
+			/*! Wrapper around the network database, created in the thread and used for every time step */
+			NetworkDao* networkDao;
+
+			/*! Wrapper around the archive database, created in the thread and used for every time step */
+			ArchiveDao* archiveDao;
+
 			/*! Records if an error has occurred */
 			bool error;
 
@@ -64,8 +89,18 @@ namespace spikestream {
 
 
 			//=======================  METHODS  =======================
+			virtual void analyzeTimeStep() = 0;
+			virtual void analyzeTimeSteps(int firstTimeStep, int lastTimeStep);
+			virtual void createDaos();
+			virtual void deleteDaos();
 			void setError(const QString& message);
 
+		private:
+			//========================  VARIABLES  ========================
+			/*! Runner that supplies the time steps to be analyzed. If this is NULL, only the time step
+				set with prepareTimeStepAnalysis is analyzed. */
+			AnalysisRunner* analysisRunner;
+
 	};
 
 }
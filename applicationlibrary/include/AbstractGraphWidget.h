@@ -76,6 +76,7 @@ namespace spikestream {
 
 			//=========================  METHODS  ======================
 			void buildBufferImage();
+			virtual QImage getPlotImage() { return *bufferImage; }
 			void increaseTimeStep(int currentTimeStep);
 			void mouseDoubleClickEvent (QMouseEvent* event);
 			void paintEvent(QPaintEvent* event);
@@ -30,11 +30,6 @@ namespace spikestream {
 			/*! Information about the analysis */
 			AnalysisInfo analysisInfo;
 
-			/*! Holds the processed data from the analysis.
-				Key1 is the time step, key2 is the first neuron id key3 is the second neuron id
-				data is the integration between the neurons */
-			QHash<unsigned int, QHash<unsigned int, QHash<unsigned int, double> > > timeStepDataMap;
-
 			/*! Minimum neuron id to set the bounding rectangle */
 			unsigned int minNeuronID;
 
@@ -47,23 +42,56 @@ namespace spikestream {
 			/*! Average over all time steps is shown */
 			bool allTimeSteps;
 
-			/*! Key pointing to unused time step value */
-			unsigned int allTimeStepsKey;
-
 			/*! Neuron IDs are displayed instead of numbers from 1 */
 			bool showNeuronIDs;
 
 
 			//=======================  METHODS  ===========================
-			void addAllTimeStepsMap(const QList<unsigned int>& neurIDList);
-			void addTimeStep(unsigned int timeStep, const QList<unsigned int>& neurIDList);
+			void addNeuronSet(unsigned int timeStep, const QList<unsigned int>& neurIDList, double value);
+			void addTimeStep(unsigned int timeStep);
 			virtual void loadData() = 0;
 			virtual void printData();
 			virtual void reset();
+			void setNeuronIDs(const QList<unsigned int>& neurIDList);
+
+		private:
+			//=======================  VARIABLES  =========================
+			/*! Holds the processed data from the analysis. The key is the time step and the value is an
+				upper triangular matrix holding the integration between each pair of neurons. Rows and
+				columns are the index of the neuron in the list passed to setNeuronIDs. */
+			QHash<unsigned int, float*> timeStepDataMap;
+
+			/*! Sum of the matrices of all of the time steps, which is updated whenever a value changes */
+			float* allTimeStepsData;
+
+			/*! Maximum value in any of the time step matrices */
+			float maxTimeStepValue;
+
+			/*! Maximum value in allTimeStepsData */
+			float maxAllTimeStepsValue;
+
+			/*! Number of neurons in the analysis, which is the size of each row and column of the matrices */
+			int numberOfNeurons;
+
+			/*! Index of each neuron in the matrices, looked up using (neuron id - minNeuronID). -1 indicates that
+				there is no neuron with that ID in the analysis */
+			int* neuronIndexArray;
+
+			/*! Matrix that value() is currently reading from */
+			const float* currentData;
+
+			/*! Factor applied to values from currentData to normalize them */
+			float currentScale;
+
+
+			//=======================  METHODS  ===========================
+			int getMatrixIndex(int index1, int index2) const;
+			int getNeuronIndex(int neuronID) const;
+			void printMatrix(const float* matrix);
+			void updateCurrentData();
 	};
 
 }
 
 
 #endif//ABSTRACTSPECTROGRAMDATA_H
-
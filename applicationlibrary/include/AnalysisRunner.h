@@ -6,14 +6,17 @@
 #include "DBInfo.h"
 
 //Qt includes
-#include <QHash>
+#include <QList>
 #include <QString>
 #include <QThread>
 #include <QMutex>
+#include <QWaitCondition>
 
 namespace spikestream {
 
-	/*! Sets up and runs an analysis that extends over one or more time steps. */
+	/*! Sets up and runs an analysis that extends over one or more time steps.
+		The time steps are analyzed by a fixed pool of worker threads, which take time steps
+		from a queue held by this class until all of them have been analyzed. */
 	class AnalysisRunner : public QThread {
 		Q_OBJECT
 
@@ -26,8 +29,12 @@ namespace spikestream {
 			void reset();
 			void run();
 			void setError(const QString& message);
+			void setLoadWeightlessNetwork(bool load) { this->loadWeightlessNetwork = load; }
+			void setTimeStepChunkSize(unsigned int chunkSize);
 			void setTimeStepThreadCreationFunction(AbstractAnalysisTimeStepThread* (*createAnalysisTimeStepThread)(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo));
 			void stop();
+			bool takeTimeSteps(int& firstTimeStep, int& lastTimeStep);
+			void workerFinished(AbstractAnalysisTimeStepThread* worker);
 
 		signals:
 			void newResultsFound();
@@ -35,9 +42,9 @@ namespace spikestream {
 			void timeStepComplete(unsigned int timeStep);
 
 		private slots:
-			void threadFinished();
 			void updateResults();
 			void updateProgress(const QString& msg, unsigned int timeStep, unsigned int stepsCompleted, unsigned int totalSteps);
+			void updateTimeStepComplete(unsigned int timeStep);
 
 		private:
 			//========================  VARAIBLES  =========================
@@ -65,18 +72,33 @@ namespace spikestream {
 			/*! Last time step to be analyzed */
 			int lastTimeStep;
 
-			/*! The next time step to be analyzed */
+			/*! The next time step to be analyzed, or -1 when all of the time steps have been handed out */
 			int nextTimeStep;
 
-			/*! Map of the currently running threads */
-			QHash<int, AbstractAnalysisTimeStepThread*> subThreadMap;
+			/*! Number of consecutive time steps handed to a worker thread at once */
+			int timeStepChunkSize;
 
-			/*! Mutex to make sure that we only process one thread finished
-			method at a time. */
+			/*! The pool of worker threads analyzing the time steps */
+			QList<AbstractAnalysisTimeStepThread*> workerList;
+
+			/*! Worker threads that have finished but have not yet been checked for errors */
+			QList<AbstractAnalysisTimeStepThread*> finishedWorkerList;
+
+			/*! Number of worker threads that have not yet finished */
+			int runningWorkers;
+
+			/*! Mutex protecting the queue of time steps, the list of workers and the error state */
 			QMutex mutex;
 
-			/*! Controls whether the thread is running or not */
-			bool stopThread;
+			/*! Woken each time a worker thread finishes */
+			QWaitCondition workerFinishedCondition;
+
+			/*! Controls whether the weightless neurons in the network are loaded once at the start
+				of the analysis and shared between all of the time step threads */
+			bool loadWeightlessNetwork;
+
+			/*! Weightless neurons in the network being analyzed */
+			WeightlessNetworkSnapshotPtr weightlessNetwork;
 
 			/*! Pointer to a function that creates a new time step thread of the appropriate class */
 			AbstractAnalysisTimeStepThread* (*createAnalysisTimeStepThread)(const DBInfo& netDBInfo, const DBInfo& archDBInfo, const DBInfo& anaDBInfo);
@@ -84,9 +106,10 @@ namespace spikestream {
 
 			//=========================  METHODS  ===========================
 			void clearError();
-			int getNextTimeStep();
-			void startAnalysisTimeStepThread(int timeStep);
-			bool subThreadsRunning();
+			void deleteWorkers();
+			void startWorkers();
+			void stopWorkers();
+			void waitForWorkers();
 	};
 
 }
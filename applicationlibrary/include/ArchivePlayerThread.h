@@ -5,6 +5,7 @@
 #include "ArchiveDao.h"
 #include "DBInfo.h"
 #include "RGBColor.h"
+#include "SpikeFrame.h"
 using namespace spikestream;
 
 //Qt includes
@@ -31,7 +32,7 @@ namespace spikestream {
 			void stop();
 
 		signals:
-			void timeStepChanged(unsigned timeStep, const QList<unsigned>& neuronIDList);
+			void timeStepChanged(const SpikeFramePtr& spikeFrame);
 
 		private slots:
 			void run();
@@ -41,7 +41,7 @@ namespace spikestream{
 			void stopButtonPressed();
 			void frameRateComboChanged(int);
 			void setArchiveProperties();
-			void updateTimeStep(unsigned timeStep, const QList<unsigned>& neuronIDList);
+			void updateTimeStep(const SpikeFramePtr& spikeFrame);
 
 
 		private:
@@ -9,24 +9,36 @@ using namespace spikestream;
 #include <QAbstractTableModel>
 #include <QList>
 
+//Other includes
+#include <vector>
+using namespace std;
+
 namespace spikestream {
 
-	/*! Model for displaying connection groups. Based on the ConnectionGroups table in the
-		SpikeStreamNetwork database. Uses the connections list that is held in the
-		NetworkDisplay class and populated by the NetworkViewer when it renders the connections. */
+	/*! Model for displaying the connections that are visible in the network viewer.
+		Each row holds an index into the list of visible connections in the NetworkDisplay class, which is
+		populated by the NetworkViewer when it selects the connections, and the data is read from the connection
+		groups that store the connections. The rows can be filtered and sorted without copying the connections.
+		When the weights change only the weight columns are updated. */
 	class ConnectionsModel : public QAbstractTableModel {
 		Q_OBJECT
 
 		public:
 			ConnectionsModel();
 			~ConnectionsModel();
+			void clearWeightFilter();
 			int columnCount(const QModelIndex& parent = QModelIndex()) const;
 			QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
 			QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
 			int rowCount(const QModelIndex& parent = QModelIndex()) const;
+			void setFromNeuronFilter(unsigned int neuronID);
+			void setToNeuronFilter(unsigned int neuronID);
+			void setWeightFilter(float minWeight, float maxWeight);
+			void sort(int column, Qt::SortOrder order = Qt::AscendingOrder);
 
 		private slots:
 			void visibleConnectionsChanged();
+			void weightsChanged();
 
 		private:
 			//====================  VARIABLES  ====================
@@ -38,10 +50,38 @@ namespace spikestream {
 			static const int weightCol = 4;
 			static const int tmpWeightCol = 5;
 
+			/*! Index in the list of visible connections of the connection in each row */
+			vector<int> rowIndexVector;
+
+			/*! Column that the rows are sorted by. The rows are in the order of the list of visible connections when this is -1 */
+			int sortColumn;
+
+			/*! Order in which the rows are sorted */
+			Qt::SortOrder sortOrder;
+
+			/*! Only connections from this neuron are shown. Connections from all neurons are shown when this is 0 */
+			unsigned int fromNeuronFilter;
+
+			/*! Only connections to this neuron are shown. Connections to all neurons are shown when this is 0 */
+			unsigned int toNeuronFilter;
+
+			/*! Records whether connections are filtered by weight */
+			bool weightFilterSet;
+
+			/*! Connections with weights below this are hidden when the weight filter is set */
+			float minWeightFilter;
+
+			/*! Connections with weights above this are hidden when the weight filter is set */
+			float maxWeightFilter;
+
 			//=====================  METHODS  ======================
+			bool filterConnection(Connection* connection) const;
+			Connection* getConnection(int visibleIndex) const;
+			double getSortValue(Connection* connection) const;
+			void loadRows();
+			void sortRows();
     };
 
 }
 
 #endif//CONNECTIONSMODEL_H
-
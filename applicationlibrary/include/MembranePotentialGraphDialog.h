@@ -7,6 +7,7 @@
 
 //Qt includes
 #include <QDialog>
+#include <QHash>
 
 namespace spikestream {
 
@@ -16,7 +17,8 @@ namespace spikestream {
 		public:
 			MembranePotentialGraphDialog(neurid_t neuronID, QWidget* parent = 0);
 			~MembranePotentialGraphDialog();
-			void addData(float membranePotential, timestep_t timeStep);
+			void addData(const QHash<unsigned, float>& membranePotentialMap, timestep_t timeStep);
+			void addNeuron(neurid_t neuronID);
 
 
 		private:
@@ -6,37 +6,60 @@
 #include "SpikeStreamTypes.h"
 
 //Qt includes
+#include <QHash>
 #include <QWidget>
 
+//Other includes
+#include <vector>
+using namespace std;
+
 namespace spikestream {
 
+	/*! Plots the membrane potential of one or more neurons. The potentials of each neuron are held in a ring buffer
+		with one entry for each time step on the X axis. The traces are drawn at the resolution of the widget,
+		with a line between the lowest and highest potential of the time steps that fall in each pixel column. */
 	class MembranePotentialGraphWidget : public AbstractGraphWidget {
 		Q_OBJECT
 
 		public:
 			MembranePotentialGraphWidget(QWidget* parent=0);
 			~MembranePotentialGraphWidget();
-			void addData(float membranePotential, timestep_t timeStep);
+			void addData(const QHash<unsigned, float>& membranePotentialMap, timestep_t timeStep);
+			void addNeuron(neurid_t neuronID);
+			const vector<neurid_t>& getNeuronIDs() { return neuronIDVector; }
 			virtual void paintLabels(QPainter& painter);
 			virtual void paintData(QPainter& painter);
 
+		protected:
+			QImage getPlotImage();
+			void paintEvent(QPaintEvent* event);
+
 
 		private:
 			//=====================  VARIABLES  ======================
-			/*! Color of plot curve */
-			QRgb plotColor;
+			/*! IDs of the neurons whose membrane potential is plotted */
+			vector<neurid_t> neuronIDVector;
+
+			/*! Color of the trace of each neuron */
+			vector<QRgb> traceColorVector;
 
-			/*! Old X location to draw lines */
-			int oldXPos;
+			/*! Membrane potential of each neuron at each time step. Each neuron has a block of entries,
+				one for each time step on the X axis, which is written at the time step modulus the number of time steps */
+			vector<float> potentialVector;
 
-			/*! Old Y location to draw lines */
-			int oldYPos;
+			/*! Time step of each entry in the potential vector. An entry is only plotted if its
+				time step is in the current range of the X axis. */
+			vector<timestep_t> sampleTimeStepVector;
 
-			int newXPos;
+			/*! Most recent time step that has been added. -1 if no data has been added */
+			timestep_t lastTimeStep;
 
-			int newYPos;
+			/*! Axes and labels scaled to the size of the widget */
+			QImage scaledImage;
 
 
+			//=======================  METHODS  ======================
+			int getWidgetY(float membranePotential);
 	};
 }
 
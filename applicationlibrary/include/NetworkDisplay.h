@@ -12,8 +12,25 @@ using namespace spikestream;
 #include <QList>
 #include <QMutex>
 
+//Other includes
+#include <vector>
+using namespace std;
+
 namespace spikestream {
 
+	/*! Locates a visible connection in the connection group that stores it */
+	struct VisibleConnection {
+		/*! ID of the connection group holding the connection */
+		unsigned int connectionGroupID;
+
+		/*! Index of the connection in the connection group */
+		unsigned int index;
+
+		bool operator==(const VisibleConnection& rhs) const { return connectionGroupID == rhs.connectionGroupID && index == rhs.index; }
+		bool operator!=(const VisibleConnection& rhs) const { return !(*this == rhs); }
+	};
+
+
 	/*! Holds display information about the current network in global scope,
 		including which neuron and connection groups are displayed, colours etc. */
 	class NetworkDisplay : public QObject {
@@ -25,11 +42,16 @@ namespace spikestream {
 			void addDefaultColor(RGBColor* color);
 			void addHighlightNeurons(const QList<unsigned int>& neuronIDs, RGBColor* color);
 			void addHighlightNeurons(const QHash< unsigned int, RGBColor*>& colorMap);
+			unsigned char addPaletteColor(const RGBColor& color);
+			void clearNeuronColorIndexes();
+			void clearNeuronColors();
 			void removeHighlightNeurons(const QList<unsigned int>& neuronIDs);
 			bool connectionGroupVisible(unsigned int connGrpID);
 			unsigned int getConnectionMode() { return connectionMode; }
 			unsigned getConnectionQuality() { return connectionQuality; }
 			unsigned getConnectionThinningThreshold();
+			const vector<unsigned int>& getColoredNeuronIDs() { return coloredNeuronIDVector; }
+			unsigned char getNeuronColorIndex(unsigned int neuronID);
 			QHash<unsigned int, RGBColor*>& getNeuronColorMap() { return *neuronColorMap; }
 			RGBColor* getDefaultNeuronColor() { return &defaultNeuronColor; }
 			RGBColor* getDefaultNeuronColorFullRender() { return &defaultNeuronColorFullRender; }
@@ -41,12 +63,13 @@ namespace spikestream {
 			RGBColor& getToNeuronColor() { return toNeuronColor; }
 			RGBColor* getNegativeConnectionColor(){ return &negativeConnectionColor; }
 			float getNeuronTransparency() { return neuronTransparency; }
+			const RGBColor& getPaletteColor(unsigned char colorIndex) { return paletteVector[colorIndex]; }
 			RGBColor* getPositiveConnectionColor(){ return &positiveConnectionColor; }
 			unsigned getSphereQuality() { return sphereQuality; }
 			float getSphereRadius() { return sphereRadius; }
 			float getVertexSize() { return vertexSize; }
 			QList<unsigned int> getVisibleConnectionGroupIDs() { return connGrpDisplayMap.keys(); }
-			QList<Connection*>& getVisibleConnectionsList() { return visibleConnectionsList; }
+			vector<VisibleConnection>& getVisibleConnections() { return visibleConnectionVector; }
 			QList<unsigned int> getVisibleNeuronGroupIDs() { return neurGrpDisplayMap.keys(); }
 			float getWeightRadiusFactor() { return weightRadiusFactor; }
 			unsigned getWeightRenderMode() { return weightRenderMode; }
@@ -57,6 +80,7 @@ namespace spikestream {
 			bool isZoomEnabled();
 			void loadDisplaySettings(ConfigLoader* configLoader);
 			void lockMutex();
+			void neuronColorsChanged();
 			bool neuronGroupVisible(unsigned int neurGrpID);
 			void disableWeightRender();
 			void renderTempWeights();
@@ -66,7 +90,7 @@ namespace spikestream {
 			void setConnectionGroupVisibility(unsigned int conGrpID, bool visible);
 			void setDefaultNeuronColor(RGBColor& color) { defaultNeuronColor = color; }
 			void setFullRenderMode(bool fullRenderMode);
-			void setNeuronColorMap(QHash<unsigned int, RGBColor*>* newMap);
+			void setNeuronColorIndex(unsigned int neuronID, unsigned char colorIndex);
 			void setNeuronGroupVisibility(unsigned int neurGrpID, bool visible);
 			void setNeuronTransparency(float neuronTransparency);
 			void setVisibleConnectionGroupIDs(const QList<unsigned int>& connGrpIDs, bool emitDisplayChangedSignal = true);
@@ -121,9 +145,27 @@ namespace spikestream {
 			/*! Visible neuron groups */
 			QHash<unsigned int, bool> neurGrpDisplayMap;
 
-			/*! Map specifying the color of each neuron */
+			/*! Map specifying the color of each highlighted neuron */
 			QHash<unsigned int, RGBColor*>* neuronColorMap;
 
+			/*! Index in the palette of the colour of each neuron, which is used to show the state of the neurons
+				during simulation and archive playback. The neuron with ID neuronColorIndexStartID + i is at
+				position i and index 0 means that the neuron is not coloured. The array is reused between time
+				steps and is only accessed from the GUI thread. */
+			unsigned char* neuronColorIndexArray;
+
+			/*! ID of the neuron at the start of the colour index array */
+			unsigned int neuronColorIndexStartID;
+
+			/*! Number of entries in the colour index array */
+			unsigned int neuronColorIndexArraySize;
+
+			/*! IDs of the neurons that have been given a colour index since the indexes were last cleared */
+			vector<unsigned int> coloredNeuronIDVector;
+
+			/*! Colours that neurons can be set to with a colour index. Entry 0 is unused. */
+			vector<RGBColor> paletteVector;
+
 			/*! Default color of a neuron */
 			RGBColor defaultNeuronColor;
 
@@ -221,20 +263,41 @@ namespace spikestream {
 				in full render mode. */
 			unsigned connectionThinningThreshold_full;
 
-			/*! List of the currently visible connections -
+			/*! Locations of the currently visible connections in their connection groups -
 				Loaded by NetworkViewer and used when in single connectiosn mode */
-			QList<Connection*> visibleConnectionsList;
+			vector<VisibleConnection> visibleConnectionVector;
 
 
 			//=========================  METHODS  =========================
 			void checkConnectionModeFlag(unsigned int flag);
 			void checkWeightRenderFlag(unsigned int flag);
 			void clearNeuronColorMap();
+			void resizeNeuronColorIndexes(unsigned int minNeuronID, unsigned int maxNeuronID);
 			void setDefaultVisibleConnectionGroupIDs();
 			void setWeightRenderFlag(unsigned flag);
 			void unsetWeightRenderFlag(unsigned flag);
 	};
 
+
+	/*! Returns the index in the palette of the neuron's colour, or 0 if the neuron is not coloured */
+	inline unsigned char NetworkDisplay::getNeuronColorIndex(unsigned int neuronID){
+		if(neuronID < neuronColorIndexStartID || neuronID - neuronColorIndexStartID >= neuronColorIndexArraySize)
+			return 0;
+		return neuronColorIndexArray[neuronID - neuronColorIndexStartID];
+	}
+
+
+	/*! Sets the neuron to the colour at the specified index in the palette. Call neuronColorsChanged()
+		once all of the neurons have been set to update the display. */
+	inline void NetworkDisplay::setNeuronColorIndex(unsigned int neuronID, unsigned char colorIndex){
+		if(neuronID < neuronColorIndexStartID || neuronID - neuronColorIndexStartID >= neuronColorIndexArraySize)
+			resizeNeuronColorIndexes(neuronID, neuronID);
+		unsigned char& neuronColorIndex = neuronColorIndexArray[neuronID - neuronColorIndexStartID];
+		if(neuronColorIndex == 0 && colorIndex != 0)
+			coloredNeuronIDVector.push_back(neuronID);
+		neuronColorIndex = colorIndex;
+	}
+
 }
 
 #endif//NETWORKDISPLAY_H
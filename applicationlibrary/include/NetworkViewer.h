@@ -3,14 +3,25 @@
 
 //SpikeStream includes
 #include "Box.h"
+#include "RGBColor.h"
 
 //Qt includes
 #include <qgl.h>
+#include <QGLBuffer>
 #include <QHash>
 
+//Other includes
+#include <vector>
+using namespace std;
+
 namespace spikestream {
 
-	/*! Draws the current network in 3D using OpenGL. */
+	/*! Draws the current network in 3D using OpenGL.
+		The positions of the visible neurons and connections are stored in vertex arrays, which are built
+		when the network or the visible groups change. Changes to firing or weights only update the colour
+		arrays. The arrays are copied to vertex buffer objects when these are supported.
+		In full render mode the neurons are drawn as textured point sprites and the weighted
+		connections as a single mesh of cones, so that large networks can be drawn in one batch. */
 	class NetworkViewer : public QGLWidget  {
 		Q_OBJECT
 
@@ -53,6 +64,10 @@ namespace spikestream {
 
 
 		private:
+			//========================  TYPES  ===========================
+			/*! Signature of glPointParameterfv */
+			typedef void (APIENTRY *PointParameterfvFunction)(GLenum pname, const GLfloat* params);
+
 			//=======================  VARIABLES  ========================
 			/*! Reference to the display list for the axes.*/
 			GLuint axesDisplayList;
@@ -60,21 +75,165 @@ namespace spikestream {
 			/*! Determines whether the stored display list should be used or a new one generated.*/
 			bool useAxesDisplayList;
 
-			/*! Reference to the display list for the neurons.*/
-			GLuint neuronsDisplayList;
+			/*! Visible neuron groups whose neurons are stored in the neuron arrays */
+			QList<unsigned int> neuronArrayGroupIDs;
+
+			/*! Number of neurons in the neuron arrays */
+			int numberOfNeurons;
+
+			/*! Position of each neuron, with three values per neuron */
+			GLfloat* neuronVertexArray;
+
+			/*! Colour of each neuron, with four values per neuron */
+			GLubyte* neuronColorArray;
+
+			/*! ID of each neuron, used to name the neurons when a neuron is selected */
+			unsigned int* neuronIDArray;
+
+			/*! Position of each neuron in the neuron arrays */
+			QHash<unsigned int, int> neuronIndexMap;
+
+			/*! Set to true when the neuron arrays have to be rebuilt */
+			bool rebuildNeuronArrays;
+
+			/*! Set to true when the colours of the neurons have to be updated */
+			bool updateNeuronColors;
+
+			/*! Set to true when the colours of all the neurons have to be filled in, rather than just those that have changed */
+			bool refillNeuronColors;
+
+			/*! Indexes of the neurons whose colours were set from the colour indexes or the neuron colour map at the last update */
+			QList<int> coloredNeuronIndexList;
+
+			/*! Transparency of the neurons at the last update of the neuron colours */
+			float lastNeuronAlpha;
+
+			/*! Default colour of the neurons at the last update of the neuron colours */
+			RGBColor lastDefaultNeuronColor;
+
+			/*! Visible connection groups whose connections are stored in the connection arrays */
+			QList<unsigned int> connectionArrayGroupIDs;
+
+			/*! Number of connections in the connection arrays */
+			int numberOfConnections;
+
+			/*! Positions of the from and to neurons of each connection, with six values per connection */
+			GLfloat* connectionVertexArray;
+
+			/*! Colour of each connection, with three values for each of its two vertices */
+			GLubyte* connectionColorArray;
+
+			/*! Weight of each connection, used to draw weighted connections in full render mode */
+			float* connectionWeightArray;
+
+			/*! Indexes of the vertices of the connections that are drawn, with two indexes per connection */
+			GLuint* connectionIndexArray;
+
+			/*! Number of connections in connectionIndexArray */
+			int numberOfVisibleConnections;
+
+			/*! Number of buckets that the connections are sorted into. Each bucket is a cell of a grid over the connections */
+			int numberOfBuckets;
+
+			/*! The connections in bucket i are listed in bucketConnectionArray from bucketStartArray[i] up to, but
+				not including, bucketStartArray[i+1]. The array has numberOfBuckets + 1 entries. */
+			int* bucketStartArray;
+
+			/*! Indexes of the connections in each bucket, sorted in order of rank */
+			int* bucketConnectionArray;
+
+			/*! Number of connections at the start of each bucket that are shown after thinning */
+			int* bucketSelectedArray;
+
+			/*! Bounding box of the connections in each bucket, stored as the minimum and then the maximum x, y and z */
+			float* bucketBoxArray;
 
-			/*! Controls whether the neuron display list should be used or a new one generated. */
-			GLuint useNeuronsDisplayList;
+			/*! All of the connections in a bucket are drawn when it is closer than this distance */
+			float lodDistance;
 
-			/*! Reference to the display list for the connections.*/
-			GLuint connectionsDisplayList;
+			/*! Connection groups are drawn as bundles when the centre of the network is further than this distance */
+			float bundleDistance;
 
-			/*! Controls whether the connections display list should be used or a new one generated. */
-			GLuint useConnectionsDisplayList;
+			/*! Centre of the bounding box of the connections */
+			float networkCentre[3];
+
+			/*! Number of bundles, one for each connection group in the connection arrays */
+			int numberOfBundles;
+
+			/*! Average positions of the from and to neurons of each bundle, with six values per bundle */
+			GLfloat* bundleVertexArray;
+
+			/*! Colour of each bundle, with three values per bundle */
+			GLubyte* bundleColorArray;
+
+			/*! Number of connections in each bundle */
+			int* bundleSizeArray;
+
+			/*! Set to true when the connection arrays have to be rebuilt */
+			bool rebuildConnectionArrays;
+
+			/*! Set to true when the colours and weights of the connections have to be updated */
+			bool updateConnectionColors;
+
+			/*! Set to true when the connections that are drawn have to be selected again */
+			bool selectConnections;
+
+			/*! Records whether the arrays are copied to vertex buffer objects on the graphics card */
+			bool useVertexBuffers;
+
+			/*! Buffer holding the neuron positions when vertex buffers are used */
+			QGLBuffer neuronVertexBuffer;
+
+			/*! Buffer holding the neuron colours when vertex buffers are used */
+			QGLBuffer neuronColorBuffer;
+
+			/*! Buffer holding the connection positions when vertex buffers are used */
+			QGLBuffer connectionVertexBuffer;
+
+			/*! Buffer holding the connection colours when vertex buffers are used */
+			QGLBuffer connectionColorBuffer;
 
 			/*! Reference to the display list for drawing spheres. */
 			GLuint sphereDisplayList;
 
+			/*! Records whether spheres are drawn as textured point sprites in full render mode.
+				Otherwise the display list is called for each neuron. */
+			bool usePointSprites;
+
+			/*! Texture holding the image of a lit sphere that is applied to the point sprites */
+			GLuint sphereTexture;
+
+			/*! Sets the distance attenuation of the point sprites. Loaded from the OpenGL driver because
+				it is not part of OpenGL 1.1 */
+			PointParameterfvFunction pointParameterfv;
+
+			/*! Positions of the vertices of the cones used to draw weighted connections in full render mode.
+				Only the visible connections that are thick enough are drawn as cones. Each of these has two cones
+				meeting at its midpoint, and each cone has a vertex at its tip followed by the vertices around its base. */
+			vector<GLfloat> coneVertexVector;
+
+			/*! Normal of each vertex in the cone vertex vector */
+			vector<GLfloat> coneNormalVector;
+
+			/*! Colour of each vertex in the cone vertex vector, with three values per vertex */
+			vector<GLubyte> coneColorVector;
+
+			/*! Indexes of the triangles of the cones */
+			vector<GLuint> coneIndexVector;
+
+			/*! Indexes of the vertices of the visible weighted connections that are too thin to be drawn as cones */
+			vector<GLuint> lineIndexVector;
+
+			/*! Indexes of the vertices of the visible connections when the cones were built.
+				The cones are rebuilt when the visible connections change. */
+			vector<GLuint> coneConnectionIndexVector;
+
+			/*! Number of vertices around the base of each cone */
+			int coneSegments;
+
+			/*! Set to true when the cones have to be rebuilt */
+			bool rebuildConeMesh;
+
 			/*! Cancels render.*/
 			bool cancelRender;
 
@@ -125,16 +284,13 @@ namespace spikestream {
 			/*! Object used to draw a sphere */
 			GLUquadricObj* gluSphereObj;
 
-			/*! Object used to draw a cone */
-			GLUquadricObj* gluConeObj;
-
-			/*! Factor by which weight is multiplied to obtain thickness */
+			/*! Factor by which weight is multiplied to obtain thickness when the cones were built */
 			float weightRadiusFactor;
 
-			/*! Minimum thickness of a connection */
+			/*! Minimum thickness of a connection when the cones were built */
 			float minimumConnectionRadius;
 
-			/*! Quality of the cones used to render a weighted connection */
+			/*! Quality of the cones used to render a weighted connection when the cones were built */
 			unsigned connectionQuality;
 
 			/*! Map holding IDs of all neurons with a connection to them.
@@ -143,23 +299,46 @@ namespace spikestream {
 
 
 			//======================  METHODS  ===========================
+			const GLvoid* bindBuffer(QGLBuffer& buffer, const GLvoid* array);
+			void buildConnectionArrays(const QList<unsigned int>& conGrpIDs);
+			void buildConeMesh();
+			void buildConnectionGrid();
+			void buildNeuronArrays(const QList<unsigned int>& neuronGrpIDs);
+			void buildSphereTexture();
 			void checkOpenGLErrors();
+			void deleteConeMesh();
+			void deleteConnectionArrays();
+			void deleteNeuronArrays();
 			void disableFullRender();
 			void drawAxes();
+			void drawConnectionBundles();
 			void drawConnections();
+			void drawNeuronNames();
 			void drawNeurons();
 			void drawSphere(float xPos, float yPos, float zPos);
-			void drawWeightedConnection(float x1, float y1, float z1, float x2, float y2, float z2, float weight);
+			void drawSphereSprites();
+			void drawWeightedConnections();
+			void fillConnectionColors();
+			void fillConnectionIndexArray();
+			void fillNeuronColors();
 			void fillRotationMatrix(float angle, float x, float y, float z);
+			float getConnectionRank(int conIndex);
 			unsigned int getSelectedNeuron(GLuint selectBuffer[], int hitCount, int bufferSize);
 			void initialiseCameraParameters();
 			void initialiseFullRender();
 			void loadDefaultClippingVolume();
 			void positionCamera();
+			void prepareNeuronArrays();
 			void rotateVector(GLfloat x, GLfloat y, GLfloat z, GLfloat result[]);
 			void rotateXAxis(float angle);
 			void rotateZAxis(float angle);
+			bool selectLevelOfDetail();
+			void setConnectionColor(int index, const RGBColor& color);
+			void setNeuronColor(int index, const RGBColor& color, float alpha);
 			void setZoomLevel();
+			void sortConnectionBuckets();
+			void uploadBuffer(QGLBuffer& buffer, const GLvoid* array, int numBytes);
+			void uploadBufferRange(QGLBuffer& buffer, const GLvoid* array, int offsetBytes, int numBytes);
 			void zoomDefaultView();
 			void zoomAboveNeuronGroup(unsigned int neuronGroupID);
 			void zoomToNeuronGroup(unsigned int neuronGroupID);
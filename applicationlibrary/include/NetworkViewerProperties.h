@@ -2,6 +2,7 @@
 #define NETWORKVIEWERPROPERTIES
 
 //SpikeStream includes
+#include "ConnectionsModel.h"
 #include "TruthTableDialog.h"
 using namespace spikestream;
 
@@ -9,6 +10,7 @@ using namespace spikestream;
 #include <QCheckBox>
 #include <QComboBox>
 #include <QLabel>
+#include <QLineEdit>
 #include <QSlider>
 #include <QWidget>
 #include <QRadioButton>
@@ -32,6 +34,7 @@ namespace spikestream {
 			void posNegSelectionChanged(int index);
 			void setRenderMode();
 			void showTruthTable();
+			void tableFilterChanged();
 			void updateConnectionCount();
 			void weightDisplayChanged(int buttonID);
 
@@ -67,6 +70,21 @@ namespace spikestream {
 			/*! Keep reference to label saying "to" to enable and disable it */
 			QLabel* toLabel;
 
+			/*! Model for the table of visible connections */
+			ConnectionsModel* connectionsModel;
+
+			/*! Filters the table to connections from a neuron */
+			QLineEdit* fromFilterLineEdit;
+
+			/*! Filters the table to connections to a neuron */
+			QLineEdit* toFilterLineEdit;
+
+			/*! Filters the table to connections with weights above a value */
+			QLineEdit* minWeightFilterLineEdit;
+
+			/*! Filters the table to connections with weights below a value */
+			QLineEdit* maxWeightFilterLineEdit;
+
 			/*! Label listing number of connections in table */
 			QLabel* numberOfConnectionsLabel;
 
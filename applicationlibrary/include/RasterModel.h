@@ -0,0 +1,113 @@
+#ifndef RASTERMODEL_H
+#define RASTERMODEL_H
+
+//SpikeStream includes
+#include "NeuronGroup.h"
+#include "SpikeFrame.h"
+
+//Qwt includes
+#include "qwt_raster_data.h"
+#include "qwt_double_interval.h"
+
+//Qt includes
+#include <QHash>
+
+//Other includes
+#include <vector>
+using namespace std;
+
+
+namespace spikestream {
+
+	/*! Spike counts at one of the reduced resolutions of the raster model.
+		Each column covers a number of time steps and is divided into tiles that each cover a number of rows.
+		The columns are held in a ring so that the newest column replaces the oldest one. */
+	struct RasterTileLevel {
+		/*! Number of time steps covered by each column */
+		int timeStepsPerColumn;
+
+		/*! Number of rows covered by each tile */
+		int rowsPerTile;
+
+		/*! Number of tiles in each column */
+		int numTiles;
+
+		/*! Number of the newest column counted from time step 0. -1 if no data has been added */
+		int lastColumn;
+
+		/*! Number of spikes in each tile, stored one column after another */
+		vector<unsigned> countVector;
+	};
+
+
+	/*! Class holding spiking data that is used to plot the raster.
+		The most recent time steps are held at full resolution. Older data is held as spike counts in tiles
+		that cover progressively more time steps and neurons, so the memory used by the model does not grow
+		during long simulations and a zoomed out plot reads one tile per pixel. */
+	class RasterModel : public QwtRasterData {
+		public:
+			RasterModel(QList<NeuronGroup*>& neuronGroupList);
+			~RasterModel();
+			void addData(const SpikeFrame& spikeFrame);
+			QwtRasterData *copy() const;
+			int getHistoryMinX();
+			int getMinX();
+			int getMaxX();
+			int getMinY();
+			int getMaxY();
+			void initRaster(const QwtDoubleRect& area, const QSize& raster);
+			QwtDoubleInterval range() const;
+			double value(double x, double y) const;
+
+		private:
+			//====================  VARIABLES  ====================
+			/*! List of neuron groups that are being monitored */
+			QList<NeuronGroup*> neuronGroupList;
+
+			/*! Lowest neuron ID in the neuron groups that are being monitored */
+			unsigned minNeuronID;
+
+			/*! Row of each neuron, indexed by the neuron ID minus the lowest neuron ID.
+				Contains -1 for IDs that are not in the neuron groups that are being monitored. */
+			vector<int> neuronRowVector;
+
+			/*! Sorted rows of the neurons that fired at each of the recent time steps.
+				The time steps are stored in a rotational manner at the time step modulus the number of time steps. */
+			vector< vector<unsigned> > spikeRowVector;
+
+			/*! Spike counts at reduced resolutions, starting with the finest */
+			vector<RasterTileLevel> tileLevelVector;
+
+			/*! Number of time steps held at full resolution, which is also the number of columns in each tile level */
+			int numTimeSteps;
+
+			/*! Most recent time step that has been added. -1 if no data has been added */
+			int lastTimeStep;
+
+			/*! The time step value corresponding to the data index. */
+			unsigned minTimeStep;
+
+			/*! Maximum neuronID. Calcuated from neuron groups. */
+			unsigned maxNeuronID;
+
+			/*! Resolution used to answer requests for values. 0 is full resolution; higher values are
+				one more than the index of the tile level. Selected when the raster is initialized. */
+			int displayLevel;
+
+			/*! Number of tile levels */
+			static const int NUMBER_OF_TILE_LEVELS = 5;
+
+			/*! Each tile level covers this many times more time steps per column than the previous one */
+			static const int TIME_STEP_FACTOR = 10;
+
+			/*! Maximum number of tiles in each column of a tile level */
+			static const int MAX_TILES_PER_COLUMN = 512;
+
+			//=====================  METHODS  =====================
+			void clearData();
+			bool levelContains(int level, int timeStep) const;
+	};
+
+}
+
+#endif//RASTERMODEL_H
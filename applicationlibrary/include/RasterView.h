@@ -7,11 +7,13 @@
 //Qwt includes
 #include "qwt_plot.h"
 #include "qwt_plot_spectrogram.h"
+#include "qwt_plot_zoomer.h"
 
 
 namespace spikestream {
 
-	/*! Displays a spike raster using the supplied data.*/
+	/*! Displays a spike raster using the supplied data.
+		The plot shows the whole history held by the model and the zoomer is used to look at part of it. */
 	class RasterView : public QwtPlot {
 		Q_OBJECT
 
@@ -28,6 +30,10 @@ namespace spikestream {
 
 			/*! Model containing the data */
 			RasterModel* rasterModel;
+
+			/*! Zooms into part of the history. Left button zooms in, right button zooms out by one step
+				and control + right button zooms out to the whole history */
+			QwtPlotZoomer* zoomer;
 	};
 
 }
@@ -3,28 +3,52 @@
 
 //SpikeStream includes
 #include "NeuronGroup.h"
+#include "RasterModel.h"
+#include "RasterView.h"
+#include "SpikeFrame.h"
 #include "SpikeRasterWidget.h"
 
 //Qt includes
 #include <QDialog>
+#include <QTabWidget>
+#include <QTimer>
 
 namespace spikestream {
 
+	/*! Shows the firing of the neuron groups. The recent tab plots the most recent time steps as they
+		arrive; the history tab plots the whole of a long simulation from a multi-resolution model and
+		is redrawn at intervals while it is visible. */
 	class SpikeRasterDialog : public QDialog {
 		Q_OBJECT
 
 		public:
 			SpikeRasterDialog(QList<NeuronGroup*> neuronGroupList, QWidget* parent = 0);
 			~SpikeRasterDialog();
-			void addData(const QList<unsigned>& firingNeuronIDs, unsigned timeStep);
+			void addData(const SpikeFrame& spikeFrame);
 
 		private slots:
 			void colorComboChanged(int index);
+			void updateHistory();
 
 		private:
 			//====================  VARIABLES  ======================
 			SpikeRasterWidget* spikeRasterWidget;
 
+			/*! Tabs holding the recent and the history plots */
+			QTabWidget* tabWidget;
+
+			/*! Holds the history of the firing. Owned by the spectrogram in rasterView, which deletes it. */
+			RasterModel* rasterModel;
+
+			/*! Plots the history of the firing */
+			RasterView* rasterView;
+
+			/*! Redraws the history plot at intervals */
+			QTimer* historyTimer;
+
+			/*! Set when data has been added since the history plot was last redrawn */
+			bool historyChanged;
+
 	};
 
 }
@@ -3,6 +3,7 @@
 
 //SpikeStream includes
 #include "NeuronGroup.h"
+#include "SpikeFrame.h"
 
 //Qt includes
 #include <QWidget>
@@ -11,16 +12,22 @@
 #include <QTime>
 #include <QPainter>
 
+//Other includes
+#include <vector>
+using namespace std;
+
 namespace spikestream {
 
-	/*! Plots raster of firing data. */
+	/*! Plots raster of firing data. The time steps are written into the columns of the image as a ring buffer,
+		so each time step only clears and fills one column and only the matching part of the scaled copy of the
+		image that is shown in the widget has to be redrawn. */
 	class SpikeRasterWidget : public QWidget {
 		Q_OBJECT
 
 		public :
 			SpikeRasterWidget(QList<NeuronGroup*>& neuronGroupList, QWidget* parent=0);
 			~SpikeRasterWidget();
-			void addSpikes(const QList<unsigned>& firingNeuronIDs, int timeStep);
+			void addSpikes(const SpikeFrame& spikeFrame);
 			void setBlackAndWhite(bool on);
 
 
@@ -46,6 +53,25 @@ namespace spikestream {
 			/*! Image onto which spikes and buffer are painted */
 			QImage* bufferImage;
 
+			/*! Copy of the buffer image scaled to the size of the widget */
+			QImage* scaledImage;
+
+			/*! Lowest neuron ID in the neuron groups that are being monitored */
+			unsigned minNeuronID;
+
+			/*! Row in the buffer image of each neuron, indexed by the neuron ID minus the lowest neuron ID.
+				Contains -1 for IDs that are not in the neuron groups that are being monitored. */
+			vector<int> neuronRowVector;
+
+			/*! Color of the spikes of each neuron, indexed in the same way as the rows */
+			vector<QRgb> neuronColorVector;
+
+			/*! Time step that was last added to the plot. -1 if no time steps have been added */
+			int lastTimeStep;
+
+			/*! Set when the whole of the scaled image has to be redrawn */
+			bool redrawAll;
+
 			/*! Number of time steps on the horizontal axis */
 			int numTimeSteps;
 
@@ -67,9 +93,6 @@ namespace spikestream {
 			/*! Height of the image */
 			int imageHeight;
 
-			/*! Flag to indicate whether painter should redraw axes */
-			bool updateAxes;
-
 			/*! Height of X axis above botton */
 			int xAxisPadding;
 
@@ -99,15 +122,19 @@ namespace spikestream {
 
 
 			//========================  METHODS  =======================
+			int advanceTimeStep(int timeStep);
+			void clearColumns(int firstX, int lastX);
+			void fillNeuronColors();
 			QString getFilePath(QString fileFilter);
 			QList<unsigned> getHueList(unsigned numItems);
-			void increaseTimeStep(int currentTimeStep);
+			void paintAxesAndNames();
 			void paintNeuronGroupNames(QPainter& painter);
 			void paintYAxis(QPainter&);
 			void paintYAxisTick(QPainter& painter, int yPos, int label);
 			void paintXAxis(QPainter&);
 			void paintXAxisTick(QPainter&, int xval, int xlable);
 			void paintAxes(QPainter&);
+			QRect scaleColumns(int firstX, int lastX);
 
 	};
 
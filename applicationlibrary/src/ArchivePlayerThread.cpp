@@ -113,14 +113,14 @@ void ArchivePlayerThread::run(){
 		startTime = QTime::currentTime();
 
 		try{
-			//Get string list of firing neuron ids
-			QList<unsigned> neuronIDList = archiveDao->getFiringNeuronIDs(archiveID, timeStep);
+			//Get the firing neuron ids and store them in a frame that is shared by all of the listening classes
+			SpikeFramePtr spikeFrame(new SpikeFrame(timeStep, archiveDao->getFiringNeuronIDs(archiveID, timeStep)));
 
 			//Set flag to true so that thread waits for graphics update before moving to next time step
 			waitForGraphics = true;
 
 			//Inform other classes that time step has changed
-			emit timeStepChanged(timeStep, neuronIDList);
+			emit timeStepChanged(spikeFrame);
 
 			//Increase time step and quit if we are at the maximum
 			++timeStep;
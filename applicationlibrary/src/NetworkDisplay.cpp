@@ -6,6 +6,10 @@
 #include "Util.h"
 using namespace spikestream;
 
+//Other includes
+#include <cstring>
+#include <stdint.h>
+
 
 /*! Constructor */
 NetworkDisplay::NetworkDisplay(){
@@ -42,6 +46,12 @@ NetworkDisplay::NetworkDisplay(){
 	//Initialize color map
 	neuronColorMap = new QHash<unsigned int, RGBColor*>();
 
+	//Colour indexes are allocated when a network is loaded. Entry 0 in the palette means that a neuron is not coloured.
+	neuronColorIndexArray = NULL;
+	neuronColorIndexStartID = 0;
+	neuronColorIndexArraySize = 0;
+	paletteVector.push_back(RGBColor());
+
 	//Default connection mode settings
 	connectionMode = 0;
 	weightRenderMode = 0;
@@ -62,6 +72,7 @@ NetworkDisplay::NetworkDisplay(){
 
 /*! Destructor */
 NetworkDisplay::~NetworkDisplay(){
+	delete [] neuronColorIndexArray;
 }
 
 
@@ -80,8 +91,23 @@ void NetworkDisplay::networkChanged(){
 	toNeuronID = 0;
 	zoomStatus = NO_ZOOM;
 	zoomNeuronGroupID = 0;
+	visibleConnectionVector.clear();
+	emit visibleConnectionsChanged();
+
+	//Size the colour indexes to hold the neurons in the new network
+	delete [] neuronColorIndexArray;
+	neuronColorIndexArray = NULL;
+	neuronColorIndexStartID = 0;
+	neuronColorIndexArraySize = 0;
+	coloredNeuronIDVector.clear();
 
 	if(Globals::networkLoaded()){
+		foreach(NeuronGroup* neurGrp, Globals::getNetwork()->getNeuronGroups()){
+			if(neurGrp->size() > 0)
+				resizeNeuronColorIndexes(neurGrp->getNeuronID(0), neurGrp->getNeuronID(neurGrp->size() - 1));
+		}
+
+
 		//Make the neuron groups visible by default
 		setVisibleNeuronGroupIDs(Globals::getNetwork()->getNeuronGroupIDs(), false);
 
@@ -172,8 +198,44 @@ void NetworkDisplay::addHighlightNeurons(const QHash<unsigned int, RGBColor*>& c
 }
 
 
+/*! Adds a colour to the palette of colours that neurons can be set to and returns its index.
+	Returns the existing index if the colour is already in the palette. */
+unsigned char NetworkDisplay::addPaletteColor(const RGBColor& color){
+	for(unsigned int i=1; i<paletteVector.size(); ++i){
+		if(paletteVector[i].red == color.red && paletteVector[i].green == color.green && paletteVector[i].blue == color.blue)
+			return i;
+	}
+	if(paletteVector.size() > 255)
+		throw SpikeStreamException("Neuron colour palette is full.");
+	paletteVector.push_back(color);
+	return paletteVector.size() - 1;
+}
+
+
+/*! Clears the colour index of every neuron that has one. Only the neurons that have been
+	coloured are visited, so the indexes can be cleared and set again at every time step. */
+void NetworkDisplay::clearNeuronColorIndexes(){
+	for(vector<unsigned int>::iterator iter = coloredNeuronIDVector.begin(); iter != coloredNeuronIDVector.end(); ++iter)
+		neuronColorIndexArray[*iter - neuronColorIndexStartID] = 0;
+	coloredNeuronIDVector.clear();
+}
+
+
+/*! Clears the highlighted neurons and the colour indexes and updates the display. */
+void NetworkDisplay::clearNeuronColors(){
+	//Obtain and lock the mutex
+	QMutexLocker locker(&mutex);
+
+	clearNeuronColorMap();
+	clearNeuronColorIndexes();
+
+	//Inform other classes that the display has changed
+	emit neuronGroupDisplayChanged();
+}
+
+
 /*! Returns the connection thinning threshold. Connection groups above this threshold
-	will be thinned out at random to improve render times.
+	will be thinned out to improve render times, with the same connections shown at every frame.
 	The value returned depends on the render mode. */
 unsigned NetworkDisplay::getConnectionThinningThreshold(){
 	if(fullRenderMode && (weightRenderMode & WEIGHT_RENDER_ENABLED))
@@ -208,6 +270,12 @@ bool NetworkDisplay::connectionGroupVisible(unsigned int conGrpID){
 }
 
 
+/*! Informs other classes that the colour indexes of the neurons have changed */
+void NetworkDisplay::neuronColorsChanged(){
+	emit neuronGroupDisplayChanged();
+}
+
+
 /*! Returns true if the specified neuron group is currently visible */
 bool NetworkDisplay::neuronGroupVisible(unsigned int neurGrpID){
 	if(neurGrpDisplayMap.contains(neurGrpID))
@@ -261,23 +329,6 @@ void NetworkDisplay::setFullRenderMode(bool fullRenderMode){
 }
 
 
-/*! Sets the map containing specified neuron colours */
-void NetworkDisplay::setNeuronColorMap(QHash<unsigned int, RGBColor*>* newMap){
-	//Obtain and lock the mutex
-	QMutexLocker locker(&mutex);
-
-	//Clear current entries and delete existing map
-	clearNeuronColorMap();
-	delete neuronColorMap;
-
-	//Point map to new map
-	neuronColorMap = newMap;
-
-	//Inform other classes that the display has changed
-	emit neuronGroupDisplayChanged();
-}
-
-
 /*! Sets the visibility of the specified neuron group */
 void NetworkDisplay::setNeuronGroupVisibility(unsigned int neurGrpID, bool visible){
 	if(visible){
@@ -427,7 +478,7 @@ void NetworkDisplay::setSelectedNeuronID(unsigned int id, bool ctrlBtnDown){
 
 	//Refresh display if something has changed
 	if(refreshDisplay){
-		visibleConnectionsList.clear();
+		visibleConnectionVector.clear();
 		emit visibleConnectionsChanged();
 		emit networkDisplayChanged();
 	}
@@ -526,6 +577,33 @@ void NetworkDisplay::clearNeuronColorMap(){
 }
 
 
+/*! Enlarges the colour index array so that it includes the neurons with IDs from minNeuronID to maxNeuronID.
+	Extra space is added above the requested range so that neurons added one at a time do not cause
+	the array to be copied every time. */
+void NetworkDisplay::resizeNeuronColorIndexes(unsigned int minNeuronID, unsigned int maxNeuronID){
+	//Work out the new range of IDs
+	unsigned int newStartID = minNeuronID;
+	uint64_t newEndID = (uint64_t)maxNeuronID + 1;
+	if(neuronColorIndexArraySize > 0){
+		newStartID = qMin(newStartID, neuronColorIndexStartID);
+		newEndID = qMax(newEndID, (uint64_t)neuronColorIndexStartID + neuronColorIndexArraySize);
+		if(maxNeuronID >= neuronColorIndexStartID + neuronColorIndexArraySize)
+			newEndID = qMin(newEndID + (newEndID - newStartID) / 2, (uint64_t)0xFFFFFFFFULL);
+	}
+	unsigned int newSize = newEndID - newStartID;
+
+	//Copy the current indexes into the new array
+	unsigned char* newArray = new unsigned char[newSize];
+	memset(newArray, 0, newSize);
+	if(neuronColorIndexArraySize > 0)
+		memcpy(newArray + (neuronColorIndexStartID - newStartID), neuronColorIndexArray, neuronColorIndexArraySize);
+	delete [] neuronColorIndexArray;
+	neuronColorIndexArray = newArray;
+	neuronColorIndexStartID = newStartID;
+	neuronColorIndexArraySize = newSize;
+}
+
+
 /*! Checks that a particular connection mode flag is valid and throws an exception if not */
 void NetworkDisplay::checkConnectionModeFlag(unsigned int flag){
 	if(flag == CONNECTION_MODE_ENABLED)
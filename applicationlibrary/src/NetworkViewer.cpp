@@ -10,8 +10,11 @@ using namespace spikestream;
 //Qt includes
 #include <QDebug>
 #include <QMouseEvent>
+#include <QPair>
 
 //Other includes
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 using namespace std;
 
@@ -28,6 +31,30 @@ using namespace std;
 #define gltDegToRad(x)	((x)*GLT_PI_DIV_180)
 #define gltRadToDeg(x)	((x)*GLT_INV_PI_DIV_180)
 
+/* Level of detail for connections. The grid has up to MAX_GRID_CELLS_PER_AXIS cells along each axis,
+	with about CONNECTIONS_PER_BUCKET connections in each cell. All of the connections in a cell are drawn
+	when it is closer than LOD_DISTANCE_FACTOR times the size of the network; beyond this the fraction drawn
+	falls with the square of the distance. Connection groups are drawn as bundles when the centre of the
+	network is further away than BUNDLE_DISTANCE_FACTOR times its size. */
+#define MAX_GRID_CELLS_PER_AXIS 16
+#define CONNECTIONS_PER_BUCKET 256
+#define LOD_DISTANCE_FACTOR 0.75f
+#define BUNDLE_DISTANCE_FACTOR 5.0f
+
+/* Width and height of the texture holding the image of a sphere */
+#define SPHERE_TEXTURE_SIZE 64
+
+/* Point sprite constants that are missing from OpenGL 1.1 headers */
+#ifndef GL_POINT_DISTANCE_ATTENUATION
+	#define GL_POINT_DISTANCE_ATTENUATION 0x8129
+#endif
+#ifndef GL_POINT_SPRITE
+	#define GL_POINT_SPRITE 0x8861
+#endif
+#ifndef GL_COORD_REPLACE
+	#define GL_COORD_REPLACE 0x8862
+#endif
+
 /* Light and material Data. */
 GLfloat fNoLight[] = { 0.0f, 0.0f, 0.0f, 0.0f };
 GLfloat fLowLight[] = { 0.25f, 0.25f, 0.25f, 1.0f };
@@ -51,8 +78,45 @@ NetworkViewer::NetworkViewer(QWidget* parent) : QGLWidget(parent) {
 	paintGLSkipped = false;
 	resizeGLSkipped = false;
 	useAxesDisplayList = false;
-	useNeuronsDisplayList = false;
-	useConnectionsDisplayList = false;
+	useVertexBuffers = false;
+	usePointSprites = false;
+	sphereTexture = 0;
+	pointParameterfv = NULL;
+
+	//Initialize the arrays holding the neurons and connections
+	numberOfNeurons = 0;
+	neuronVertexArray = NULL;
+	neuronColorArray = NULL;
+	neuronIDArray = NULL;
+	rebuildNeuronArrays = true;
+	updateNeuronColors = true;
+	refillNeuronColors = true;
+	lastNeuronAlpha = 1.0f;
+	numberOfConnections = 0;
+	numberOfVisibleConnections = 0;
+	connectionVertexArray = NULL;
+	connectionColorArray = NULL;
+	connectionWeightArray = NULL;
+	connectionIndexArray = NULL;
+	numberOfBundles = 0;
+	bundleVertexArray = NULL;
+	bundleColorArray = NULL;
+	bundleSizeArray = NULL;
+	numberOfBuckets = 0;
+	bucketStartArray = NULL;
+	bucketConnectionArray = NULL;
+	bucketSelectedArray = NULL;
+	bucketBoxArray = NULL;
+	lodDistance = 0.0f;
+	bundleDistance = 0.0f;
+	rebuildConnectionArrays = true;
+	updateConnectionColors = true;
+	selectConnections = true;
+	coneSegments = 0;
+	rebuildConeMesh = true;
+	weightRadiusFactor = 0.0f;
+	minimumConnectionRadius = 0.0f;
+	connectionQuality = 0;
 	perspective_angle = 46.0f;
 	perspective_near = 1.0f;
 	perspective_far = 100000.0f;//Set this to a large number so everything will be visible
@@ -81,6 +145,14 @@ NetworkViewer::NetworkViewer(QWidget* parent) : QGLWidget(parent) {
 
 /*! Destructor */
 NetworkViewer::~NetworkViewer(){
+	deleteNeuronArrays();
+	deleteConnectionArrays();
+
+	//Delete the sphere texture in the context that created it
+	if(sphereTexture != 0){
+		makeCurrent();
+		glDeleteTextures(1, &sphereTexture);
+	}
 }
 
 
@@ -96,12 +168,25 @@ void NetworkViewer::initializeGL(){
 	//Create IDs for display lists
 	axesDisplayList = glGenLists(1);
 	sphereDisplayList =  glGenLists(1);
-	neuronsDisplayList =  glGenLists(1);
-	connectionsDisplayList =  glGenLists(1);
+
+	//Use vertex buffer objects if they are supported, otherwise the arrays are drawn from client memory
+	useVertexBuffers = neuronVertexBuffer.create() && neuronColorBuffer.create() && connectionVertexBuffer.create() && connectionColorBuffer.create();
+	if(useVertexBuffers){
+		neuronColorBuffer.setUsagePattern(QGLBuffer::DynamicDraw);
+		connectionColorBuffer.setUsagePattern(QGLBuffer::DynamicDraw);
+	}
+
+	/* Draw spheres as point sprites if they are supported, otherwise the sphere display list is used.
+		The distance attenuation of the sprites needs glPointParameterfv from the point parameters extension */
+	const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+	if(extensions != NULL && strstr(extensions, "GL_ARB_point_sprite") != NULL && strstr(extensions, "GL_ARB_point_parameters") != NULL)
+		pointParameterfv = (PointParameterfvFunction)context()->getProcAddress("glPointParameterfv");
+	usePointSprites = pointParameterfv != NULL;
+	if(usePointSprites)
+		buildSphereTexture();
 
 	//Create objects
 	gluSphereObj = gluNewQuadric();
-	gluConeObj = gluNewQuadric();
 	gluQuadricDrawStyle(gluSphereObj, GLU_FILL);
 	gluQuadricNormals(gluSphereObj, GLU_SMOOTH);
 
@@ -261,7 +346,7 @@ void NetworkViewer::mouseDoubleClickEvent (QMouseEvent* event){
 	positionCamera();
 
 	//Draw the neurons
-	drawNeurons();
+	drawNeuronNames();
 
 	//Restore the matrix state
 	glPopMatrix();
@@ -377,24 +462,26 @@ void NetworkViewer::rotateRight(){
 }
 
 
-/*! Re-draws everything in the network */
+/*! Re-draws everything in the network. The visible groups are checked when the
+	network is drawn, so only the colours and visible connections need to be updated. */
 void NetworkViewer::refresh(){
-	useNeuronsDisplayList = false;
-	useConnectionsDisplayList = false;
+	updateNeuronColors = true;
+	updateConnectionColors = true;
+	selectConnections = true;
 	updateGL();
 }
 
 
 /*! Redraws the neurons */
 void NetworkViewer::refreshNeurons(){
-	useNeuronsDisplayList = false;
+	updateNeuronColors = true;
 	updateGL();
 }
 
 
 /*! Redraws the weights */
 void NetworkViewer::refreshConnections(){
-	useConnectionsDisplayList = false;
+	updateConnectionColors = true;
 	updateGL();
 }
 
@@ -407,9 +494,9 @@ void NetworkViewer::reset(){
 	//Look at this network horizontally
 	viewClippingVolume_Horizontal(defaultClippingVol);
 
-	//Network has changed so need to re-render the display list
-	useNeuronsDisplayList = false;
-	useConnectionsDisplayList = false;
+	//Network has changed so need to rebuild the arrays
+	rebuildNeuronArrays = true;
+	rebuildConnectionArrays = true;
 
 	//Re-draw
 	updateGL();
@@ -421,6 +508,368 @@ void NetworkViewer::reset(){
 /*-----                PRIVATE METHODS                 -----*/
 /*----------------------------------------------------------*/
 
+/*! Binds the buffer holding an array and returns the pointer that should be passed to OpenGL.
+	This is an offset into the buffer when vertex buffers are used, otherwise it is the array itself. */
+const GLvoid* NetworkViewer::bindBuffer(QGLBuffer& buffer, const GLvoid* array){
+	if(!useVertexBuffers)
+		return array;
+	buffer.bind();
+	return 0;
+}
+
+
+/*! Builds the cones that are used to draw the visible weighted connections in full render mode.
+	Connections that are too thin are drawn as lines instead. The vertices of all of the cones are
+	stored in one set of vectors so that they can be drawn with a single call. Cones are only built
+	for the connections that are drawn, so their memory does not grow with the size of the network. */
+void NetworkViewer::buildConeMesh(){
+	NetworkDisplay* netDisplay = Globals::getNetworkDisplay();
+	weightRadiusFactor = netDisplay->getWeightRadiusFactor();
+	minimumConnectionRadius = netDisplay->getMinimumConnectionRadius();
+	connectionQuality = netDisplay->getConnectionQuality();
+	coneSegments = qMax(connectionQuality, 3u);
+	int verticesPerConnection = 2 * (coneSegments + 1);
+	coneConnectionIndexVector.assign(connectionIndexArray, connectionIndexArray + numberOfVisibleConnections * 2);
+
+	//Decide which of the visible connections are drawn as cones
+	int numberOfConeConnections = 0;
+	lineIndexVector.clear();
+	for(int i=0; i<numberOfVisibleConnections; ++i){
+		if(weightRadiusFactor * fabs(connectionWeightArray[connectionIndexArray[2*i] / 2]) < minimumConnectionRadius){
+			lineIndexVector.push_back(connectionIndexArray[2*i]);
+			lineIndexVector.push_back(connectionIndexArray[2*i + 1]);
+		}
+		else{
+			++numberOfConeConnections;
+		}
+	}
+
+	//Size the vectors, which keep their memory between builds
+	int numberOfConeVertices = numberOfConeConnections * verticesPerConnection;
+	coneVertexVector.resize(numberOfConeVertices * 3);
+	coneNormalVector.resize(numberOfConeVertices * 3);
+	coneColorVector.resize(numberOfConeVertices * 3);
+	coneIndexVector.resize(numberOfConeConnections * coneSegments * 6);
+
+	//Directions around the base of each cone
+	vector<float> cosVector(coneSegments), sinVector(coneSegments);
+	for(int i=0; i<coneSegments; ++i){
+		cosVector[i] = cos(2.0f * GL_PI * i / coneSegments);
+		sinVector[i] = sin(2.0f * GL_PI * i / coneSegments);
+	}
+
+	int coneStart = 0, numberOfConeIndexes = 0;
+	for(int visIndex=0; visIndex<numberOfVisibleConnections; ++visIndex){
+		int conIndex = connectionIndexArray[2*visIndex] / 2;
+		float radius = weightRadiusFactor * fabs(connectionWeightArray[conIndex]);
+		if(radius < minimumConnectionRadius)
+			continue;
+
+		//Unit vector along the connection and two unit vectors perpendicular to it
+		GLfloat* fromPtr = &connectionVertexArray[conIndex * 6];
+		GLfloat* toPtr = &connectionVertexArray[conIndex * 6 + 3];
+		float axis[3] = { toPtr[0] - fromPtr[0], toPtr[1] - fromPtr[1], toPtr[2] - fromPtr[2] };
+		float length = sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+		if(length > 0.0f){
+			for(int j=0; j<3; ++j)
+				axis[j] /= length;
+		}
+		else{
+			axis[0] = 0.0f; axis[1] = 0.0f; axis[2] = 1.0f;
+		}
+		float perp1[3];
+		if(fabs(axis[0]) < 0.9f){//Cross product with X axis
+			perp1[0] = 0.0f; perp1[1] = axis[2]; perp1[2] = -axis[1];
+		}
+		else{//Cross product with Y axis
+			perp1[0] = -axis[2]; perp1[1] = 0.0f; perp1[2] = axis[0];
+		}
+		float perpLength = sqrt(perp1[0] * perp1[0] + perp1[1] * perp1[1] + perp1[2] * perp1[2]);
+		for(int j=0; j<3; ++j)
+			perp1[j] /= perpLength;
+		float perp2[3] = {
+			axis[1] * perp1[2] - axis[2] * perp1[1],
+			axis[2] * perp1[0] - axis[0] * perp1[2],
+			axis[0] * perp1[1] - axis[1] * perp1[0]
+		};
+
+		//The cones have their tips at the neurons and meet at the midpoint of the connection
+		float halfLength = length / 2.0f;
+		float normalLength = sqrt(halfLength * halfLength + radius * radius);
+		for(int cone=0; cone<2; ++cone){
+			GLfloat* tipPtr = cone == 0 ? fromPtr : toPtr;
+			float direction = cone == 0 ? -1.0f : 1.0f;
+			int vertex = coneStart + cone * (coneSegments + 1);
+			for(int j=0; j<3; ++j){
+				coneVertexVector[vertex * 3 + j] = tipPtr[j];
+				coneNormalVector[vertex * 3 + j] = direction * axis[j];
+			}
+			for(int i=0; i<coneSegments; ++i){
+				++vertex;
+				for(int j=0; j<3; ++j){
+					float radial = cosVector[i] * perp1[j] + sinVector[i] * perp2[j];
+					coneVertexVector[vertex * 3 + j] = (fromPtr[j] + toPtr[j]) / 2.0f + radius * radial;
+					if(normalLength > 0.0f)
+						coneNormalVector[vertex * 3 + j] = (halfLength * radial + direction * radius * axis[j]) / normalLength;
+					else
+						coneNormalVector[vertex * 3 + j] = radial;
+				}
+			}
+		}
+
+		//Cones have the colour of the connection
+		for(int i=0; i<verticesPerConnection; ++i){
+			for(int j=0; j<3; ++j)
+				coneColorVector[(coneStart + i) * 3 + j] = connectionColorArray[conIndex * 6 + j];
+		}
+
+		//Triangles run from the tip of each cone to its base, wound anticlockwise when seen from outside
+		int secondTip = coneStart + coneSegments + 1;
+		for(int s=0; s<coneSegments; ++s){
+			int nextS = (s + 1) % coneSegments;
+			coneIndexVector[numberOfConeIndexes++] = coneStart;
+			coneIndexVector[numberOfConeIndexes++] = coneStart + 1 + nextS;
+			coneIndexVector[numberOfConeIndexes++] = coneStart + 1 + s;
+			coneIndexVector[numberOfConeIndexes++] = secondTip;
+			coneIndexVector[numberOfConeIndexes++] = secondTip + 1 + s;
+			coneIndexVector[numberOfConeIndexes++] = secondTip + 1 + nextS;
+		}
+		coneStart += verticesPerConnection;
+	}
+	rebuildConeMesh = false;
+}
+
+
+/*! Builds the arrays holding the positions of the connections in the specified connection groups.
+	Positions are looked up once here, so that the connections can be drawn without accessing the network. */
+void NetworkViewer::buildConnectionArrays(const QList<unsigned int>& conGrpIDs){
+	deleteConnectionArrays();
+	Network* network = Globals::getNetwork();
+
+	//Count the connections
+	numberOfConnections = 0;
+	foreach(unsigned int conGrpID, conGrpIDs)
+		numberOfConnections += network->getConnectionGroup(conGrpID)->size();
+
+	//Allocate the arrays
+	connectionVertexArray = new GLfloat[numberOfConnections * 6];
+	connectionColorArray = new GLubyte[numberOfConnections * 6];
+	connectionWeightArray = new float[numberOfConnections];
+	connectionIndexArray = new GLuint[numberOfConnections * 2];
+	numberOfBundles = conGrpIDs.size();
+	bundleVertexArray = new GLfloat[numberOfBundles * 6];
+	bundleColorArray = new GLubyte[numberOfBundles * 3];
+	bundleSizeArray = new int[numberOfBundles];
+
+	//Store the positions of the from and to neurons of each connection
+	int conIndex = 0, bundleIndex = 0;
+	foreach(unsigned int conGrpID, conGrpIDs){
+		ConnectionGroup* conGrp = network->getConnectionGroup(conGrpID);
+		int firstConIndex = conIndex;
+		NeuronGroup* fromNeuronGroup = network->getNeuronGroup(conGrp->getFromNeuronGroupID());
+		NeuronGroup* toNeuronGroup = network->getNeuronGroup(conGrp->getToNeuronGroupID());
+		ConnectionIterator endConGrp = conGrp->end();
+		for(ConnectionIterator conIter = conGrp->begin(); conIter != endConGrp; ++conIter){
+			Point3D fromNeuronPoint = fromNeuronGroup->getNeuronLocation(conIter->getFromNeuronID());
+			Point3D toNeuronPoint = toNeuronGroup->getNeuronLocation(conIter->getToNeuronID());
+			GLfloat* vertexPtr = &connectionVertexArray[conIndex * 6];
+			vertexPtr[0] = fromNeuronPoint.getXPos();
+			vertexPtr[1] = fromNeuronPoint.getYPos();
+			vertexPtr[2] = fromNeuronPoint.getZPos();
+			vertexPtr[3] = toNeuronPoint.getXPos();
+			vertexPtr[4] = toNeuronPoint.getYPos();
+			vertexPtr[5] = toNeuronPoint.getZPos();
+			++conIndex;
+		}
+
+		//The bundle representing the group runs between the average positions of its from and to neurons
+		GLfloat* bundlePtr = &bundleVertexArray[bundleIndex * 6];
+		for(int i=0; i<6; ++i)
+			bundlePtr[i] = 0.0f;
+		for(int i=firstConIndex; i<conIndex; ++i){
+			for(int j=0; j<6; ++j)
+				bundlePtr[j] += connectionVertexArray[i * 6 + j];
+		}
+		bundleSizeArray[bundleIndex] = conIndex - firstConIndex;
+		if(bundleSizeArray[bundleIndex] > 0){
+			for(int i=0; i<6; ++i)
+				bundlePtr[i] /= bundleSizeArray[bundleIndex];
+		}
+		++bundleIndex;
+	}
+	uploadBuffer(connectionVertexBuffer, connectionVertexArray, numberOfConnections * 6 * sizeof(GLfloat));
+
+	//Sort the connections into the cells of a grid, so that connections out of view can be skipped
+	buildConnectionGrid();
+
+	//Record the groups in the arrays. Colours and visible connections have to be filled in for the new arrays
+	connectionArrayGroupIDs = conGrpIDs;
+	rebuildConnectionArrays = false;
+	updateConnectionColors = true;
+	selectConnections = true;
+}
+
+
+/*! Sorts the connections into buckets, which are the cells of a grid over the bounding box of the connections.
+	Each connection goes into the cell containing its midpoint and the bounding box of each bucket encloses all
+	of its connections, so a bucket can be skipped when its box is out of view. */
+void NetworkViewer::buildConnectionGrid(){
+	//Find the bounding box of the connections
+	float minPos[3] = {0.0f, 0.0f, 0.0f}, maxPos[3] = {0.0f, 0.0f, 0.0f};
+	for(int i=0; i<numberOfConnections * 2; ++i){
+		for(int j=0; j<3; ++j){
+			if(i == 0 || connectionVertexArray[i * 3 + j] < minPos[j])
+				minPos[j] = connectionVertexArray[i * 3 + j];
+			if(i == 0 || connectionVertexArray[i * 3 + j] > maxPos[j])
+				maxPos[j] = connectionVertexArray[i * 3 + j];
+		}
+	}
+
+	//Distances at which the level of detail changes depend on the size of the network
+	float networkSize = sqrt(pow(maxPos[0] - minPos[0], 2) + pow(maxPos[1] - minPos[1], 2) + pow(maxPos[2] - minPos[2], 2));
+	lodDistance = LOD_DISTANCE_FACTOR * networkSize;
+	bundleDistance = BUNDLE_DISTANCE_FACTOR * networkSize;
+	for(int j=0; j<3; ++j)
+		networkCentre[j] = (minPos[j] + maxPos[j]) / 2.0f;
+
+	//Double the number of cells along each axis until the buckets are small enough
+	int cellsPerAxis = 1;
+	while(cellsPerAxis < MAX_GRID_CELLS_PER_AXIS && cellsPerAxis * cellsPerAxis * cellsPerAxis * CONNECTIONS_PER_BUCKET < numberOfConnections)
+		cellsPerAxis *= 2;
+	numberOfBuckets = cellsPerAxis * cellsPerAxis * cellsPerAxis;
+
+	//Find the bucket of each connection and count the connections in each bucket
+	bucketStartArray = new int[numberOfBuckets + 1];
+	for(int i=0; i<=numberOfBuckets; ++i)
+		bucketStartArray[i] = 0;
+	int* connectionBucketArray = new int[numberOfConnections];
+	for(int conIndex=0; conIndex<numberOfConnections; ++conIndex){
+		int bucket = 0;
+		for(int j=0; j<3; ++j){
+			float midPos = (connectionVertexArray[conIndex * 6 + j] + connectionVertexArray[conIndex * 6 + 3 + j]) / 2.0f;
+			int cell = 0;
+			if(maxPos[j] > minPos[j])
+				cell = (int)( (midPos - minPos[j]) / (maxPos[j] - minPos[j]) * cellsPerAxis );
+			if(cell >= cellsPerAxis)
+				cell = cellsPerAxis - 1;
+			bucket = bucket * cellsPerAxis + cell;
+		}
+		connectionBucketArray[conIndex] = bucket;
+		++bucketStartArray[bucket + 1];
+	}
+
+	//Fill the buckets and find their bounding boxes
+	for(int i=0; i<numberOfBuckets; ++i)
+		bucketStartArray[i + 1] += bucketStartArray[i];
+	bucketConnectionArray = new int[numberOfConnections];
+	bucketSelectedArray = new int[numberOfBuckets];
+	bucketBoxArray = new float[numberOfBuckets * 6];
+	int* nextPositionArray = new int[numberOfBuckets];
+	for(int i=0; i<numberOfBuckets; ++i){
+		nextPositionArray[i] = bucketStartArray[i];
+		bucketSelectedArray[i] = 0;
+	}
+	for(int conIndex=0; conIndex<numberOfConnections; ++conIndex){
+		int bucket = connectionBucketArray[conIndex];
+		float* boxPtr = &bucketBoxArray[bucket * 6];
+		for(int j=0; j<3; ++j){
+			float pos1 = connectionVertexArray[conIndex * 6 + j], pos2 = connectionVertexArray[conIndex * 6 + 3 + j];
+			if(nextPositionArray[bucket] == bucketStartArray[bucket]){
+				boxPtr[j] = qMin(pos1, pos2);
+				boxPtr[j + 3] = qMax(pos1, pos2);
+			}
+			else{
+				boxPtr[j] = qMin(boxPtr[j], qMin(pos1, pos2));
+				boxPtr[j + 3] = qMax(boxPtr[j + 3], qMax(pos1, pos2));
+			}
+		}
+		bucketConnectionArray[nextPositionArray[bucket]++] = conIndex;
+	}
+	delete [] nextPositionArray;
+	delete [] connectionBucketArray;
+}
+
+
+/*! Builds the arrays holding the positions and IDs of the neurons in the specified neuron groups. */
+void NetworkViewer::buildNeuronArrays(const QList<unsigned int>& neuronGrpIDs){
+	deleteNeuronArrays();
+	Network* network = Globals::getNetwork();
+
+	//Count the neurons
+	numberOfNeurons = 0;
+	foreach(unsigned int neurGrpID, neuronGrpIDs)
+		numberOfNeurons += network->getNeuronGroup(neurGrpID)->size();
+
+	//Allocate the arrays
+	neuronVertexArray = new GLfloat[numberOfNeurons * 3];
+	neuronColorArray = new GLubyte[numberOfNeurons * 4];
+	neuronIDArray = new unsigned int[numberOfNeurons];
+
+	//Store the position and ID of each neuron
+	int neurIndex = 0;
+	foreach(unsigned int neurGrpID, neuronGrpIDs){
+		NeuronGroup* neurGrp = network->getNeuronGroup(neurGrpID);
+		int neurGrpSize = neurGrp->size();
+		for(int i=0; i<neurGrpSize; ++i){
+			neuronVertexArray[neurIndex * 3] = neurGrp->getNeuronXPos(i);
+			neuronVertexArray[neurIndex * 3 + 1] = neurGrp->getNeuronYPos(i);
+			neuronVertexArray[neurIndex * 3 + 2] = neurGrp->getNeuronZPos(i);
+			neuronIDArray[neurIndex] = neurGrp->getNeuronID(i);
+			neuronIndexMap[neuronIDArray[neurIndex]] = neurIndex;
+			++neurIndex;
+		}
+	}
+	uploadBuffer(neuronVertexBuffer, neuronVertexArray, numberOfNeurons * 3 * sizeof(GLfloat));
+
+	//Record the groups in the arrays. Colours have to be filled in for all of the new neurons
+	neuronArrayGroupIDs = neuronGrpIDs;
+	rebuildNeuronArrays = false;
+	updateNeuronColors = true;
+	refillNeuronColors = true;
+}
+
+
+/*! Builds the texture for the point sprites, which is an image of a sphere lit from the upper left.
+	The texture is white and is multiplied by the colour of each neuron. */
+void NetworkViewer::buildSphereTexture(){
+	float lightDirection[3] = { -0.4f, 0.5f, 0.77f };
+	float lightLength = sqrt(lightDirection[0] * lightDirection[0] + lightDirection[1] * lightDirection[1] + lightDirection[2] * lightDirection[2]);
+	for(int j=0; j<3; ++j)
+		lightDirection[j] /= lightLength;
+
+	//Work out the lighting of the sphere at each point. The points outside the sphere are transparent
+	GLubyte* textureArray = new GLubyte[SPHERE_TEXTURE_SIZE * SPHERE_TEXTURE_SIZE * 4];
+	for(int y=0; y<SPHERE_TEXTURE_SIZE; ++y){
+		for(int x=0; x<SPHERE_TEXTURE_SIZE; ++x){
+			GLubyte* texelPtr = &textureArray[(y * SPHERE_TEXTURE_SIZE + x) * 4];
+			float normal[3];
+			normal[0] = (2.0f * x + 1.0f) / SPHERE_TEXTURE_SIZE - 1.0f;
+			normal[1] = 1.0f - (2.0f * y + 1.0f) / SPHERE_TEXTURE_SIZE;//Point sprite textures start at the top
+			float radiusSquared = normal[0] * normal[0] + normal[1] * normal[1];
+			if(radiusSquared > 1.0f){
+				texelPtr[0] = texelPtr[1] = texelPtr[2] = texelPtr[3] = 0;
+				continue;
+			}
+			normal[2] = sqrt(1.0f - radiusSquared);
+			float diffuse = qMax(0.0f, normal[0] * lightDirection[0] + normal[1] * lightDirection[1] + normal[2] * lightDirection[2]);
+			GLubyte intensity = (GLubyte)(255.0f * (fLowLight[0] + (1.0f - fLowLight[0]) * diffuse) + 0.5f);
+			texelPtr[0] = texelPtr[1] = texelPtr[2] = intensity;
+			texelPtr[3] = 255;
+		}
+	}
+
+	glGenTextures(1, &sphereTexture);
+	glBindTexture(GL_TEXTURE_2D, sphereTexture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, SPHERE_TEXTURE_SIZE, SPHERE_TEXTURE_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, textureArray);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	delete [] textureArray;
+}
+
+
 /*! Checks for errors in OpenGL. */
 void NetworkViewer::checkOpenGLErrors(){
 	//Check to see if error has occurred
@@ -439,6 +888,94 @@ void NetworkViewer::checkOpenGLErrors(){
 }
 
 
+/*! Frees the memory holding the cones of the weighted connections */
+void NetworkViewer::deleteConeMesh(){
+	vector<GLfloat>().swap(coneVertexVector);
+	vector<GLfloat>().swap(coneNormalVector);
+	vector<GLubyte>().swap(coneColorVector);
+	vector<GLuint>().swap(coneIndexVector);
+	vector<GLuint>().swap(lineIndexVector);
+	vector<GLuint>().swap(coneConnectionIndexVector);
+	rebuildConeMesh = true;
+}
+
+
+/*! Deletes the arrays holding the connections */
+void NetworkViewer::deleteConnectionArrays(){
+	deleteConeMesh();
+	if(connectionVertexArray != NULL){
+		delete [] connectionVertexArray;
+		connectionVertexArray = NULL;
+	}
+	if(connectionColorArray != NULL){
+		delete [] connectionColorArray;
+		connectionColorArray = NULL;
+	}
+	if(connectionWeightArray != NULL){
+		delete [] connectionWeightArray;
+		connectionWeightArray = NULL;
+	}
+	if(connectionIndexArray != NULL){
+		delete [] connectionIndexArray;
+		connectionIndexArray = NULL;
+	}
+	if(bundleVertexArray != NULL){
+		delete [] bundleVertexArray;
+		bundleVertexArray = NULL;
+	}
+	if(bundleColorArray != NULL){
+		delete [] bundleColorArray;
+		bundleColorArray = NULL;
+	}
+	if(bundleSizeArray != NULL){
+		delete [] bundleSizeArray;
+		bundleSizeArray = NULL;
+	}
+	if(bucketStartArray != NULL){
+		delete [] bucketStartArray;
+		bucketStartArray = NULL;
+	}
+	if(bucketConnectionArray != NULL){
+		delete [] bucketConnectionArray;
+		bucketConnectionArray = NULL;
+	}
+	if(bucketSelectedArray != NULL){
+		delete [] bucketSelectedArray;
+		bucketSelectedArray = NULL;
+	}
+	if(bucketBoxArray != NULL){
+		delete [] bucketBoxArray;
+		bucketBoxArray = NULL;
+	}
+	numberOfBundles = 0;
+	numberOfBuckets = 0;
+	numberOfConnections = 0;
+	numberOfVisibleConnections = 0;
+	connectionArrayGroupIDs.clear();
+}
+
+
+/*! Deletes the arrays holding the neurons */
+void NetworkViewer::deleteNeuronArrays(){
+	if(neuronVertexArray != NULL){
+		delete [] neuronVertexArray;
+		neuronVertexArray = NULL;
+	}
+	if(neuronColorArray != NULL){
+		delete [] neuronColorArray;
+		neuronColorArray = NULL;
+	}
+	if(neuronIDArray != NULL){
+		delete [] neuronIDArray;
+		neuronIDArray = NULL;
+	}
+	numberOfNeurons = 0;
+	neuronIndexMap.clear();
+	neuronArrayGroupIDs.clear();
+	coloredNeuronIndexList.clear();
+}
+
+
 /*! Draw X, Y and Z axes
 	These are drawn so that they cover the clipping volume plus a bit of extra length. */
 void NetworkViewer::drawAxes(void){
@@ -523,187 +1060,86 @@ void NetworkViewer::drawConnections(){
 	if(!Globals::networkLoaded())
 		return;
 
-	//Use existing display list
-	if(useConnectionsDisplayList){
-		glCallList(connectionsDisplayList);
-	}
-	//Create new display list with connections
-	else{
-		glNewList(connectionsDisplayList, GL_COMPILE_AND_EXECUTE);
-
-		//Local variables declared once here to save processing. These point to the points stored in the neurons
-		Point3D* fromNeuronPoint;
-		Point3D* toNeuronPoint;
-
-		//Get pointer to network that is to be drawn and its associated display
-		Network* network = Globals::getNetwork();
-		NetworkDisplay* netDisplay = Globals::getNetworkDisplay();
-		bool fullRender = netDisplay->isFullRenderMode();
-
-		//Get information about rendering connections
-		unsigned weightRenderMode = netDisplay->getWeightRenderMode();
-		float weight = 0.0f;//Declare here to save declaring it all the time.
-		weightRadiusFactor = netDisplay->getWeightRadiusFactor();
-		minimumConnectionRadius = netDisplay->getMinimumConnectionRadius();
-		connectionQuality = netDisplay->getConnectionQuality();
-
-		//Default neuron colour
-		RGBColor positiveConnectionColor = *netDisplay->getPositiveConnectionColor();
-		RGBColor negativeConnectionColor = *netDisplay->getNegativeConnectionColor();
-
-		//Sort out the connection mode
-		unsigned int singleNeuronID=0, toNeuronID=0;
-		unsigned int connectionMode = netDisplay->getConnectionMode();
-		QList<Connection*>& visConList = netDisplay->getVisibleConnectionsList();
-		if(connectionMode & CONNECTION_MODE_ENABLED){
-			connectedNeuronMap.clear();
-			singleNeuronID = netDisplay->getSingleNeuronID();
-			if(connectionMode & SHOW_BETWEEN_CONNECTIONS)
-				toNeuronID = netDisplay->getToNeuronID();
-
-			//Rebuild list of visible connections
-			visConList.clear();
+	//Rebuild the arrays if the network or the visible connection groups have changed
+	QList<unsigned int> conGrpIDs = Globals::getNetworkDisplay()->getVisibleConnectionGroupIDs();
+	if(rebuildConnectionArrays || conGrpIDs != connectionArrayGroupIDs)
+		buildConnectionArrays(conGrpIDs);
+
+	//Update the colours and select the connections that are drawn
+	if(updateConnectionColors)
+		fillConnectionColors();
+	if(selectConnections)
+		fillConnectionIndexArray();
+
+	//Choose the connections to draw from the current view, unless only the connections of selected neurons are shown
+	NetworkDisplay* netDisplay = Globals::getNetworkDisplay();
+	if( !(netDisplay->getConnectionMode() & CONNECTION_MODE_ENABLED) ){
+		if(!selectLevelOfDetail()){
+			drawConnectionBundles();
+			return;
 		}
+	}
+	if(numberOfVisibleConnections == 0)
+		return;
 
-		//Work through the connection groups listed in the network display
-		bool drawConnection;
-		int thinningThreshold = Globals::getNetworkDisplay()->getConnectionThinningThreshold();
-		unsigned ignoreConCnt = 0;
-		QList<unsigned int> conGrpIDs = Globals::getNetworkDisplay()->getVisibleConnectionGroupIDs();
-		for(QList<unsigned int>::iterator conGrpIter = conGrpIDs.begin(); conGrpIter != conGrpIDs.end(); ++conGrpIter){
-
-			//Pointer to connection group
-			ConnectionGroup* conGrp = network->getConnectionGroup(*conGrpIter);
-			int numCons = conGrp->size();
-			int drawingThreshold = 0;
-			if(numCons > thinningThreshold){
-				drawingThreshold = Util::rInt(RAND_MAX * ( (double)thinningThreshold/(double)numCons));
-			}
-
-			//Get neuron groups for extracting the position information
-			NeuronGroup* fromNeuronGroup = network->getNeuronGroup(conGrp->getFromNeuronGroupID());
-			NeuronGroup* toNeuronGroup = network->getNeuronGroup(conGrp->getToNeuronGroupID());
-
-			//Draw all the connections in the group
-			ConnectionIterator endConGrp = conGrp->end();
-			for(ConnectionIterator conIter = conGrp->begin(); conIter != endConGrp; ++ conIter){
-				//Get the weight
-				weight = conIter->getWeight();
-				if( (weightRenderMode & WEIGHT_RENDER_ENABLED) && (weightRenderMode & RENDER_TEMP_WEIGHTS) )
-					weight = conIter->getTempWeight();
-
-				//Decide if connection should be drawn, depending on the connection mode and neuron id
-				drawConnection = true;
-				if(connectionMode & CONNECTION_MODE_ENABLED){
-					//Single neuron mode
-					if( !(connectionMode & SHOW_BETWEEN_CONNECTIONS) ){
-						//Show only connections from a single neuron
-						if(connectionMode & SHOW_FROM_CONNECTIONS){
-							if( conIter->getFromNeuronID() != singleNeuronID){
-								drawConnection = false;
-							}
-							else{
-								connectedNeuronMap[conIter->getToNeuronID()] = weight;
-							}
-						}
-						//Show only connections to a single neuron
-						else if(connectionMode & SHOW_TO_CONNECTIONS){
-							if( conIter->getToNeuronID() != singleNeuronID){
-								drawConnection = false;
-							}
-							else{
-								connectedNeuronMap[conIter->getFromNeuronID()] = weight;//Positive connection
-							}
-						}
-						//Show from and to connections to a single neuron
-						else {
-							if( (conIter->getFromNeuronID() != singleNeuronID) && (conIter->getToNeuronID() != singleNeuronID) ){
-								drawConnection = false;
-							}
-							else {//Highlight connected neurons
-								if( conIter->getFromNeuronID() == singleNeuronID){
-									connectedNeuronMap[conIter->getToNeuronID()] = weight;//Positive connection
-								}
-								else if( conIter->getToNeuronID() == singleNeuronID){
-									connectedNeuronMap[conIter->getFromNeuronID()] = weight;//Positive connection
-								}
-							}
-						}
-					}
-					//Between neuron mode
-					else{
-						//Only show connections from first neuron to second
-						if( conIter->getFromNeuronID() != singleNeuronID || conIter->getToNeuronID() != toNeuronID)
-							drawConnection = false;
-					}
+	//Draw weighted connections as cones in full render mode
+	if(netDisplay->isFullRenderMode() && (netDisplay->getWeightRenderMode() & WEIGHT_RENDER_ENABLED) ){
+		drawWeightedConnections();
+		return;
+	}
 
-					//Decide whether to draw connection based on its weight
-					if( weight < 0 && (connectionMode & SHOW_POSITIVE_CONNECTIONS) )
-						drawConnection = false;
-					if( weight >= 0 && (connectionMode & SHOW_NEGATIVE_CONNECTIONS))
-						drawConnection = false;
+	//Draw the selected connections as lines
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(3, GL_FLOAT, 0, bindBuffer(connectionVertexBuffer, connectionVertexArray));
+	glColorPointer(3, GL_UNSIGNED_BYTE, 0, bindBuffer(connectionColorBuffer, connectionColorArray));
+	if(useVertexBuffers)
+		QGLBuffer::release(QGLBuffer::VertexBuffer);
+	glDrawElements(GL_LINES, numberOfVisibleConnections * 2, GL_UNSIGNED_INT, connectionIndexArray);
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+}
 
-					//Add connection to list of visible connections
-					if(drawConnection)
-						visConList.append(&(*conIter));
 
-				}
-				//Draw all connections, potentially thinned
-				else if(drawingThreshold && (rand() > drawingThreshold)){
-					drawConnection = false;
-					++ignoreConCnt;
-				}
+/*! Draws each connection group as a single line between the average positions of its
+	from and to neurons, whose width increases with the number of connections in the group. */
+void NetworkViewer::drawConnectionBundles(){
+	glPushAttrib(GL_LINE_BIT);
+	for(int i=0; i<numberOfBundles; ++i){
+		if(bundleSizeArray[i] == 0)
+			continue;
+		glLineWidth(1.0f + log10((float)bundleSizeArray[i]));
+		glColor3ubv(&bundleColorArray[i * 3]);
+		glBegin(GL_LINES);
+			glVertex3fv(&bundleVertexArray[i * 6]);
+			glVertex3fv(&bundleVertexArray[i * 6 + 3]);
+		glEnd();
+	}
+	glPopAttrib();
+}
 
-				//Draw the connection
-				if(drawConnection){
-					//Get the position of the from and to neurons
-					fromNeuronPoint = &fromNeuronGroup->getNeuronLocation(conIter->getFromNeuronID());
-					toNeuronPoint = &toNeuronGroup->getNeuronLocation(conIter->getToNeuronID());
-
-					//Set the colour
-					if(weight > 0)
-						glColor3f(positiveConnectionColor.red, positiveConnectionColor.green, positiveConnectionColor.blue);
-					else if(weight < 0)
-						glColor3f(negativeConnectionColor.red, negativeConnectionColor.green, negativeConnectionColor.blue);
-					else
-						glColor3f(0.0f, 0.0f, 0.0f);
-
-					//Draw the connection
-					if(fullRender && (weightRenderMode & WEIGHT_RENDER_ENABLED) ){
-						drawWeightedConnection(
-								fromNeuronPoint->getXPos(),
-								fromNeuronPoint->getYPos(),
-								fromNeuronPoint->getZPos(),
-								toNeuronPoint->getXPos(),
-								toNeuronPoint->getYPos(),
-								toNeuronPoint->getZPos(),
-								weight
-						);
-					}
-					else{
-						//Start drawing lines
-						glBegin(GL_LINES);
-							glVertex3f(fromNeuronPoint->getXPos(), fromNeuronPoint->getYPos(), fromNeuronPoint->getZPos());
-							glVertex3f(toNeuronPoint->getXPos(), toNeuronPoint->getYPos(), toNeuronPoint->getZPos());
-						glEnd();//End of line drawing
-					}
 
-				}
+/*! Draws each visible neuron with its ID as its name so that neurons can be selected with the mouse */
+void NetworkViewer::drawNeuronNames(){
+	//Nothing to do if no network is loaded
+	if(!Globals::networkLoaded())
+		return;
+	prepareNeuronArrays();
+
+	//Draw each neuron separately so that it can be named
+	bool fullRenderMode = Globals::getNetworkDisplay()->isFullRenderMode();
+	glInitNames();
+	for(int i=0; i<numberOfNeurons; ++i){
+		glPushName(neuronIDArray[i]);
+			if(!fullRenderMode){//Draw neurons as a vertex
+				glBegin(GL_POINTS);
+					glVertex3fv(&neuronVertexArray[3*i]);
+				glEnd();
 			}
-		}
-
-		//Inform other classes that the list of visible connections has changed.
-		if(connectionMode & CONNECTION_MODE_ENABLED){
-			Globals::getEventRouter()->visibleConnectionsChangedSlot();
-		}
-
-		#ifdef DEBUG
-			qDebug()<<"Number of ignored connections = "<<ignoreConCnt;
-		#endif//DEBUG
-
-		//Finished creating connection display list
-		glEndList();
-		useConnectionsDisplayList = true;
+			else{//Draw neurons as a sphere
+				drawSphere(neuronVertexArray[3*i], neuronVertexArray[3*i + 1], neuronVertexArray[3*i + 2]);
+			}
+		glPopName();
 	}
 }
 
@@ -713,103 +1149,35 @@ void NetworkViewer::drawNeurons(){
 	//Nothing to do if no network is loaded
 	if(!Globals::networkLoaded())
 		return;
+	prepareNeuronArrays();
+	if(numberOfNeurons == 0)
+		return;
 
-	//Use existing display list
-	if(useNeuronsDisplayList){
-		glCallList(neuronsDisplayList);
-	}
-	//Create new display list with connections
-	else{
-		glNewList(neuronsDisplayList, GL_COMPILE_AND_EXECUTE);
-
-		//Local variables
-		RGBColor *tmpColor, tmpColor2;
-		float weight;
-
-		//Get pointer to network that is to be drawn and its associated display
-		Network* network = Globals::getNetwork();
-		NetworkDisplay* netDisplay = Globals::getNetworkDisplay();
-
-		//Connection mode
-		unsigned int connectionMode = netDisplay->getConnectionMode();
-
-		//Default neuron colour
-		RGBColor defaultNeuronColor;
-		bool fullRenderMode = netDisplay->isFullRenderMode();//Local copy for speed
-		if(fullRenderMode){
-			defaultNeuronColor = *netDisplay->getDefaultNeuronColorFullRender();
+	//Draw neurons as spheres in full render mode
+	NetworkDisplay* netDisplay = Globals::getNetworkDisplay();
+	if(netDisplay->isFullRenderMode()){
+		if(usePointSprites){
+			drawSphereSprites();
+			return;
 		}
-		else{
-			defaultNeuronColor = *netDisplay->getDefaultNeuronColor();
-			glPointSize(netDisplay->getVertexSize());//Set the size of points in OpenGL
-		}
-		float neuronAlpha = netDisplay->getNeuronTransparency();
-
-		//Get map with colours of neurons
-		QHash<unsigned int, RGBColor*> neuronColorMap = netDisplay->getNeuronColorMap();
-
-		//Initialize list of names for clicking on neurons
-		glInitNames();
-
-		//Work through the neuron groups listed in the view vector
-		QList<unsigned int> neuronGrpIDs = Globals::getNetworkDisplay()->getVisibleNeuronGroupIDs();
-		for(QList<unsigned int>::iterator neurGrpIter = neuronGrpIDs.begin(); neurGrpIter != neuronGrpIDs.end(); ++neurGrpIter){
-			//Get the map of neurons associated with this group
-			NeuronMap* neuronMap = network->getNeuronGroup(*neurGrpIter)->getNeuronMap();
-
-			//Draw the neurons in the map
-			NeuronMap::iterator neurMapEnd = neuronMap->end();
-			for(NeuronMap::iterator neurIter = neuronMap->begin(); neurIter != neurMapEnd; ++neurIter){
-
-				//Set the color of the neuron
-				if(connectionMode & CONNECTION_MODE_ENABLED){
-					if(netDisplay->getSingleNeuronID() == (*neurIter)->getID() ){//Single selected neuron
-						tmpColor2 = netDisplay->getSingleNeuronColor();
-						glColor4f(tmpColor2.red, tmpColor2.green, tmpColor2.blue, neuronAlpha);
-					}
-					else if(netDisplay->getToNeuronID() == (*neurIter)->getID() ){//To neuron
-						tmpColor2 = netDisplay->getToNeuronColor();
-						glColor4f(tmpColor2.red, tmpColor2.green, tmpColor2.blue, neuronAlpha);
-					}
-					else if(connectedNeuronMap.contains((*neurIter)->getID())){//A connected neuron
-						weight = connectedNeuronMap[(*neurIter)->getID()];
-						if(weight > 0)//Positive connection
-							glColor4f(1.0f, 0.0f, 0.0f, neuronAlpha);
-						else if(weight < 0)
-							glColor4f(0.0f, 0.0f, 1.0f, neuronAlpha);
-						else
-							glColor4f(0.0f, 0.0f, 0.0f, neuronAlpha);
-					}
-					else{
-						glColor4f(defaultNeuronColor.red, defaultNeuronColor.green, defaultNeuronColor.blue, neuronAlpha);
-					}
-				}
-				else if(neuronColorMap.contains(neurIter.key())){
-					tmpColor = neuronColorMap[neurIter.key()];
-					glColor4f(tmpColor->red, tmpColor->green, tmpColor->blue, neuronAlpha);
-				}
-				else{
-					glColor4f(defaultNeuronColor.red, defaultNeuronColor.green, defaultNeuronColor.blue, neuronAlpha);
-				}
-
-				//Draw the neuron
-				glPushName((*neurIter)->getID());
-					if(!fullRenderMode){//Draw neurons as a vertex
-						glBegin(GL_POINTS);
-							glVertex3f(neurIter.value()->getXPos(), neurIter.value()->getYPos(), neurIter.value()->getZPos());
-						glEnd();
-					}
-					else{//Draw neurons as a sphere
-						drawSphere(neurIter.value()->getXPos(), neurIter.value()->getYPos(), neurIter.value()->getZPos());
-					}
-				glPopName();
-			}
+		for(int i=0; i<numberOfNeurons; ++i){
+			glColor4ubv(&neuronColorArray[4*i]);
+			drawSphere(neuronVertexArray[3*i], neuronVertexArray[3*i + 1], neuronVertexArray[3*i + 2]);
 		}
-
-		//Finished creating neurons display list
-		glEndList();
-		useNeuronsDisplayList = true;
+		return;
 	}
+
+	//Draw neurons as vertices
+	glPointSize(netDisplay->getVertexSize());
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(3, GL_FLOAT, 0, bindBuffer(neuronVertexBuffer, neuronVertexArray));
+	glColorPointer(4, GL_UNSIGNED_BYTE, 0, bindBuffer(neuronColorBuffer, neuronColorArray));
+	if(useVertexBuffers)
+		QGLBuffer::release(QGLBuffer::VertexBuffer);
+	glDrawArrays(GL_POINTS, 0, numberOfNeurons);
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
 }
 
 
@@ -825,36 +1193,71 @@ void NetworkViewer::drawSphere(float xPos, float yPos, float zPos) {
 }
 
 
-/*! Draws a connection whose thickness varies with the weight */
-void NetworkViewer::drawWeightedConnection(float x1, float y1, float z1, float x2, float y2, float z2, float weight){
-	//Make sure weight is positive
-	if(weight < 0.0f)
-		weight *= -1.0f;
-
-	//Draw line if we are less than minimum connection weight
-	if(weightRadiusFactor * weight < minimumConnectionRadius){
-		glBegin(GL_LINES);
-			glVertex3f(x1, y1, z1);
-			glVertex3f(x2, y2, z2);
-		glEnd();//End of line drawing
-		return;
-	}
+/*! Draws the neurons as point sprites textured with the image of a sphere. The size of the points is
+	attenuated with distance so that they match the size of the spheres drawn with the display list. */
+void NetworkViewer::drawSphereSprites(){
+	//Diameter in pixels of a sphere at unit distance from the camera
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	float diameter = 2.0f * Globals::getNetworkDisplay()->getSphereRadius() * viewport[3] / (2.0f * tan(gltDegToRad(perspective_angle) / 2.0f));
+	GLfloat attenuation[3] = { 0.0f, 0.0f, 1.0f / (diameter * diameter) };
 
-	//Calculate vector and angle with Z axis
-	float conVect [] = { x2-x1, y2-y1, z2-z1 };
+	//The texture provides the lighting, so lighting is switched off and the texture multiplies the neuron colour
+	glPushAttrib(GL_ENABLE_BIT | GL_POINT_BIT | GL_TEXTURE_BIT | GL_COLOR_BUFFER_BIT);
+	glDisable(GL_LIGHTING);
+	glEnable(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, sphereTexture);
+	glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+	glEnable(GL_POINT_SPRITE);
+	glTexEnvi(GL_POINT_SPRITE, GL_COORD_REPLACE, GL_TRUE);
+	glEnable(GL_ALPHA_TEST);
+	glAlphaFunc(GL_GREATER, 0.0f);
+	pointParameterfv(GL_POINT_DISTANCE_ATTENUATION, attenuation);
+	glPointSize(1.0f);
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(3, GL_FLOAT, 0, bindBuffer(neuronVertexBuffer, neuronVertexArray));
+	glColorPointer(4, GL_UNSIGNED_BYTE, 0, bindBuffer(neuronColorBuffer, neuronColorArray));
+	if(useVertexBuffers)
+		QGLBuffer::release(QGLBuffer::VertexBuffer);
+	glDrawArrays(GL_POINTS, 0, numberOfNeurons);
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glPopAttrib();
+}
 
-	//Some calculations
-	float length = sqrt(pow(conVect[0], 2) + pow(conVect[1], 2) + pow(conVect[2], 2));
-	float rotationAngle = GLT_INV_PI_DIV_180 * -1.0f * acos((conVect[2]) / length);//Angle with vertical z axis
 
-	//Store matrix and move to first point
-	glPushMatrix();
-	glTranslatef(x1, y1, z1);
-	glRotatef(rotationAngle, conVect[1], -conVect[0], 0.0f);//Rotate z vertical
-	gluCylinder(gluConeObj, 0.0 , weightRadiusFactor * weight, length/2.0, 8, 8);
-	glTranslatef(0.0, 0.0, length/2);//Half way up current Z axis
-	gluCylinder(gluConeObj, weightRadiusFactor * weight, 0.0, length/2.0, 8, 8);
-	glPopMatrix();
+/*! Draws the visible weighted connections. The triangles of the cones of the visible connections
+	are drawn with one call and the connections that are too thin for cones are drawn as lines. */
+void NetworkViewer::drawWeightedConnections(){
+	//Rebuild the cones if the visible connections or the display settings have changed
+	NetworkDisplay* netDisplay = Globals::getNetworkDisplay();
+	if(rebuildConeMesh || weightRadiusFactor != netDisplay->getWeightRadiusFactor() ||
+			minimumConnectionRadius != netDisplay->getMinimumConnectionRadius() || connectionQuality != netDisplay->getConnectionQuality() ||
+			(int)coneConnectionIndexVector.size() != numberOfVisibleConnections * 2 ||
+			!equal(coneConnectionIndexVector.begin(), coneConnectionIndexVector.end(), connectionIndexArray))
+		buildConeMesh();
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	if(!coneIndexVector.empty()){
+		glEnableClientState(GL_NORMAL_ARRAY);
+		glVertexPointer(3, GL_FLOAT, 0, &coneVertexVector[0]);
+		glNormalPointer(GL_FLOAT, 0, &coneNormalVector[0]);
+		glColorPointer(3, GL_UNSIGNED_BYTE, 0, &coneColorVector[0]);
+		glDrawElements(GL_TRIANGLES, coneIndexVector.size(), GL_UNSIGNED_INT, &coneIndexVector[0]);
+		glDisableClientState(GL_NORMAL_ARRAY);
+	}
+	if(!lineIndexVector.empty()){
+		glVertexPointer(3, GL_FLOAT, 0, bindBuffer(connectionVertexBuffer, connectionVertexArray));
+		glColorPointer(3, GL_UNSIGNED_BYTE, 0, bindBuffer(connectionColorBuffer, connectionColorArray));
+		if(useVertexBuffers)
+			QGLBuffer::release(QGLBuffer::VertexBuffer);
+		glDrawElements(GL_LINES, lineIndexVector.size(), GL_UNSIGNED_INT, &lineIndexVector[0]);
+	}
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
 }
 
 
@@ -916,6 +1319,294 @@ void NetworkViewer::positionCamera(){    //
 }
 
 
+/*! Rebuilds the neuron arrays if the network or the visible neuron groups have changed
+	and updates the colours of the neurons if necessary. */
+void NetworkViewer::prepareNeuronArrays(){
+	QList<unsigned int> neuronGrpIDs = Globals::getNetworkDisplay()->getVisibleNeuronGroupIDs();
+	if(rebuildNeuronArrays || neuronGrpIDs != neuronArrayGroupIDs)
+		buildNeuronArrays(neuronGrpIDs);
+	if(updateNeuronColors)
+		fillNeuronColors();
+}
+
+
+/*! Fills in the colour and weight of each connection in the connection arrays.
+	The connections are visited in the same order that they were added to the arrays. */
+void NetworkViewer::fillConnectionColors(){
+	Network* network = Globals::getNetwork();
+	NetworkDisplay* netDisplay = Globals::getNetworkDisplay();
+	unsigned weightRenderMode = netDisplay->getWeightRenderMode();
+	bool renderTempWeights = (weightRenderMode & WEIGHT_RENDER_ENABLED) && (weightRenderMode & RENDER_TEMP_WEIGHTS);
+	RGBColor positiveConnectionColor = *netDisplay->getPositiveConnectionColor();
+	RGBColor negativeConnectionColor = *netDisplay->getNegativeConnectionColor();
+
+	int conIndex = 0, bundleIndex = 0;
+	float weight;
+	foreach(unsigned int conGrpID, connectionArrayGroupIDs){
+		ConnectionGroup* conGrp = network->getConnectionGroup(conGrpID);
+		ConnectionIterator endConGrp = conGrp->end();
+		int weightBalance = 0;
+		for(ConnectionIterator conIter = conGrp->begin(); conIter != endConGrp && conIndex < numberOfConnections; ++conIter){
+			if(renderTempWeights)
+				weight = conIter->getTempWeight();
+			else
+				weight = conIter->getWeight();
+			connectionWeightArray[conIndex] = weight;
+			if(weight > 0){
+				setConnectionColor(conIndex, positiveConnectionColor);
+				++weightBalance;
+			}
+			else if(weight < 0){
+				setConnectionColor(conIndex, negativeConnectionColor);
+				--weightBalance;
+			}
+			else{
+				setConnectionColor(conIndex, RGBColor::BLACK);
+			}
+			++conIndex;
+		}
+
+		//Bundles have the colour of the majority of their connections
+		const RGBColor& bundleColor = weightBalance > 0 ? positiveConnectionColor : (weightBalance < 0 ? negativeConnectionColor : RGBColor::BLACK);
+		bundleColorArray[bundleIndex * 3] = (GLubyte)(bundleColor.red * 255.0f + 0.5f);
+		bundleColorArray[bundleIndex * 3 + 1] = (GLubyte)(bundleColor.green * 255.0f + 0.5f);
+		bundleColorArray[bundleIndex * 3 + 2] = (GLubyte)(bundleColor.blue * 255.0f + 0.5f);
+		++bundleIndex;
+	}
+	uploadBuffer(connectionColorBuffer, connectionColorArray, numberOfConnections * 6 * sizeof(GLubyte));
+	updateConnectionColors = false;
+
+	//The cones depend on the weights and colours
+	rebuildConeMesh = true;
+
+	//Weights decide which connections are visible when connection mode is enabled
+	if(netDisplay->getConnectionMode() & CONNECTION_MODE_ENABLED)
+		selectConnections = true;
+}
+
+
+/*! Selects the connections that are drawn. When connection mode is enabled, the connections of the selected
+	neurons are stored in the index array, and the list of visible connections in the network display and the map of
+	connected neurons are rebuilt. Otherwise the connections in each bucket are sorted so that the level of detail
+	can be chosen at each frame. */
+void NetworkViewer::fillConnectionIndexArray(){
+	Network* network = Globals::getNetwork();
+	NetworkDisplay* netDisplay = Globals::getNetworkDisplay();
+	selectConnections = false;
+
+	//Connections are chosen from the buckets at each frame when connection mode is not enabled
+	unsigned int connectionMode = netDisplay->getConnectionMode();
+	if( !(connectionMode & CONNECTION_MODE_ENABLED) ){
+		sortConnectionBuckets();
+		return;
+	}
+
+	//Sort out the connection mode
+	unsigned int singleNeuronID = netDisplay->getSingleNeuronID(), toNeuronID = 0;
+	if(connectionMode & SHOW_BETWEEN_CONNECTIONS)
+		toNeuronID = netDisplay->getToNeuronID();
+	connectedNeuronMap.clear();
+
+	//Rebuild list of visible connections
+	vector<VisibleConnection> newVisibleConnections;
+	VisibleConnection visibleConnection;
+
+	//Work through the connection groups in the arrays
+	bool drawConnection;
+	float weight;
+	int conIndex = 0;
+	numberOfVisibleConnections = 0;
+	foreach(unsigned int conGrpID, connectionArrayGroupIDs){
+		ConnectionGroup* conGrp = network->getConnectionGroup(conGrpID);
+		ConnectionIterator endConGrp = conGrp->end();
+		visibleConnection.connectionGroupID = conGrpID;
+		visibleConnection.index = 0;
+		for(ConnectionIterator conIter = conGrp->begin(); conIter != endConGrp && conIndex < numberOfConnections; ++conIter, ++conIndex, ++visibleConnection.index){
+			weight = connectionWeightArray[conIndex];
+
+			//Decide if connection should be drawn, depending on the connection mode and neuron id
+			drawConnection = true;
+
+			//Single neuron mode
+			if( !(connectionMode & SHOW_BETWEEN_CONNECTIONS) ){
+				//Show only connections from a single neuron
+				if(connectionMode & SHOW_FROM_CONNECTIONS){
+					if( conIter->getFromNeuronID() != singleNeuronID){
+						drawConnection = false;
+					}
+					else{
+						connectedNeuronMap[conIter->getToNeuronID()] = weight;
+					}
+				}
+				//Show only connections to a single neuron
+				else if(connectionMode & SHOW_TO_CONNECTIONS){
+					if( conIter->getToNeuronID() != singleNeuronID){
+						drawConnection = false;
+					}
+					else{
+						connectedNeuronMap[conIter->getFromNeuronID()] = weight;//Positive connection
+					}
+				}
+				//Show from and to connections to a single neuron
+				else {
+					if( (conIter->getFromNeuronID() != singleNeuronID) && (conIter->getToNeuronID() != singleNeuronID) ){
+						drawConnection = false;
+					}
+					else {//Highlight connected neurons
+						if( conIter->getFromNeuronID() == singleNeuronID){
+							connectedNeuronMap[conIter->getToNeuronID()] = weight;//Positive connection
+						}
+						else if( conIter->getToNeuronID() == singleNeuronID){
+							connectedNeuronMap[conIter->getFromNeuronID()] = weight;//Positive connection
+						}
+					}
+				}
+			}
+			//Between neuron mode
+			else{
+				//Only show connections from first neuron to second
+				if( conIter->getFromNeuronID() != singleNeuronID || conIter->getToNeuronID() != toNeuronID)
+					drawConnection = false;
+			}
+
+			//Decide whether to draw connection based on its weight
+			if( weight < 0 && (connectionMode & SHOW_POSITIVE_CONNECTIONS) )
+				drawConnection = false;
+			if( weight >= 0 && (connectionMode & SHOW_NEGATIVE_CONNECTIONS))
+				drawConnection = false;
+
+			//Add connection to list of visible connections and store the indexes of its two vertices
+			if(drawConnection){
+				newVisibleConnections.push_back(visibleConnection);
+				connectionIndexArray[numberOfVisibleConnections * 2] = conIndex * 2;
+				connectionIndexArray[numberOfVisibleConnections * 2 + 1] = conIndex * 2 + 1;
+				++numberOfVisibleConnections;
+			}
+		}
+	}
+
+	/* Inform other classes if the list of visible connections has changed. This is rebuilt whenever the weights change,
+		which usually leaves the list unchanged. The colours of the connected neurons also change */
+	vector<VisibleConnection>& visibleConnections = netDisplay->getVisibleConnections();
+	if(newVisibleConnections != visibleConnections){
+		visibleConnections.swap(newVisibleConnections);
+		Globals::getEventRouter()->visibleConnectionsChangedSlot();
+	}
+	updateNeuronColors = true;
+}
+
+
+/*! Fills in the colours of the neurons in the neuron arrays.
+	During simulation and archive playback only a few neurons change colour at each time step, so when the
+	display settings are unchanged only the neurons coloured at the last update and the neurons with colour
+	indexes or in the current colour map are set, and only the range of the colour buffer containing them is copied. */
+void NetworkViewer::fillNeuronColors(){
+	NetworkDisplay* netDisplay = Globals::getNetworkDisplay();
+	unsigned int connectionMode = netDisplay->getConnectionMode();
+	float neuronAlpha = netDisplay->getNeuronTransparency();
+
+	//Default neuron colour
+	RGBColor defaultNeuronColor;
+	if(netDisplay->isFullRenderMode())
+		defaultNeuronColor = *netDisplay->getDefaultNeuronColorFullRender();
+	else
+		defaultNeuronColor = *netDisplay->getDefaultNeuronColor();
+
+	//All neurons have to be filled in if the arrays or the settings have changed, or connection mode is enabled
+	bool fillAllNeurons = refillNeuronColors || (connectionMode & CONNECTION_MODE_ENABLED) || neuronAlpha != lastNeuronAlpha ||
+		defaultNeuronColor.red != lastDefaultNeuronColor.red || defaultNeuronColor.green != lastDefaultNeuronColor.green ||
+		defaultNeuronColor.blue != lastDefaultNeuronColor.blue;
+	lastNeuronAlpha = neuronAlpha;
+	lastDefaultNeuronColor = defaultNeuronColor;
+	refillNeuronColors = (connectionMode & CONNECTION_MODE_ENABLED);
+
+	//Get map with colours of neurons
+	QHash<unsigned int, RGBColor*>& neuronColorMap = netDisplay->getNeuronColorMap();
+
+	//Set the colour of every neuron in connection mode
+	int minChangedIndex = numberOfNeurons, maxChangedIndex = -1;
+	if(connectionMode & CONNECTION_MODE_ENABLED){
+		unsigned int neuronID;
+		float weight;
+		for(int i=0; i<numberOfNeurons; ++i){
+			neuronID = neuronIDArray[i];
+			if(netDisplay->getSingleNeuronID() == neuronID){//Single selected neuron
+				setNeuronColor(i, netDisplay->getSingleNeuronColor(), neuronAlpha);
+			}
+			else if(netDisplay->getToNeuronID() == neuronID){//To neuron
+				setNeuronColor(i, netDisplay->getToNeuronColor(), neuronAlpha);
+			}
+			else if(connectedNeuronMap.contains(neuronID)){//A connected neuron
+				weight = connectedNeuronMap[neuronID];
+				if(weight > 0)//Positive connection
+					setNeuronColor(i, RGBColor(1.0f, 0.0f, 0.0f), neuronAlpha);
+				else if(weight < 0)
+					setNeuronColor(i, RGBColor(0.0f, 0.0f, 1.0f), neuronAlpha);
+				else
+					setNeuronColor(i, RGBColor::BLACK, neuronAlpha);
+			}
+			else{
+				setNeuronColor(i, defaultNeuronColor, neuronAlpha);
+			}
+		}
+		coloredNeuronIndexList.clear();
+		minChangedIndex = 0;
+		maxChangedIndex = numberOfNeurons - 1;
+	}
+	else{
+		//Return neurons to the default colour
+		if(fillAllNeurons){
+			for(int i=0; i<numberOfNeurons; ++i)
+				setNeuronColor(i, defaultNeuronColor, neuronAlpha);
+			minChangedIndex = 0;
+			maxChangedIndex = numberOfNeurons - 1;
+		}
+		else{
+			foreach(int neurIndex, coloredNeuronIndexList){
+				setNeuronColor(neurIndex, defaultNeuronColor, neuronAlpha);
+				minChangedIndex = qMin(minChangedIndex, neurIndex);
+				maxChangedIndex = qMax(maxChangedIndex, neurIndex);
+			}
+		}
+
+		//Set the colours of the neurons with colour indexes, which show their state during simulation and archive playback
+		coloredNeuronIndexList.clear();
+		QHash<unsigned int, int>::const_iterator indexIter;
+		const vector<unsigned int>& coloredNeuronIDs = netDisplay->getColoredNeuronIDs();
+		for(vector<unsigned int>::const_iterator idIter = coloredNeuronIDs.begin(); idIter != coloredNeuronIDs.end(); ++idIter){
+			unsigned char colorIndex = netDisplay->getNeuronColorIndex(*idIter);
+			if(colorIndex == 0)
+				continue;
+			indexIter = neuronIndexMap.constFind(*idIter);
+			if(indexIter == neuronIndexMap.constEnd())
+				continue;//Neuron is not visible
+			setNeuronColor(indexIter.value(), netDisplay->getPaletteColor(colorIndex), neuronAlpha);
+			coloredNeuronIndexList.append(indexIter.value());
+			minChangedIndex = qMin(minChangedIndex, indexIter.value());
+			maxChangedIndex = qMax(maxChangedIndex, indexIter.value());
+		}
+
+		//Set the colours of the highlighted neurons in the colour map
+		for(QHash<unsigned int, RGBColor*>::const_iterator colorIter = neuronColorMap.constBegin(); colorIter != neuronColorMap.constEnd(); ++colorIter){
+			indexIter = neuronIndexMap.constFind(colorIter.key());
+			if(indexIter == neuronIndexMap.constEnd())
+				continue;//Neuron is not visible
+			setNeuronColor(indexIter.value(), *colorIter.value(), neuronAlpha);
+			coloredNeuronIndexList.append(indexIter.value());
+			minChangedIndex = qMin(minChangedIndex, indexIter.value());
+			maxChangedIndex = qMax(maxChangedIndex, indexIter.value());
+		}
+	}
+
+	//Copy the neurons that have changed to the graphics card
+	if(fillAllNeurons)
+		uploadBuffer(neuronColorBuffer, neuronColorArray, numberOfNeurons * 4 * sizeof(GLubyte));
+	else if(maxChangedIndex >= minChangedIndex)
+		uploadBufferRange(neuronColorBuffer, neuronColorArray, minChangedIndex * 4 * sizeof(GLubyte), (maxChangedIndex - minChangedIndex + 1) * 4 * sizeof(GLubyte));
+	updateNeuronColors = false;
+}
+
+
 /*! Adapted from gltools
 	Fills the 4x4 rotation matrix to enable it to be used to rotate camera frame
 	Note that angle is in radians NOT degrees. */
@@ -973,6 +1664,20 @@ void NetworkViewer::fillRotationMatrix(float angle, float x, float y, float z){
 }
 
 
+/*! Returns a rank between 0 and 1 for the connection with the specified index.
+	The rank is a hash of the index, so it is the same at every frame, and connections are drawn
+	in order of their rank when only some of the connections in a bucket are shown. */
+float NetworkViewer::getConnectionRank(int conIndex){
+	unsigned int hash = (unsigned int)conIndex;
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bU;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35U;
+	hash ^= hash >> 16;
+	return (float)(hash / 4294967296.0);
+}
+
+
 /*! Identifies the closest neuron to the viewer within the select buffer.
 	Returns an invalid neuron ID if no hits are present */
 unsigned int NetworkViewer::getSelectedNeuron(GLuint selectBuffer[], int hitCount, int bufferSize){
@@ -1213,6 +1918,107 @@ void NetworkViewer::viewClippingVolume_Vertical(Box& clipVolume){
 }
 
 
+/*! Chooses the connections to draw from the buckets, depending on the current view. Buckets outside the
+	view are skipped and only a fraction of the connections are drawn from buckets that are far away. The
+	connections in each bucket are sorted by rank, so the same connections are drawn at each frame and
+	moving closer only adds connections. Returns false if the whole network is so far away that the
+	connection groups should be drawn as bundles. */
+bool NetworkViewer::selectLevelOfDetail(){
+	numberOfVisibleConnections = 0;
+
+	//Get the matrices for the current view
+	GLfloat projMatrix[16], modelMatrix[16], clipMatrix[16];
+	glGetFloatv(GL_PROJECTION_MATRIX, projMatrix);
+	glGetFloatv(GL_MODELVIEW_MATRIX, modelMatrix);
+	for(int col=0; col<4; ++col){
+		for(int row=0; row<4; ++row){
+			clipMatrix[col * 4 + row] = 0.0f;
+			for(int k=0; k<4; ++k)
+				clipMatrix[col * 4 + row] += projMatrix[k * 4 + row] * modelMatrix[col * 4 + k];
+		}
+	}
+
+	//Position of the camera in the coordinates of the network
+	float cameraPos[3];
+	for(int i=0; i<3; ++i)
+		cameraPos[i] = -(modelMatrix[i * 4] * modelMatrix[12] + modelMatrix[i * 4 + 1] * modelMatrix[13] + modelMatrix[i * 4 + 2] * modelMatrix[14]);
+
+	//Draw bundles when the network is far away
+	float centreDistance = sqrt(pow(cameraPos[0] - networkCentre[0], 2) + pow(cameraPos[1] - networkCentre[1], 2) + pow(cameraPos[2] - networkCentre[2], 2));
+	if(numberOfBuckets > 0 && centreDistance > bundleDistance)
+		return false;
+
+	//Extract the planes of the view frustum. Each plane is stored as a, b, c, d with points inside having ax + by + cz + d >= 0
+	float planes[6][4];
+	for(int i=0; i<3; ++i){
+		for(int j=0; j<4; ++j){
+			planes[i * 2][j] = clipMatrix[j * 4 + 3] + clipMatrix[j * 4 + i];
+			planes[i * 2 + 1][j] = clipMatrix[j * 4 + 3] - clipMatrix[j * 4 + i];
+		}
+	}
+
+	for(int bucket=0; bucket<numberOfBuckets; ++bucket){
+		int numSelected = bucketSelectedArray[bucket];
+		if(numSelected == 0)
+			continue;
+
+		//Skip buckets whose box is completely outside one of the planes
+		float* boxPtr = &bucketBoxArray[bucket * 6];
+		bool inView = true;
+		for(int p=0; p<6 && inView; ++p){
+			float dist = planes[p][3];
+			for(int j=0; j<3; ++j)
+				dist += planes[p][j] * (planes[p][j] > 0 ? boxPtr[j + 3] : boxPtr[j]);
+			if(dist < 0)
+				inView = false;
+		}
+		if(!inView)
+			continue;
+
+		//Reduce the number of connections drawn from buckets that are far away
+		float boxDistance = 0.0f;
+		for(int j=0; j<3; ++j){
+			if(cameraPos[j] < boxPtr[j])
+				boxDistance += pow(boxPtr[j] - cameraPos[j], 2);
+			else if(cameraPos[j] > boxPtr[j + 3])
+				boxDistance += pow(cameraPos[j] - boxPtr[j + 3], 2);
+		}
+		boxDistance = sqrt(boxDistance);
+		int numDrawn = numSelected;
+		if(boxDistance > lodDistance)
+			numDrawn = (int)ceil(numSelected * pow(lodDistance / boxDistance, 2));
+
+		//Store the indexes of the vertices of the connections with the lowest rank
+		int* conPtr = &bucketConnectionArray[bucketStartArray[bucket]];
+		for(int i=0; i<numDrawn; ++i){
+			connectionIndexArray[numberOfVisibleConnections * 2] = conPtr[i] * 2;
+			connectionIndexArray[numberOfVisibleConnections * 2 + 1] = conPtr[i] * 2 + 1;
+			++numberOfVisibleConnections;
+		}
+	}
+	return true;
+}
+
+
+/*! Sets the colour of both vertices of the connection with the specified index */
+void NetworkViewer::setConnectionColor(int index, const RGBColor& color){
+	GLubyte* colorPtr = &connectionColorArray[index * 6];
+	colorPtr[0] = colorPtr[3] = (GLubyte)(color.red * 255.0f + 0.5f);
+	colorPtr[1] = colorPtr[4] = (GLubyte)(color.green * 255.0f + 0.5f);
+	colorPtr[2] = colorPtr[5] = (GLubyte)(color.blue * 255.0f + 0.5f);
+}
+
+
+/*! Sets the colour of the neuron with the specified index */
+void NetworkViewer::setNeuronColor(int index, const RGBColor& color, float alpha){
+	GLubyte* colorPtr = &neuronColorArray[index * 4];
+	colorPtr[0] = (GLubyte)(color.red * 255.0f + 0.5f);
+	colorPtr[1] = (GLubyte)(color.green * 255.0f + 0.5f);
+	colorPtr[2] = (GLubyte)(color.blue * 255.0f + 0.5f);
+	colorPtr[3] = (GLubyte)(alpha * 255.0f + 0.5f);
+}
+
+
 /*! Zooms into a particular neuron group or zooms out to show whole network. */
 void NetworkViewer::setZoomLevel(){
 	if(Globals::getNetworkDisplay()->isZoomEnabled()){
@@ -1257,3 +2063,62 @@ void NetworkViewer::zoomToNeuronGroup(unsigned int neuronGroupID){
 }
 
 
+/*! Copies an array into a vertex buffer object, if vertex buffers are being used */
+void NetworkViewer::uploadBuffer(QGLBuffer& buffer, const GLvoid* array, int numBytes){
+	if(!useVertexBuffers)
+		return;
+	buffer.bind();
+	if(buffer.size() == numBytes)
+		buffer.write(0, array, numBytes);
+	else
+		buffer.allocate(array, numBytes);
+	buffer.release();
+}
+
+
+/*! Copies part of an array into a vertex buffer object, if vertex buffers are being used.
+	The buffer must already have been allocated with the full size of the array. */
+void NetworkViewer::uploadBufferRange(QGLBuffer& buffer, const GLvoid* array, int offsetBytes, int numBytes){
+	if(!useVertexBuffers)
+		return;
+	buffer.bind();
+	buffer.write(offsetBytes, (const char*)array + offsetBytes, numBytes);
+	buffer.release();
+}
+
+
+/*! Sorts the connections in each bucket in order of their rank and records how many are shown.
+	Connection groups with more connections than the thinning threshold are thinned out by only showing the
+	connections whose rank is below the fraction of the group that is kept, which is the same at every frame. */
+void NetworkViewer::sortConnectionBuckets(){
+	Network* network = Globals::getNetwork();
+	int thinningThreshold = Globals::getNetworkDisplay()->getConnectionThinningThreshold();
+
+	//Work out the rank of each connection relative to the fraction of its group that is kept
+	float* relativeRankArray = new float[numberOfConnections];
+	int conIndex = 0;
+	foreach(unsigned int conGrpID, connectionArrayGroupIDs){
+		int numCons = network->getConnectionGroup(conGrpID)->size();
+		float keepFraction = 1.0f;
+		if(numCons > thinningThreshold)
+			keepFraction = (float)thinningThreshold / (float)numCons;
+		for(int i=0; i<numCons && conIndex < numberOfConnections; ++i, ++conIndex)
+			relativeRankArray[conIndex] = getConnectionRank(conIndex) / keepFraction;
+	}
+
+	//Sort the connections in each bucket in order of rank, so that the connections that are kept come first
+	for(int bucket=0; bucket<numberOfBuckets; ++bucket){
+		QList< QPair<float, int> > rankList;
+		for(int i=bucketStartArray[bucket]; i<bucketStartArray[bucket + 1]; ++i)
+			rankList.append(qMakePair(relativeRankArray[bucketConnectionArray[i]], bucketConnectionArray[i]));
+		qSort(rankList);
+
+		bucketSelectedArray[bucket] = 0;
+		for(int i=0; i<rankList.size(); ++i){
+			bucketConnectionArray[bucketStartArray[bucket] + i] = rankList.at(i).second;
+			if(rankList.at(i).first < 1.0f)
+				++bucketSelectedArray[bucket];
+		}
+	}
+	delete [] relativeRankArray;
+}
@@ -1,5 +1,6 @@
 //SpikeStream includes
 #include "AbstractAnalysisTimeStepThread.h"
+#include "AnalysisRunner.h"
 #include "SpikeStreamException.h"
 #include "Util.h"
 using namespace spikestream;
@@ -21,6 +22,12 @@ AbstractAnalysisTimeStepThread::AbstractAnalysisTimeStepThread(const DBInfo& net
 
 	//Initialize variables
 	timeStep = -1;
+	stop = true;
+	error = false;
+	networkDao = NULL;
+	archiveDao = NULL;
+	analysisRunner = NULL;
+	threadsPerTimeStep = 1;
 }
 
 
@@ -40,13 +47,71 @@ void AbstractAnalysisTimeStepThread::clearError(){
 }
 
 
-/*! Prepares for the analysis by storing the analysis information and time step to be analyzed. */
+/*! Prepares the thread to analyze the time steps supplied by the analysis runner. */
+void AbstractAnalysisTimeStepThread::prepareAnalysis(const AnalysisInfo& anaInfo, AnalysisRunner* analysisRunner){
+	this->analysisInfo = anaInfo;
+	this->analysisRunner = analysisRunner;
+	this->timeStep = -1;
+}
+
+
+/*! Prepares for the analysis by storing the analysis information and the single time step to be analyzed. */
 void AbstractAnalysisTimeStepThread::prepareTimeStepAnalysis(const AnalysisInfo& anaInfo, int timeStep){
 	this->analysisInfo = anaInfo;
+	this->analysisRunner = NULL;
 	this->timeStep = timeStep;
 }
 
 
+/*! Run method inherited from QThread.
+	Creates the data access objects and then analyzes time steps until the runner has no more
+	time steps to hand out, the thread is stopped or an error occurs. */
+void AbstractAnalysisTimeStepThread::run(){
+	stop = false;
+	clearError();
+
+	try{
+		createDaos();
+
+		//Work through the time steps supplied by the runner, or the single time step that has been set
+		int firstTimeStep = timeStep, lastTimeStep = timeStep;
+		while(!stop){
+			if(analysisRunner != NULL && !analysisRunner->takeTimeSteps(firstTimeStep, lastTimeStep))
+				break;
+			analyzeTimeSteps(firstTimeStep, lastTimeStep);
+			if(analysisRunner == NULL)
+				break;
+		}
+	}
+	catch(SpikeStreamException& ex){
+		setError(ex.getMessage());
+	}
+
+	//Clean up the connections to the database
+	try{
+		deleteDaos();
+	}
+	catch(SpikeStreamException& ex){
+		if(!error)
+			setError(ex.getMessage());
+	}
+
+	stop = true;
+
+	//Inform the runner that this thread has finished
+	if(analysisRunner != NULL)
+		analysisRunner->workerFinished(this);
+}
+
+
+/*! Sets the number of threads that can be used within the analysis of a single time step. */
+void AbstractAnalysisTimeStepThread::setThreadsPerTimeStep(unsigned int numThreads){
+	if(numThreads < 1)
+		numThreads = 1;
+	this->threadsPerTimeStep = numThreads;
+}
+
+
 /*! Stops the analysis */
 void AbstractAnalysisTimeStepThread::stopThread(){
 	stop = true;
@@ -70,9 +135,40 @@ void AbstractAnalysisTimeStepThread::updateProgress(const QString& msg, unsigned
 
 
 /*----------------------------------------------------------*/
-/*-----                 PRIVATE METHODS                -----*/
+/*-----               PROTECTED METHODS                -----*/
 /*----------------------------------------------------------*/
 
+/*! Analyzes a chunk of time steps handed out by the runner by calling analyzeTimeStep() for each of them. */
+void AbstractAnalysisTimeStepThread::analyzeTimeSteps(int firstTimeStep, int lastTimeStep){
+	for(timeStep = firstTimeStep; timeStep <= lastTimeStep && !stop; ++timeStep){
+		analyzeTimeStep();
+		if(!stop)
+			emit timeStepComplete(timeStep);
+	}
+}
+
+
+/*! Creates the data access objects used by the thread. Called in the thread before the first time step
+	is analyzed. Classes that use other data access objects should extend this method. */
+void AbstractAnalysisTimeStepThread::createDaos(){
+	networkDao = new NetworkDao(networkDBInfo);
+	archiveDao = new ArchiveDao(archiveDBInfo);
+}
+
+
+/*! Deletes the data access objects used by the thread. Called in the thread after the last time step. */
+void AbstractAnalysisTimeStepThread::deleteDaos(){
+	if(networkDao != NULL){
+		delete networkDao;
+		networkDao = NULL;
+	}
+	if(archiveDao != NULL){
+		delete archiveDao;
+		archiveDao = NULL;
+	}
+}
+
+
 /*! Sets the thread into the error state */
 void AbstractAnalysisTimeStepThread::setError(const QString& message){
 	error = true;
@@ -17,12 +17,22 @@ AbstractSpectrogramData::AbstractSpectrogramData(const AnalysisInfo& analysisInf
 	this->analysisInfo = analysisInfo;
 	allTimeSteps = true;
 	showNeuronIDs = true;
+	selectedTimeStep = -1;
+	minNeuronID = 0;
+	maxNeuronID = 0;
+	numberOfNeurons = 0;
+	neuronIndexArray = NULL;
+	allTimeStepsData = NULL;
+	maxTimeStepValue = 0.0f;
+	maxAllTimeStepsValue = 0.0f;
+	currentData = NULL;
+	currentScale = 0.0f;
 }
 
 
 /*! Destructor */
 AbstractSpectrogramData::~AbstractSpectrogramData(){
-
+	reset();
 }
 
 
@@ -45,12 +55,14 @@ QwtDoubleInterval AbstractSpectrogramData::range() const {
 /*! Sets the current time step that is being plotted */
 void AbstractSpectrogramData::showSelectedTimeStep(unsigned int timeStep){
 	selectedTimeStep = timeStep;
+	updateCurrentData();
 }
 
 
 /*! Controls whether the average over all time steps is shown */
 void AbstractSpectrogramData::showAllTimeSteps(bool show){
 	allTimeSteps = show;
+	updateCurrentData();
 }
 
 
@@ -65,10 +77,14 @@ void AbstractSpectrogramData::setShowNeuronIDs(bool show){
 }
 
 
-/*! Inherited from QwtRasterData */
+/*! Inherited from QwtRasterData. Called for every pixel of the spectrogram, so it
+	reads directly from the matrix of the time step that is being displayed. */
 double AbstractSpectrogramData::value(double x, double y) const {
-	unsigned int tmpX = (unsigned int)rint(x);
-	unsigned int tmpY = (unsigned int)rint(y);
+	if(currentData == NULL)
+		return 0.0;
+
+	int tmpX = (int)rint(x);
+	int tmpY = (int)rint(y);
 
 	//Resolve data as neuron ids or as numbers from 1-networksize
 	if(!showNeuronIDs){
@@ -76,30 +92,13 @@ double AbstractSpectrogramData::value(double x, double y) const {
 		tmpY += minNeuronID - 1;
 	}
 
-	//Get time step
-	unsigned int timeStep = selectedTimeStep;
-	if(allTimeSteps)
-		timeStep = allTimeStepsKey;
-
-	//Check data exists for this time step
-	if(!timeStepDataMap.contains(timeStep)){
-		qCritical()<<"Time step cannot be found"<<timeStep;
+	//Points that do not correspond to a neuron in the analysis have no value
+	int index1 = getNeuronIndex(tmpX);
+	int index2 = getNeuronIndex(tmpY);
+	if(index1 < 0 || index2 < 0)
 		return 0.0;
-	}
 
-	if(tmpX > tmpY){
-		if(!timeStepDataMap[timeStep].contains(tmpY) || !timeStepDataMap[timeStep][tmpY].contains(tmpX)){
-			qCritical()<<"Y and X value cannot be found."<<tmpY<<" "<<tmpX;
-			return 0.0;
-		}
-		return timeStepDataMap[timeStep][tmpY][tmpX];
-	}
-
-	if(!timeStepDataMap[timeStep].contains(tmpX) || !timeStepDataMap[timeStep][tmpX].contains(tmpY)){
-		qCritical()<<"X and Y value cannot be found."<<tmpX<<" "<<tmpY;
-		return 0.0;
-	}
-	return timeStepDataMap[timeStep][tmpX][tmpY];
+	return currentData[getMatrixIndex(index1, index2)] * currentScale;
 }
 
 
@@ -107,88 +106,182 @@ double AbstractSpectrogramData::value(double x, double y) const {
 /*------              PROTECTED METHODS               ------*/
 /*----------------------------------------------------------*/
 
-/*! Adds a time step to the data map with entries for all the neuron ids */
-void AbstractSpectrogramData::addTimeStep(unsigned int timeStep, const QList<unsigned int>& neurIDList){
-	if(timeStepDataMap.contains(timeStep))
-		throw SpikeStreamAnalysisException("Time step already exists in time step data map.");
+/*! Raises the value between every pair of neurons in the list to at least the specified value.
+	The average over all time steps is updated with each change. */
+void AbstractSpectrogramData::addNeuronSet(unsigned int timeStep, const QList<unsigned int>& neurIDList, double value){
+	if(!timeStepDataMap.contains(timeStep))
+		throw SpikeStreamAnalysisException("Time step cannot be found in time step data map: " + QString::number(timeStep));
+	float* timeStepData = timeStepDataMap[timeStep];
+	float newValue = (float)value;
+
+	//Convert the neuron ids into indexes
+	QList<int> indexList;
+	foreach(unsigned int neurID, neurIDList){
+		int index = getNeuronIndex(neurID);
+		if(index < 0)
+			throw SpikeStreamAnalysisException("Neuron ID cannot be found in spectrogram data: " + QString::number(neurID));
+		indexList.append(index);
+	}
 
-	//Add each combination of neuron IDs only once
-	for(int i=0; i<neurIDList.size(); ++i){
-		for(int j=i; j<neurIDList.size(); ++j){
-			//Make sure that map always stores lower number in the first key
-			if(neurIDList.at(i) <= neurIDList.at(j))
-				timeStepDataMap[timeStep][neurIDList.at(i)][neurIDList.at(j)] = 0.0;
-			else
-				timeStepDataMap[timeStep][neurIDList.at(j)][neurIDList.at(i)] = 0.0;
+	//Work through all possible combinations of the neurons. Current measure is symmetrical
+	for(int i=0; i<indexList.size(); ++i){
+		for(int j=i; j<indexList.size(); ++j){
+			int matrixIndex = getMatrixIndex(indexList.at(i), indexList.at(j));
+			if(newValue > timeStepData[matrixIndex]){
+				allTimeStepsData[matrixIndex] += newValue - timeStepData[matrixIndex];
+				timeStepData[matrixIndex] = newValue;
+				if(allTimeStepsData[matrixIndex] > maxAllTimeStepsValue)
+					maxAllTimeStepsValue = allTimeStepsData[matrixIndex];
+			}
 		}
 	}
+	if(newValue > maxTimeStepValue)
+		maxTimeStepValue = newValue;
+
+	updateCurrentData();
 }
 
 
-/*! Calculates the average over all time steps */
-void AbstractSpectrogramData::addAllTimeStepsMap(const QList<unsigned int>& neurIDList){
-	//Identify a key that is not currently in use
-	for(int i=0; i< timeStepDataMap.size() + 10; ++i){
-		if(!timeStepDataMap.contains(i)){
-			allTimeStepsKey = i;
-			addTimeStep(i, neurIDList);
-			break;
-		}
+/*! Adds a time step to the data with zero values between all of the neurons.
+	setNeuronIDs must have been called first. */
+void AbstractSpectrogramData::addTimeStep(unsigned int timeStep){
+	if(timeStepDataMap.contains(timeStep))
+		throw SpikeStreamAnalysisException("Time step already exists in time step data map.");
+	if(allTimeStepsData == NULL)
+		throw SpikeStreamAnalysisException("Neuron IDs must be set before time steps are added.");
+
+	int matrixSize = numberOfNeurons * (numberOfNeurons + 1) / 2;
+	float* timeStepData = new float[matrixSize];
+	for(int i=0; i<matrixSize; ++i)
+		timeStepData[i] = 0.0f;
+	timeStepDataMap[timeStep] = timeStepData;
+
+	updateCurrentData();
+}
+
+
+/*! Prints out the data */
+void AbstractSpectrogramData::printData(){
+	cout<<"-------------  All Time Steps  -----------------"<<endl;
+	printMatrix(allTimeStepsData);
+	for(QHash<unsigned int, float*>::iterator tsIter = timeStepDataMap.begin(); tsIter != timeStepDataMap.end(); ++tsIter){
+		cout<<"-------------  Time step: "<<tsIter.key()<<"  -----------------"<<endl;
+		printMatrix(tsIter.value());
 	}
+	cout<<endl;
+}
 
-	//Sum the integration between neurons for each time step
-	for(QHash<unsigned int, QHash<unsigned int, QHash<unsigned int, double> > >::iterator tsIter = timeStepDataMap.begin(); tsIter != timeStepDataMap.end(); ++tsIter)	{
-		if(tsIter.key() != allTimeStepsKey){
-			for(QHash<unsigned int, QHash<unsigned int, double> >::iterator neur1Iter = tsIter.value().begin(); neur1Iter != tsIter.value().end(); ++neur1Iter){
-				for(QHash<unsigned int, double>::iterator neur2Iter = neur1Iter.value().begin(); neur2Iter != neur1Iter.value().end(); ++neur2Iter){
-					timeStepDataMap[allTimeStepsKey][neur1Iter.key()][neur2Iter.key()] += neur2Iter.value();
-				}
-			}
-		}
+
+/*! Resets the data */
+void AbstractSpectrogramData::reset(){
+	for(QHash<unsigned int, float*>::iterator iter = timeStepDataMap.begin(); iter != timeStepDataMap.end(); ++iter)
+		delete [] iter.value();
+	timeStepDataMap.clear();
+
+	if(allTimeStepsData != NULL){
+		delete [] allTimeStepsData;
+		allTimeStepsData = NULL;
 	}
+	if(neuronIndexArray != NULL){
+		delete [] neuronIndexArray;
+		neuronIndexArray = NULL;
+	}
+	numberOfNeurons = 0;
+	maxTimeStepValue = 0.0f;
+	maxAllTimeStepsValue = 0.0f;
+	currentData = NULL;
+	currentScale = 0.0f;
+}
 
-	//Divide by the number of time steps
-	double numTimeSteps = timeStepDataMap.size() - 1;
-	double max = 0.0;
-	for(QHash<unsigned int, QHash<unsigned int, double> >::iterator neur1Iter = timeStepDataMap[allTimeStepsKey].begin(); neur1Iter != timeStepDataMap[allTimeStepsKey].end(); ++neur1Iter){
-		for(QHash<unsigned int, double>::iterator neur2Iter = neur1Iter.value().begin(); neur2Iter != neur1Iter.value().end(); ++neur2Iter){
-			timeStepDataMap[allTimeStepsKey][neur1Iter.key()][neur2Iter.key()] /= numTimeSteps;
 
-			//Find maximum
-			if(timeStepDataMap[allTimeStepsKey][neur1Iter.key()][neur2Iter.key()] > max)
-				max = timeStepDataMap[allTimeStepsKey][neur1Iter.key()][neur2Iter.key()];
-		}
+/*! Sets the neurons in the analysis, which must be called before time steps are added.
+	Also sets the minimum and maximum neuron IDs and the bounding rectangle. */
+void AbstractSpectrogramData::setNeuronIDs(const QList<unsigned int>& neurIDList){
+	reset();
+
+	//Calculate the minimum and maximum neuron id for the graph range
+	minNeuronID = 0;
+	maxNeuronID = 0;
+	for(int i=0; i<neurIDList.size(); ++i){
+		if(i == 0 || neurIDList.at(i) < minNeuronID)
+			minNeuronID = neurIDList.at(i);
+		if(i == 0 || neurIDList.at(i) > maxNeuronID)
+			maxNeuronID = neurIDList.at(i);
 	}
 
-	//Normalize
-	for(QHash<unsigned int, QHash<unsigned int, double> >::iterator neur1Iter = timeStepDataMap[allTimeStepsKey].begin(); neur1Iter != timeStepDataMap[allTimeStepsKey].end(); ++neur1Iter){
-		for(QHash<unsigned int, double>::iterator neur2Iter = neur1Iter.value().begin(); neur2Iter != neur1Iter.value().end(); ++neur2Iter){
-			timeStepDataMap[allTimeStepsKey][neur1Iter.key()][neur2Iter.key()] /= max;
-		}
+	//Map each neuron id to its position in the list
+	numberOfNeurons = neurIDList.size();
+	int neuronIDRange = maxNeuronID - minNeuronID + 1;
+	neuronIndexArray = new int[neuronIDRange];
+	for(int i=0; i<neuronIDRange; ++i)
+		neuronIndexArray[i] = -1;
+	for(int i=0; i<numberOfNeurons; ++i)
+		neuronIndexArray[neurIDList.at(i) - minNeuronID] = i;
+
+	//Create the matrix holding the sum over all time steps
+	int matrixSize = numberOfNeurons * (numberOfNeurons + 1) / 2;
+	allTimeStepsData = new float[matrixSize];
+	for(int i=0; i<matrixSize; ++i)
+		allTimeStepsData[i] = 0.0f;
+
+	//Set the bounding rectangle
+	setShowNeuronIDs(showNeuronIDs);
+
+	updateCurrentData();
+}
+
+
+/*----------------------------------------------------------*/
+/*------               PRIVATE METHODS                ------*/
+/*----------------------------------------------------------*/
+
+/*! Returns the position in an upper triangular matrix of the value between the neurons with the specified indexes */
+int AbstractSpectrogramData::getMatrixIndex(int index1, int index2) const {
+	if(index1 > index2){
+		int tmpIndex = index1;
+		index1 = index2;
+		index2 = tmpIndex;
 	}
+	return index1 * (2 * numberOfNeurons - index1 - 1) / 2 + index2;
 }
 
 
-/*! Prints out the data */
-void AbstractSpectrogramData::printData(){
-	for(QHash<unsigned int, QHash<unsigned int, QHash<unsigned int, double> > >::iterator tsIter = timeStepDataMap.begin(); tsIter != timeStepDataMap.end(); ++tsIter)	{
-		if(tsIter.key() == allTimeStepsKey)
-			cout<<"-------------  All Time Steps  -----------------"<<endl;
-		else
-			cout<<"-------------  Time step: "<<tsIter.key()<<"  -----------------"<<endl;
-		for(QHash<unsigned int, QHash<unsigned int, double> >::iterator neur1Iter = tsIter.value().begin(); neur1Iter != tsIter.value().end(); ++neur1Iter){
-			for(QHash<unsigned int, double>::iterator neur2Iter = neur1Iter.value().begin(); neur2Iter != neur1Iter.value().end(); ++neur2Iter){
-				cout<<"From "<<neur1Iter.key()<<" to "<<neur2Iter.key()<<" phi="<<neur2Iter.value()<<endl;
-			}
+/*! Returns the index of the neuron in the matrices or -1 if the neuron is not part of the analysis */
+int AbstractSpectrogramData::getNeuronIndex(int neuronID) const {
+	if(neuronIndexArray == NULL || neuronID < (int)minNeuronID || neuronID > (int)maxNeuronID)
+		return -1;
+	return neuronIndexArray[neuronID - minNeuronID];
+}
+
+
+/*! Prints out the values between each pair of neurons in a matrix */
+void AbstractSpectrogramData::printMatrix(const float* matrix){
+	for(unsigned int neurID1 = minNeuronID; neurID1 <= maxNeuronID && numberOfNeurons > 0; ++neurID1){
+		for(unsigned int neurID2 = neurID1; neurID2 <= maxNeuronID; ++neurID2){
+			int index1 = getNeuronIndex(neurID1), index2 = getNeuronIndex(neurID2);
+			if(index1 >= 0 && index2 >= 0)
+				cout<<"From "<<neurID1<<" to "<<neurID2<<" value="<<matrix[getMatrixIndex(index1, index2)]<<endl;
 		}
 	}
-	cout<<endl;
 }
 
 
-/*! Resets the data */
-void AbstractSpectrogramData::reset(){
-	timeStepDataMap.clear();
+/*! Points currentData at the matrix that is being displayed and sets the factor that normalizes it.
+	Time steps are normalized by the maximum value in all of the time steps; the average over all time
+	steps is normalized by its own maximum. */
+void AbstractSpectrogramData::updateCurrentData(){
+	currentData = NULL;
+	currentScale = 0.0f;
+	if(allTimeSteps){
+		currentData = allTimeStepsData;
+		if(maxAllTimeStepsValue > 0.0f)
+			currentScale = 1.0f / maxAllTimeStepsValue;
+	}
+	else if(selectedTimeStep >= 0 && timeStepDataMap.contains(selectedTimeStep)){
+		currentData = timeStepDataMap[selectedTimeStep];
+		if(maxTimeStepValue > 0.0f)
+			currentScale = 1.0f / maxTimeStepValue;
+	}
 }
 
 
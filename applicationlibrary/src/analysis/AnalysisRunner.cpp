@@ -1,5 +1,6 @@
 #include "AnalysisRunner.h"
 #include "Globals.h"
+#include "NetworkDao.h"
 #include "SpikeStreamException.h"
 using namespace spikestream;
 
@@ -19,12 +20,18 @@ AnalysisRunner::AnalysisRunner(const DBInfo& netDBInfo, const DBInfo& archDBInfo
 	this->analysisDBInfo = anaDBInfo;
 
 	//Initialize variables
-	stopThread = true;
+	loadWeightlessNetwork = false;
+	timeStepChunkSize = 1;
+	runningWorkers = 0;
+	createAnalysisTimeStepThread = NULL;
+	reset();
 }
 
 
 /*! Destructor */
 AnalysisRunner::~AnalysisRunner(){
+	stop();
+	wait();
 }
 
 
@@ -34,9 +41,7 @@ AnalysisRunner::~AnalysisRunner(){
 
 /*! Sets up the class ready to carry out the analysis */
 void AnalysisRunner::prepareAnalysisTask(const AnalysisInfo& analysisInfo, int firstTimeStep, int lastTimeStep){
-	if(subThreadsRunning())
-		throw SpikeStreamException("Cannot prepare analysis task when sub threads are running.");
-	if(stopThread == false)
+	if(isRunning())
 		throw SpikeStreamException("Cannot prepare analysis task when analysis thread is running.");
 
 	//Reset class
@@ -57,50 +62,52 @@ void AnalysisRunner::prepareAnalysisTask(const AnalysisInfo& analysisInfo, int f
 
 
 /*! Run method inherited from QThread.
-	A parameter controls how many threads are launched at once.
-	Each new thread is connected to appropriate signals and when it finishes a new thread is launched
-	until all of the time steps have been analyzed. */
+	A parameter controls how many worker threads are launched. Each worker takes time steps from the
+	queue until all of them have been analyzed. This thread sleeps until the workers have finished. */
 void AnalysisRunner::run(){
-	stopThread = false;
-
-	//Launch the first batch of threads
-	unsigned int threadCount = 0;
-	while(threadCount < analysisInfo.getNumberOfThreads()){
-		int tmpTimeStep = getNextTimeStep();
-
-		//No more time steps, break out of the launching loop
-		if(tmpTimeStep == -1)
-			break;
-
-		//Start the thread running to analyze this time step
+	/* Load the weightless neurons once for the whole analysis instead of once per time step.
+	   Networks that are not weightless are left for the time step threads to report. */
+	if(loadWeightlessNetwork){
 		try{
-			startAnalysisTimeStepThread(tmpTimeStep);
-			++threadCount;
+			NetworkDao networkDao(networkDBInfo);
+			if(networkDao.isWeightlessNetwork(analysisInfo.getNetworkID())){
+				weightlessNetwork = WeightlessNetworkSnapshotPtr(networkDao.getWeightlessNetworkSnapshot(analysisInfo.getNetworkID()));
+				if(analysisInfo.getParameterMap().contains("generalization"))
+					weightlessNetwork->setGeneralization(analysisInfo.getParameter("generalization"));
+			}
 		}
 		catch(SpikeStreamException& ex){
 			setError(ex.getMessage());
+			return;
 		}
 	}
 
-	/* Wait for the analysis to complete
-	When all of the sub threads have finished, stopThread should be set to true. */
-	while(!stopThread){
-		usleep(500000);//Sleep for half a second
-	}
+	//Launch the pool of workers and wait for them to analyze all of the time steps
+	startWorkers();
+	waitForWorkers();
+
+	//Clean up
+	deleteWorkers();
+	weightlessNetwork.clear();
 }
 
 
-/*! Stops the thread running */
+/*! Stops the analysis. The worker threads finish as soon as they can and
+	no more time steps are handed out. Returns without waiting for the workers to finish. */
 void AnalysisRunner::stop(){
-	//Halt all of the other threads and wait for them to finish
-	for(QHash<int, AbstractAnalysisTimeStepThread*>::iterator iter = subThreadMap.begin(); iter != subThreadMap.end(); ++iter){
-		iter.value()->stopThread();
-		iter.value()->wait();
-		delete iter.value();
-	}
+	QMutexLocker locker(&mutex);
+	stopWorkers();
+}
 
-	subThreadMap.clear();
-	stopThread = true;
+
+/*! Sets the number of consecutive time steps that are handed to a worker at once.
+	Larger chunks reduce contention for the queue when each time step takes very little time. */
+void AnalysisRunner::setTimeStepChunkSize(unsigned int chunkSize){
+	if(isRunning())
+		throw SpikeStreamException("Cannot change the time step chunk size when analysis thread is running.");
+	if(chunkSize == 0)
+		throw SpikeStreamException("Time step chunk size must be greater than zero.");
+	timeStepChunkSize = chunkSize;
 }
 
 
@@ -110,66 +117,43 @@ void AnalysisRunner::setTimeStepThreadCreationFunction(AbstractAnalysisTimeStepT
 }
 
 
-/*-------------------------------------------------------------*/
-/*-------                  PRIVATE SLOTS                 ------*/
-/*-------------------------------------------------------------*/
-
-/*! Called when one of the sub threads emits a progress signal */
-void AnalysisRunner::updateProgress(const QString& msg, unsigned int timeStep, unsigned int stepsCompleted, unsigned int totalSteps){
-	emit progress(msg, timeStep, stepsCompleted, totalSteps);
-}
-
-
-/*! Called when one of the sub threads finishes.
-	Another thread is launched if time steps sill need to be analyzed. */
-void AnalysisRunner::threadFinished(){
-	//Do nothing if thread is trying to stop
-	if(stopThread)
-		return;
-
-	/* Multiple sub threads could call this method simultaneously and mess things up
-	Lock mutex to make sure we only process one thread finished event at a time. */
-	QMutexLocker(&this->mutex);
-
-	//Get a reference to the thread that has stopped
-	AbstractAnalysisTimeStepThread* tmpSubThread = (AbstractAnalysisTimeStepThread*) sender();
+/*! Called by the worker threads to get the next time steps to be analyzed.
+	Returns false when all of the time steps have been handed out or the analysis has been stopped. */
+bool AnalysisRunner::takeTimeSteps(int& firstTimeStep, int& lastTimeStep){
+	QMutexLocker locker(&mutex);
+	if(nextTimeStep == -1)
+		return false;
 
-	//Remove it from the map of currently running threads
-	int tmpTimeStep = tmpSubThread->getTimeStep();
-	if(!subThreadMap.contains(tmpTimeStep)){
-		setError("Thread with time step " + QString::number(tmpTimeStep) + " is not recorded as running.");
-		return;
+	//Hand out the next chunk of time steps
+	firstTimeStep = nextTimeStep;
+	lastTimeStep = nextTimeStep + timeStepChunkSize - 1;
+	if(lastTimeStep >= this->lastTimeStep){
+		lastTimeStep = this->lastTimeStep;
+		nextTimeStep = -1;//No more time steps left
 	}
-
-	//Check for errors - set error will delete all of the threads
-	if(tmpSubThread->isError()){
-		setError(tmpSubThread->getErrorMessage());
-		return;
+	else{
+		nextTimeStep = lastTimeStep + 1;
 	}
+	return true;
+}
 
-	//Delete the thread class and remove it from the map
-	delete tmpSubThread;
-	subThreadMap.remove(tmpTimeStep);
 
-	//Inform listening classes that the analysis of this time step is now complete.
-	emit timeStepComplete(tmpTimeStep);
+/*! Called by a worker thread when it has finished running */
+void AnalysisRunner::workerFinished(AbstractAnalysisTimeStepThread* worker){
+	QMutexLocker locker(&mutex);
+	finishedWorkerList.append(worker);
+	--runningWorkers;
+	workerFinishedCondition.wakeAll();
+}
 
-	//Determine if any time steps need to be analyzed
-	int tmpNextTimeStep = getNextTimeStep();
-	if(tmpNextTimeStep >= 0){
-		try{
-			startAnalysisTimeStepThread(tmpNextTimeStep);
-		}
-		catch(SpikeStreamException& ex){
-			setError(ex.getMessage());
-		}
-	}
 
-	//Next time step is -1. All of the time step threads have been launched and may have all finished
-	else if(!subThreadsRunning()){//See if any threads are still running
-		//Stop this thread when no sub threads are running
-		stop();
-	}
+/*-------------------------------------------------------------*/
+/*-------                  PRIVATE SLOTS                 ------*/
+/*-------------------------------------------------------------*/
+
+/*! Called when one of the sub threads emits a progress signal */
+void AnalysisRunner::updateProgress(const QString& msg, unsigned int timeStep, unsigned int stepsCompleted, unsigned int totalSteps){
+	emit progress(msg, timeStep, stepsCompleted, totalSteps);
 }
 
 
@@ -179,6 +163,12 @@ void AnalysisRunner::updateResults(){
 }
 
 
+/*! Informs listening classes that the analysis of a time step is complete. */
+void AnalysisRunner::updateTimeStepComplete(unsigned int timeStep){
+	emit timeStepComplete(timeStep);
+}
+
+
 /*-------------------------------------------------------------*/
 /*-------                PRIVATE METHODS                 ------*/
 /*-------------------------------------------------------------*/
@@ -190,29 +180,20 @@ void AnalysisRunner::clearError(){
 }
 
 
-/*! Returns the next time step to be analyzed or -1 if no time steps remain
-	to be analyzed. */
-int AnalysisRunner::getNextTimeStep(){
-	if(nextTimeStep == -1)
-		return -1;
-
-	//Store current value of next time step. This is what will be returned
-	int oldNextTimeStep = nextTimeStep;
-
-	//Increase the next time step and check to see if it has exceeded the range
-	++nextTimeStep;
-	if(nextTimeStep > lastTimeStep)
-		nextTimeStep = -1;//No more time steps left. -1 will be returned next time this method is called
-
-	//Return the original value of the next time step before it was increased or invalidated
-	return oldNextTimeStep;
+/*! Deletes the worker threads, which must have finished running */
+void AnalysisRunner::deleteWorkers(){
+	QMutexLocker locker(&mutex);
+	foreach(AbstractAnalysisTimeStepThread* worker, workerList){
+		worker->wait();
+		delete worker;
+	}
+	workerList.clear();
+	finishedWorkerList.clear();
 }
 
 
 /*! Resets this class ready for another analysis. All information should be cleared. */
 void AnalysisRunner::reset(){
-	subThreadMap.clear();
-	stopThread = true;
 	clearError();
 	firstTimeStep = -1;
 	lastTimeStep = -1;
@@ -220,41 +201,81 @@ void AnalysisRunner::reset(){
 }
 
 
-/*! Sets the thread into the error state */
+/*! Sets the analysis into the error state and stops it */
 void AnalysisRunner::setError(const QString& message){
+	QMutexLocker locker(&mutex);
 	error = true;
 	errorMessage = message;
-
-	//exit this thread
-	stop();
+	stopWorkers();
 }
 
 
-/*! Starts a thread to analyze a particular time step */
-void AnalysisRunner::startAnalysisTimeStepThread(int timeStep){
-	//Run some checks on the time step
-	if(timeStep == -1){
-		throw SpikeStreamException("Trying to start a new thread with an invalid time step.");
+/*! Launches the worker threads. The number of workers is set by the analysis, but there is
+	no point in launching more workers than there are time steps. Threads that are not
+	needed for workers are shared out between the workers to use within each time step. */
+void AnalysisRunner::startWorkers(){
+	QMutexLocker locker(&mutex);
+	if(nextTimeStep == -1)
+		return;
+
+	int numberOfWorkers = analysisInfo.getNumberOfThreads();
+	int numberOfChunks = (lastTimeStep - firstTimeStep + timeStepChunkSize) / timeStepChunkSize;
+	if(numberOfWorkers > numberOfChunks)
+		numberOfWorkers = numberOfChunks;
+	if(numberOfWorkers < 1)
+		numberOfWorkers = 1;
+	unsigned int threadsPerTimeStep = analysisInfo.getNumberOfThreads() / numberOfWorkers;
+
+	try{
+		if(createAnalysisTimeStepThread == NULL)
+			throw SpikeStreamException("Time step thread creation function has not been set.");
+		for(int i=0; i<numberOfWorkers; ++i){
+			AbstractAnalysisTimeStepThread* newThread = createAnalysisTimeStepThread(networkDBInfo, archiveDBInfo, analysisDBInfo);
+			connect(newThread, SIGNAL(newResultsFound()), this, SLOT(updateResults()));
+			connect(newThread, SIGNAL(timeStepComplete(unsigned int)), this, SLOT(updateTimeStepComplete(unsigned int)));
+			connect(newThread, SIGNAL(progress(const QString&, unsigned int, unsigned int, unsigned int)), this, SLOT(updateProgress(const QString&, unsigned int, unsigned int, unsigned int)));
+			newThread->prepareAnalysis(analysisInfo, this);
+			newThread->setWeightlessNetwork(weightlessNetwork);
+			newThread->setThreadsPerTimeStep(threadsPerTimeStep);
+			workerList.append(newThread);
+			++runningWorkers;
+			newThread->start();
+		}
 	}
-	if(subThreadMap.contains(timeStep)){
-		throw SpikeStreamException("Trying to launch new thread to analyze time step " + QString::number(timeStep) + " which is already running.");
+	catch(SpikeStreamException& ex){
+		error = true;
+		errorMessage = ex.getMessage();
+		stopWorkers();
 	}
+}
 
-	//Lanch the new thread and store its address in the map
-	AbstractAnalysisTimeStepThread* newThread = createAnalysisTimeStepThread(networkDBInfo, archiveDBInfo, analysisDBInfo);
-	connect(newThread, SIGNAL(newResultsFound()), this, SLOT(updateResults()));
-	connect(newThread, SIGNAL(finished()), this, SLOT(threadFinished()));
-	connect(newThread, SIGNAL(progress(const QString&, unsigned int, unsigned int, unsigned int)), this, SLOT(updateProgress(const QString&, unsigned int, unsigned int, unsigned int)));
-	newThread->prepareTimeStepAnalysis(analysisInfo, timeStep);
-	subThreadMap[timeStep] = newThread;
-	newThread->start();
+
+/*! Stops the worker threads and empties the queue of time steps. The mutex must be locked when this is called. */
+void AnalysisRunner::stopWorkers(){
+	nextTimeStep = -1;
+	foreach(AbstractAnalysisTimeStepThread* worker, workerList)
+		worker->stopThread();
 }
 
 
-/*! Returns true if threads are running carrying out the analysis of time steps. */
-bool AnalysisRunner::subThreadsRunning(){
-	if(subThreadMap.isEmpty())
-		return false;
-	return true;
+/*! Sleeps until all of the workers have finished. If a worker finishes with an error,
+	the analysis is put into the error state and the other workers are stopped. */
+void AnalysisRunner::waitForWorkers(){
+	QMutexLocker locker(&mutex);
+	while(true){
+		//Check the workers that have finished for errors
+		foreach(AbstractAnalysisTimeStepThread* worker, finishedWorkerList){
+			if(worker->isError() && !error){
+				error = true;
+				errorMessage = worker->getErrorMessage();
+				stopWorkers();
+			}
+		}
+		finishedWorkerList.clear();
+
+		if(runningWorkers == 0)
+			break;
+		workerFinishedCondition.wait(&mutex);
+	}
 }
 
@@ -15,6 +15,7 @@ MembranePotentialGraphDialog::MembranePotentialGraphDialog(neurid_t neuronID, QW
 
 	try{
 		memPotWidget = new MembranePotentialGraphWidget(this);
+		memPotWidget->addNeuron(neuronID);
 		mainVBox->addWidget(memPotWidget);
 	}
 	catch(SpikeStreamException& ex){
@@ -35,7 +36,25 @@ MembranePotentialGraphDialog::~MembranePotentialGraphDialog(){
 /*------                PRIVATE SLOTS                 ------*/
 /*----------------------------------------------------------*/
 
-/*! Adds membrane potential data and replots the graph. */
-void MembranePotentialGraphDialog::addData(float membranePotential, timestep_t timeStep){
-	memPotWidget->addData(membranePotential,timeStep);
+/*! Adds membrane potential data and replots the graph.
+	The map can hold the potentials of all the neurons in the network; only the plotted neurons are read. */
+void MembranePotentialGraphDialog::addData(const QHash<unsigned, float>& membranePotentialMap, timestep_t timeStep){
+	memPotWidget->addData(membranePotentialMap, timeStep);
+}
+
+
+/*! Adds another neuron to the graph and lists the plotted neurons in the title */
+void MembranePotentialGraphDialog::addNeuron(neurid_t neuronID){
+	memPotWidget->addNeuron(neuronID);
+
+	const vector<neurid_t>& neuronIDs = memPotWidget->getNeuronIDs();
+	if(neuronIDs.size() < 2)
+		return;
+	QString neuronIDStr;
+	for(size_t i=0; i<neuronIDs.size(); ++i){
+		if(i > 0)
+			neuronIDStr += ", ";
+		neuronIDStr += QString::number(neuronIDs[i]);
+	}
+	this->setWindowTitle("Membrane Potential for Neurons " + neuronIDStr);
 }
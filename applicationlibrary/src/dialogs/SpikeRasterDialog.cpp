@@ -8,21 +8,41 @@ using namespace spikestream;
 #include <QDebug>
 #include <QLayout>
 
+//Interval between redraws of the history plot in milliseconds
+#define HISTORY_UPDATE_INTERVAL_MS 1000
+
 
 /*! Constructor */
 SpikeRasterDialog::SpikeRasterDialog(QList<NeuronGroup*> neuronGroupList, QWidget* parent) : QDialog(parent){
 	QVBoxLayout* mainVBox = new QVBoxLayout(this);
+	spikeRasterWidget = NULL;
+	tabWidget = NULL;
+	rasterModel = NULL;
+	rasterView = NULL;
+	historyChanged = false;
 
 	try{
 		spikeRasterWidget = new SpikeRasterWidget(neuronGroupList, this);
 
+		//History plot, which is only redrawn while its tab is visible
+		rasterModel = new RasterModel(neuronGroupList);
+		rasterView = new RasterView(rasterModel, this);
+		historyTimer = new QTimer(this);
+		connect(historyTimer, SIGNAL(timeout()), this, SLOT(updateHistory()));
+		historyTimer->start(HISTORY_UPDATE_INTERVAL_MS);
+
 		QComboBox* colorCombo = new QComboBox();
 		colorCombo->addItem("Color");
 		colorCombo->addItem("Black and white");
 		connect(colorCombo, SIGNAL(currentIndexChanged(int)), this, SLOT(colorComboChanged(int)));
 
+		tabWidget = new QTabWidget();
+		tabWidget->addTab(spikeRasterWidget, "Recent");
+		tabWidget->addTab(rasterView, "History");
+		connect(tabWidget, SIGNAL(currentChanged(int)), this, SLOT(updateHistory()));
+
 		mainVBox->addWidget(colorCombo);
-		mainVBox->addWidget(spikeRasterWidget);
+		mainVBox->addWidget(tabWidget);
 	}
 	catch(SpikeStreamException& ex){
 		qCritical()<<"Raster error: "<<ex.getMessage();
@@ -55,7 +75,24 @@ void SpikeRasterDialog::colorComboChanged(int index){
 	}
 }
 
-/*! Adds firing neuron data and replots the spike raster. */
-void SpikeRasterDialog::addData(const QList<unsigned>& firingNeuronIDs, unsigned timeStep){
-	spikeRasterWidget->addSpikes(firingNeuronIDs,timeStep);
+/*! Redraws the history plot if it is visible and data has been added since it was last drawn. */
+void SpikeRasterDialog::updateHistory(){
+	if(tabWidget == NULL || !historyChanged || tabWidget->currentWidget() != rasterView)
+		return;
+	rasterView->rescale();
+	historyChanged = false;
+}
+
+
+/*----------------------------------------------------------*/
+/*------               PUBLIC METHODS                 ------*/
+/*----------------------------------------------------------*/
+
+/*! Adds firing neuron data, replots the spike raster and stores the data in the history. */
+void SpikeRasterDialog::addData(const SpikeFrame& spikeFrame){
+	spikeRasterWidget->addSpikes(spikeFrame);
+	if(rasterModel != NULL){
+		rasterModel->addData(spikeFrame);
+		historyChanged = true;
+	}
 }
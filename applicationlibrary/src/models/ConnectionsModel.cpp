@@ -10,11 +10,22 @@ using namespace spikestream;
 #include <QDebug>
 #include <QIcon>
 
+//Other includes
+#include <algorithm>
+
 
 /*! Constructor */
 ConnectionsModel::ConnectionsModel() : QAbstractTableModel(){
+	sortColumn = -1;
+	sortOrder = Qt::AscendingOrder;
+	fromNeuronFilter = 0;
+	toNeuronFilter = 0;
+	weightFilterSet = false;
+	minWeightFilter = 0.0f;
+	maxWeightFilter = 0.0f;
+
 	connect(Globals::getEventRouter(), SIGNAL(visibleConnectionsChangedSignal()), this, SLOT(visibleConnectionsChanged()), Qt::QueuedConnection);
-	connect(Globals::getEventRouter(), SIGNAL(weightsChangedSignal()), this, SLOT(visibleConnectionsChanged()), Qt::QueuedConnection);
+	connect(Globals::getEventRouter(), SIGNAL(weightsChangedSignal()), this, SLOT(weightsChanged()), Qt::QueuedConnection);
 }
 
 
@@ -27,6 +38,15 @@ ConnectionsModel::~ConnectionsModel(){
 /*-----                 PUBLIC METHODS                 -----*/
 /*----------------------------------------------------------*/
 
+/*! Shows connections with any weight */
+void ConnectionsModel::clearWeightFilter(){
+	if(!weightFilterSet)
+		return;
+	weightFilterSet = false;
+	loadRows();
+}
+
+
 /*! Inherited from QAbstractTableModel. Returns the number of columns in the model */
 int ConnectionsModel::columnCount(const QModelIndex&) const{
     return numCols;
@@ -48,9 +68,10 @@ QVariant ConnectionsModel::data(const QModelIndex & index, int role) const{
 
     //Return appropriate data
     if (role == Qt::DisplayRole){
-		//Get pointer to the appropriate Connection class
-		QList<Connection*>& tmpConList = Globals::getNetworkDisplay()->getVisibleConnectionsList();
-		Connection* tmpConnection = tmpConList[index.row()];
+		//Get pointer to the connection in its connection group
+		Connection* tmpConnection = getConnection(rowIndexVector[index.row()]);
+		if(tmpConnection == NULL)
+			return QVariant();
 
 		if(index.column() == idCol)
 			return tmpConnection->getID();
@@ -99,13 +120,80 @@ QVariant ConnectionsModel::headerData(int section, Qt::Orientation orientation,
 
 /*! Inherited from QAbstractTableModel. Returns the number of rows in the model. */
 int ConnectionsModel::rowCount(const QModelIndex&) const{
-	return Globals::getNetworkDisplay()->getVisibleConnectionsList().size();
+	return rowIndexVector.size();
+}
+
+
+/*! Only shows connections from the specified neuron. All connections are shown when the ID is 0. */
+void ConnectionsModel::setFromNeuronFilter(unsigned int neuronID){
+	if(neuronID == fromNeuronFilter)
+		return;
+	fromNeuronFilter = neuronID;
+	loadRows();
+}
+
+
+/*! Only shows connections to the specified neuron. All connections are shown when the ID is 0. */
+void ConnectionsModel::setToNeuronFilter(unsigned int neuronID){
+	if(neuronID == toNeuronFilter)
+		return;
+	toNeuronFilter = neuronID;
+	loadRows();
 }
 
 
-/*! Instructs viewers to reload model when network display has changed */
+/*! Only shows connections whose weights are in the specified range. */
+void ConnectionsModel::setWeightFilter(float minWeight, float maxWeight){
+	if(weightFilterSet && minWeight == minWeightFilter && maxWeight == maxWeightFilter)
+		return;
+	weightFilterSet = true;
+	minWeightFilter = minWeight;
+	maxWeightFilter = maxWeight;
+	loadRows();
+}
+
+
+/*! Inherited from QAbstractTableModel. Sorts the rows by the values in the specified column.
+	The connections stay where they are and only the row indexes are reordered. */
+void ConnectionsModel::sort(int column, Qt::SortOrder order){
+	if(column < 0 || column >= numCols)
+		column = -1;
+	sortColumn = column;
+	sortOrder = order;
+
+	emit layoutAboutToBeChanged();
+	sortRows();
+	emit layoutChanged();
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                  PRIVATE SLOTS                 -----*/
+/*----------------------------------------------------------*/
+
+/*! Reloads the rows when the list of visible connections has changed */
 void ConnectionsModel::visibleConnectionsChanged(){
-	reset();
+	loadRows();
+}
+
+
+/*! Updates the weights in the table. The rows only have to be reloaded if the weights decide
+	which rows are shown or the order of the rows; otherwise viewers just redraw the weight columns. */
+void ConnectionsModel::weightsChanged(){
+	if(rowIndexVector.empty())
+		return;
+
+	if(weightFilterSet){
+		loadRows();
+	}
+	else if(sortColumn == weightCol || sortColumn == tmpWeightCol){
+		emit layoutAboutToBeChanged();
+		sortRows();
+		emit layoutChanged();
+	}
+	else{
+		emit dataChanged(index(0, weightCol), index(rowIndexVector.size() - 1, tmpWeightCol));
+	}
 }
 
 
@@ -113,4 +201,90 @@ void ConnectionsModel::visibleConnectionsChanged(){
 /*-----                PRIVATE METHODS                 -----*/
 /*----------------------------------------------------------*/
 
+/*! Returns true if the connection passes the filters and should be shown in the table */
+bool ConnectionsModel::filterConnection(Connection* connection) const{
+	if(fromNeuronFilter != 0 && connection->getFromNeuronID() != fromNeuronFilter)
+		return false;
+	if(toNeuronFilter != 0 && connection->getToNeuronID() != toNeuronFilter)
+		return false;
+	if(weightFilterSet && (connection->getWeight() < minWeightFilter || connection->getWeight() > maxWeightFilter))
+		return false;
+	return true;
+}
+
+
+/*! Returns the connection at the specified index in the list of visible connections.
+	Returns NULL if the list has changed and the index no longer points to a connection. */
+Connection* ConnectionsModel::getConnection(int visibleIndex) const{
+	vector<VisibleConnection>& visibleConnections = Globals::getNetworkDisplay()->getVisibleConnections();
+	if(visibleIndex < 0 || visibleIndex >= (int)visibleConnections.size())
+		return NULL;
+
+	const VisibleConnection& visibleConnection = visibleConnections[visibleIndex];
+	ConnectionGroup* conGrp = Globals::getNetwork()->getConnectionGroup(visibleConnection.connectionGroupID);
+	if((int)visibleConnection.index >= conGrp->size())
+		return NULL;
+	return &(*conGrp)[visibleConnection.index];
+}
+
+
+/*! Returns the value of the connection in the sort column */
+double ConnectionsModel::getSortValue(Connection* connection) const{
+	if(sortColumn == idCol)
+		return connection->getID();
+	if(sortColumn == fromIDCol)
+		return connection->getFromNeuronID();
+	if(sortColumn == toIDCol)
+		return connection->getToNeuronID();
+	if(sortColumn == delayCol)
+		return connection->getDelay();
+	if(sortColumn == weightCol)
+		return connection->getWeight();
+	if(sortColumn == tmpWeightCol)
+		return connection->getTempWeight();
+	return 0.0;
+}
+
+
+/*! Fills the rows with the visible connections that pass the filters, sorts them and
+	instructs viewers to reload the model. */
+void ConnectionsModel::loadRows(){
+	rowIndexVector.clear();
+	if(Globals::networkLoaded()){
+		int numberOfVisibleConnections = Globals::getNetworkDisplay()->getVisibleConnections().size();
+		bool filtersSet = fromNeuronFilter != 0 || toNeuronFilter != 0 || weightFilterSet;
+		rowIndexVector.reserve(numberOfVisibleConnections);
+		for(int i=0; i<numberOfVisibleConnections; ++i){
+			if(filtersSet){
+				Connection* tmpConnection = getConnection(i);
+				if(tmpConnection == NULL || !filterConnection(tmpConnection))
+					continue;
+			}
+			rowIndexVector.push_back(i);
+		}
+		sortRows();
+	}
+	reset();
+}
+
 
+/*! Sorts the rows by the values in the sort column, keeping rows with equal values in the
+	order of the list of visible connections. */
+void ConnectionsModel::sortRows(){
+	if(sortColumn < 0){
+		std::sort(rowIndexVector.begin(), rowIndexVector.end());
+		return;
+	}
+
+	//Read each sort value once and sort the values with their indexes
+	vector< pair<double, int> > sortVector;
+	sortVector.reserve(rowIndexVector.size());
+	for(size_t i=0; i<rowIndexVector.size(); ++i){
+		Connection* tmpConnection = getConnection(rowIndexVector[i]);
+		double value = tmpConnection == NULL ? 0.0 : getSortValue(tmpConnection);
+		sortVector.push_back(pair<double, int>(sortOrder == Qt::AscendingOrder ? value : -value, rowIndexVector[i]));
+	}
+	std::sort(sortVector.begin(), sortVector.end());
+	for(size_t i=0; i<sortVector.size(); ++i)
+		rowIndexVector[i] = sortVector[i].second;
+}
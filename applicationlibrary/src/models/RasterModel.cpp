@@ -0,0 +1,251 @@
+//SpikeStream includes
+#include "RasterModel.h"
+using namespace spikestream;
+
+//Qt includes
+#include <QDebug>
+
+//Other includes
+#include <algorithm>
+#include <math.h>
+
+/*! Constructor */
+RasterModel::RasterModel(QList<NeuronGroup*>& neuronGroupList) : QwtRasterData(){
+	this->neuronGroupList = neuronGroupList;
+
+	//Find the number of rows and the range of neuron IDs
+	maxNeuronID = 0;
+	minNeuronID = 0;
+	unsigned lastNeuronID = 0;
+	bool firstNeuron = true;
+	for(QList<NeuronGroup*>::iterator neurGrpIter = neuronGroupList.begin(); neurGrpIter != neuronGroupList.end(); ++neurGrpIter){
+		maxNeuronID += (*neurGrpIter)->size();
+		for(int i=0; i<(*neurGrpIter)->size(); ++i){
+			unsigned tmpNeurID = (*neurGrpIter)->getNeuronID(i);
+			if(firstNeuron || tmpNeurID < minNeuronID)
+				minNeuronID = tmpNeurID;
+			if(firstNeuron || tmpNeurID > lastNeuronID)
+				lastNeuronID = tmpNeurID;
+			firstNeuron = false;
+		}
+	}
+
+	//Give each neuron a row, with the neuron groups one above another
+	if(!firstNeuron){
+		neuronRowVector.resize(lastNeuronID - minNeuronID + 1, -1);
+		int rowOffset = 0;
+		for(QList<NeuronGroup*>::iterator neurGrpIter = neuronGroupList.begin(); neurGrpIter != neuronGroupList.end(); ++neurGrpIter){
+			for(int i=0; i<(*neurGrpIter)->size(); ++i)
+				neuronRowVector[(*neurGrpIter)->getNeuronID(i) - minNeuronID] = rowOffset + i;
+			rowOffset += (*neurGrpIter)->size();
+		}
+	}
+
+	//Initialize variables
+	numTimeSteps = 1000;
+	spikeRowVector.resize(numTimeSteps);
+	displayLevel = 0;
+
+	//Create the tile levels. Each one covers more time steps per column and is limited in the number of tiles per column
+	int rowsPerTile = (maxNeuronID + MAX_TILES_PER_COLUMN - 1) / MAX_TILES_PER_COLUMN;
+	if(rowsPerTile < 1)
+		rowsPerTile = 1;
+	int timeStepsPerColumn = 1;
+	for(int i=0; i<NUMBER_OF_TILE_LEVELS; ++i){
+		timeStepsPerColumn *= TIME_STEP_FACTOR;
+		RasterTileLevel tileLevel;
+		tileLevel.timeStepsPerColumn = timeStepsPerColumn;
+		tileLevel.rowsPerTile = rowsPerTile;
+		tileLevel.numTiles = (maxNeuronID + rowsPerTile - 1) / rowsPerTile;
+		tileLevel.countVector.resize(numTimeSteps * tileLevel.numTiles, 0);
+		tileLevelVector.push_back(tileLevel);
+	}
+	clearData();
+}
+
+
+/*! Destructor */
+RasterModel::~RasterModel(){
+}
+
+
+/*----------------------------------------------------------*/
+/*------               PUBLIC METHODS                 ------*/
+/*----------------------------------------------------------*/
+
+/*! Adds data to the model. This will erase the oldest bit of data at each resolution if
+	the time step is greater than the maximum. The model is cleared if the time step is earlier than
+	the last one that was added, and data for a time step that has already been added is ignored. */
+void RasterModel::addData(const SpikeFrame& spikeFrame){
+	int timeStep = spikeFrame.getTimeStep();
+	if(timeStep < lastTimeStep)
+		clearData();
+	else if(timeStep == lastTimeStep)
+		return;
+
+	//Clear the full resolution time steps between the last time step and this one
+	int firstClearTimeStep = lastTimeStep + 1;
+	if(firstClearTimeStep < timeStep - numTimeSteps + 1)
+		firstClearTimeStep = timeStep - numTimeSteps + 1;
+	for(int i = firstClearTimeStep; i <= timeStep; ++i)
+		spikeRowVector[i % numTimeSteps].clear();
+
+	//Clear the columns of each tile level that this time step moves into
+	for(vector<RasterTileLevel>::iterator levelIter = tileLevelVector.begin(); levelIter != tileLevelVector.end(); ++levelIter){
+		int column = timeStep / levelIter->timeStepsPerColumn;
+		int firstClearColumn = levelIter->lastColumn + 1;
+		if(firstClearColumn < column - numTimeSteps + 1)
+			firstClearColumn = column - numTimeSteps + 1;
+		for(int i = firstClearColumn; i <= column; ++i)
+			fill(levelIter->countVector.begin() + (i % numTimeSteps) * levelIter->numTiles, levelIter->countVector.begin() + (i % numTimeSteps + 1) * levelIter->numTiles, 0);
+		levelIter->lastColumn = column;
+	}
+
+	//Fix minimum time step
+	lastTimeStep = timeStep;
+	if(timeStep > (int)(minTimeStep + numTimeSteps))
+		minTimeStep = timeStep - numTimeSteps;
+
+	//Add the rows of the firing neurons at full resolution and count them at the other resolutions
+	vector<unsigned>& rowVector = spikeRowVector[timeStep % numTimeSteps];
+	unsigned lookupSize = neuronRowVector.size();
+	const unsigned* spikeFrameEnd = spikeFrame.end();
+	for(const unsigned* neurIter = spikeFrame.begin(); neurIter != spikeFrameEnd; ++neurIter){
+		if(*neurIter < minNeuronID || *neurIter - minNeuronID >= lookupSize)
+			continue;
+		int row = neuronRowVector[*neurIter - minNeuronID];
+		if(row < 0)
+			continue;
+		rowVector.push_back(row);
+		for(vector<RasterTileLevel>::iterator levelIter = tileLevelVector.begin(); levelIter != tileLevelVector.end(); ++levelIter)
+			++levelIter->countVector[(levelIter->lastColumn % numTimeSteps) * levelIter->numTiles + row / levelIter->rowsPerTile];
+	}
+	sort(rowVector.begin(), rowVector.end());
+}
+
+
+//Inherited from QwtData
+QwtRasterData* RasterModel::copy() const{
+	return (QwtRasterData*)this;
+}
+
+
+/*! Returns the earliest time step that is held at any resolution */
+int RasterModel::getHistoryMinX(){
+	const RasterTileLevel& coarsestLevel = tileLevelVector.back();
+	int firstColumn = coarsestLevel.lastColumn - numTimeSteps + 1;
+	if(firstColumn < 0)
+		return 0;
+	return firstColumn * coarsestLevel.timeStepsPerColumn;
+}
+
+
+/*! Returns the minimum value of X */
+int RasterModel::getMinX(){
+	return minTimeStep;
+}
+
+
+/*! Returns the maximum value of X */
+int RasterModel::getMaxX(){
+	return minTimeStep + numTimeSteps;
+}
+
+
+/*! Returns the minimum value of Y */
+int RasterModel::getMinY(){
+	return 0;
+}
+
+
+/*! Returns the maximum value of Y */
+int RasterModel::getMaxY(){
+	return maxNeuronID;
+}
+
+
+/*! Inherited from QwtRasterData. Selects the resolution that is used for the values in the area
+	that is about to be drawn. This is the coarsest resolution that holds the whole area and covers
+	no more than one pixel per column. A coarser resolution is only used when the finer ones no longer
+	hold the start of the area, and the coarsest resolution is used if none of them do. */
+void RasterModel::initRaster(const QwtDoubleRect& area, const QSize& raster){
+	double timeStepsPerPixel = 1.0;
+	if(raster.width() > 0)
+		timeStepsPerPixel = area.width() / raster.width();
+	int firstTimeStep = (int)floor(area.left());
+	if(firstTimeStep < 0)
+		firstTimeStep = 0;
+
+	displayLevel = -1;
+	int timeStepsPerColumn = 1;
+	for(int level=0; level<=NUMBER_OF_TILE_LEVELS; ++level){
+		if(levelContains(level, firstTimeStep)){
+			if(timeStepsPerColumn <= timeStepsPerPixel)
+				displayLevel = level;
+			else if(displayLevel < 0)
+				displayLevel = level;
+		}
+		if(timeStepsPerColumn > timeStepsPerPixel && displayLevel >= 0)
+			break;
+		timeStepsPerColumn *= TIME_STEP_FACTOR;
+	}
+	if(displayLevel < 0)
+		displayLevel = NUMBER_OF_TILE_LEVELS;
+}
+
+
+//Inherited from QwtData
+double RasterModel::value (double x, double y) const{
+	int timeStep = (int)floor(x);
+	int row = (int)floor(y);
+	if(timeStep < 0 || timeStep > lastTimeStep || row < 0 || row >= (int)maxNeuronID || !levelContains(displayLevel, timeStep))
+		return 0.0;
+
+	//Full resolution
+	if(displayLevel == 0){
+		const vector<unsigned>& rowVector = spikeRowVector[timeStep % numTimeSteps];
+		if(binary_search(rowVector.begin(), rowVector.end(), (unsigned)row))
+			return 1.0;
+		return 0.0;
+	}
+
+	/* A tile has the maximum of the full resolution values that it covers, so that it is shown
+		as firing if any of its neurons fired and isolated spikes stay visible when zoomed out */
+	const RasterTileLevel& tileLevel = tileLevelVector[displayLevel - 1];
+	int column = timeStep / tileLevel.timeStepsPerColumn;
+	if(tileLevel.countVector[(column % numTimeSteps) * tileLevel.numTiles + row / tileLevel.rowsPerTile] > 0)
+		return 1.0;
+	return 0.0;
+}
+
+
+//Inherited from QwtData
+QwtDoubleInterval RasterModel::range() const{
+	return QwtDoubleInterval(0.0, 1.0);
+}
+
+
+/*----------------------------------------------------------*/
+/*------              PRIVATE METHODS                 ------*/
+/*----------------------------------------------------------*/
+
+/*! Removes all of the data from the model */
+void RasterModel::clearData(){
+	for(vector< vector<unsigned> >::iterator iter = spikeRowVector.begin(); iter != spikeRowVector.end(); ++iter)
+		iter->clear();
+	for(vector<RasterTileLevel>::iterator levelIter = tileLevelVector.begin(); levelIter != tileLevelVector.end(); ++levelIter){
+		fill(levelIter->countVector.begin(), levelIter->countVector.end(), 0);
+		levelIter->lastColumn = -1;
+	}
+	lastTimeStep = -1;
+	minTimeStep = 0;
+}
+
+
+/*! Returns true if the time step is still held at the specified resolution */
+bool RasterModel::levelContains(int level, int timeStep) const{
+	if(level == 0)
+		return timeStep > lastTimeStep - numTimeSteps;
+	const RasterTileLevel& tileLevel = tileLevelVector[level - 1];
+	return timeStep / tileLevel.timeStepsPerColumn > tileLevel.lastColumn - numTimeSteps;
+}
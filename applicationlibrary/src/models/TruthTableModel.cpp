@@ -101,21 +101,19 @@ void TruthTableModel::setNeuronID(unsigned int neuronID){
 		}
 	}
 
-	//Get training data
-	QList<unsigned char*> trainingDataList = neuron->getTrainingData();
-
 	//Add training data to list
-	for(int i=0; i<trainingDataList.size(); ++i){//Work through the arrays of training data
+	for(int i=0; i<neuron->getNumberOfTrainingPatterns(); ++i){//Work through the training patterns
+		const unsigned char* trainingPattern = neuron->getTrainingPattern(i);
 		QList<unsigned int> tmpList;
 		for(int j=0; j<neuron->getNumberOfConnections(); ++j){//Work through all of the connections
-			if(trainingDataList.at(i)[j/8 + 1] & 1<<(j%8))
+			if(trainingPattern[j/8] & 1<<(j%8))
 				tmpList.append(1);
 			else
 				tmpList.append(0);
 		}
 
 		//Add output
-		tmpList.append(trainingDataList.at(i)[0]);
+		tmpList.append(neuron->getTrainingOutput(i));
 
 		//Store list
 		dataList.append(tmpList);
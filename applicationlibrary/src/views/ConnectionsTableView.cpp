@@ -12,8 +12,10 @@ ConnectionsTableView::ConnectionsTableView(QWidget* parent, QAbstractTableModel*
 	setShowGrid(false);
 	setSelectionMode(QAbstractItemView::NoSelection);
 
-	//Set the model for this view and show it
+	//Set the model for this view and show it. Clicking on a header sorts the rows in the model.
 	setModel(model);
+	horizontalHeader()->setSortIndicator(0, Qt::AscendingOrder);
+	setSortingEnabled(true);
 	show();
 	resizeHeaders();
 }
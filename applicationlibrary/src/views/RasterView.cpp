@@ -4,6 +4,7 @@ using namespace spikestream;
 
 //Qwt includes
 #include <qwt_color_map.h>
+#include <qwt_plot_panner.h>
 
 //Qt includes
 #include <QDebug>
@@ -29,6 +30,13 @@ RasterView::RasterView (RasterModel* rasterModel, QWidget* parent) : QwtPlot( pa
 	setAxisMaxMinor(QwtPlot::yLeft, 0);
 	setAxisMaxMinor(QwtPlot::xBottom, 0);
 
+	//Zoomer and panner for looking at part of the history
+	zoomer = new QwtPlotZoomer(canvas());
+	zoomer->setMousePattern(QwtEventPattern::MouseSelect2, Qt::RightButton, Qt::ControlModifier);
+	zoomer->setMousePattern(QwtEventPattern::MouseSelect3, Qt::RightButton);
+	QwtPlotPanner *panner = new QwtPlotPanner(canvas());
+	panner->setMouseButton(Qt::MidButton);
+
 	rescale();
 //	plotLayout()->setAlignCanvasToScales(true);
 
@@ -62,10 +70,18 @@ RasterView::~RasterView(){
 /*-----                 PUBLIC METHODS                 -----*/
 /*----------------------------------------------------------*/
 
-/*! Rescales the plot */
+/*! Rescales the plot to show the whole history held by the model, which is shown at a reduced resolution
+	when it covers more time steps than there are pixels, and replots it.
+	The scales are left alone while the user is zoomed in. */
 void RasterView::rescale(){
-	setAxisScale(QwtPlot::xBottom, rasterModel->getMinX(), rasterModel->getMaxX(), 1);
+	if(zoomer->zoomRectIndex() != 0){
+		replot();
+		return;
+	}
+	setAxisScale(QwtPlot::xBottom, rasterModel->getHistoryMinX(), rasterModel->getMaxX(), 1);
 	setAxisScale(QwtPlot::yLeft, rasterModel->getMinY(),rasterModel->getMaxY(), 1);
+	replot();
+	zoomer->setZoomBase();
 }
 
 
@@ -107,7 +107,7 @@ void AbstractGraphWidget::mouseDoubleClickEvent (QMouseEvent*){
 	}
 
 	//Save file
-	bufferImage->save(filePath, fileType.toAscii(), 100);
+	getPlotImage().save(filePath, fileType.toAscii(), 100);
 }
 
 
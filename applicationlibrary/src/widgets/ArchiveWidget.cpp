@@ -18,7 +18,7 @@ ArchiveWidget::ArchiveWidget(QWidget* parent) : QWidget(parent){
 	QVBoxLayout* verticalBox = new QVBoxLayout(this);
 
 	//Register types to enable signals and slots to work
-	qRegisterMetaType< QList<unsigned> >("QList<unsigned>");
+	qRegisterMetaType<SpikeFramePtr>("SpikeFramePtr");
 
     //Add tool bar
     toolBar = getToolBar();
@@ -53,7 +53,7 @@ ArchiveWidget::ArchiveWidget(QWidget* parent) : QWidget(parent){
     //Create class to load archive data in a separate thread
     archivePlayer = new ArchivePlayerThread(Globals::getArchiveDao()->getDBInfo());
     connect(archivePlayer, SIGNAL(finished()), this, SLOT(archivePlayerStopped()));
-	connect(archivePlayer, SIGNAL(timeStepChanged(unsigned, const QList<unsigned>&)), this, SLOT(updateTimeStep(unsigned, const QList<unsigned>&)), Qt::QueuedConnection);
+	connect(archivePlayer, SIGNAL(timeStepChanged(const SpikeFramePtr&)), this, SLOT(updateTimeStep(const SpikeFramePtr&)), Qt::QueuedConnection);
 
     //Initialise variables
     ignoreButton = false;
@@ -395,20 +395,20 @@ void ArchiveWidget::setArchiveProperties(){
 
 
 /*! Called when the time step changes and updates the time step counter */
-void ArchiveWidget::updateTimeStep(unsigned timeStep, const QList<unsigned>& neuronIDList){
+void ArchiveWidget::updateTimeStep(const SpikeFramePtr& spikeFrame){
 	//Update the time step counter and the time step in the archive
+	unsigned timeStep = spikeFrame->getTimeStep();
 	Globals::getArchive()->setTimeStep(timeStep);
 	timeStepLabel->setText(QString::number(timeStep));
 
-	//Build new highlight map from list of IDs
-	QHash<unsigned int, RGBColor*>* newHighlightMap = new QHash<unsigned int, RGBColor*>();
-	RGBColor* neuronColor = Globals::getNetworkDisplay()->getArchiveFiringNeuronColor();
-	foreach(unsigned tmpNeurID, neuronIDList){
-		(*newHighlightMap)[tmpNeurID] = neuronColor;
-	}
-
-	//Set the colour map - this should automatically delete the old one.
-	Globals::getNetworkDisplay()->setNeuronColorMap(newHighlightMap);
+	//Colour the firing neurons, reusing the colour indexes from the previous time step
+	NetworkDisplay* netDisplay = Globals::getNetworkDisplay();
+	unsigned char colorIndex = netDisplay->addPaletteColor(*netDisplay->getArchiveFiringNeuronColor());
+	netDisplay->clearNeuronColorIndexes();
+	const unsigned* endFrame = spikeFrame->end();
+	for(const unsigned* iter = spikeFrame->begin(); iter != endFrame; ++iter)
+		netDisplay->setNeuronColorIndex(*iter, colorIndex);
+	netDisplay->neuronColorsChanged();
 
 	//Instruct thread to continue with next time step
 	archivePlayer->clearWaitForGraphics();
@@ -547,7 +547,7 @@ void ArchiveWidget::rewindArchive(){
 	unsigned minTimeStep = Globals::getArchiveDao()->getMinTimeStep(Globals::getArchive()->getID());
 	Globals::getArchive()->setTimeStep(minTimeStep);
 	timeStepLabel->setText(QString::number(minTimeStep));
-	Globals::getNetworkDisplay()->setNeuronColorMap(new QHash<unsigned int, RGBColor*>());
+	Globals::getNetworkDisplay()->clearNeuronColors();
     archiveOpen = false;
 }
 
@@ -6,16 +6,22 @@ using namespace spikestream;
 //Qt includes
 #include <QDebug>
 
+//Other includes
+#include <algorithm>
+
+
+/*! Colors of the traces, which are used in turn as neurons are added */
+static const QRgb traceColors[] = { qRgb(255, 0, 0), qRgb(0, 0, 255), qRgb(0, 160, 0), qRgb(200, 0, 200), qRgb(0, 160, 160), qRgb(230, 130, 0) };
+
+/*! Number of colors of the traces */
+static const int numTraceColors = 6;
+
+
 /*! Constructor */
 MembranePotentialGraphWidget::MembranePotentialGraphWidget(QWidget* parent) : AbstractGraphWidget(parent) {
-	plotColor = qRgb(255, 0, 0);
 	setYRange(-130, 50);
 	buildBufferImage();
-
-	newXPos = 0;
-	newYPos = 0;
-	oldXPos = 0;
-	oldYPos = 0;
+	lastTimeStep = -1;
 }
 
 
@@ -30,35 +36,163 @@ MembranePotentialGraphWidget::~MembranePotentialGraphWidget(){
 /*------               PUBLIC METHODS                 ------*/
 /*----------------------------------------------------------*/
 
-/*! Adds a membrane potential value to the plot */
-void MembranePotentialGraphWidget::addData(float membranePotential, timestep_t timeStep){
-	oldXPos = newXPos;
-	oldYPos = newYPos;
-
-	newXPos = timeStep % numTimeSteps +  yAxisPadding + 1;
-
-	//Make sure membrane potential does not go out of range
-	newYPos = imageHeight - Util::rInt(membranePotential - getMinY());
-	if(newYPos > imageHeight)
-		newYPos = imageHeight;
-	if(newYPos < 0)
-		newYPos = 0;
+/*! Adds the membrane potentials of the neurons that are being plotted at a time step.
+	The map holds the potentials of any number of neurons; neurons that are not being plotted are ignored. */
+void MembranePotentialGraphWidget::addData(const QHash<unsigned, float>& membranePotentialMap, timestep_t timeStep){
+	//Discard the data if the time step has gone backwards
+	if(timeStep < lastTimeStep)
+		fill(sampleTimeStepVector.begin(), sampleTimeStepVector.end(), -1);
+	lastTimeStep = timeStep;
 
 	//Advance the time step
 	increaseTimeStep(timeStep);
-	repaint();
+
+	//Store the potential of each neuron in its ring buffer
+	int bufferIndex = timeStep % numTimeSteps;
+	QHash<unsigned, float>::const_iterator endMap = membranePotentialMap.end();
+	for(size_t i=0; i<neuronIDVector.size(); ++i, bufferIndex += numTimeSteps){
+		QHash<unsigned, float>::const_iterator iter = membranePotentialMap.find(neuronIDVector[i]);
+		if(iter != endMap){
+			potentialVector[bufferIndex] = iter.value();
+			sampleTimeStepVector[bufferIndex] = timeStep;
+		}
+	}
+	update();
 }
 
 
-/*! Paints a line between the last 2 data points */
+/*! Adds a neuron to the plot */
+void MembranePotentialGraphWidget::addNeuron(neurid_t neuronID){
+	if(find(neuronIDVector.begin(), neuronIDVector.end(), neuronID) != neuronIDVector.end())
+		return;
+
+	traceColorVector.push_back(traceColors[neuronIDVector.size() % numTraceColors]);
+	neuronIDVector.push_back(neuronID);
+	potentialVector.resize(neuronIDVector.size() * numTimeSteps, 0.0f);
+	sampleTimeStepVector.resize(neuronIDVector.size() * numTimeSteps, -1);
+
+	//Repaint the labels with the new neuron
+	updateAxes = true;
+	update();
+}
+
+
+/*! Paints the trace of each neuron onto the widget. The time steps are divided between the pixel columns
+	of the widget and the lowest and highest potentials in each column are joined by a vertical line.
+	Columns holding consecutive time steps are joined from the last potential in one to the first in the next. */
 void MembranePotentialGraphWidget::paintData(QPainter &painter){
-	painter.setPen( QPen(plotColor) );
-	//Only draw line if it is a sequential point
-	if(newXPos - oldXPos == 1)
-		painter.drawLine(oldXPos, oldYPos, newXPos, newYPos);
+	if(widgetWidth <= 0 || widgetHeight <= 0)
+		return;
+
+	for(size_t trace=0; trace<neuronIDVector.size(); ++trace){
+		painter.setPen( QPen(QColor(traceColorVector[trace])) );
+		const float* potentials = &potentialVector[trace * numTimeSteps];
+		const timestep_t* sampleTimeSteps = &sampleTimeStepVector[trace * numTimeSteps];
+
+		int oldXPos = 0, oldYPos = 0, oldTimeStep = -2;
+		for(int xPos=0; xPos<widgetWidth; ++xPos){
+			//Find the time steps whose columns in the buffer image are scaled into this column
+			int startStep = (xPos * imageWidth + widgetWidth - 1) / widgetWidth - yAxisPadding - 1;
+			int endStep = ((xPos + 1) * imageWidth + widgetWidth - 1) / widgetWidth - yAxisPadding - 1;
+			if(startStep < 0)
+				startStep = 0;
+			if(endStep > numTimeSteps)
+				endStep = numTimeSteps;
+
+			//Get the range of potentials in the column
+			int firstStep = -1, lastStep = -1;
+			float minPotential = 0.0f, maxPotential = 0.0f;
+			for(int step = startStep; step < endStep; ++step){
+				if(sampleTimeSteps[step] != minTimeStep + step)
+					continue;
+				if(firstStep < 0){
+					firstStep = step;
+					minPotential = potentials[step];
+					maxPotential = potentials[step];
+				}
+				else{
+					minPotential = std::min(minPotential, potentials[step]);
+					maxPotential = std::max(maxPotential, potentials[step]);
+				}
+				lastStep = step;
+			}
+			if(firstStep < 0)
+				continue;
+
+			//Join the column to the previous one if the time steps are consecutive and draw the range
+			if(oldTimeStep == firstStep - 1)
+				painter.drawLine(oldXPos, oldYPos, xPos, getWidgetY(potentials[firstStep]));
+			painter.drawLine(xPos, getWidgetY(minPotential), xPos, getWidgetY(maxPotential));
+			oldXPos = xPos;
+			oldYPos = getWidgetY(potentials[lastStep]);
+			oldTimeStep = lastStep;
+		}
+	}
 }
 
 
-/*! Paints the labels  */
+/*! Paints the IDs of the neurons in the colors of their traces */
 void MembranePotentialGraphWidget::paintLabels(QPainter& painter){
+	QFont font;
+	font.setFamily("Helvetica");
+	font.setWeight(QFont::Light);
+	font.setPixelSize(labelFontSize);
+	painter.setFont(font);
+
+	for(size_t i=0; i<neuronIDVector.size(); ++i){
+		painter.setPen( QPen(QColor(traceColorVector[i])) );
+		painter.drawText(yAxisPadding + 10, (int)(i + 1) * (labelFontSize + 2), "Neuron " + QString::number(neuronIDVector[i]));
+	}
+}
+
+
+/*----------------------------------------------------------*/
+/*------              PROTECTED METHODS               ------*/
+/*----------------------------------------------------------*/
+
+/*! Returns the axes and traces as they are shown in the widget */
+QImage MembranePotentialGraphWidget::getPlotImage(){
+	QImage plotImage = bufferImage->scaled(widgetWidth, widgetHeight);
+	QPainter painter(&plotImage);
+	paintData(painter);
+	painter.end();
+	return plotImage;
+}
+
+
+/*! Inherited from QWidget. The axes and labels are painted into the buffer image and scaled to the widget
+	when they change. The traces are painted straight onto the widget at its own resolution. */
+void MembranePotentialGraphWidget::paintEvent(QPaintEvent*){
+	QPainter painter(this);
+	if(bufferImage != NULL){
+		if(updateAxes){
+			bufferImage->fill(backgroundColor);
+			QPainter imagePainter(bufferImage);
+			paintAxes(imagePainter);
+			paintLabels(imagePainter);
+			imagePainter.end();
+			scaledImage = QImage();
+		}
+		if(scaledImage.width() != widgetWidth || scaledImage.height() != widgetHeight)
+			scaledImage = bufferImage->scaled(widgetWidth, widgetHeight);
+		painter.drawImage(0, 0, scaledImage);
+		paintData(painter);
+	}
+	painter.end();
+}
+
+
+/*----------------------------------------------------------*/
+/*------              PRIVATE METHODS                 ------*/
+/*----------------------------------------------------------*/
+
+/*! Returns the position of a membrane potential on the vertical axis of the widget,
+	keeping potentials that are out of range at the edge of the plot. */
+int MembranePotentialGraphWidget::getWidgetY(float membranePotential){
+	float imageYPos = imageHeight - (membranePotential - getMinY());
+	if(imageYPos > imageHeight)
+		imageYPos = imageHeight;
+	if(imageYPos < 0)
+		imageYPos = 0;
+	return Util::rInt(imageYPos * widgetHeight / imageHeight);
 }
@@ -11,6 +11,8 @@ using namespace spikestream;
 
 //Qt includes
 #include <QButtonGroup>
+#include <QDoubleValidator>
+#include <QIntValidator>
 #include <QLayout>
 
 
@@ -130,8 +132,39 @@ NetworkViewerProperties::NetworkViewerProperties(QWidget* parent) : QWidget(pare
 	posNegBox->addStretch(5);
 	mainVerticalBox->addLayout(posNegBox);
 
+	//Filtering of the connections in the table
+	QHBoxLayout* tableFilterBox = new QHBoxLayout();
+	QIntValidator* neuronIDValidator = new QIntValidator(0, 2147483647, this);
+	QDoubleValidator* weightValidator = new QDoubleValidator(-1000000.0, 1000000.0, 5, this);
+	tableFilterBox->addWidget(new QLabel("Filter table. From: "));
+	fromFilterLineEdit = new QLineEdit();
+	fromFilterLineEdit->setValidator(neuronIDValidator);
+	fromFilterLineEdit->setMaximumWidth(80);
+	connect(fromFilterLineEdit, SIGNAL(editingFinished()), this, SLOT(tableFilterChanged()));
+	tableFilterBox->addWidget(fromFilterLineEdit);
+	tableFilterBox->addWidget(new QLabel("To: "));
+	toFilterLineEdit = new QLineEdit();
+	toFilterLineEdit->setValidator(neuronIDValidator);
+	toFilterLineEdit->setMaximumWidth(80);
+	connect(toFilterLineEdit, SIGNAL(editingFinished()), this, SLOT(tableFilterChanged()));
+	tableFilterBox->addWidget(toFilterLineEdit);
+	tableFilterBox->addWidget(new QLabel("Weight: "));
+	minWeightFilterLineEdit = new QLineEdit();
+	minWeightFilterLineEdit->setValidator(weightValidator);
+	minWeightFilterLineEdit->setMaximumWidth(60);
+	connect(minWeightFilterLineEdit, SIGNAL(editingFinished()), this, SLOT(tableFilterChanged()));
+	tableFilterBox->addWidget(minWeightFilterLineEdit);
+	tableFilterBox->addWidget(new QLabel("to "));
+	maxWeightFilterLineEdit = new QLineEdit();
+	maxWeightFilterLineEdit->setValidator(weightValidator);
+	maxWeightFilterLineEdit->setMaximumWidth(60);
+	connect(maxWeightFilterLineEdit, SIGNAL(editingFinished()), this, SLOT(tableFilterChanged()));
+	tableFilterBox->addWidget(maxWeightFilterLineEdit);
+	tableFilterBox->addStretch(5);
+	mainVerticalBox->addLayout(tableFilterBox);
+
 	//Add table view and model
-	QAbstractTableModel* connectionsModel = new ConnectionsModel();
+	connectionsModel = new ConnectionsModel();
 	QTableView* connectionsView = new ConnectionsTableView(this, connectionsModel);
 	connectionsView->setMinimumWidth(500);
 	connectionsView->setMinimumHeight(500);
@@ -148,7 +181,7 @@ NetworkViewerProperties::NetworkViewerProperties(QWidget* parent) : QWidget(pare
 
 	//Listen for changes in the network display
 	connect(Globals::getEventRouter(), SIGNAL(networkDisplayChangedSignal()), this, SLOT(networkDisplayChanged()));
-	connect(Globals::getEventRouter(), SIGNAL(visibleConnectionsChangedSignal()), this, SLOT(updateConnectionCount()));
+	connect(connectionsModel, SIGNAL(modelReset()), this, SLOT(updateConnectionCount()));
 
 	/* Initialize truth table dialog to NULL
 		Otherwise it appears as an annoying flash up during boot up of SpikeStream */
@@ -229,6 +262,21 @@ void NetworkViewerProperties::setRenderMode(){
 }
 
 
+/*! Applies the filters for the connections table. Empty fields are not used for filtering. */
+void NetworkViewerProperties::tableFilterChanged(){
+	connectionsModel->setFromNeuronFilter(fromFilterLineEdit->text().toUInt());
+	connectionsModel->setToNeuronFilter(toFilterLineEdit->text().toUInt());
+	if(minWeightFilterLineEdit->text().isEmpty() && maxWeightFilterLineEdit->text().isEmpty()){
+		connectionsModel->clearWeightFilter();
+	}
+	else{
+		float minWeight = minWeightFilterLineEdit->text().isEmpty() ? -1000000.0f : minWeightFilterLineEdit->text().toFloat();
+		float maxWeight = maxWeightFilterLineEdit->text().isEmpty() ? 1000000.0f : maxWeightFilterLineEdit->text().toFloat();
+		connectionsModel->setWeightFilter(minWeight, maxWeight);
+	}
+}
+
+
 /*! Shows a dialog with the truth table for the selected neuron */
 void NetworkViewerProperties::showTruthTable(){
 	//Get neuron id.
@@ -243,7 +291,7 @@ void NetworkViewerProperties::showTruthTable(){
 
 /*! Updates the field showing the number of connections in the table. */
 void NetworkViewerProperties::updateConnectionCount(){
-	numberOfConnectionsLabel->setText("Number of connections: " + QString::number( Globals::getNetworkDisplay()->getVisibleConnectionsList().size() ) );
+	numberOfConnectionsLabel->setText("Number of connections: " + QString::number( connectionsModel->rowCount() ) );
 }
 
 
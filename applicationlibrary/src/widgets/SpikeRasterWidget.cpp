@@ -8,6 +8,7 @@ using namespace spikestream;
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QPainter>
+#include <QPaintEvent>
 #include <QResizeEvent>
 #include <QDebug>
 
@@ -42,13 +43,40 @@ SpikeRasterWidget::SpikeRasterWidget(QList<NeuronGroup*>& neuronGroupList, QWidg
 	//Initialize other variables
 	numTimeSteps = 1000;
 	minTimeStep = 0;
+	lastTimeStep = -1;
+	redrawAll = true;
 
 	//Create buffer image
 	imageWidth = numTimeSteps + yAxisPadding + 1;
 	imageHeight = numNeurons + xAxisPadding + 1;
 	bufferImage = new QImage(imageWidth, imageHeight, QImage::Format_RGB32);
 	bufferImage->fill(backgroundColor);
-	updateAxes = true;
+	paintAxesAndNames();
+
+	//Work out the row of each neuron so that spikes can be added without searching the neuron groups
+	minNeuronID = 0;
+	unsigned maxNeuronID = 0;
+	bool firstNeuron = true;
+	for(QList<NeuronGroup*>::iterator iter = neuronGroupList.begin(); iter != neuronGroupList.end(); ++iter){
+		for(int i=0; i<(*iter)->size(); ++i){
+			unsigned tmpNeurID = (*iter)->getNeuronID(i);
+			if(firstNeuron || tmpNeurID < minNeuronID)
+				minNeuronID = tmpNeurID;
+			if(firstNeuron || tmpNeurID > maxNeuronID)
+				maxNeuronID = tmpNeurID;
+			firstNeuron = false;
+		}
+	}
+	if(!firstNeuron){
+		neuronRowVector.resize(maxNeuronID - minNeuronID + 1, -1);
+		neuronColorVector.resize(maxNeuronID - minNeuronID + 1, backgroundColor);
+		for(QList<NeuronGroup*>::iterator iter = neuronGroupList.begin(); iter != neuronGroupList.end(); ++iter){
+			unsigned neurGrpOffset = neurGrpOffsetMap[(*iter)->getID()];
+			for(int i=0; i<(*iter)->size(); ++i)
+				neuronRowVector[(*iter)->getNeuronID(i) - minNeuronID] = imageHeight - xAxisPadding - (neurGrpOffset + i) - 1;
+		}
+	}
+	fillNeuronColors();
 
 	//Set up widget graphic properties
 	if(imageWidth > 500)
@@ -64,12 +92,15 @@ SpikeRasterWidget::SpikeRasterWidget(QList<NeuronGroup*>& neuronGroupList, QWidg
 	setAttribute(Qt::WA_PaintOnScreen);
 	widgetWidth = this->size().width();
 	widgetHeight = this->size().height();
+	scaledImage = new QImage(widgetWidth, widgetHeight, QImage::Format_RGB32);
+	scaleColumns(0, imageWidth - 1);
 }
 
 
 /*! Destructor */
 SpikeRasterWidget::~SpikeRasterWidget(){
 	delete bufferImage;
+	delete scaledImage;
 }
 
 
@@ -78,25 +109,34 @@ SpikeRasterWidget::~SpikeRasterWidget(){
 /*----------------------------------------------------------*/
 
 /*! Adds spikes to the plot, filtered by the neuron groups that are being monitored. */
-void SpikeRasterWidget::addSpikes(const QList<unsigned>& firingNeuronIDs, int timeStep){
+void SpikeRasterWidget::addSpikes(const SpikeFrame& spikeFrame){
+	int timeStep = spikeFrame.getTimeStep();
+	int firstTimeStep = advanceTimeStep(timeStep);
 	int writeLocation = timeStep % numTimeSteps +  yAxisPadding + 1;
 
-	//Add spikes to the current image
-	unsigned tmpNeurID;
-	QList<unsigned>::const_iterator firingNeuronIDsEnd = firingNeuronIDs.end();
-	for(QList<unsigned>::const_iterator neurIter = firingNeuronIDs.begin(); neurIter != firingNeuronIDsEnd; ++neurIter){
-		for(QList<NeuronGroup*>::iterator neurGrpIter = neuronGroupList.begin(); neurGrpIter != neuronGroupList.end(); ++neurGrpIter){
-			if((*neurGrpIter)->contains(*neurIter)){
-				tmpNeurID = *neurIter - (*neurGrpIter)->getStartNeuronID() + neurGrpOffsetMap[(*neurGrpIter)->getID()];
-				bufferImage->setPixel(writeLocation, imageHeight - xAxisPadding - tmpNeurID - 1, neurGrpColorMap[(*neurGrpIter)->getID()]);
-				break;
-			}
-		}
+	//Write the spikes straight into the column of the current time step
+	uchar* imageBits = bufferImage->bits();
+	int bytesPerLine = bufferImage->bytesPerLine();
+	unsigned lookupSize = neuronRowVector.size();
+	const unsigned* spikeFrameEnd = spikeFrame.end();
+	for(const unsigned* neurIter = spikeFrame.begin(); neurIter != spikeFrameEnd; ++neurIter){
+		if(*neurIter < minNeuronID || *neurIter - minNeuronID >= lookupSize)
+			continue;
+		int row = neuronRowVector[*neurIter - minNeuronID];
+		if(row < 0)
+			continue;
+		((QRgb*)(imageBits + row * bytesPerLine))[writeLocation] = neuronColorVector[*neurIter - minNeuronID];
 	}
 
-	//Advance the time step
-	increaseTimeStep(timeStep);
-	repaint();
+	//Scale the changed part of the image and repaint it
+	if(redrawAll){
+		scaleColumns(0, imageWidth - 1);
+		redrawAll = false;
+		update();
+	}
+	else{
+		update(scaleColumns(firstTimeStep % numTimeSteps + yAxisPadding + 1, writeLocation));
+	}
 }
 
 
@@ -111,7 +151,11 @@ void SpikeRasterWidget::setBlackAndWhite(bool on){
 		neurGrpColorMap[(*iter)->getID()] = hueList.at(hueCntr);
 		++hueCntr;
 	}
-	repaint();
+	fillNeuronColors();
+	paintAxesAndNames();
+	scaleColumns(0, imageWidth - 1);
+	redrawAll = false;
+	update();
 }
 
 
@@ -141,15 +185,9 @@ void SpikeRasterWidget::mouseDoubleClickEvent (QMouseEvent*){
 
 
 //Inherited from QWidget
-void SpikeRasterWidget::paintEvent(QPaintEvent*){
+void SpikeRasterWidget::paintEvent(QPaintEvent* event){
 	QPainter painter(this);
-	if(updateAxes){
-		QPainter axesPainter(bufferImage);
-		paintAxes(axesPainter);
-		paintNeuronGroupNames(axesPainter);
-	}
-
-	painter.drawImage(0, 0, bufferImage->scaled(widgetWidth, widgetHeight));
+	painter.drawImage(event->rect().topLeft(), *scaledImage, event->rect());
 	painter.end();
 }
 
@@ -158,6 +196,12 @@ void SpikeRasterWidget::paintEvent(QPaintEvent*){
 void SpikeRasterWidget::resizeEvent(QResizeEvent* /*event*/) {
 	widgetWidth = this->size().width();
 	widgetHeight = this->size().height();
+
+	//Rebuild the scaled copy of the image at the new size
+	delete scaledImage;
+	scaledImage = new QImage(widgetWidth, widgetHeight, QImage::Format_RGB32);
+	scaleColumns(0, imageWidth - 1);
+	redrawAll = false;
 }
 
 
@@ -165,6 +209,58 @@ void SpikeRasterWidget::resizeEvent(QResizeEvent* /*event*/) {
 /*------              PRIVATE METHODS                 ------*/
 /*----------------------------------------------------------*/
 
+/*! Moves the plot on to the time step and returns the first time step whose column has changed.
+	The column of each time step that is moved over is cleared. The whole plot is cleared if the time
+	step goes backwards or jumps more than the width of the plot, and the X axis is relabelled when
+	the time step moves into a new window. */
+int SpikeRasterWidget::advanceTimeStep(int timeStep){
+	int firstTimeStep = timeStep;
+	if(lastTimeStep < 0 || timeStep < lastTimeStep || timeStep - lastTimeStep >= numTimeSteps){
+		clearColumns(yAxisPadding + 1, yAxisPadding + numTimeSteps);
+		redrawAll = true;
+	}
+	else{
+		if(timeStep > lastTimeStep)
+			firstTimeStep = lastTimeStep + 1;
+		for(int i = firstTimeStep; i <= timeStep; ++i){
+			int tmpX = i % numTimeSteps + yAxisPadding + 1;
+			clearColumns(tmpX, tmpX);
+		}
+	}
+	lastTimeStep = timeStep;
+
+	//Check to see if we have moved out of the X axis range
+	if( ((timeStep / numTimeSteps) * numTimeSteps) != minTimeStep){
+		minTimeStep = (timeStep / numTimeSteps) * numTimeSteps;
+		paintAxesAndNames();
+		redrawAll = true;
+	}
+	return firstTimeStep;
+}
+
+
+/*! Sets the neuron rows between the two columns of the buffer image, inclusive, to the background colour */
+void SpikeRasterWidget::clearColumns(int firstX, int lastX){
+	uchar* imageBits = bufferImage->bits();
+	int bytesPerLine = bufferImage->bytesPerLine();
+	for(int row = imageHeight - xAxisPadding - numNeurons; row < imageHeight - xAxisPadding; ++row){
+		QRgb* line = (QRgb*)(imageBits + row * bytesPerLine);
+		for(int x = firstX; x <= lastX; ++x)
+			line[x] = backgroundColor;
+	}
+}
+
+
+/*! Sets the spike colour of each neuron to the colour of its neuron group */
+void SpikeRasterWidget::fillNeuronColors(){
+	for(QList<NeuronGroup*>::iterator iter = neuronGroupList.begin(); iter != neuronGroupList.end(); ++iter){
+		QRgb neurGrpColor = neurGrpColorMap[(*iter)->getID()];
+		for(int i=0; i<(*iter)->size(); ++i)
+			neuronColorVector[(*iter)->getNeuronID(i) - minNeuronID] = neurGrpColor;
+	}
+}
+
+
 /*! Enables user to enter a file path */
 QString SpikeRasterWidget::getFilePath(QString fileFilter){
 	QFileDialog dialog(this);
@@ -231,17 +327,6 @@ QList<unsigned> SpikeRasterWidget::getHueList(unsigned numItems){
 }
 
 
-/*! Advances the time step and redraws axes if necessary */
-void SpikeRasterWidget::increaseTimeStep(int currentTimeStep){
-	//Check to see if we have moved out of the X axis range
-	if( ((currentTimeStep /numTimeSteps) * numTimeSteps) != minTimeStep){
-		minTimeStep = (currentTimeStep/numTimeSteps) * numTimeSteps;
-		bufferImage->fill(backgroundColor);
-		updateAxes = true;
-	}
-}
-
-
 /*! Paints the X and Y axes */
 void SpikeRasterWidget::paintAxes(QPainter& painter) {
 	painter.setPen( QPen(Qt::black) );
@@ -256,9 +341,18 @@ void SpikeRasterWidget::paintAxes(QPainter& painter) {
 	//Paint axes
 	paintYAxis(painter);
 	paintXAxis(painter);
+}
+
 
-	//Set flag recording that axes are updated
-	updateAxes = false;
+/*! Clears the areas of the buffer image around the neuron rows and repaints the axes and
+	the names of the neuron groups with the current X axis range. */
+void SpikeRasterWidget::paintAxesAndNames(){
+	QPainter painter(bufferImage);
+	painter.fillRect(0, 0, yAxisPadding + 1, imageHeight, QColor(backgroundColor));
+	painter.fillRect(0, imageHeight - xAxisPadding, imageWidth, xAxisPadding, QColor(backgroundColor));
+	paintAxes(painter);
+	paintNeuronGroupNames(painter);
+	painter.end();
 }
 
 
@@ -331,3 +425,30 @@ void SpikeRasterWidget::paintYAxis(QPainter& painter){
 }
 
 
+/*! Copies the columns between firstX and lastX of the buffer image, inclusive, into the scaled image.
+	Each pixel of the scaled image shows the nearest pixel in the buffer image, so the columns can be
+	scaled separately and give the same result as scaling the whole image.
+	Returns the area of the scaled image that has changed. */
+QRect SpikeRasterWidget::scaleColumns(int firstX, int lastX){
+	if(widgetWidth <= 0 || widgetHeight <= 0)
+		return QRect();
+
+	//Find the columns of the scaled image whose nearest pixels are in the range
+	int firstScaledX = (firstX * widgetWidth + imageWidth - 1) / imageWidth;
+	int endScaledX = ((lastX + 1) * widgetWidth + imageWidth - 1) / imageWidth;
+	if(endScaledX <= firstScaledX)
+		return QRect();
+
+	//Copy the pixels, reading each line of the buffer image directly
+	const uchar* imageBits = bufferImage->bits();
+	int imageBytesPerLine = bufferImage->bytesPerLine();
+	uchar* scaledBits = scaledImage->bits();
+	int scaledBytesPerLine = scaledImage->bytesPerLine();
+	for(int y=0; y<widgetHeight; ++y){
+		const QRgb* imageLine = (const QRgb*)(imageBits + (y * imageHeight / widgetHeight) * imageBytesPerLine);
+		QRgb* scaledLine = (QRgb*)(scaledBits + y * scaledBytesPerLine);
+		for(int x = firstScaledX; x < endScaledX; ++x)
+			scaledLine[x] = imageLine[x * imageWidth / widgetWidth];
+	}
+	return QRect(firstScaledX, 0, endScaledX - firstScaledX, widgetHeight);
+}
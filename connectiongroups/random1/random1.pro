@@ -34,8 +34,10 @@ win32 {
 #---                 FILES                  ---#
 #----------------------------------------------#
 HEADERS = src/gui/Random1Widget.h \
-			src/model/Random1BuilderThread.h
+			src/model/Random1BuilderThread.h \
+			src/model/Random1RowThread.h
 
 SOURCES = src/gui/Random1Widget.cpp \
-			src/model/Random1BuilderThread.cpp
+			src/model/Random1BuilderThread.cpp \
+			src/model/Random1RowThread.cpp
 
@@ -1,8 +1,8 @@
 #include "Globals.h"
 #include "NeuronGroup.h"
 #include "Random1BuilderThread.h"
+#include "Random1RowThread.h"
 #include "SpikeStreamException.h"
-#include "Util.h"
 using namespace spikestream;
 
 /*! Constructor */
@@ -19,8 +19,9 @@ Random1BuilderThread::~Random1BuilderThread(){
 /*-----                PROTECTED METHODS               -----*/
 /*----------------------------------------------------------*/
 
-/*! Returns a neuron group whose neurons are constructed according to the
-	parameters in the neuron group info. */
+/*! Builds the connection group with connections chosen at random between the neurons in the from and to neuron groups.
+	The rows of connections from ranges of from neurons are built in parallel and then added to the connection group
+	in the order of the from neurons, so the same random seed always gives the same connections. */
 void Random1BuilderThread::buildConnectionGroup(){
 	//Sort out connection and neuron groups
 	newConnectionGroup = new ConnectionGroup(connectionGroupInfo);
@@ -28,42 +29,64 @@ void Random1BuilderThread::buildConnectionGroup(){
 	NeuronGroup* toNeurGrp = Globals::getNetwork()->getNeuronGroup(connectionGroupInfo.getToNeuronGroupID());
 
 	//Extract parameters
-	double minWeightRange1 = getParameter("min_weight_range_1");
-	double maxWeightRange1 = getParameter("max_weight_range_1");
-	int percentWeightRange1 = (int)getParameter("percent_weight_range_1");
-	double minWeightRange2 = getParameter("min_weight_range_2");
-	double maxWeightRange2 = getParameter("max_weight_range_2");
-	unsigned int minDelay = (unsigned int)getParameter("min_delay");
-	unsigned int maxDelay = (unsigned int)getParameter("max_delay");
-	double connectionProbability = getParameter("connection_probability");
-	int randomSeed = getParameter("random_seed");
-
-	//Set the random seed
-	qsrand(randomSeed);
-
-	//Work through each pair of neurons
-	numberOfProgressSteps = fromNeurGrp->size() + 1;
-	int cntr = 0;
-	double weight = 0;
-	for(NeuronMap::iterator fromIter = fromNeurGrp->begin(); fromIter != fromNeurGrp->end() && !stopThread; ++fromIter){
-		for(NeuronMap::iterator toIter = toNeurGrp->begin(); toIter != toNeurGrp->end(); ++toIter){
-			//Decide if connection is made
-			double ranNum = (double)rand() / (double)RAND_MAX;
-			if(ranNum <= connectionProbability){
-				//Calculate weight of connection
-				if(rand() % 100 <= percentWeightRange1)
-					weight = Util::getRandomDouble(minWeightRange1, maxWeightRange1);
-				else
-					weight = Util::getRandomDouble(minWeightRange2, maxWeightRange2);
-
-				//Add the connection
-				newConnectionGroup->addConnection(fromIter.key(), toIter.key(), Util::getRandomUInt(minDelay, maxDelay+1), weight);
-			}
+	Random1Parameters parameters;
+	parameters.minWeightRange1 = getParameter("min_weight_range_1");
+	parameters.maxWeightRange1 = getParameter("max_weight_range_1");
+	parameters.percentWeightRange1 = (int)getParameter("percent_weight_range_1");
+	parameters.minWeightRange2 = getParameter("min_weight_range_2");
+	parameters.maxWeightRange2 = getParameter("max_weight_range_2");
+	parameters.minDelay = (unsigned int)getParameter("min_delay");
+	parameters.maxDelay = (unsigned int)getParameter("max_delay");
+	parameters.connectionProbability = getParameter("connection_probability");
+	parameters.randomSeed = (unsigned int)getParameter("random_seed");
+
+	//Share the from neurons out between the threads in contiguous ranges
+	int numberOfFromNeurons = fromNeurGrp->size();
+	int numberOfThreads = QThread::idealThreadCount();
+	if(numberOfThreads > numberOfFromNeurons)
+		numberOfThreads = numberOfFromNeurons;
+	if(numberOfThreads < 1)
+		numberOfThreads = 1;
+	QList<Random1RowThread*> rowThreadList;
+	for(int i=0; i<numberOfThreads; ++i){
+		int startFromIndex = (int)( (qint64)numberOfFromNeurons * i / numberOfThreads );
+		int endFromIndex = (int)( (qint64)numberOfFromNeurons * (i + 1) / numberOfThreads );
+		Random1RowThread* rowThread = new Random1RowThread(parameters, startFromIndex, endFromIndex, toNeurGrp->size(), &stopThread);
+		rowThreadList.append(rowThread);
+		rowThread->start();
+	}
+
+	//Wait for the threads to finish, reporting the number of rows that have been built
+	numberOfProgressSteps = 2 * numberOfFromNeurons + 1;
+	foreach(Random1RowThread* rowThread, rowThreadList){
+		while(!rowThread->wait(200)){
+			int rowsCompleted = 0;
+			foreach(Random1RowThread* tmpThread, rowThreadList)
+				rowsCompleted += tmpThread->getRowsCompleted();
+			emit progress(rowsCompleted, numberOfProgressSteps, "Building connections...");
 		}
+	}
 
-		//Update progress
-		++cntr;
-		emit progress(cntr, numberOfProgressSteps, "Building connections...");
+	//Add the connections to the connection group in the order of the from neurons
+	int stepsCompleted = numberOfFromNeurons;
+	foreach(Random1RowThread* rowThread, rowThreadList){
+		if(!stopThread){
+			const vector<unsigned int>& rowSizes = rowThread->getRowSizes();
+			const vector<int>& toIndexes = rowThread->getToIndexes();
+			const vector<float>& delays = rowThread->getDelays();
+			const vector<float>& weights = rowThread->getWeights();
+			size_t conIndex = 0;
+			for(size_t row = 0; row < rowSizes.size(); ++row){
+				unsigned int fromNeuronID = fromNeurGrp->getNeuronID(rowThread->getStartFromIndex() + row);
+				for(unsigned int i=0; i<rowSizes[row]; ++i){
+					newConnectionGroup->addConnection(fromNeuronID, toNeurGrp->getNeuronID(toIndexes[conIndex]), delays[conIndex], weights[conIndex]);
+					++conIndex;
+				}
+			}
+			stepsCompleted += rowThread->getEndFromIndex() - rowThread->getStartFromIndex();
+			emit progress(stepsCompleted, numberOfProgressSteps, "Adding connections...");
+		}
+		delete rowThread;
 	}
 }
 
@@ -0,0 +1,97 @@
+//SpikeStream includes
+#include "Random1RowThread.h"
+using namespace spikestream;
+
+//Other includes
+#include <cmath>
+
+
+/*! Constructor */
+Random1RowThread::Random1RowThread(const Random1Parameters& parameters, int startFromIndex, int endFromIndex, int numberOfToNeurons, bool* stop){
+	this->parameters = parameters;
+	this->startFromIndex = startFromIndex;
+	this->endFromIndex = endFromIndex;
+	this->numberOfToNeurons = numberOfToNeurons;
+	this->stop = stop;
+	rowsCompleted = 0;
+	seedStream = RandomStream(parameters.randomSeed);
+}
+
+
+/*! Destructor */
+Random1RowThread::~Random1RowThread(){
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                 PUBLIC METHODS                 -----*/
+/*----------------------------------------------------------*/
+
+/*! Run method inherited from QThread.
+	Builds the rows of connections from each neuron in the range. */
+void Random1RowThread::run(){
+	rowsCompleted = 0;
+	rowSizeVector.clear();
+	toIndexVector.clear();
+	delayVector.clear();
+	weightVector.clear();
+
+	//Reserve space for the expected number of connections
+	double connectionProbability = parameters.connectionProbability;
+	size_t expectedConnections = (size_t)(connectionProbability * numberOfToNeurons * (endFromIndex - startFromIndex));
+	rowSizeVector.reserve(endFromIndex - startFromIndex);
+	toIndexVector.reserve(expectedConnections);
+	delayVector.reserve(expectedConnections);
+	weightVector.reserve(expectedConnections);
+
+	//Log of the probability that a pair of neurons is not connected, used to work out how many neurons to skip
+	double logNoConnectionProb = connectionProbability < 1.0 ? log(1.0 - connectionProbability) : 0.0;
+
+	for(int fromIndex = startFromIndex; fromIndex < endFromIndex && !*stop; ++fromIndex){
+		seedRow(fromIndex);
+		size_t rowStart = toIndexVector.size();
+
+		if(connectionProbability >= 1.0){
+			for(int toIndex = 0; toIndex < numberOfToNeurons; ++toIndex)
+				addConnection(toIndex);
+		}
+		else if(connectionProbability > 0.0){
+			//The gap to the next connection is geometrically distributed
+			double toIndex = -1.0;
+			while(true){
+				toIndex += 1.0 + floor(log(1.0 - rowStream.nextDouble()) / logNoConnectionProb);
+				if(toIndex >= numberOfToNeurons)
+					break;
+				addConnection((int)toIndex);
+			}
+		}
+
+		rowSizeVector.push_back(toIndexVector.size() - rowStart);
+		++rowsCompleted;
+	}
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                 PRIVATE METHODS                -----*/
+/*----------------------------------------------------------*/
+
+/*! Adds a connection to the neuron with the specified index in the to neuron group
+	with a random delay and weight. */
+void Random1RowThread::addConnection(int toIndex){
+	toIndexVector.push_back(toIndex);
+	delayVector.push_back(parameters.minDelay + rowStream.nextUInt(parameters.maxDelay - parameters.minDelay + 1));
+
+	double weight;
+	if((int)rowStream.nextUInt(100) <= parameters.percentWeightRange1)
+		weight = parameters.minWeightRange1 + (parameters.maxWeightRange1 - parameters.minWeightRange1) * rowStream.nextDouble();
+	else
+		weight = parameters.minWeightRange2 + (parameters.maxWeightRange2 - parameters.minWeightRange2) * rowStream.nextDouble();
+	weightVector.push_back(weight);
+}
+
+
+/*! Starts the random number sequence for the row of connections from the neuron with the specified index */
+void Random1RowThread::seedRow(int fromIndex){
+	rowStream = seedStream.split(fromIndex);
+}
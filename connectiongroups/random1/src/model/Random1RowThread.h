@@ -0,0 +1,95 @@
+#ifndef RANDOM1ROWTHREAD_H
+#define RANDOM1ROWTHREAD_H
+
+//SpikeStream includes
+#include "RandomStream.h"
+
+//Qt includes
+#include <QThread>
+
+//Other includes
+#include <vector>
+using namespace std;
+
+namespace spikestream {
+
+	/*! Parameters of a random connection group */
+	struct Random1Parameters {
+		double minWeightRange1;
+		double maxWeightRange1;
+		int percentWeightRange1;
+		double minWeightRange2;
+		double maxWeightRange2;
+		unsigned int minDelay;
+		unsigned int maxDelay;
+		double connectionProbability;
+		unsigned int randomSeed;
+	};
+
+
+	/*! Builds the connections from a range of neurons in the from neuron group to the neurons in the to neuron group.
+		Each row of connections from a neuron has its own random number stream, which is split from a stream
+		seeded with the random seed using the index of the from neuron, so the connections do not depend on how the rows are
+		shared out between threads. The targets in each row are chosen by skipping a geometrically distributed
+		number of neurons, so only one random number is needed per connection instead of one per pair of neurons. */
+	class Random1RowThread : public QThread {
+		Q_OBJECT
+
+		public:
+			Random1RowThread(const Random1Parameters& parameters, int startFromIndex, int endFromIndex, int numberOfToNeurons, bool* stop);
+			~Random1RowThread();
+			const vector<float>& getDelays() { return delayVector; }
+			int getEndFromIndex() { return endFromIndex; }
+			const vector<unsigned int>& getRowSizes() { return rowSizeVector; }
+			int getRowsCompleted() { return rowsCompleted; }
+			int getStartFromIndex() { return startFromIndex; }
+			const vector<int>& getToIndexes() { return toIndexVector; }
+			const vector<float>& getWeights() { return weightVector; }
+			void run();
+
+		private:
+			//========================  VARIABLES  ========================
+			/*! Parameters of the connection group */
+			Random1Parameters parameters;
+
+			/*! Index of the first from neuron whose connections are built by this thread */
+			int startFromIndex;
+
+			/*! Index after the last from neuron whose connections are built by this thread */
+			int endFromIndex;
+
+			/*! Number of neurons in the to neuron group */
+			int numberOfToNeurons;
+
+			/*! Stops the thread when set to true. Shared with the thread that launched this one */
+			bool* stop;
+
+			/*! Number of rows that have been built */
+			volatile int rowsCompleted;
+
+			/*! Number of connections in each row */
+			vector<unsigned int> rowSizeVector;
+
+			/*! Index of the to neuron of each connection, in the order of the rows */
+			vector<int> toIndexVector;
+
+			/*! Delay of each connection */
+			vector<float> delayVector;
+
+			/*! Weight of each connection */
+			vector<float> weightVector;
+
+			/*! Stream that is split with the index of each from neuron to give the random numbers of its row */
+			RandomStream seedStream;
+
+			/*! Random numbers of the row being built */
+			RandomStream rowStream;
+
+			//=========================  METHODS  =========================
+			void addConnection(int toIndex);
+			void seedRow(int fromIndex);
+	};
+
+}
+
+#endif//RANDOM1ROWTHREAD_H
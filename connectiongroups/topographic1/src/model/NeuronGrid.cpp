@@ -0,0 +1,142 @@
+//SpikeStream includes
+#include "NeuronGrid.h"
+using namespace spikestream;
+
+//Other includes
+#include <algorithm>
+#include <cmath>
+
+
+/*! Constructor. Sorts the neurons in the group into cells that hold about one neuron each on average.
+	Axes along which the group is flat have a single cell. */
+NeuronGrid::NeuronGrid(NeuronGroup* neuronGroup){
+	this->neuronGroup = neuronGroup;
+	gridBox = neuronGroup->getBoundingBox();
+	int numberOfNeurons = neuronGroup->size();
+
+	//Work out the size of a cube that would hold one neuron if the neurons were spread evenly through the box
+	float extent[3] = { gridBox.getWidth(), gridBox.getLength(), gridBox.getHeight() };
+	double volume = 1.0;
+	int numberOfDimensions = 0;
+	for(int axis=0; axis<3; ++axis){
+		if(extent[axis] > 0.0f){
+			volume *= extent[axis];
+			++numberOfDimensions;
+		}
+	}
+	double targetCellSize = 1.0;
+	if(numberOfDimensions > 0 && numberOfNeurons > 0)
+		targetCellSize = pow(volume / numberOfNeurons, 1.0 / numberOfDimensions);
+
+	//Choose the number of cells along each axis, making the cells larger if there would be many more cells than neurons
+	double maxCells = 2.0 * numberOfNeurons + 8.0;
+	while(true){
+		double cellCount = 1.0;
+		for(int axis=0; axis<3; ++axis){
+			double cellsOnAxis = 1.0;
+			if(extent[axis] > 0.0f)
+				cellsOnAxis = ceil(extent[axis] / targetCellSize);
+			cellCount *= cellsOnAxis < 1.0 ? 1.0 : cellsOnAxis;
+		}
+		if(cellCount <= maxCells)
+			break;
+		targetCellSize *= 2.0;
+	}
+	int totalCells = 1;
+	for(int axis=0; axis<3; ++axis){
+		numberOfCells[axis] = 1;
+		if(extent[axis] > 0.0f)
+			numberOfCells[axis] = (int)ceil(extent[axis] / targetCellSize);
+		if(numberOfCells[axis] < 1)
+			numberOfCells[axis] = 1;
+		totalCells *= numberOfCells[axis];
+	}
+	for(int axis=0; axis<3; ++axis)
+		cellSize[axis] = extent[axis] > 0.0f ? extent[axis] / numberOfCells[axis] : 1.0f;
+
+	//Count the neurons in each cell
+	int* neuronCellArray = new int[numberOfNeurons];
+	cellStartArray = new int[totalCells + 1];
+	for(int i=0; i<=totalCells; ++i)
+		cellStartArray[i] = 0;
+	for(int i=0; i<numberOfNeurons; ++i){
+		int xCell = getCell(0, neuronGroup->getNeuronXPos(i));
+		int yCell = getCell(1, neuronGroup->getNeuronYPos(i));
+		int zCell = getCell(2, neuronGroup->getNeuronZPos(i));
+		neuronCellArray[i] = (zCell * numberOfCells[1] + yCell) * numberOfCells[0] + xCell;
+		++cellStartArray[neuronCellArray[i] + 1];
+	}
+
+	//Turn the counts into the start of each cell and fill in the neurons
+	for(int i=0; i<totalCells; ++i)
+		cellStartArray[i + 1] += cellStartArray[i];
+	cellNeuronArray = new int[numberOfNeurons];
+	int* cellFillArray = new int[totalCells];
+	for(int i=0; i<totalCells; ++i)
+		cellFillArray[i] = cellStartArray[i];
+	for(int i=0; i<numberOfNeurons; ++i){
+		cellNeuronArray[cellFillArray[neuronCellArray[i]]] = i;
+		++cellFillArray[neuronCellArray[i]];
+	}
+	delete [] cellFillArray;
+	delete [] neuronCellArray;
+}
+
+
+/*! Destructor */
+NeuronGrid::~NeuronGrid(){
+	delete [] cellStartArray;
+	delete [] cellNeuronArray;
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                 PUBLIC METHODS                 -----*/
+/*----------------------------------------------------------*/
+
+/*! Fills the vector with the indexes of the neurons inside the box in increasing order,
+	which is the order in which they were added to the neuron group. */
+void NeuronGrid::getNeuronIndexes(const Box& box, vector<int>& indexVector) const{
+	indexVector.clear();
+
+	//Check that the box overlaps the grid
+	if(box.getX2() < gridBox.getX1() || box.getX1() > gridBox.getX2() ||
+			box.getY2() < gridBox.getY1() || box.getY1() > gridBox.getY2() ||
+			box.getZ2() < gridBox.getZ1() || box.getZ1() > gridBox.getZ2())
+		return;
+
+	//Check the neurons in each cell that overlaps the box
+	int xStart = getCell(0, box.getX1()), xEnd = getCell(0, box.getX2());
+	int yStart = getCell(1, box.getY1()), yEnd = getCell(1, box.getY2());
+	int zStart = getCell(2, box.getZ1()), zEnd = getCell(2, box.getZ2());
+	for(int zCell = zStart; zCell <= zEnd; ++zCell){
+		for(int yCell = yStart; yCell <= yEnd; ++yCell){
+			for(int xCell = xStart; xCell <= xEnd; ++xCell){
+				int cell = (zCell * numberOfCells[1] + yCell) * numberOfCells[0] + xCell;
+				for(int i = cellStartArray[cell]; i < cellStartArray[cell + 1]; ++i){
+					int neurIndex = cellNeuronArray[i];
+					Point3D neurLocation(neuronGroup->getNeuronXPos(neurIndex), neuronGroup->getNeuronYPos(neurIndex), neuronGroup->getNeuronZPos(neurIndex));
+					if(box.contains(neurLocation))
+						indexVector.push_back(neurIndex);
+				}
+			}
+		}
+	}
+	sort(indexVector.begin(), indexVector.end());
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                 PRIVATE METHODS                -----*/
+/*----------------------------------------------------------*/
+
+/*! Returns the cell along the axis that contains the position. Positions outside the grid are put in the nearest cell. */
+int NeuronGrid::getCell(int axis, float position) const{
+	float start = axis == 0 ? gridBox.getX1() : (axis == 1 ? gridBox.getY1() : gridBox.getZ1());
+	double cell = floor( (position - start) / cellSize[axis] );
+	if(cell < 0.0)
+		return 0;
+	if(cell >= numberOfCells[axis])
+		return numberOfCells[axis] - 1;
+	return (int)cell;
+}
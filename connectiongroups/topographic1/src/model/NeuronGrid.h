@@ -0,0 +1,52 @@
+#ifndef NEURONGRID_H
+#define NEURONGRID_H
+
+//SpikeStream includes
+#include "Box.h"
+#include "NeuronGroup.h"
+
+//Other includes
+#include <vector>
+using namespace std;
+
+namespace spikestream {
+
+	/*! Divides the space around a neuron group into a grid of cells and records the neurons in each cell,
+		so that the neurons inside a box can be found without checking every neuron in the group.
+		The grid only reads from the neuron group after it has been built, so it can be queried from several threads at once. */
+	class NeuronGrid {
+		public:
+			NeuronGrid(NeuronGroup* neuronGroup);
+			~NeuronGrid();
+			void getNeuronIndexes(const Box& box, vector<int>& indexVector) const;
+
+		private:
+			//========================  VARIABLES  ========================
+			/*! Neuron group covered by the grid */
+			NeuronGroup* neuronGroup;
+
+			/*! Box enclosing the neuron group */
+			Box gridBox;
+
+			/*! Number of cells along the x, y and z axes */
+			int numberOfCells[3];
+
+			/*! Size of the cells along the x, y and z axes */
+			float cellSize[3];
+
+			/*! The neurons in cell i are listed in cellNeuronArray from cellStartArray[i] up to, but not including,
+				cellStartArray[i+1]. The array has one more entry than the number of cells. */
+			int* cellStartArray;
+
+			/*! Indexes in the neuron group of the neurons in each cell */
+			int* cellNeuronArray;
+
+			//=========================  METHODS  =========================
+			int getCell(int axis, float position) const;
+			NeuronGrid(const NeuronGrid& neuronGrid);
+			NeuronGrid& operator=(const NeuronGrid& rhs);
+	};
+
+}
+
+#endif//NEURONGRID_H
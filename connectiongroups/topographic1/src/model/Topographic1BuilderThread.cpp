@@ -1,13 +1,11 @@
 #include "Globals.h"
 #include "NeuronGroup.h"
 #include "Topographic1BuilderThread.h"
+#include "Topographic1RowThread.h"
+#include "NeuronGrid.h"
 #include "SpikeStreamException.h"
-#include "Util.h"
 using namespace spikestream;
 
-//Enables output of debugging information.
-//#define DEBUG
-
 /*! Constructor */
 Topographic1BuilderThread::Topographic1BuilderThread() : AbstractConnectionBuilder() {
 }
@@ -31,48 +29,46 @@ void Topographic1BuilderThread::buildConnectionGroup(){
 	NeuronGroup* toNeurGrp = Globals::getNetwork()->getNeuronGroup(connectionGroupInfo.getToNeuronGroupID());
 
 	//Extract parameters
-	projWidth = getParameter("projection_width");
-	projLength = getParameter("projection_length");
-	projHeight = getParameter("projection_height");
-	ovWidth = getParameter("overlap_width");
-	ovLength = getParameter("overlap_length");
-	ovHeight = getParameter("overlap_height");
-	conPattern = getParameter("connection_pattern");
-	minWeight = getParameter("min_weight");
-	maxWeight = getParameter("max_weight");
-	delayType = getParameter("delay_type");
-	delayDistanceFactor = 0;
-	minDelay = 0, maxDelay = 0;
-	if(delayType == 0){
-		delayDistanceFactor = getParameter("delay_distance_factor");
+	double projWidth = getParameter("projection_width");
+	double projLength = getParameter("projection_length");
+	double projHeight = getParameter("projection_height");
+	double ovWidth = getParameter("overlap_width");
+	double ovLength = getParameter("overlap_length");
+	double ovHeight = getParameter("overlap_height");
+	Topographic1Parameters parameters;
+	parameters.connectionPattern = (int)getParameter("connection_pattern");
+	parameters.minWeight = getParameter("min_weight");
+	parameters.maxWeight = getParameter("max_weight");
+	parameters.delayType = (int)getParameter("delay_type");
+	parameters.delayDistanceFactor = 0;
+	parameters.minDelay = 0, parameters.maxDelay = 0;
+	if(parameters.delayType == Topographic1RowThread::DELAY_WITH_DISTANCE){
+		parameters.delayDistanceFactor = getParameter("delay_distance_factor");
 	}
 	else{
-		minDelay = (unsigned)getParameter("min_delay");
-		maxDelay = (unsigned)getParameter("max_delay");
+		parameters.minDelay = (unsigned)getParameter("min_delay");
+		parameters.maxDelay = (unsigned)getParameter("max_delay");
 	}
-	density = getParameter("density");
-
-	//Keep track of progress
-	numberOfProgressSteps = fromNeurGrp->size() + 1;
+	parameters.density = getParameter("density");
 
-	//Work through all of the from neurons to build the projection space
-	QHash<unsigned, Box> projBoxMap;
-	Point3D tmpPnt;
+	//Work through all of the from neurons to build the projection space, storing the box of each neuron at its index
+	int numberOfFromNeurons = fromNeurGrp->size();
+	vector<Box> projBoxVector(numberOfFromNeurons);
 	int xCount=0, yCount=0, zCount=0;
 	float tmpX, tmpY, tmpZ, prevX, prevY, prevZ, boxXPos, boxYPos, boxZPos;
+	float minX = 0.0f, minY = 0.0f, minZ = 0.0f, maxX = 0.0f, maxY = 0.0f, maxZ = 0.0f;
 	bool firstTime = true;
 	for(NeuronPositionIterator posIter = fromNeurGrp->positionBegin(); posIter != fromNeurGrp->positionEnd(); ++posIter){
-		tmpPnt = posIter.value()->getLocation();
-		tmpX = tmpPnt.getXPos();
-		tmpY = tmpPnt.getYPos();
-		tmpZ = tmpPnt.getZPos();
+		int fromIndex = posIter.getIndex();
+		tmpX = fromNeurGrp->getNeuronXPos(fromIndex);
+		tmpY = fromNeurGrp->getNeuronYPos(fromIndex);
+		tmpZ = fromNeurGrp->getNeuronZPos(fromIndex);
 
 		//Initialize previous values on first call
 		if(firstTime){
 			prevX = tmpX;
 			prevY = tmpY;
 			prevZ = tmpZ;
-			firstTime = false;
 		}
 
 		//Sanity check
@@ -93,14 +89,18 @@ void Topographic1BuilderThread::buildConnectionGroup(){
 			++zCount;
 		}
 
-		//Create new box
+		//Create new box and expand the box enclosing all of the boxes to include it
 		boxXPos = xCount * (projWidth - ovWidth);
 		boxYPos = yCount * (projLength - ovLength);
 		boxZPos = zCount * (projHeight - ovHeight);
-		Box newBox(boxXPos, boxYPos, boxZPos, boxXPos + projWidth, boxYPos + projLength, boxZPos + projHeight);
-		if(projBoxMap.contains(posIter.value()->getID()))
-			throw SpikeStreamException("Duplicate neuron ID: " + QString::number(posIter.value()->getID()));
-		projBoxMap[posIter.value()->getID()] = newBox;
+		projBoxVector[fromIndex] = Box(boxXPos, boxYPos, boxZPos, boxXPos + projWidth, boxYPos + projLength, boxZPos + projHeight);
+		if(firstTime || boxXPos < minX) minX = boxXPos;
+		if(firstTime || boxYPos < minY) minY = boxYPos;
+		if(firstTime || boxZPos < minZ) minZ = boxZPos;
+		if(firstTime || boxXPos + projWidth > maxX) maxX = boxXPos + projWidth;
+		if(firstTime || boxYPos + projLength > maxY) maxY = boxYPos + projLength;
+		if(firstTime || boxZPos + projHeight > maxZ) maxZ = boxZPos + projHeight;
+		firstTime = false;
 
 		//Store location for next iteration
 		prevX = tmpX;
@@ -109,7 +109,7 @@ void Topographic1BuilderThread::buildConnectionGroup(){
 	}
 
 	//Get a single box enclosing all of the boxes that have been created
-	Box totalBox = Box::getEnclosingBox(projBoxMap.values());
+	Box totalBox(minX, minY, minZ, maxX, maxY, maxZ);
 
 	/* Now have a projection volume with its origin at (0,0,0)
 		Need to translate this volume so that its centre is aligned with the centre of the to neuron group. */
@@ -118,64 +118,66 @@ void Topographic1BuilderThread::buildConnectionGroup(){
 	float dx = toCentre.getXPos() - fromCentre.getXPos();
 	float dy = toCentre.getYPos() - fromCentre.getYPos();
 	float dz = toCentre.getZPos() - fromCentre.getZPos();
-
-	//Translate boxes and create connections
-	int neuronCntr = 0;
-	NeuronIterator fromNeurGrpEnd = fromNeurGrp->end();
-	for(NeuronIterator iter = fromNeurGrp->begin(); iter != fromNeurGrpEnd; ++iter){
-		if(!projBoxMap.contains(iter.key()))
-			throw SpikeStreamException("Neuron ID missing from projection box map: " + QString::number(iter.key()));
-		projBoxMap[iter.key()].translate(dx, dy, dz);
-		addProjectiveConnections(iter.value(), toNeurGrp, projBoxMap[iter.key()]);
-
-		//Inform user about progress
-		emit progress(neuronCntr, numberOfProgressSteps, "Building connections...");
-		++neuronCntr;
+	for(int i=0; i<numberOfFromNeurons; ++i)
+		projBoxVector[i].translate(dx, dy, dz);
+
+	//Sort the to neurons into a grid so that the neurons in each box can be found quickly
+	NeuronGrid toNeuronGrid(toNeurGrp);
+
+	//Share the from neurons out between the threads in contiguous ranges
+	int numberOfThreads = QThread::idealThreadCount();
+	if(numberOfThreads > numberOfFromNeurons)
+		numberOfThreads = numberOfFromNeurons;
+	if(numberOfThreads < 1)
+		numberOfThreads = 1;
+	QList<Topographic1RowThread*> rowThreadList;
+	for(int i=0; i<numberOfThreads; ++i){
+		int startFromIndex = (int)( (qint64)numberOfFromNeurons * i / numberOfThreads );
+		int endFromIndex = (int)( (qint64)numberOfFromNeurons * (i + 1) / numberOfThreads );
+		Topographic1RowThread* rowThread = new Topographic1RowThread(parameters, fromNeurGrp, projBoxVector, toNeuronGrid, toNeurGrp, startFromIndex, endFromIndex, &stopThread);
+		rowThreadList.append(rowThread);
+		rowThread->start();
 	}
-}
-
 
-/*----------------------------------------------------------*/
-/*-----                 PRIVATE METHODS                -----*/
-/*----------------------------------------------------------*/
-
-/*! Adds projective connections from the neuron to all neurons in the box
-	 using parameters supplied. */
-void Topographic1BuilderThread::addProjectiveConnections(Neuron* fromNeuron, NeuronGroup* toNeurGrp, Box& projBox){
-	float radius = 0.5 * Util::min(projBox.getWidth(), projBox.getLength(), projBox.getHeight());
-	Point3D projBoxCentre = projBox.centre();
-
-	QList<Neuron*> neurList = toNeurGrp->getNeurons(projBox);
-	Neuron* tmpNeur;
-	for(int i=0; i<neurList.size(); ++i){
-		tmpNeur = neurList.at(i);
-		if(conPattern == GAUSSIAN_SPHERE){
-			if(makeGaussianConnection(projBox, tmpNeur->getLocation())){
-				newConnectionGroup->addConnection(fromNeuron->getID(), tmpNeur->getID(), getDelay(fromNeuron, tmpNeur), getWeight());
-			}
+	//Wait for the threads to finish, reporting the number of rows that have been built
+	numberOfProgressSteps = 2 * numberOfFromNeurons + 1;
+	foreach(Topographic1RowThread* rowThread, rowThreadList){
+		while(!rowThread->wait(200)){
+			int rowsCompleted = 0;
+			foreach(Topographic1RowThread* tmpThread, rowThreadList)
+				rowsCompleted += tmpThread->getRowsCompleted();
+			emit progress(rowsCompleted, numberOfProgressSteps, "Building connections...");
 		}
-		else if(conPattern == UNIFORM_SPHERE){
-			double ranNum = (double)rand() / (double)RAND_MAX;
-			if(ranNum <= density){//Decide if connection is made
-				if(tmpNeur->getLocation().distance(projBoxCentre) < radius){
-					newConnectionGroup->addConnection(fromNeuron->getID(), tmpNeur->getID(), getDelay(fromNeuron, tmpNeur), getWeight());
+	}
+
+	//Add the connections to the connection group in the order of the from neurons
+	int stepsCompleted = numberOfFromNeurons;
+	foreach(Topographic1RowThread* rowThread, rowThreadList){
+		if(!stopThread){
+			const vector<unsigned int>& rowSizes = rowThread->getRowSizes();
+			const vector<int>& toIndexes = rowThread->getToIndexes();
+			const vector<float>& delays = rowThread->getDelays();
+			const vector<float>& weights = rowThread->getWeights();
+			size_t conIndex = 0;
+			for(size_t row = 0; row < rowSizes.size(); ++row){
+				unsigned int fromNeuronID = fromNeurGrp->getNeuronID(rowThread->getStartFromIndex() + row);
+				for(unsigned int i=0; i<rowSizes[row]; ++i){
+					newConnectionGroup->addConnection(fromNeuronID, toNeurGrp->getNeuronID(toIndexes[conIndex]), delays[conIndex], weights[conIndex]);
+					++conIndex;
 				}
 			}
+			stepsCompleted += rowThread->getEndFromIndex() - rowThread->getStartFromIndex();
+			emit progress(stepsCompleted, numberOfProgressSteps, "Adding connections...");
 		}
-		else if(conPattern == UNIFORM_CUBE){
-			double ranNum = (double)rand() / (double)RAND_MAX;
-			if(ranNum <= density){//Decide if connection is made
-				newConnectionGroup->addConnection(fromNeuron->getID(), tmpNeur->getID(), getDelay(fromNeuron, tmpNeur), getWeight());
-			}
-		}
-		else{
-			throw SpikeStreamException("Connection pattern not recognized: " + conPattern);
-		}
-
+		delete rowThread;
 	}
 }
 
 
+/*----------------------------------------------------------*/
+/*-----                 PRIVATE METHODS                -----*/
+/*----------------------------------------------------------*/
+
 /*! Extracts parameters from neuron group info and checks that they are in range. */
 void Topographic1BuilderThread::checkParameters(){
 	double projectionWidth = getParameter("projection_width");
@@ -204,21 +206,21 @@ void Topographic1BuilderThread::checkParameters(){
 	if(overlapHeight < 0.0)
 		throw SpikeStreamException("Overlap height cannot be less than 0: " + QString::number(overlapHeight));
 
-	if(!(connectionPattern == GAUSSIAN_SPHERE || connectionPattern == UNIFORM_SPHERE || connectionPattern == UNIFORM_CUBE))
+	if(!(connectionPattern == Topographic1RowThread::GAUSSIAN_SPHERE || connectionPattern == Topographic1RowThread::UNIFORM_SPHERE || connectionPattern == Topographic1RowThread::UNIFORM_CUBE))
 		throw SpikeStreamException("Connection pattern not recognized: " + QString::number(connectionPattern));
 
 	if(minWeight > maxWeight)
 		throw SpikeStreamException("Min weight cannot be greater than max weight.");
 
-	if(!(delayType == DELAY_WITH_DISTANCE || delayType == RANDOM_DELAY))
+	if(!(delayType == Topographic1RowThread::DELAY_WITH_DISTANCE || delayType == Topographic1RowThread::RANDOM_DELAY))
 		throw SpikeStreamException("Delay type not recognized: " + QString::number(delayType));
 
-	if(delayType == DELAY_WITH_DISTANCE){
+	if(delayType == Topographic1RowThread::DELAY_WITH_DISTANCE){
 		double delayDistanceFactor = getParameter("delay_distance_factor");
 		if(delayDistanceFactor <= 0.0)
 			throw SpikeStreamException("Delay distance factor cannot be less than or equal to 0: " + QString::number(delayDistanceFactor));
 	}
-	else if (delayType == RANDOM_DELAY){
+	else if (delayType == Topographic1RowThread::RANDOM_DELAY){
 		unsigned minDelay = (unsigned)getParameter("min_delay");
 		unsigned maxDelay = (unsigned)getParameter("max_delay");
 		if(minDelay > maxDelay)
@@ -228,108 +230,3 @@ void Topographic1BuilderThread::checkParameters(){
 	if(density <= 0.0)
 		throw SpikeStreamException("Density must be greater than 0: " + QString::number(density));
 }
-
-
-/*! Returns delay that will vary with the distance of the two neurons or randomly selected from a range */
-float Topographic1BuilderThread::getDelay(Neuron *fromNeuron, Neuron *toNeuron){
-	if(delayType == DELAY_WITH_DISTANCE){
-		return delayDistanceFactor * fromNeuron->getLocation().distance(toNeuron->getLocation());
-	}
-	else if (delayType == RANDOM_DELAY){
-		return Util::getRandomUInt(minDelay, maxDelay);
-	}
-	else
-		throw SpikeStreamException("Delay type not recognized: " + QString::number(delayType));
-}
-
-
-/*! Returns weight that is randomly selected from the specified range */
-float Topographic1BuilderThread::getWeight(){
-	return Util::getRandomDouble(minWeight, maxWeight);
-}
-
-
-/*! Returns normally distributed true and false depending on the relationshiop between
-	the point and the box. The closer the point is to the centre of the box the more likely
-	that the respose will be true. */
-bool Topographic1BuilderThread::makeGaussianConnection(const Box& projectionBox, const Point3D neuronLocation){
-	//Get the connection probability on each axis
-	float radius = projectionBox.getWidth()/2.0;
-	float distance = Util::toPositive(neuronLocation.getXPos() - (projectionBox.getX1() + radius) );
-	if(!makeGaussianConnection(radius, distance))
-		return false;
-
-	radius = projectionBox.getLength()/2.0;
-	distance = Util::toPositive(neuronLocation.getYPos() - (projectionBox.getY1() + radius) );
-	if(!makeGaussianConnection(radius, distance))
-		return false;
-
-	radius = projectionBox.getHeight()/2.0;
-	distance = Util::toPositive(neuronLocation.getZPos() - (projectionBox.getZ1() + radius) );
-	if(!makeGaussianConnection(radius, distance))
-		return false;
-
-	return true;
-}
-
-
-/*! Returns normally distributed true and false depending on the relationshiop between
-	the distance and the radius. The closer the distance is to zero, the more likely
-	that the respose will be true. */
-bool Topographic1BuilderThread::makeGaussianConnection(float radius, float distance){
-	//Get normally distributed random number
-	double normRan = Util::toPositive(getNormalRandom());
-
-	//Limit it to + 3
-	if(normRan > 3.0)
-		normRan = 3.0;
-
-	//Normal random number now varies between -3 and +3 so need to make it fit into the radius range
-	normRan *= (radius / 3.0);
-
-	/* 68% of values will be between 0 and 1. Adding 1 makes little difference to large networks and
-		creates a better connection pattern on small networks. */
-	++normRan;
-
-	#ifdef DEBUG
-		qDebug()<<"NormRan="<<normRan<<"; Radius="<<radius<<"; distance="<<distance<<"; density factor="<<(1.0f/density);
-	#endif//DEBUG
-
-	/* Should now have a number that is between 1 and radius and
-		much more likely to be closer to 0 than to radius
-		Accept connection if normRan is greater than the distance.
-		The shorter the distance, the more likely this is to occur.
-		Higher values of density will reduce the distance and make the connection more likely. */
-	if(normRan >= (1.0f/density)* distance)
-		return true;
-	return false;
-}
-
-
-/*! Returns a normally distributed random number with standar deviation = 1
-	Uses Box-Muller method to generate values
-	Code adapted from http://www.csit.fsu.edu/~burkardt/cpp_src/random_data/random_data.html. */
-double Topographic1BuilderThread::getNormalRandom(){
-	double PI = 3.141592653589793;
-	double rand1, rand2;
-	static int used = 0;
-	double x;
-	static double y = 0.0;
-	//  If we've used an even number of values so far, generate two more, return one and save one.
-	if (( used % 2 ) == 0 ){
-		for ( ; ; ){
-			rand1 = (double)rand()/(double)RAND_MAX;
-			if ( rand1 != 0.0 )
-				break;
-		}
-		rand2 = (double)rand()/(double)RAND_MAX;
-		x = sqrt ( -2.0 * log ( rand1 ) ) * cos ( 2.0 * PI * rand2 );
-		y = sqrt ( -2.0 * log ( rand1 ) ) * sin ( 2.0 * PI * rand2 );
-	}
-	//  Otherwise, return the second, saved, value.
-	else{
-		x = y;
-	}
-	++used;
-	return x;
-}
@@ -0,0 +1,162 @@
+//SpikeStream includes
+#include "Topographic1RowThread.h"
+#include "SpikeStreamException.h"
+#include "Util.h"
+using namespace spikestream;
+
+//Other includes
+#include <cmath>
+
+
+/*! Constructor */
+Topographic1RowThread::Topographic1RowThread(const Topographic1Parameters& parameters, NeuronGroup* fromNeurGrp, const vector<Box>& projectionBoxVector, const NeuronGrid& toNeuronGrid, NeuronGroup* toNeurGrp, int startFromIndex, int endFromIndex, bool* stop) :
+		projectionBoxVector(projectionBoxVector), toNeuronGrid(toNeuronGrid) {
+	this->parameters = parameters;
+	this->fromNeurGrp = fromNeurGrp;
+	this->toNeurGrp = toNeurGrp;
+	this->startFromIndex = startFromIndex;
+	this->endFromIndex = endFromIndex;
+	this->stop = stop;
+	rowsCompleted = 0;
+	seedStream = RandomStream(RANDOM_SEED);
+}
+
+
+/*! Destructor */
+Topographic1RowThread::~Topographic1RowThread(){
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                 PUBLIC METHODS                 -----*/
+/*----------------------------------------------------------*/
+
+/*! Run method inherited from QThread.
+	Builds the rows of connections from each neuron in the range to the neurons inside its projection box. */
+void Topographic1RowThread::run(){
+	rowsCompleted = 0;
+	rowSizeVector.clear();
+	toIndexVector.clear();
+	delayVector.clear();
+	weightVector.clear();
+	rowSizeVector.reserve(endFromIndex - startFromIndex);
+
+	vector<int> boxIndexVector;
+	for(int fromIndex = startFromIndex; fromIndex < endFromIndex && !*stop; ++fromIndex){
+		seedRow(fromIndex);
+		size_t rowStart = toIndexVector.size();
+
+		const Box& projBox = projectionBoxVector[fromIndex];
+		float radius = 0.5 * Util::min(projBox.getWidth(), projBox.getLength(), projBox.getHeight());
+		Point3D projBoxCentre = projBox.centre();
+		Point3D fromLocation(fromNeurGrp->getNeuronXPos(fromIndex), fromNeurGrp->getNeuronYPos(fromIndex), fromNeurGrp->getNeuronZPos(fromIndex));
+
+		//Work through the neurons inside the projection box in the order in which they were added to the to group
+		toNeuronGrid.getNeuronIndexes(projBox, boxIndexVector);
+		for(size_t i=0; i<boxIndexVector.size(); ++i){
+			int toIndex = boxIndexVector[i];
+			Point3D toLocation(toNeurGrp->getNeuronXPos(toIndex), toNeurGrp->getNeuronYPos(toIndex), toNeurGrp->getNeuronZPos(toIndex));
+			if(parameters.connectionPattern == GAUSSIAN_SPHERE){
+				if(makeGaussianConnection(projBox, toLocation))
+					addConnection(toIndex, fromLocation, toLocation);
+			}
+			else if(parameters.connectionPattern == UNIFORM_SPHERE){
+				if(rowStream.nextDouble() <= parameters.density){//Decide if connection is made
+					if(toLocation.distance(projBoxCentre) < radius)
+						addConnection(toIndex, fromLocation, toLocation);
+				}
+			}
+			else if(parameters.connectionPattern == UNIFORM_CUBE){
+				if(rowStream.nextDouble() <= parameters.density)//Decide if connection is made
+					addConnection(toIndex, fromLocation, toLocation);
+			}
+			else{
+				throw SpikeStreamException("Connection pattern not recognized: " + QString::number(parameters.connectionPattern));
+			}
+		}
+
+		rowSizeVector.push_back(toIndexVector.size() - rowStart);
+		++rowsCompleted;
+	}
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                 PRIVATE METHODS                -----*/
+/*----------------------------------------------------------*/
+
+/*! Adds a connection to the neuron with the specified index in the to neuron group.
+	The delay varies with the distance between the two neurons or is randomly selected from a range,
+	and the weight is randomly selected from the weight range. */
+void Topographic1RowThread::addConnection(int toIndex, const Point3D& fromLocation, const Point3D& toLocation){
+	float delay;
+	if(parameters.delayType == DELAY_WITH_DISTANCE)
+		delay = parameters.delayDistanceFactor * fromLocation.distance(toLocation);
+	else if(parameters.delayType == RANDOM_DELAY)
+		delay = parameters.minDelay == parameters.maxDelay ? parameters.minDelay : parameters.minDelay + rowStream.nextUInt(parameters.maxDelay - parameters.minDelay);
+	else
+		throw SpikeStreamException("Delay type not recognized: " + QString::number(parameters.delayType));
+
+	toIndexVector.push_back(toIndex);
+	delayVector.push_back(delay);
+	weightVector.push_back(parameters.minWeight + (parameters.maxWeight - parameters.minWeight) * rowStream.nextDouble());
+}
+
+
+/*! Returns normally distributed true and false depending on the relationshiop between
+	the point and the box. The closer the point is to the centre of the box the more likely
+	that the respose will be true. */
+bool Topographic1RowThread::makeGaussianConnection(const Box& projectionBox, const Point3D& neuronLocation){
+	//Get the connection probability on each axis
+	float radius = projectionBox.getWidth()/2.0;
+	float distance = Util::toPositive(neuronLocation.getXPos() - (projectionBox.getX1() + radius) );
+	if(!makeGaussianConnection(radius, distance))
+		return false;
+
+	radius = projectionBox.getLength()/2.0;
+	distance = Util::toPositive(neuronLocation.getYPos() - (projectionBox.getY1() + radius) );
+	if(!makeGaussianConnection(radius, distance))
+		return false;
+
+	radius = projectionBox.getHeight()/2.0;
+	distance = Util::toPositive(neuronLocation.getZPos() - (projectionBox.getZ1() + radius) );
+	if(!makeGaussianConnection(radius, distance))
+		return false;
+
+	return true;
+}
+
+
+/*! Returns normally distributed true and false depending on the relationshiop between
+	the distance and the radius. The closer the distance is to zero, the more likely
+	that the respose will be true. */
+bool Topographic1RowThread::makeGaussianConnection(float radius, float distance){
+	//Get normally distributed random number
+	double normRan = Util::toPositive(rowStream.nextNormal());
+
+	//Limit it to + 3
+	if(normRan > 3.0)
+		normRan = 3.0;
+
+	//Normal random number now varies between -3 and +3 so need to make it fit into the radius range
+	normRan *= (radius / 3.0);
+
+	/* 68% of values will be between 0 and 1. Adding 1 makes little difference to large networks and
+		creates a better connection pattern on small networks. */
+	++normRan;
+
+	/* Should now have a number that is between 1 and radius and
+		much more likely to be closer to 0 than to radius
+		Accept connection if normRan is greater than the distance.
+		The shorter the distance, the more likely this is to occur.
+		Higher values of density will reduce the distance and make the connection more likely. */
+	if(normRan >= (1.0f/parameters.density)* distance)
+		return true;
+	return false;
+}
+
+
+/*! Starts the random number sequence for the row of connections from the neuron with the specified index */
+void Topographic1RowThread::seedRow(int fromIndex){
+	rowStream = seedStream.split(fromIndex);
+}
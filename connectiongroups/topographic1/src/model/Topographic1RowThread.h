@@ -0,0 +1,127 @@
+#ifndef TOPOGRAPHIC1ROWTHREAD_H
+#define TOPOGRAPHIC1ROWTHREAD_H
+
+//SpikeStream includes
+#include "Box.h"
+#include "NeuronGrid.h"
+#include "NeuronGroup.h"
+#include "Point3D.h"
+#include "RandomStream.h"
+
+//Qt includes
+#include <QThread>
+
+//Other includes
+#include <vector>
+using namespace std;
+
+namespace spikestream {
+
+	/*! Parameters controlling the connections of a topographic connection group */
+	struct Topographic1Parameters {
+		int connectionPattern;
+		double minWeight;
+		double maxWeight;
+		int delayType;
+		double delayDistanceFactor;
+		unsigned int minDelay;
+		unsigned int maxDelay;
+		double density;
+	};
+
+
+	/*! Builds the connections from a range of neurons in the from neuron group to the neurons inside their projection boxes.
+		The neurons inside each box are found with a grid over the to neuron group. Each row of connections from a neuron has
+		its own random number stream, which is split from a seeded stream using the index of the from neuron, so the connections do not depend
+		on how the rows are shared out between threads. */
+	class Topographic1RowThread : public QThread {
+		Q_OBJECT
+
+		public:
+			Topographic1RowThread(const Topographic1Parameters& parameters, NeuronGroup* fromNeurGrp, const vector<Box>& projectionBoxVector, const NeuronGrid& toNeuronGrid, NeuronGroup* toNeurGrp, int startFromIndex, int endFromIndex, bool* stop);
+			~Topographic1RowThread();
+			const vector<float>& getDelays() { return delayVector; }
+			int getEndFromIndex() { return endFromIndex; }
+			const vector<unsigned int>& getRowSizes() { return rowSizeVector; }
+			int getRowsCompleted() { return rowsCompleted; }
+			int getStartFromIndex() { return startFromIndex; }
+			const vector<int>& getToIndexes() { return toIndexVector; }
+			const vector<float>& getWeights() { return weightVector; }
+			void run();
+
+			/*! Connection projects to a Gaussian sphere of neurons */
+			static const int GAUSSIAN_SPHERE = 0;
+
+			/*! Connection projects to a uniform sphere of neurons  */
+			static const int UNIFORM_SPHERE = 1;
+
+			/*! Connection projects to a uniform cube of neurons */
+			static const int UNIFORM_CUBE = 2;
+
+			/*! Delay varies with distance */
+			static const int DELAY_WITH_DISTANCE = 0;
+
+			/*! Delays are randomly selected from a range of values */
+			static const int RANDOM_DELAY = 1;
+
+
+		private:
+			//========================  VARIABLES  ========================
+			/*! Parameters of the connection group */
+			Topographic1Parameters parameters;
+
+			/*! Neuron group that the connections are from */
+			NeuronGroup* fromNeurGrp;
+
+			/*! Projection box of each neuron in the from neuron group */
+			const vector<Box>& projectionBoxVector;
+
+			/*! Grid used to find the neurons in the to neuron group that lie inside a projection box */
+			const NeuronGrid& toNeuronGrid;
+
+			/*! Neuron group that the connections are to */
+			NeuronGroup* toNeurGrp;
+
+			/*! Index of the first from neuron whose connections are built by this thread */
+			int startFromIndex;
+
+			/*! Index after the last from neuron whose connections are built by this thread */
+			int endFromIndex;
+
+			/*! Stops the thread when set to true. Shared with the thread that launched this one */
+			bool* stop;
+
+			/*! Number of rows that have been built */
+			volatile int rowsCompleted;
+
+			/*! Number of connections in each row */
+			vector<unsigned int> rowSizeVector;
+
+			/*! Index of the to neuron of each connection, in the order of the rows */
+			vector<int> toIndexVector;
+
+			/*! Delay of each connection */
+			vector<float> delayVector;
+
+			/*! Weight of each connection */
+			vector<float> weightVector;
+
+			/*! Stream that is split with the index of each from neuron to give the random numbers of its row */
+			RandomStream seedStream;
+
+			/*! Random numbers of the row being built */
+			RandomStream rowStream;
+
+			/*! Seed of the stream that the rows are split from */
+			static const unsigned int RANDOM_SEED = 12345678;
+
+			//=========================  METHODS  =========================
+			void addConnection(int toIndex, const Point3D& fromLocation, const Point3D& toLocation);
+			bool makeGaussianConnection(const Box& projectionBox, const Point3D& neuronLocation);
+			bool makeGaussianConnection(float radius, float distance);
+			void seedRow(int fromIndex);
+	};
+
+}
+
+#endif//TOPOGRAPHIC1ROWTHREAD_H
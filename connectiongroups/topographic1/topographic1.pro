@@ -34,8 +34,12 @@ win32 {
 #---                 FILES                  ---#
 #----------------------------------------------#
 HEADERS = src/gui/Topographic1Widget.h \
-			src/model/Topographic1BuilderThread.h
+			src/model/NeuronGrid.h \
+			src/model/Topographic1BuilderThread.h \
+			src/model/Topographic1RowThread.h
 
 SOURCES = src/gui/Topographic1Widget.cpp \
-			src/model/Topographic1BuilderThread.cpp
+			src/model/NeuronGrid.cpp \
+			src/model/Topographic1BuilderThread.cpp \
+			src/model/Topographic1RowThread.cpp
 
@@ -39,6 +39,7 @@ ENGINE=InnoDB;
 
 INSERT INTO AnalysisTypes (AnalysisTypeID, Description) VALUES (1, "State-based Phi Analysis");
 INSERT INTO AnalysisTypes (AnalysisTypeID, Description) VALUES (2, "Liveliness Analysis");
+INSERT INTO AnalysisTypes (AnalysisTypeID, Description) VALUES (3, "Transfer Entropy Analysis");
 
 
 /* PhiAnalysisData
@@ -88,6 +89,24 @@ CREATE TABLE NeuronLiveliness (
 ENGINE=InnoDB;
 
 
+/* Transfer entropy from one neuron to another.
+	TimeStep is the first time step of the window within which the transfer entropy was calculated. */
+CREATE TABLE TransferEntropy (
+	AnalysisID SMALLINT UNSIGNED NOT NULL,
+	FromNeuronID MEDIUMINT UNSIGNED NOT NULL,
+	ToNeuronID MEDIUMINT UNSIGNED NOT NULL,
+	TimeStep INT UNSIGNED NOT NULL, /* The first time step of the window. */
+	TransferEntropy DOUBLE NOT NULL,
+
+	PRIMARY KEY (AnalysisID, FromNeuronID, ToNeuronID, TimeStep),
+	INDEX AnalysisIDTimeStepIndex(AnalysisID, TimeStep),
+	FOREIGN KEY AnalysisID_FK(AnalysisID) REFERENCES Analyses(AnalysisID) ON DELETE CASCADE,
+	FOREIGN KEY FromNeuronID_FK(FromNeuronID) REFERENCES SpikeStreamNetwork.Neurons(NeuronID) ON DELETE CASCADE,
+	FOREIGN KEY ToNeuronID_FK(ToNeuronID) REFERENCES SpikeStreamNetwork.Neurons(NeuronID) ON DELETE CASCADE
+)
+ENGINE=InnoDB;
+
+
 /* Disable foreign key checks whilst creating tables etc. */
 SET foreign_key_checks = 1;
 
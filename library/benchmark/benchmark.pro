@@ -0,0 +1,42 @@
+SPIKESTREAM_ROOT_DIR = ../..
+
+include( $${SPIKESTREAM_ROOT_DIR}/spikestream.pri )
+
+TARGET = benchmarkspikestreamlibrary
+
+DESTDIR = $${SPIKESTREAM_ROOT_DIR}/bin
+
+QT += sql xml
+
+CONFIG += qtestlib console
+
+
+#----------------------------------------------#
+#---              INCLUDE PATH              ---#
+#----------------------------------------------#
+INCLUDEPATH += src ../include
+
+
+#----------------------------------------------#
+#---               LIBRARIES                ---#
+#----------------------------------------------#
+unix {
+	LIBS += -lspikestream -L$${SPIKESTREAM_ROOT_DIR}/lib
+}
+win32 {
+	LIBS += -L$${SPIKESTREAM_ROOT_DIR}/lib -lspikestream0
+}
+
+
+#----------------------------------------------#
+#---           Benchmark Files              ---#
+#----------------------------------------------#
+HEADERS += src/Benchmark.h \
+			src/BenchmarkRunner.h \
+			src/NeuronGroupBenchmark.h \
+			src/WeightlessNeuronBenchmark.h
+
+SOURCES += src/Main.cpp \
+			src/BenchmarkRunner.cpp \
+			src/NeuronGroupBenchmark.cpp \
+			src/WeightlessNeuronBenchmark.cpp
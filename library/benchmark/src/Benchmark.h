@@ -0,0 +1,24 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+//Qt includes
+#include <QObject>
+#include <QTest>
+
+/*! Base class of the benchmarks. Each benchmark builds its data in initTestCase(), checks in a test
+	that the old and new code give the same results and then times each version with measure(). */
+class Benchmark : public QObject {
+	protected:
+		/*! Times the method inside QBENCHMARK. The method returns a sum of the values that it reads,
+			which is checked afterwards so that the compiler cannot discard the work being timed. */
+		template<class T> void measure(double (T::*method)()){
+			T* benchmark = static_cast<T*>(this);
+			double sum = 0.0;
+			QBENCHMARK {
+				sum += (benchmark->*method)();
+			}
+			QVERIFY(sum >= 0.0);
+		}
+};
+
+#endif//BENCHMARK_H
@@ -0,0 +1,20 @@
+//SpikeStream includes
+#include "BenchmarkRunner.h"
+#include "NeuronGroupBenchmark.h"
+#include "WeightlessNeuronBenchmark.h"
+
+//Qt includes
+#include <QCoreApplication>
+
+
+/*! Runs all of the benchmarks. The command line arguments are passed on to QTest,
+	so options such as -tickcounter or -iterations can be used to control the measurements. */
+void BenchmarkRunner::runBenchmarks(int argc, char** argv){
+	QCoreApplication coreApplication(argc, argv);
+
+	WeightlessNeuronBenchmark weightlessNeuronBenchmark;
+	QTest::qExec(&weightlessNeuronBenchmark, argc, argv);
+
+	NeuronGroupBenchmark neuronGroupBenchmark;
+	QTest::qExec(&neuronGroupBenchmark, argc, argv);
+}
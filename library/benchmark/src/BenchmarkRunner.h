@@ -0,0 +1,9 @@
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+class BenchmarkRunner {
+	public:
+		static void runBenchmarks(int argc, char** argv);
+};
+
+#endif//BENCHMARKRUNNER_H
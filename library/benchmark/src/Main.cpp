@@ -0,0 +1,8 @@
+//Benchmark includes
+#include "BenchmarkRunner.h"
+
+int main(int argc, char** argv){
+	//Call the runner to invoke benchmarks
+	BenchmarkRunner::runBenchmarks(argc, argv);
+	return 0;
+}
@@ -0,0 +1,114 @@
+#include "NeuronGroupBenchmark.h"
+#include "SpikeStreamException.h"
+using namespace spikestream;
+
+//Number of neurons along each side of the cube of benchmarked neurons
+#define GROUP_WIDTH 100
+
+
+/*----------------------------------------------------------*/
+/*-----                     TESTS                      -----*/
+/*----------------------------------------------------------*/
+
+/*! Builds a cube of neurons in both formats */
+void NeuronGroupBenchmark::initTestCase(){
+	//Add the neurons to the map as NeuronGroup used to
+	unsigned int neurID = 1;
+	for(int x=0; x<GROUP_WIDTH; ++x){
+		for(int y=0; y<GROUP_WIDTH; ++y){
+			for(int z=0; z<GROUP_WIDTH; ++z){
+				neuronMap[neurID] = new Neuron(neurID, x, y, z);
+				++neurID;
+			}
+		}
+	}
+
+	//Add the same neurons to the neuron group
+	NeuronType neurType(2, "neur type description", "neur type paramTableName", "");
+	neuronGroup = new NeuronGroup( NeuronGroupInfo(0, "no name", "no description", QHash<QString, double>(), neurType) );
+	neurID = 1;
+	for(int x=0; x<GROUP_WIDTH; ++x){
+		for(int y=0; y<GROUP_WIDTH; ++y){
+			for(int z=0; z<GROUP_WIDTH; ++z){
+				neuronGroup->addNeuron(neurID, x, y, z);
+				++neurID;
+			}
+		}
+	}
+}
+
+
+/*! Deletes the neurons */
+void NeuronGroupBenchmark::cleanupTestCase(){
+	for(QHash<unsigned int, Neuron*>::iterator iter = neuronMap.begin(); iter != neuronMap.end(); ++iter)
+		delete iter.value();
+	neuronMap.clear();
+	delete neuronGroup;
+}
+
+
+/*! Checks that all three scans visit the same neurons */
+void NeuronGroupBenchmark::testScansMatch(){
+	try{
+		QCOMPARE(neuronGroup->size(), neuronMap.size());
+		double mapSum = scanNeuronMap();
+		QCOMPARE(scanNeuronIterator(), mapSum);
+		QCOMPARE(scanIndexes(), mapSum);
+	}
+	catch(SpikeStreamException& ex){
+		QFAIL(ex.getMessage().toAscii());
+	}
+}
+
+
+/*! Measures the time taken to scan the map of neurons */
+void NeuronGroupBenchmark::benchmarkNeuronMapScan(){
+	measure(&NeuronGroupBenchmark::scanNeuronMap);
+}
+
+
+/*! Measures the time taken to scan the neuron group with its iterator */
+void NeuronGroupBenchmark::benchmarkNeuronIteratorScan(){
+	measure(&NeuronGroupBenchmark::scanNeuronIterator);
+}
+
+
+/*! Measures the time taken to scan the neuron group by index */
+void NeuronGroupBenchmark::benchmarkIndexScan(){
+	measure(&NeuronGroupBenchmark::scanIndexes);
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                PRIVATE METHODS                 -----*/
+/*----------------------------------------------------------*/
+
+/*! Returns the sum of the IDs and positions of the neurons, read from the neuron group by index.
+	The positions are whole numbers, so the sum does not depend on the order of the neurons. */
+double NeuronGroupBenchmark::scanIndexes(){
+	double sum = 0.0;
+	int numNeurons = neuronGroup->size();
+	for(int i=0; i<numNeurons; ++i)
+		sum += (double)neuronGroup->getNeuronID(i) + neuronGroup->getNeuronXPos(i) + neuronGroup->getNeuronYPos(i) + neuronGroup->getNeuronZPos(i);
+	return sum;
+}
+
+
+/*! Returns the sum of the IDs and positions of the neurons, read with the neuron group's iterator */
+double NeuronGroupBenchmark::scanNeuronIterator(){
+	double sum = 0.0;
+	NeuronIterator neurGrpEnd = neuronGroup->end();
+	for(NeuronIterator iter = neuronGroup->begin(); iter != neurGrpEnd; ++iter)
+		sum += (double)iter.key() + iter.value()->getXPos() + iter.value()->getYPos() + iter.value()->getZPos();
+	return sum;
+}
+
+
+/*! Returns the sum of the IDs and positions of the neurons in the map */
+double NeuronGroupBenchmark::scanNeuronMap(){
+	double sum = 0.0;
+	QHash<unsigned int, Neuron*>::iterator neurMapEnd = neuronMap.end();
+	for(QHash<unsigned int, Neuron*>::iterator iter = neuronMap.begin(); iter != neurMapEnd; ++iter)
+		sum += (double)iter.key() + iter.value()->getXPos() + iter.value()->getYPos() + iter.value()->getZPos();
+	return sum;
+}
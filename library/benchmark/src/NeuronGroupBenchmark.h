@@ -0,0 +1,40 @@
+#ifndef NEURONGROUPBENCHMARK_H
+#define NEURONGROUPBENCHMARK_H
+
+//SpikeStream includes
+#include "Benchmark.h"
+#include "Neuron.h"
+#include "NeuronGroup.h"
+using namespace spikestream;
+
+//Qt includes
+#include <QHash>
+
+/*! Compares the time taken to scan a neuron group stored as a map of individually allocated neurons,
+	which is how NeuronGroup used to store neurons, with the time taken to scan the arrays in NeuronGroup. */
+class NeuronGroupBenchmark : public Benchmark {
+	Q_OBJECT
+
+	private slots:
+		void initTestCase();
+		void cleanupTestCase();
+		void testScansMatch();
+		void benchmarkNeuronMapScan();
+		void benchmarkNeuronIteratorScan();
+		void benchmarkIndexScan();
+
+	private:
+		//======================  VARIABLES  ======================
+		/*! Neurons stored in the old format */
+		QHash<unsigned int, Neuron*> neuronMap;
+
+		/*! The same neurons stored in a neuron group */
+		NeuronGroup* neuronGroup;
+
+		//=======================  METHODS  =======================
+		double scanIndexes();
+		double scanNeuronIterator();
+		double scanNeuronMap();
+};
+
+#endif//NEURONGROUPBENCHMARK_H
@@ -0,0 +1,167 @@
+#include "WeightlessNeuronBenchmark.h"
+#include "SpikeStreamException.h"
+#include "Util.h"
+using namespace spikestream;
+
+//Number of connections to the benchmarked neuron
+#define NUMBER_OF_CONNECTIONS 256
+
+//Number of training patterns stored in the neuron
+#define NUMBER_OF_TRAINING_PATTERNS 1000
+
+//Number of patterns that are matched against the training data in each benchmark
+#define NUMBER_OF_QUERIES 1000
+
+/*! Number of bits set in each byte, used by the old matching code */
+static unsigned char bitCountLookup[256];
+
+
+/*----------------------------------------------------------*/
+/*-----                     TESTS                      -----*/
+/*----------------------------------------------------------*/
+
+/*! Builds a neuron with random training data and a set of query patterns that lie close to the training data */
+void WeightlessNeuronBenchmark::initTestCase(){
+	for(int i=0; i<256; ++i){
+		bitCountLookup[i] = 0;
+		for(int j=0; j<8; ++j){
+			if(i & 1<<j)
+				++bitCountLookup[i];
+		}
+	}
+
+	QHash<unsigned int, QList<unsigned int> > connMap;
+	for(int i=0; i<NUMBER_OF_CONNECTIONS; ++i)
+		connMap[i+10].append(i);
+	neuron = new WeightlessNeuron(connMap, 0);
+	neuron->setGeneralization(0.9);
+	patternLength = neuron->getTrainingDataLength() - 1;
+
+	//Add random training data in both formats
+	Util::seedRandom(42);
+	for(int i=0; i<NUMBER_OF_TRAINING_PATTERNS; ++i){
+		unsigned char* byteArr = new unsigned char[patternLength + 1];
+		byteArr[0] = Util::getRandom(0, 2);
+		for(int j=1; j<=patternLength; ++j)
+			byteArr[j] = Util::getRandom(0, 256);
+		QByteArray qByteArr = QByteArray::fromRawData((const char*)&byteArr[1], patternLength);
+		neuron->addTraining(qByteArr, byteArr[0]);
+		byteTrainingData.append(byteArr);
+	}
+
+	//Query patterns are training patterns with a few bits flipped so that some of them match
+	for(int i=0; i<NUMBER_OF_QUERIES; ++i){
+		unsigned char* queryArr = new unsigned char[patternLength];
+		unsigned char* trainingArr = byteTrainingData[Util::getRandom(0, NUMBER_OF_TRAINING_PATTERNS)];
+		for(int j=0; j<patternLength; ++j)
+			queryArr[j] = trainingArr[j+1];
+		int numFlips = Util::getRandom(0, NUMBER_OF_CONNECTIONS / 5);
+		for(int j=0; j<numFlips; ++j){
+			int bitIndx = Util::getRandom(0, NUMBER_OF_CONNECTIONS);
+			queryArr[bitIndx/8] ^= 1<<(bitIndx%8);
+		}
+		queryPatterns.append(queryArr);
+	}
+}
+
+
+/*! Deletes the neuron and patterns */
+void WeightlessNeuronBenchmark::cleanupTestCase(){
+	delete neuron;
+	foreach(unsigned char* byteArr, byteTrainingData)
+		delete [] byteArr;
+	byteTrainingData.clear();
+	foreach(unsigned char* byteArr, queryPatterns)
+		delete [] byteArr;
+	queryPatterns.clear();
+}
+
+
+/*! Checks that the word based matching gives the same results as the byte lookup */
+void WeightlessNeuronBenchmark::testMatchesByteLookup(){
+	try{
+		foreach(unsigned char* queryArr, queryPatterns){
+			QCOMPARE(neuron->getFiringStateProbability(queryArr, patternLength, 1), getByteLookupProbability(queryArr, 1));
+			QCOMPARE(neuron->getFiringStateProbability(queryArr, patternLength, 0), getByteLookupProbability(queryArr, 0));
+		}
+	}
+	catch(SpikeStreamException& ex){
+		QFAIL(ex.getMessage().toAscii());
+	}
+}
+
+
+/*! Measures the time taken to match the query patterns using byte lookup */
+void WeightlessNeuronBenchmark::benchmarkByteLookup(){
+	measure(&WeightlessNeuronBenchmark::matchByteLookup);
+}
+
+
+/*! Measures the time taken to match the query patterns using the weightless neuron */
+void WeightlessNeuronBenchmark::benchmarkWordMatching(){
+	measure(&WeightlessNeuronBenchmark::matchWords);
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                PRIVATE METHODS                 -----*/
+/*----------------------------------------------------------*/
+
+/*! The byte by byte matching that WeightlessNeuron::getFiringStateProbability used to carry out */
+double WeightlessNeuronBenchmark::getByteLookupProbability(unsigned char inPatArr[], int firingState){
+	unsigned int hammingThreshold = neuron->getHammingThreshold();
+	bool firstTime = true;
+	unsigned int minDist = hammingThreshold + 1;
+	QHash<int, unsigned char> minDistIndxMap;
+	for(int listIndx=0; listIndx<byteTrainingData.size(); ++listIndx){
+		unsigned char* trainingPattern = byteTrainingData[listIndx];
+		unsigned int hamDist = 0;
+		for(int i=0; i<patternLength; ++i){
+			hamDist += bitCountLookup[inPatArr[i] ^ trainingPattern[i + 1]];
+			if(hamDist > hammingThreshold)
+				break;
+		}
+		if(firstTime || hamDist < minDist){
+			minDist = hamDist;
+			minDistIndxMap.clear();
+			minDistIndxMap[listIndx] = trainingPattern[0];
+			firstTime = false;
+		}
+		else if(hamDist == minDist){
+			minDistIndxMap[listIndx] = trainingPattern[0];
+		}
+	}
+	if(minDist > hammingThreshold)
+		return 0.5;
+
+	bool zeroFound = false, oneFound = false;
+	for(QHash<int, unsigned char>::iterator iter = minDistIndxMap.begin(); iter != minDistIndxMap.end(); ++iter){
+		if(iter.value() == 0)
+			zeroFound = true;
+		else
+			oneFound = true;
+		if(oneFound && zeroFound)
+			return 0.5;
+	}
+	if(minDistIndxMap.begin().value() == firingState)
+		return 1.0;
+	return 0.0;
+}
+
+
+/*! Returns the sum of the probabilities of firing for the query patterns, worked out using byte lookup */
+double WeightlessNeuronBenchmark::matchByteLookup(){
+	double probSum = 0.0;
+	foreach(unsigned char* queryArr, queryPatterns)
+		probSum += getByteLookupProbability(queryArr, 1);
+	return probSum;
+}
+
+
+/*! Returns the sum of the probabilities of firing for the query patterns, worked out by the weightless neuron */
+double WeightlessNeuronBenchmark::matchWords(){
+	double probSum = 0.0;
+	foreach(unsigned char* queryArr, queryPatterns)
+		probSum += neuron->getFiringStateProbability(queryArr, patternLength, 1);
+	return probSum;
+}
@@ -0,0 +1,44 @@
+#ifndef WEIGHTLESSNEURONBENCHMARK_H
+#define WEIGHTLESSNEURONBENCHMARK_H
+
+//SpikeStream includes
+#include "Benchmark.h"
+#include "WeightlessNeuron.h"
+using namespace spikestream;
+
+//Qt includes
+#include <QList>
+
+/*! Compares the throughput of the byte lookup pattern matching that weightless neurons
+	used to carry out with the word based matching in WeightlessNeuron. */
+class WeightlessNeuronBenchmark : public Benchmark {
+	Q_OBJECT
+
+	private slots:
+		void initTestCase();
+		void cleanupTestCase();
+		void testMatchesByteLookup();
+		void benchmarkByteLookup();
+		void benchmarkWordMatching();
+
+	private:
+		//======================  VARIABLES  ======================
+		/*! Neuron being benchmarked */
+		WeightlessNeuron* neuron;
+
+		/*! Training data in the old format, with the output in the first byte */
+		QList<unsigned char*> byteTrainingData;
+
+		/*! Patterns used to query the neuron */
+		QList<unsigned char*> queryPatterns;
+
+		/*! Length of the query patterns in bytes */
+		int patternLength;
+
+		//=======================  METHODS  =======================
+		double getByteLookupProbability(unsigned char inPatArr[], int firingState);
+		double matchByteLookup();
+		double matchWords();
+};
+
+#endif//WEIGHTLESSNEURONBENCHMARK_H
@@ -23,13 +23,17 @@ namespace spikestream {
 		protected:
 			void checkDatabase();
 			void closeDatabaseConnection();
+			void commitTransaction();
 			void connectToDatabase();
 			bool isConnected();
+			void executeBatchInsert(const QString& insertStr, int numberOfColumns, const QList<QVariant>& valueList, const QString& suffixStr = "");
 			void executeQuery(QSqlQuery& query);
 			void executeQuery(const QString& queryStr);
 			QSqlQuery getQuery();
 			QSqlQuery getQuery(const QString& queryStr);
+			void rollbackTransaction();
 			void setDBInfo(const DBInfo& dbInfo) { this->dbInfo = dbInfo; }
+			void startTransaction();
 
 		private:
 			//=========================  VARIABLES  ============================
@@ -46,6 +50,9 @@ namespace spikestream {
 			/*! Static counter that is used to assign a unique id to each QSql database */
 			static unsigned int dbCounter;
 
+			/*! Maximum number of rows added by a single statement in executeBatchInsert */
+			static const int maxBatchInsertRows = 250;
+
 
 			//=========================  METHODS  ===============================
 			static QString getUniqueDBName();
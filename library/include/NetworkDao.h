@@ -12,6 +12,7 @@
 #include "NeuronType.h"
 #include "ParameterInfo.h"
 #include "SynapseType.h"
+#include "WeightlessNetworkSnapshot.h"
 #include "WeightlessNeuron.h"
 using namespace spikestream;
 
@@ -65,6 +66,7 @@ namespace spikestream{
 			SynapseType getSynapseType(const QString& synapseTypeDescription);//UNTESTED
 			QList<SynapseType> getSynapseTypes();
 			WeightlessNeuron* getWeightlessNeuron(unsigned int neuronID);
+			WeightlessNetworkSnapshot* getWeightlessNetworkSnapshot(unsigned int networkID);
 			bool isWeightlessNetwork(unsigned int networkID);
 			bool isWeightlessNeuron(unsigned int neuronID);
 			void setConnectionGroupProperties(unsigned connectionGroupID, const QString& description);
@@ -9,28 +9,60 @@ using namespace spikestream;
 
 //Qt includes
 #include <stdint.h>
-#include <QMap>
+#include <QHash>
+#include <QList>
 
-/*! Structure holding pointers to neurons. */
-typedef QHash<unsigned int, Neuron*> NeuronMap;
+namespace spikestream {
 
-/*! Iterator over positions in the group */
-typedef QMap<uint64_t, Neuron*>::iterator NeuronPositionIterator;
+	class NeuronGroup;
 
-/*! An iterator for working through all of the neurons in the group. */
-typedef NeuronMap::iterator NeuronIterator;
+	/*! Iterator for working through the neurons in a group, either in the order in which they were
+		added or ordered by position. key() returns the ID of the current neuron and value() returns
+		a neuron holding its ID and location. The neuron belongs to the iterator, so it is only valid
+		until the iterator is moved and changes to it are not stored in the group. */
+	class NeuronIterator {
+		public:
+			NeuronIterator(NeuronGroup* neuronGroup, int position, const int* orderArray = 0);
+			int getIndex() const;
+			unsigned int key() const;
+			Neuron* value();
+			NeuronIterator& operator++() { ++position; return *this; }
+			bool operator==(const NeuronIterator& rhs) const { return position == rhs.position; }
+			bool operator!=(const NeuronIterator& rhs) const { return position != rhs.position; }
+
+		private:
+			//========================  VARIABLES  =======================
+			/*! Group whose neurons are being iterated over */
+			NeuronGroup* neuronGroup;
+
+			/*! Position of the iterator in the group */
+			int position;
+
+			/*! Indexes of the neurons in the order of iteration. Neurons are visited
+				in the order of their indexes when this is NULL */
+			const int* orderArray;
+
+			/*! Neuron returned by value() */
+			Neuron neuron;
+	};
+
+	/*! Iterator over positions in the group */
+	typedef NeuronIterator NeuronPositionIterator;
 
-namespace spikestream {
 
-	/*! A group of neurons. */
+	/*! A group of neurons.
+		The IDs and positions of the neurons are stored in arrays, with one entry per neuron. Neurons
+		usually have continuous IDs, in which case the IDs are not stored and the neuron at index i has ID
+		startNeuronID + i. The IDs are stored in an array and a map from ID to index when they have gaps. */
     class NeuronGroup {
 		public:
 			NeuronGroup(const NeuronGroupInfo& info);
 			~NeuronGroup();
 			void addLayer(int width, int height, int xPos, int yPos, int zPos);
-			Neuron* addNeuron(float xPos, float yPos, float zPos);
-			NeuronMap::iterator begin() { return neuronMap->begin(); }
-			NeuronMap::iterator end() { return neuronMap->end(); }
+			int addNeuron(float xPos, float yPos, float zPos);
+			int addNeuron(unsigned int neuronID, float xPos, float yPos, float zPos);
+			NeuronIterator begin() { return NeuronIterator(this, 0); }
+			NeuronIterator end() { return NeuronIterator(this, numberOfNeurons); }
 			NeuronPositionIterator positionBegin();
 			NeuronPositionIterator positionEnd();
 			void buildPositionMap();
@@ -40,12 +72,16 @@ namespace spikestream {
 			Box getBoundingBox();
 			unsigned int getID();
 			NeuronGroupInfo getInfo() {return info;}
-			Neuron* getNearestNeuron(const Point3D& point);
+			unsigned int getNearestNeuronID(const Point3D& point);
+			unsigned int getNeuronID(int index) const { return neuronIDArray == NULL ? startNeuronID + index : neuronIDArray[index]; }
 			unsigned int getNeuronIDAtLocation(const Point3D& location);
-			QList<unsigned int> getNeuronIDs() { return neuronMap->keys(); }
-			Point3D& getNeuronLocation(unsigned int neuronID);
-			NeuronMap* getNeuronMap() { return neuronMap; }
-			QList<Neuron*> getNeurons(const Box& box);
+			QList<unsigned int> getNeuronIDs();
+			int getNeuronIndex(unsigned int neuronID);
+			Point3D getNeuronLocation(unsigned int neuronID);
+			float getNeuronXPos(int index) const { return xPosArray[index]; }
+			float getNeuronYPos(int index) const { return yPosArray[index]; }
+			float getNeuronZPos(int index) const { return zPosArray[index]; }
+			QList<Neuron> getNeurons(const Box& box);
 			unsigned getNeuronTypeID();
 			double getParameter(const QString& key);
 			QHash<QString, double> getParameters() { return parameterMap; }
@@ -55,12 +91,12 @@ namespace spikestream {
 			bool isWeightless();
 			bool parametersSet();
 			void print();
+			void reserve(int capacity);
 			void setID(unsigned int id);
 			void setDescription(const QString& description);
 			void setName(const QString& name);
-			void setNeuronMap(NeuronMap* newMap);
+			void setNeuronIDs(const QList<unsigned int>& neuronIDList);
 			void setParameters(QHash<QString, double>& paramMap);
-			void setStartNeuronID(unsigned int id) { this->startNeuronID = id; }
 			int size();
 
 
@@ -70,15 +106,30 @@ namespace spikestream {
 				table in SpikeStreamNetwork database */
 			NeuronGroupInfo info;
 
-			/*! Map linking neuron Ids to Neuron classes.
-				This map can be used to get a list of all the neuron ids in the
-				group and also to get the position of an individual neuron. */
-			NeuronMap* neuronMap;
+			/*! Number of neurons in the group */
+			int numberOfNeurons;
 
-			/*! Map linking a 64 bit number describing neuron position
-				with pointer to neuron class. This map enables iteration through
-				neuron group in a geometrically ordered way. */
-			QMap<uint64_t, Neuron*> neuronPositionMap;
+			/*! Number of neurons that the arrays can hold before they have to be enlarged */
+			int neuronCapacity;
+
+			/*! ID of each neuron. NULL when the IDs run continuously from startNeuronID */
+			unsigned int* neuronIDArray;
+
+			/*! X position of each neuron */
+			float* xPosArray;
+
+			/*! Y position of each neuron */
+			float* yPosArray;
+
+			/*! Z position of each neuron */
+			float* zPosArray;
+
+			/*! Index of each neuron in the arrays. Only used when the IDs are stored in neuronIDArray */
+			QHash<unsigned int, int> neuronIndexMap;
+
+			/*! Indexes of the neurons sorted by the 64 bit number describing their positions.
+				This enables iteration through the neuron group in a geometrically ordered way. */
+			int* positionIndexArray;
 
 			/*! Flag recording whether position map has been built.
 				Position map takes processor power and memory and is rarely used,
@@ -106,10 +157,39 @@ namespace spikestream {
 			//====================  METHODS  ==========================
 			unsigned getTemporaryID();
 			void neuronGroupChanged();
+			void storeNeuronIDs();
 			NeuronGroup(const NeuronGroup& connGrp);
 			NeuronGroup& operator=(const NeuronGroup& rhs);
     };
 
+
+	/*! Constructor */
+	inline NeuronIterator::NeuronIterator(NeuronGroup* neuronGroup, int position, const int* orderArray) : neuron(0.0f, 0.0f, 0.0f) {
+		this->neuronGroup = neuronGroup;
+		this->position = position;
+		this->orderArray = orderArray;
+	}
+
+	/*! Returns the index of the current neuron in the group */
+	inline int NeuronIterator::getIndex() const {
+		return orderArray == 0 ? position : orderArray[position];
+	}
+
+	/*! Returns the ID of the current neuron */
+	inline unsigned int NeuronIterator::key() const {
+		return neuronGroup->getNeuronID(getIndex());
+	}
+
+	/*! Returns a neuron holding the ID and location of the current neuron */
+	inline Neuron* NeuronIterator::value() {
+		int index = getIndex();
+		neuron.setID(neuronGroup->getNeuronID(index));
+		neuron.getLocation().setXPos(neuronGroup->getNeuronXPos(index));
+		neuron.getLocation().setYPos(neuronGroup->getNeuronYPos(index));
+		neuron.getLocation().setZPos(neuronGroup->getNeuronZPos(index));
+		return &neuron;
+	}
+
 }
 
 #endif//NEURONGROUP_H
@@ -0,0 +1,45 @@
+#ifndef RANDOMSTREAM_H
+#define RANDOMSTREAM_H
+
+//Other includes
+#include <stdint.h>
+
+namespace spikestream {
+
+	/*! Seeded sequence of random numbers that can be split into independent child sequences.
+		Each number is worked out from the key of the stream and the position of the number in the stream,
+		using the mixing function of the SplitMix64 generator, so a stream holds no state that is shared with
+		other streams. Builders split a stream for each neuron group or each from neuron and get the same
+		numbers whichever thread uses the child stream and in whatever order the children are used. */
+	class RandomStream {
+		public:
+			RandomStream(uint64_t seed = 0);
+			uint64_t getNumber(uint64_t index) const;
+			uint64_t getPosition() const { return position; }
+			double nextDouble();
+			double nextNormal();
+			uint64_t nextNumber();
+			unsigned int nextUInt(unsigned int max);
+			RandomStream split(uint64_t streamID) const;
+
+		private:
+			//======================  VARIABLES  ======================
+			/*! Key that is combined with the position of each number in the stream */
+			uint64_t key;
+
+			/*! Position in the stream of the next number */
+			uint64_t position;
+
+			/*! Records whether a second normally distributed random number has been stored */
+			bool normalStored;
+
+			/*! Second of the pair of normally distributed random numbers generated by the Box-Muller method */
+			double storedNormal;
+
+			//======================  METHODS  ======================
+			static uint64_t mix(uint64_t z);
+	};
+
+}
+
+#endif//RANDOMSTREAM_H
@@ -0,0 +1,51 @@
+#ifndef SPIKEFRAME_H
+#define SPIKEFRAME_H
+
+//Qt includes
+#include <QList>
+#include <QMetaType>
+#include <QSharedPointer>
+
+namespace spikestream {
+
+	/*! The neurons that fired at a single time step. The IDs are held in a contiguous array that
+		is filled when the frame is created and never changed afterwards, so one frame can be passed
+		between threads and read by every class that is listening without being copied. */
+	class SpikeFrame {
+		public:
+			SpikeFrame(unsigned int timeStep, const unsigned int* neuronIDArray, int numberOfNeurons);
+			SpikeFrame(unsigned int timeStep, const QList<unsigned int>& neuronIDList);
+			~SpikeFrame();
+			const unsigned int* begin() const { return neuronIDArray; }
+			const unsigned int* end() const { return neuronIDArray + numberOfNeurons; }
+			const unsigned int* getNeuronIDs() const { return neuronIDArray; }
+			unsigned int getTimeStep() const { return timeStep; }
+			bool isEmpty() const { return numberOfNeurons == 0; }
+			int size() const { return numberOfNeurons; }
+			QList<unsigned int> toList() const;
+
+		private:
+			//===================  VARIABLES  ===================
+			/*! Time step at which the neurons fired */
+			unsigned int timeStep;
+
+			/*! IDs of the neurons that fired */
+			unsigned int* neuronIDArray;
+
+			/*! Number of IDs in the array */
+			int numberOfNeurons;
+
+			//====================  METHODS  =====================
+			SpikeFrame(const SpikeFrame&);
+			SpikeFrame& operator=(const SpikeFrame&);
+	};
+
+	/*! Reference counted pointer used to share a frame between threads. The frame is
+		deleted when the last class holding a pointer to it has finished with it. */
+	typedef QSharedPointer<const SpikeFrame> SpikeFramePtr;
+
+}
+
+Q_DECLARE_METATYPE(spikestream::SpikeFramePtr)
+
+#endif//SPIKEFRAME_H
@@ -0,0 +1,63 @@
+#ifndef WEIGHTLESSNETWORKSNAPSHOT_H
+#define WEIGHTLESSNETWORKSNAPSHOT_H
+
+//SpikeStream includes
+#include "WeightlessNeuron.h"
+
+//Qt includes
+#include <QHash>
+#include <QList>
+#include <QSharedPointer>
+
+//Other includes
+#include <stdint.h>
+
+namespace spikestream {
+
+	/*! All of the weightless neurons in a network, loaded once and then shared between the threads
+		analyzing the network. The training data of the neurons is stored in a single contiguous arena
+		owned by this class. Once it has been built and the generalization set, the snapshot is only read,
+		so it can be used by several threads at the same time. */
+	class WeightlessNetworkSnapshot {
+		public:
+			WeightlessNetworkSnapshot(unsigned int networkID);
+			~WeightlessNetworkSnapshot();
+			void addWeightlessNeuron(WeightlessNeuron* neuron);
+			void allocateTrainingArena(const QHash<unsigned int, int>& patternCountMap);
+			void getAllFromConnections(QHash<unsigned int, QHash<unsigned int, bool> >& connMap) const;
+			void getAllToConnections(QHash<unsigned int, QHash<unsigned int, bool> >& connMap) const;
+			unsigned int getNetworkID() const { return networkID; }
+			QList<unsigned int> getNeuronIDs() const;
+			int getNumberOfTrainingPatterns() const { return arenaCapacity; }
+			WeightlessNeuron* getWeightlessNeuron(unsigned int neuronID) const;
+			const QHash<unsigned int, WeightlessNeuron*>& getWeightlessNeuronMap() const { return weightlessNeuronMap; }
+			void setGeneralization(double generalization);
+
+		private:
+			//===================  VARIABLES  ===================
+			/*! ID of the network that the neurons belong to */
+			unsigned int networkID;
+
+			/*! The weightless neurons in the network. The key is the neuron ID */
+			QHash<unsigned int, WeightlessNeuron*> weightlessNeuronMap;
+
+			/*! Training patterns of all of the neurons, stored one neuron after another */
+			uint64_t* trainingArena;
+
+			/*! Outputs of the training patterns of all of the neurons */
+			unsigned char* outputArena;
+
+			/*! Number of training patterns that the arena has space for */
+			int arenaCapacity;
+
+			//====================  METHODS  =====================
+			WeightlessNetworkSnapshot(const WeightlessNetworkSnapshot&);
+			WeightlessNetworkSnapshot& operator=(const WeightlessNetworkSnapshot&);
+	};
+
+	/*! Reference counted pointer used to share a snapshot between threads */
+	typedef QSharedPointer<WeightlessNetworkSnapshot> WeightlessNetworkSnapshotPtr;
+
+}
+
+#endif//WEIGHTLESSNETWORKSNAPSHOT_H
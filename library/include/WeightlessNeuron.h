@@ -4,6 +4,9 @@
 //Qt includes
 #include <QHash>
 
+//Other includes
+#include <stdint.h>
+
 namespace spikestream {
 
 	/*! A weightless neuron */
@@ -15,13 +18,17 @@ namespace spikestream {
 				QHash<unsigned int, QList<unsigned int> >& getConnectionMap() { return connectionMap; }
 				unsigned int getID() { return id; }
 				int getNumberOfConnections() { return numberOfConnections; }
-				double getFiringStateProbability(unsigned char inPatArr[], int inPatArrLen, int firingState);
+				double getFiringStateProbability(unsigned char inPatArr[], int inPatArrLen, int firingState) const;
 				unsigned int getHammingThreshold() { return hammingThreshold; }
-				QList<unsigned char*> getTrainingData() { return trainingData; }
+				int getNumberOfTrainingPatterns() { return numberOfTrainingPatterns; }
 				int getTrainingDataLength() { return trainingDataLength; }
-				double getTransitionProbability(const QList<unsigned int>& neurIDList, const QString& x0Pattern, int firingState);
+				int getTrainingWordLength() { return trainingWordLength; }
+				unsigned char getTrainingOutput(int index);
+				const unsigned char* getTrainingPattern(int index);
+				double getTransitionProbability(const QList<unsigned int>& neurIDList, const QString& x0Pattern, int firingState) const;
 				void resetTraining();
 				void setGeneralization(double generalization);
+				void setTrainingStorage(uint64_t* trainingMatrix, unsigned char* trainingOutputs, int capacity);
 
 			private:
 				//===================  VARIABLES  ===================
@@ -36,20 +43,44 @@ namespace spikestream {
 				/*! Number of connections to this weightless neuron. This has to be calculated from the connection map */
 				int numberOfConnections;
 
-				/*! List of training arrays */
-				QList<unsigned char*> trainingData;
+				/*! Training patterns stored contiguously. Each pattern occupies trainingWordLength
+					64 bit words, with the input bits in the same order as the bytes passed to addTraining
+					and unused bits set to zero. */
+				uint64_t* trainingMatrix;
+
+				/*! Output of each training pattern, 0 or 1. */
+				unsigned char* trainingOutputs;
+
+				/*! Number of training patterns stored in the training matrix */
+				int numberOfTrainingPatterns;
+
+				/*! Number of patterns that the training matrix has space for */
+				int trainingCapacity;
 
-				/*! Length of each array of training data */
+				/*! Records whether the training matrix and outputs were allocated by this neuron and should
+					be deleted by it. Set to false when the training data is stored in memory supplied
+					by another class, such as WeightlessNetworkSnapshot. */
+				bool ownsTrainingStorage;
+
+				/*! Number of 64 bit words occupied by each pattern in the training matrix */
+				int trainingWordLength;
+
+				/*! Length of each array of training data including the output byte.
+					Input patterns are one byte shorter than this. */
 				int trainingDataLength;
 
 				/*! The minimum Hamming distance for a match between two patterns */
 				unsigned int hammingThreshold;
 
+				/*! Function used to calculate the Hamming distance between two patterns.
+					Selected in the constructor according to the pattern length and the features of the processor. */
+				unsigned int (*hammingDistance)(const uint64_t* pattern1, const uint64_t* pattern2, int wordLength, unsigned int maxDist);
+
 				//====================  METHODS  =====================
-				void buildInputPattern(unsigned char inPatArr[], int inPatArrSize, bool selArr[], int selArrSize, QHash<unsigned int, unsigned char>& firingNeuronIndexMap);
+				double getFiringStateProbability(const uint64_t inPatWords[], int firingState) const;
 				void printConnectionMap();
-				void printSelectionArray(bool selArr[], int arrSize);
 				void printTraining();
+				double sampleTransitionProbability(const uint64_t knownValues[], const int unknownIndexes[], int numberOfUnknownIndexes, int firingState) const;
 			};
 
 }
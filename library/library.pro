@@ -43,6 +43,7 @@ HEADERS = include/GlobalVariables.h \
 			include/PerformanceTimer.h \
 			include/RGBColor.h \
 			include/Box.h \
+			include/RandomStream.h \
 			include/Util.h \
 			include/SpikeStreamThread.h \
 			include/SpikeStreamTypes.h
@@ -50,6 +51,7 @@ HEADERS = include/GlobalVariables.h \
 SOURCES = src/PerformanceTimer.cpp \
 			src/Box.cpp \
 			src/RGBColor.cpp \
+			src/RandomStream.cpp \
 			src/Util.cpp \
 			src/SpikeStreamThread.cpp
 
@@ -103,11 +105,13 @@ HEADERS += include/Network.h \
 			include/ArchiveInfo.h \
 			include/AnalysisInfo.h \
 			include/WeightlessNeuron.h \
+			include/WeightlessNetworkSnapshot.h \
 			include/Neuron.h \
 			include/NeuronType.h \
 			include/Point3D.h \
 			include/SynapseType.h \
-			include/ParameterInfo.h
+			include/ParameterInfo.h \
+			include/SpikeFrame.h
 SOURCES += src/model/Network.cpp \
 			src/model/NetworkInfo.cpp \
 			src/model/NeuronGroup.cpp \
@@ -119,11 +123,13 @@ SOURCES += src/model/Network.cpp \
 			src/model/Connection.cpp \
 			src/model/AnalysisInfo.cpp \
 			src/model/WeightlessNeuron.cpp \
+			src/model/WeightlessNetworkSnapshot.cpp \
 			src/model/Neuron.cpp \
 			src/model/NeuronType.cpp \
 			src/model/Point3D.cpp \
 			src/model/SynapseType.cpp \
-			src/model/ParameterInfo.cpp
+			src/model/ParameterInfo.cpp \
+			src/model/SpikeFrame.cpp
 
 #----------------------------------------------#
 #---                  xml                   ---#
@@ -0,0 +1,95 @@
+//SpikeStream includes
+#include "RandomStream.h"
+#include "SpikeStreamException.h"
+using namespace spikestream;
+
+//Other includes
+#include <cmath>
+
+/*! Increment between the counters of successive numbers in a stream */
+#define GOLDEN_GAMMA 0x9E3779B97F4A7C15ULL
+
+
+/*! Constructor. Streams with the same seed produce the same numbers. */
+RandomStream::RandomStream(uint64_t seed){
+	key = mix(seed + GOLDEN_GAMMA);
+	position = 0;
+	normalStored = false;
+	storedNormal = 0.0;
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                 PUBLIC METHODS                 -----*/
+/*----------------------------------------------------------*/
+
+/*! Returns the number at the specified position in the stream without moving through the stream. */
+uint64_t RandomStream::getNumber(uint64_t index) const{
+	return mix(key + (index + 1) * GOLDEN_GAMMA);
+}
+
+
+/*! Returns a random double that is greater than or equal to 0 and less than 1 */
+double RandomStream::nextDouble(){
+	return (nextNumber() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+/*! Returns a normally distributed random number with standard deviation = 1
+	Uses Box-Muller method to generate values
+	Code adapted from http://www.csit.fsu.edu/~burkardt/cpp_src/random_data/random_data.html. */
+double RandomStream::nextNormal(){
+	//Return the second, saved, value if there is one
+	if(normalStored){
+		normalStored = false;
+		return storedNormal;
+	}
+
+	//Generate two more values, return one and save one.
+	double PI = 3.141592653589793;
+	double rand1, rand2;
+	for ( ; ; ){
+		rand1 = nextDouble();
+		if ( rand1 != 0.0 )
+			break;
+	}
+	rand2 = nextDouble();
+	storedNormal = sqrt ( -2.0 * log ( rand1 ) ) * sin ( 2.0 * PI * rand2 );
+	normalStored = true;
+	return sqrt ( -2.0 * log ( rand1 ) ) * cos ( 2.0 * PI * rand2 );
+}
+
+
+/*! Returns the next number in the stream */
+uint64_t RandomStream::nextNumber(){
+	return getNumber(position++);
+}
+
+
+/*! Returns a random integer that is greater than or equal to 0 and less than max */
+unsigned int RandomStream::nextUInt(unsigned int max){
+	if(max == 0)
+		throw SpikeStreamException("Incorrect range for random number: maximum is zero.");
+	return (unsigned int)(((nextNumber() >> 32) * max) >> 32);
+}
+
+
+/*! Returns a new stream whose numbers are independent of this stream and of the other streams
+	split from it with different IDs. The position of this stream has no effect on the new stream. */
+RandomStream RandomStream::split(uint64_t streamID) const{
+	RandomStream childStream;
+	childStream.key = mix(key ^ mix(streamID + GOLDEN_GAMMA));
+	return childStream;
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                PRIVATE METHODS                 -----*/
+/*----------------------------------------------------------*/
+
+/*! Mixing function of the SplitMix64 generator, which scrambles the bits of the counter */
+uint64_t RandomStream::mix(uint64_t z){
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
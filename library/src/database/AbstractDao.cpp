@@ -90,6 +90,15 @@ void AbstractDao::closeDatabaseConnection(){
 }
 
 
+/*! Commits the transaction started with startTransaction() */
+void AbstractDao::commitTransaction(){
+	checkDatabase();
+	QSqlDatabase database = QSqlDatabase::database(dbName);
+	if(!database.commit())
+		throw SpikeStreamDBException("Error committing transaction: " + database.lastError().text());
+}
+
+
 /*! Connects to the database */
 void AbstractDao::connectToDatabase(){
 	//Record the thread that this database was created in - this class cannot be used across multiple threads
@@ -116,6 +125,44 @@ void AbstractDao::connectToDatabase(){
 }
 
 
+/*! Adds rows to a table using prepared statements that insert many rows at once.
+	insertStr is the start of the statement up to and including VALUES, for example
+	"INSERT INTO Table (A, B) VALUES", and suffixStr is appended after the rows.
+	The values of each row are stored one after the other in valueList. */
+void AbstractDao::executeBatchInsert(const QString& insertStr, int numberOfColumns, const QList<QVariant>& valueList, const QString& suffixStr){
+	if(numberOfColumns < 1 || valueList.size() % numberOfColumns != 0)
+		throw SpikeStreamDBException("Number of values in batch insert (" + QString::number(valueList.size()) + ") is not a multiple of the number of columns (" + QString::number(numberOfColumns) + ").");
+
+	//Placeholders for a single row
+	QString rowStr = "(";
+	for(int i=0; i<numberOfColumns-1; ++i)
+		rowStr += "?, ";
+	rowStr += "?)";
+
+	//Work through the rows, preparing the query again only when the number of rows changes
+	int numberOfRows = valueList.size() / numberOfColumns;
+	int preparedRows = 0;
+	QSqlQuery query = getQuery();
+	for(int firstRow = 0; firstRow < numberOfRows; firstRow += maxBatchInsertRows){
+		int batchRows = qMin(maxBatchInsertRows, numberOfRows - firstRow);
+		if(batchRows != preparedRows){
+			QString queryStr = insertStr + " ";
+			for(int i=0; i<batchRows-1; ++i)
+				queryStr += rowStr + ",";
+			queryStr += rowStr + " " + suffixStr;
+			query.prepare(queryStr);
+			preparedRows = batchRows;
+		}
+
+		//Bind values to query and execute it
+		int valueOffset = firstRow * numberOfColumns;
+		for(int i=0; i<batchRows * numberOfColumns; ++i)
+			query.bindValue(i, valueList.at(valueOffset + i));
+		executeQuery(query);
+	}
+}
+
+
 /*! Executes the query */
 void AbstractDao::executeQuery(QSqlQuery& query){
     bool result = query.exec();
@@ -153,6 +200,23 @@ QSqlQuery AbstractDao::getQuery(const QString& queryStr){
 }
 
 
+/*! Rolls back the transaction started with startTransaction().
+	Does not throw exceptions so that it can be used when handling another error. */
+void AbstractDao::rollbackTransaction(){
+	if(isConnected() && QThread::currentThread() == dbThread)
+		QSqlDatabase::database(dbName).rollback();
+}
+
+
+/*! Starts a transaction on this class's database connection */
+void AbstractDao::startTransaction(){
+	checkDatabase();
+	QSqlDatabase database = QSqlDatabase::database(dbName);
+	if(!database.transaction())
+		throw SpikeStreamDBException("Error starting transaction: " + database.lastError().text());
+}
+
+
 /*----------------------------------------------------------*/
 /*-----                 PRIVATE METHODS                -----*/
 /*----------------------------------------------------------*/
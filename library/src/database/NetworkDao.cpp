@@ -681,6 +681,58 @@ WeightlessNeuron* NetworkDao::getWeightlessNeuron(unsigned int neuronID){
 }
 
 
+/*! Returns a snapshot containing all of the weightless neurons in the network.
+	The neurons, their connections and their training patterns are loaded with a handful of queries
+	covering the whole network, instead of two queries per neuron. The calling class is responsible
+	for deleting the snapshot. */
+WeightlessNetworkSnapshot* NetworkDao::getWeightlessNetworkSnapshot(unsigned int networkID){
+	/* Get the connections and pattern indexes of every neuron in the network.
+	   The key of the outer map is the TO neuron id; the inner map is the connection map of that neuron */
+	QHash<unsigned int, QHash<unsigned int, QList<unsigned int> > > netConMap;
+	QSqlQuery query = getQuery("SELECT cons.ToNeuronID, cons.FromNeuronID, weiCons.PatternIndex FROM Connections cons INNER JOIN WeightlessConnections weiCons ON cons.ConnectionID=weiCons.ConnectionID INNER JOIN ConnectionGroups conGrps ON cons.ConnectionGroupID=conGrps.ConnectionGroupID WHERE conGrps.NetworkID=" + QString::number(networkID));
+	executeQuery(query);
+	for(int i=0; i<query.size(); ++i){
+		query.next();
+		netConMap[Util::getUInt(query.value(0).toString())][Util::getUInt(query.value(1).toString())].append(Util::getUInt(query.value(2).toString()));
+	}
+
+	//Create the neurons, including those that have no connections
+	WeightlessNetworkSnapshot* snapshot = new WeightlessNetworkSnapshot(networkID);
+	try{
+		QList<unsigned int> neuronIDList = getNeuronIDs(networkID);
+		foreach(unsigned int neurID, neuronIDList){
+			snapshot->addWeightlessNeuron(new WeightlessNeuron(netConMap[neurID], neurID));
+		}
+		netConMap.clear();
+
+		//Count the training patterns of each neuron so that the arena can be allocated in one go
+		QHash<unsigned int, int> patternCountMap;
+		query = getQuery("SELECT pats.NeuronID, COUNT(*) FROM WeightlessNeuronTrainingPatterns pats INNER JOIN Neurons neurs ON pats.NeuronID=neurs.NeuronID INNER JOIN NeuronGroups neurGrps ON neurs.NeuronGroupID=neurGrps.NeuronGroupID WHERE neurGrps.NetworkID=" + QString::number(networkID) + " GROUP BY pats.NeuronID");
+		executeQuery(query);
+		for(int i=0; i<query.size(); ++i){
+			query.next();
+			patternCountMap[Util::getUInt(query.value(0).toString())] = Util::getInt(query.value(1).toString());
+		}
+		snapshot->allocateTrainingArena(patternCountMap);
+
+		//Add the training patterns to the neurons
+		query = getQuery("SELECT pats.NeuronID, pats.Pattern, pats.Output FROM WeightlessNeuronTrainingPatterns pats INNER JOIN Neurons neurs ON pats.NeuronID=neurs.NeuronID INNER JOIN NeuronGroups neurGrps ON neurs.NeuronGroupID=neurGrps.NeuronGroupID WHERE neurGrps.NetworkID=" + QString::number(networkID));
+		executeQuery(query);
+		for(int i=0; i<query.size(); ++i){
+			query.next();
+			QByteArray tmpByteArray = query.value(1).toByteArray();
+			snapshot->getWeightlessNeuron(Util::getUInt(query.value(0).toString()))->addTraining(tmpByteArray, Util::getUInt(query.value(2).toString()));
+		}
+	}
+	catch(...){
+		delete snapshot;
+		throw;
+	}
+
+	return snapshot;
+}
+
+
 /*! Returns the neuron group containing the specified neuron */
 unsigned int NetworkDao::getNeuronGroupID(unsigned int neuronID){
 	QSqlQuery query = getQuery("SELECT NeuronGroupID FROM Neurons WHERE NeuronID = " + QString::number(neuronID));
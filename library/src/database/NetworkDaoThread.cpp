@@ -10,6 +10,9 @@
 #include "Util.h"
 using namespace spikestream;
 
+//Qt includes
+#include <QPair>
+
 #include <iostream>
 using namespace std;
 
@@ -530,18 +533,17 @@ void NetworkDaoThread::addNeuronGroups(){
 
 		//Add neurons to database
 		int neurCntr = 0, offset = 0, neurAddedCntr = 0, tmpNeurGrpID = neuronGroup->getID();
-		NeuronMap* newNeurMap = new NeuronMap();
-		QList<Neuron*> tmpNeurList;
-		NeuronIterator endNeurGrp = neuronGroup->end();
-		for(NeuronIterator neurIter = neuronGroup->begin(); neurIter != endNeurGrp && !stopThread; ++neurIter){
+		QList<unsigned int> newNeurIDList;
+		QList<int> tmpNeurList;
+		for(int neurIndex = 0; neurIndex < neuronGroup->size() && !stopThread; ++neurIndex){
 			offset = 4 * (neurCntr % numNeurBuffers);
 
 			//Bind values to query
-			tmpNeurList.append(neurIter.value());
+			tmpNeurList.append(neurIndex);
 			query.bindValue(0 + offset, tmpNeurGrpID);
-			query.bindValue(1 + offset, neurIter.value()->getXPos());
-			query.bindValue(2 + offset, neurIter.value()->getYPos());
-			query.bindValue(3 + offset, neurIter.value()->getZPos());
+			query.bindValue(1 + offset, neuronGroup->getNeuronXPos(neurIndex));
+			query.bindValue(2 + offset, neuronGroup->getNeuronYPos(neurIndex));
+			query.bindValue(3 + offset, neuronGroup->getNeuronZPos(neurIndex));
 
 			//Execute query if we have added a whole number of buffers
 			if(neurCntr % numNeurBuffers == numNeurBuffers-1){
@@ -556,11 +558,9 @@ void NetworkDaoThread::addNeuronGroups(){
 				if(tmpNeurList.size() != numNeurBuffers)
 					throw SpikeStreamException("Temporary neuron list size " + QString::number(tmpNeurList.size()) + " does not match number of buffers: " + QString::number(numNeurBuffers));
 
-				//Set neuron IDs and add neurons to new map with the new ID
-				for(int i=0; i<tmpNeurList.size(); ++i){
-					tmpNeurList.at(i)->setID(lastInsertID + i);
-					(*newNeurMap)[lastInsertID + i] = tmpNeurList.at(i);
-				}
+				//Store the new neuron IDs in the order of the neurons in the group
+				for(int i=0; i<tmpNeurList.size(); ++i)
+					newNeurIDList.append(lastInsertID + i);
 
 				//Count number of neurons that have been added
 				neurAddedCntr += numNeurBuffers;
@@ -577,11 +577,11 @@ void NetworkDaoThread::addNeuronGroups(){
 		if(!tmpNeurList.isEmpty()){
 			query = getQuery();
 			query.prepare("INSERT INTO Neurons ( NeuronGroupID, X, Y, Z) VALUES (?, ?, ?, ?)");
-			for(QList<Neuron*>::iterator neurListIter = tmpNeurList.begin(); neurListIter != tmpNeurList.end(); ++neurListIter){
+			foreach(int neurIndex, tmpNeurList){
 				query.bindValue(0, tmpNeurGrpID);
-				query.bindValue(1, (*neurListIter)->getXPos());
-				query.bindValue(2, (*neurListIter)->getYPos());
-				query.bindValue(3, (*neurListIter)->getZPos());
+				query.bindValue(1, neuronGroup->getNeuronXPos(neurIndex));
+				query.bindValue(2, neuronGroup->getNeuronYPos(neurIndex));
+				query.bindValue(3, neuronGroup->getNeuronZPos(neurIndex));
 
 				//Execute query
 				executeQuery(query);
@@ -592,8 +592,7 @@ void NetworkDaoThread::addNeuronGroups(){
 					throw SpikeStreamException("Database generated neuron ID is out of range: " + QString::number(lastInsertID) + ". It must be less than or equal to " + QString::number(LAST_NEURON_ID));
 				if(lastInsertID < START_NEURON_ID)
 					throw SpikeStreamException("Insert ID for Neuron is invalid.");
-				(*neurListIter)->setID(lastInsertID);
-				(*newNeurMap)[lastInsertID] = *neurListIter;
+				newNeurIDList.append(lastInsertID);
 
 				//Count number of neurons that have been added
 				++neurAddedCntr;
@@ -604,16 +603,13 @@ void NetworkDaoThread::addNeuronGroups(){
 		if(!stopThread && (neuronGroup->size() != neurAddedCntr))
 			throw SpikeStreamException("Number of neurons added to database: " + QString::number(neurAddedCntr) + " does not match size of neuron group: " + QString::number(neuronGroup->size()));
 
-		//Set the start ID of the neuron group
-		NetworkDao networkDao(this->getDBInfo());
-		neuronGroup->setStartNeuronID( networkDao.getStartNeuronID(tmpNeurGrpID) );
-
 		#ifdef TIME_PERFORMANCE
 			timer.printTime("Adding neurons. Number of buffers: " + QString::number(numNeurBuffers) + ". Number of neurons remaining: " + QString::number(tmpNeurList.size()) + ". Added " + QString::number(neurAddedCntr) + " neurons");
 		#endif//TIME_PERFORMANCE
 
-		//Add the new map to the neuron group. This should also clean up the old map
-		neuronGroup->setNeuronMap(newNeurMap);
+		//Replace the temporary IDs in the neuron group with the IDs from the database
+		if(!stopThread)
+			neuronGroup->setNeuronIDs(newNeurIDList);
 
 		//Track progress
 		++numberOfCompletedSteps;
@@ -741,27 +737,17 @@ void NetworkDaoThread::loadNeurons(){
 		//Empty current connections in group
 		(*iter)->clearNeurons();
 
-		//Get pointer to neuron map
-		NeuronMap* tmpNeurMap = (*iter)->getNeuronMap();
-
-		//Load neurons into group
-		bool firstTime = true;
+		//Load neurons into group. The neuron group works out the start neuron ID and only stores the IDs if they are not continuous
 		QSqlQuery query = getQuery("SELECT NeuronID, X, Y, Z FROM Neurons WHERE NeuronGroupID = " + QString::number((*iter)->getID()) + " ORDER BY NeuronID");
 		executeQuery(query);
+		(*iter)->reserve(query.size());
 		while ( query.next() ) {
-			Neuron* tmpNeuron = new Neuron(
+			(*iter)->addNeuron(
 					query.value(0).toUInt(),//ID
 					query.value(1).toString().toFloat(),//X
 					query.value(2).toString().toFloat(),//Y
 					query.value(3).toString().toFloat()//Z
 					);
-			(*tmpNeurMap)[query.value(0).toUInt()] = tmpNeuron;
-
-			//Store the start neuron id - useful when neurons are stored continuously, which is usually but not always the case
-			if(firstTime){
-				(*iter)->setStartNeuronID(query.value(0).toUInt());
-				firstTime = false;
-			}
 
 			//Track progress
 			++numberOfCompletedSteps;
@@ -828,22 +814,21 @@ void NetworkDaoThread::saveNetwork(){
 	deleteNeuronGroups();
 	deleteConnectionGroups();
 
-	/* Store link between old IDs and neurons in the groups that we are going to add.
+	/* Store link between old IDs and the group and index of the neurons in the groups that we are going to add.
 	   Also store link between old neuron group IDs and neuron group IDs */
-	QHash<unsigned, Neuron*> oldIDNeurMap;
+	QHash<unsigned, QPair<NeuronGroup*, int> > oldIDNeurMap;
 	QHash<unsigned, NeuronGroup*> oldIDNeurGrpMap;
 	foreach(NeuronGroup* tmpNeurGrp, neuronGroupList){
 		//Store old neuron group ID
 		oldIDNeurGrpMap[tmpNeurGrp->getID()] = tmpNeurGrp;
 
 		//Store old neuron IDS
-		QHash<unsigned, Neuron*>::iterator endNeurGrp = tmpNeurGrp->end();
-		for(QHash<unsigned, Neuron*>::iterator neurIter = tmpNeurGrp->begin(); neurIter != endNeurGrp; ++neurIter){
-			oldIDNeurMap[neurIter.key()] = neurIter.value();
+		for(int neurIndex=0; neurIndex<tmpNeurGrp->size(); ++neurIndex){
+			oldIDNeurMap[tmpNeurGrp->getNeuronID(neurIndex)] = qMakePair(tmpNeurGrp, neurIndex);
 		}
 	}
 
-	//Add neuron groups to database, the new IDs wil be stored in the neurons and neuron groups
+	//Add neuron groups to database, the new IDs wil be stored in the neuron groups
 	addNeuronGroups();
 
 	//Update connections with the new IDs
@@ -854,8 +839,10 @@ void NetworkDaoThread::saveNetwork(){
 			ConnectionIterator endConGrp = tmpConGrp->end();
 			for(ConnectionIterator conIter = tmpConGrp->begin(); conIter!= endConGrp; ++conIter){
 				//Check FROM neuron ID exists
-				if(oldIDNeurMap.contains(conIter->getFromNeuronID()))
-					conIter->setFromNeuronID(oldIDNeurMap[conIter->getFromNeuronID()]->getID());
+				if(oldIDNeurMap.contains(conIter->getFromNeuronID())){
+					QPair<NeuronGroup*, int> neurGrpIndex = oldIDNeurMap[conIter->getFromNeuronID()];
+					conIter->setFromNeuronID(neurGrpIndex.first->getNeuronID(neurGrpIndex.second));
+				}
 				else
 					throw SpikeStreamException("FROM neuron ID missing from old ID neuron map: " + QString::number(conIter->getFromNeuronID()));
 			}
@@ -866,8 +853,10 @@ void NetworkDaoThread::saveNetwork(){
 			ConnectionIterator endConGrp = tmpConGrp->end();
 			for(ConnectionIterator conIter = tmpConGrp->begin(); conIter!= endConGrp; ++conIter){
 				//Check TO neuron ID exists
-				if(oldIDNeurMap.contains(conIter->getToNeuronID()))
-					conIter->setToNeuronID(oldIDNeurMap[conIter->getToNeuronID()]->getID());
+				if(oldIDNeurMap.contains(conIter->getToNeuronID())){
+					QPair<NeuronGroup*, int> neurGrpIndex = oldIDNeurMap[conIter->getToNeuronID()];
+					conIter->setToNeuronID(neurGrpIndex.first->getNeuronID(neurGrpIndex.second));
+				}
 				else
 					throw SpikeStreamException("TO neuron ID missing from old ID neuron map: " + QString::number(conIter->getToNeuronID()));
 			}
@@ -7,6 +7,8 @@ using namespace spikestream;
 
 //Qt includes
 #include <QDebug>
+#include <QPair>
+#include <QtAlgorithms>
 
 //Other includes
 #include <iostream>
@@ -19,7 +21,13 @@ unsigned NeuronGroup::neuronIDCounter = LAST_NEURON_ID + 1;
 /*! Constructor */
 NeuronGroup::NeuronGroup(const NeuronGroupInfo& info){
 	this->info = info;
-	neuronMap = new NeuronMap();
+	numberOfNeurons = 0;
+	neuronCapacity = 0;
+	neuronIDArray = NULL;
+	xPosArray = NULL;
+	yPosArray = NULL;
+	zPosArray = NULL;
+	positionIndexArray = NULL;
 	startNeuronID = 0;
 	calculateBoundingBox = false;
 	positionMapBuilt = false;
@@ -28,11 +36,7 @@ NeuronGroup::NeuronGroup(const NeuronGroupInfo& info){
 
 /*! Destructor */
 NeuronGroup::~NeuronGroup(){
-	//Deletes neuron map and all its dynamically allocated objects
-	if(neuronMap != NULL){
-		clearNeurons();
-		delete neuronMap;
-	}
+	clearNeurons();
 }
 
 
@@ -41,34 +45,57 @@ NeuronGroup::~NeuronGroup(){
 /*--------------------------------------------------------- */
 
 /*! Adds a neuron to the group using a temporary ID. This ID is replaced
-	by the actual ID when the group is added to the network and database. */
-Neuron* NeuronGroup::addNeuron(float xPos, float yPos, float zPos){
-	//Get temporary ID for the neuron - this must be unique and not exist in the current map
+	by the actual ID when the group is added to the network and database.
+	Returns the index of the neuron, which does not change when the ID is replaced. */
+int NeuronGroup::addNeuron(float xPos, float yPos, float zPos){
+	//Get temporary ID for the neuron - this must be unique and not exist in the group
 	unsigned tmpID = getTemporaryID();
+	if(contains(tmpID))
+		throw SpikeStreamException("Automatically generated temporary neuron ID clashes with one in the network. New ID=" + QString::number(tmpID));
+	return addNeuron(tmpID, xPos, yPos, zPos);
+}
 
-	//Fix start neuron id
-	if(neuronMap->isEmpty())
-		startNeuronID = tmpID;
-	else if(tmpID < startNeuronID)
-		startNeuronID = tmpID;
 
-	//Create neuron class
-	Neuron* tmpNeuron = new Neuron(tmpID, xPos, yPos, zPos);
+/*! Adds a neuron with the specified ID to the group and returns its index.
+	IDs are only stored when they stop increasing continuously from the start neuron ID. */
+int NeuronGroup::addNeuron(unsigned int neuronID, float xPos, float yPos, float zPos){
+	//Enlarge the arrays if they are full
+	if(numberOfNeurons == neuronCapacity)
+		reserve(neuronCapacity < 16 ? 16 : neuronCapacity * 2);
 
-	//Store neuron class in ID map
-	if(neuronMap->contains(tmpID))
-		throw SpikeStreamException("Automatically generated temporary neuron ID clashes with one in the network. New ID=" + QString::number(tmpID));
-	(*neuronMap)[tmpID] = tmpNeuron;
+	//Work out whether the ID continues the sequence
+	if(neuronIDArray == NULL){
+		if(numberOfNeurons == 0)
+			startNeuronID = neuronID;
+		else if(neuronID != startNeuronID + numberOfNeurons)
+			storeNeuronIDs();
+	}
+	if(neuronIDArray != NULL){
+		if(neuronIndexMap.contains(neuronID))
+			throw SpikeStreamException("Neuron ID " + QString::number(neuronID) + " is already in the neuron group.");
+		neuronIDArray[numberOfNeurons] = neuronID;
+		neuronIndexMap[neuronID] = numberOfNeurons;
+		if(neuronID < startNeuronID)
+			startNeuronID = neuronID;
+	}
+
+	//Store the position
+	xPosArray[numberOfNeurons] = xPos;
+	yPosArray[numberOfNeurons] = yPos;
+	zPosArray[numberOfNeurons] = zPos;
+	++numberOfNeurons;
 
 	//Finish off
 	neuronGroupChanged();
-	return tmpNeuron;
+	return numberOfNeurons - 1;
 }
 
 
 /*! Adds a layer to the group with the specified width and height.
 	Temporary neuron ids are used and the neurons are appended to the neurons already in the group. */
 void NeuronGroup::addLayer(int width, int height, int xPos, int yPos, int zPos){
+	if(numberOfNeurons + width * height > neuronCapacity)
+		reserve(numberOfNeurons + width * height);
 	for(int x=xPos; x < (xPos + width); ++x){
 		for(int y=yPos; y < (yPos + height); ++y){
 			addNeuron(x, y, zPos);
@@ -78,18 +105,23 @@ void NeuronGroup::addLayer(int width, int height, int xPos, int yPos, int zPos){
 }
 
 
-/*! Builds map that allows iteration by geometrically close neurons. */
+/*! Builds the array of neuron indexes that allows iteration by geometrically close neurons. */
 void NeuronGroup::buildPositionMap(){
-	neuronPositionMap.clear();
-
-	//Work through all neurons
-	NeuronMap::iterator mapEnd = neuronMap->end();
-	for(NeuronMap::iterator iter=neuronMap->begin(); iter != mapEnd; ++iter){
-		//Store link between neuron position and neuron class
-		uint64_t tmpKey = getPositionKey(iter.value()->getXPos(), iter.value()->getYPos(), iter.value()->getZPos());
-		if(neuronPositionMap.contains(tmpKey))
-			throw SpikeStreamException("Position key clashes with one in the position map. Key=" + QString::number(tmpKey));
-		neuronPositionMap[tmpKey] = iter.value();
+	//Work out the position key of each neuron
+	QList< QPair<uint64_t, int> > positionList;
+	positionList.reserve(numberOfNeurons);
+	for(int i=0; i<numberOfNeurons; ++i)
+		positionList.append(qMakePair(getPositionKey(xPosArray[i], yPosArray[i], zPosArray[i]), i));
+
+	//Sort the neurons by position and check that no two neurons share a position
+	qSort(positionList);
+	if(positionIndexArray != NULL)
+		delete [] positionIndexArray;
+	positionIndexArray = new int[numberOfNeurons];
+	for(int i=0; i<numberOfNeurons; ++i){
+		if(i > 0 && positionList.at(i).first == positionList.at(i-1).first)
+			throw SpikeStreamException("Position key clashes with one in the position map. Key=" + QString::number(positionList.at(i).first));
+		positionIndexArray[i] = positionList.at(i).second;
 	}
 
 	//Set flag to record that we have built position map
@@ -99,28 +131,42 @@ void NeuronGroup::buildPositionMap(){
 
 /*! Clears all of the neurons that are currently loaded */
 void NeuronGroup::clearNeurons(){
-	NeuronMap::iterator endNeuronMap = neuronMap->end();
-	for(NeuronMap::iterator iter = neuronMap->begin(); iter != endNeuronMap; ++iter){
-		delete iter.value();
+	if(neuronIDArray != NULL){
+		delete [] neuronIDArray;
+		neuronIDArray = NULL;
+	}
+	if(xPosArray != NULL){
+		delete [] xPosArray;
+		delete [] yPosArray;
+		delete [] zPosArray;
+		xPosArray = NULL;
+		yPosArray = NULL;
+		zPosArray = NULL;
+	}
+	if(positionIndexArray != NULL){
+		delete [] positionIndexArray;
+		positionIndexArray = NULL;
 	}
-	neuronMap->clear();
+	neuronIndexMap.clear();
+	numberOfNeurons = 0;
+	neuronCapacity = 0;
+	startNeuronID = 0;
 	neuronGroupChanged();
 }
 
 
 /*! Returns true if the neuron group contains a neuron with the specified id. */
 bool NeuronGroup::contains(unsigned int neurID){
-	if(neuronMap->contains(neurID))
-		return true;
-	return false;
+	return getNeuronIndex(neurID) >= 0;
 }
 
 
 /*! Returns true if a neuron with this specification exists in this group */
 bool NeuronGroup::contains(unsigned int neurID, float x, float y, float z){
-	if(!neuronMap->contains(neurID))
-		return false;;
-	if((*neuronMap)[neurID]->getXPos() != x || (*neuronMap)[neurID]->getYPos() != y || (*neuronMap)[neurID]->getZPos() != z)
+	int index = getNeuronIndex(neurID);
+	if(index < 0)
+		return false;
+	if(xPosArray[index] != x || yPosArray[index] != y || zPosArray[index] != z)
 		return false;
 	return true;
 }
@@ -133,33 +179,23 @@ Box NeuronGroup::getBoundingBox(){
 	if(!calculateBoundingBox)
 		return boundingBox;
 
-	//Calculate the bounding box
-	Neuron* tmpNeuron;
-	bool firstTime = true;
-	NeuronMap::iterator mapEnd = neuronMap->end();//Saves accessing this function multiple times
-	for(NeuronMap::iterator iter=neuronMap->begin(); iter != mapEnd; ++iter){
-		tmpNeuron = iter.value();
-		if(firstTime){//Take first neuron as starting point
-			boundingBox = Box(tmpNeuron->getXPos(), tmpNeuron->getYPos(), tmpNeuron->getZPos(),
-								tmpNeuron->getXPos(), tmpNeuron->getYPos(), tmpNeuron->getZPos()
-							);
-			firstTime = false;
-		}
-		else{//Expand box to include subsequent neurons
-			if(tmpNeuron->getXPos() < boundingBox.x1)
-				boundingBox.x1 = tmpNeuron->getXPos();
-			if(tmpNeuron->getYPos() < boundingBox.y1)
-				boundingBox.y1 = tmpNeuron->getYPos();
-			if(tmpNeuron->getZPos() < boundingBox.z1)
-				boundingBox.z1 = tmpNeuron->getZPos();
-
-			if(tmpNeuron->getXPos() > boundingBox.x2)
-				boundingBox.x2 = tmpNeuron->getXPos();
-			if(tmpNeuron->getYPos() > boundingBox.y2)
-				boundingBox.y2 = tmpNeuron->getYPos();
-			if(tmpNeuron->getZPos() > boundingBox.z2)
-				boundingBox.z2 = tmpNeuron->getZPos();
-		}
+	//Calculate the bounding box, taking the first neuron as the starting point
+	if(numberOfNeurons > 0)
+		boundingBox = Box(xPosArray[0], yPosArray[0], zPosArray[0], xPosArray[0], yPosArray[0], zPosArray[0]);
+	for(int i=1; i<numberOfNeurons; ++i){
+		if(xPosArray[i] < boundingBox.x1)
+			boundingBox.x1 = xPosArray[i];
+		if(yPosArray[i] < boundingBox.y1)
+			boundingBox.y1 = yPosArray[i];
+		if(zPosArray[i] < boundingBox.z1)
+			boundingBox.z1 = zPosArray[i];
+
+		if(xPosArray[i] > boundingBox.x2)
+			boundingBox.x2 = xPosArray[i];
+		if(yPosArray[i] > boundingBox.y2)
+			boundingBox.y2 = yPosArray[i];
+		if(zPosArray[i] > boundingBox.z2)
+			boundingBox.z2 = zPosArray[i];
 	}
 
 	//Return calculated box
@@ -174,60 +210,73 @@ unsigned NeuronGroup::getID(){
 }
 
 
-/*! Returns the nearest neuron to the specified point.
+/*! Returns the ID of the nearest neuron to the specified point.
 	When more than one neurons are found, only the first is returned.
 	FIXME: CURRENTLY A COMPLETE SEARCH - OPTIMIZE! */
-Neuron* NeuronGroup::getNearestNeuron(const Point3D& point){
+unsigned int NeuronGroup::getNearestNeuronID(const Point3D& point){
+	if(numberOfNeurons == 0)
+		throw SpikeStreamException("Cannot find nearest neuron in an empty neuron group.");
 	double minDist = 0, tmpDist;
-	bool firstTime;
-	Neuron* closestNeuron = NULL;
-	NeuronMap::iterator mapEnd = neuronMap->end();//Saves accessing this function multiple times
-	for(NeuronMap::iterator iter=neuronMap->begin(); iter != mapEnd; ++iter){
-		tmpDist = iter.value()->getLocation().distance(point);
-		if(firstTime){
+	int closestIndex = 0;
+	for(int i=0; i<numberOfNeurons; ++i){
+		tmpDist = Point3D(xPosArray[i], yPosArray[i], zPosArray[i]).distance(point);
+		if(i == 0 || tmpDist < minDist){
 			minDist = tmpDist;
-			closestNeuron = iter.value();
-			firstTime = false;
-		}
-		else{
-			if(tmpDist < minDist){
-				minDist = tmpDist;
-				closestNeuron = iter.value();
-			}
+			closestIndex = i;
 		}
 	}
-	return closestNeuron;
+	return getNeuronID(closestIndex);
 }
 
 
 /*! Returns the ID of the neuron at a specified location */
 unsigned int NeuronGroup::getNeuronIDAtLocation(const Point3D& point){
-	NeuronMap::iterator mapEnd = neuronMap->end();//Saves accessing this function multiple times
-	for(NeuronMap::iterator iter=neuronMap->begin(); iter != mapEnd; ++iter){
-		if(iter.value()->getLocation() == point)
-			return iter.key();
+	for(int i=0; i<numberOfNeurons; ++i){
+		if(xPosArray[i] == point.getXPos() && yPosArray[i] == point.getYPos() && zPosArray[i] == point.getZPos())
+			return getNeuronID(i);
 	}
 	throw SpikeStreamException("No neuron at location "+ point.toString());
 }
 
 
+/*! Returns the IDs of the neurons in the group in the order of their indexes. */
+QList<unsigned int> NeuronGroup::getNeuronIDs(){
+	QList<unsigned int> tmpList;
+	tmpList.reserve(numberOfNeurons);
+	for(int i=0; i<numberOfNeurons; ++i)
+		tmpList.append(getNeuronID(i));
+	return tmpList;
+}
+
+
+/*! Returns the index of the neuron with the specified ID or -1 if it is not in the group. */
+int NeuronGroup::getNeuronIndex(unsigned int neuronID){
+	if(neuronIDArray != NULL)
+		return neuronIndexMap.value(neuronID, -1);
+	if(neuronID < startNeuronID || neuronID - startNeuronID >= (unsigned)numberOfNeurons)
+		return -1;
+	return neuronID - startNeuronID;
+}
+
+
 /*! Returns the location of the neuron with the specified ID */
-Point3D& NeuronGroup::getNeuronLocation(unsigned int neuronID){
-	if(!neuronMap->contains(neuronID)){
+Point3D NeuronGroup::getNeuronLocation(unsigned int neuronID){
+	int index = getNeuronIndex(neuronID);
+	if(index < 0){
 		this->print();
 		throw SpikeStreamException("Neuron ID '" + QString::number(neuronID) + "' could not be found.");
 	}
-	return (*neuronMap)[neuronID]->getLocation();
+	return Point3D(xPosArray[index], yPosArray[index], zPosArray[index]);
 }
 
 
 /*! Returns neurons contained within the specified box */
-QList<Neuron*> NeuronGroup::getNeurons(const Box& box){
-	QList<Neuron*> tmpList;
-	NeuronMap::iterator mapEnd = neuronMap->end();
-	for(NeuronMap::iterator iter=neuronMap->begin(); iter != mapEnd; ++iter){
-		if( box.contains(iter.value()->getLocation()) )
-			tmpList.append(iter.value());
+QList<Neuron> NeuronGroup::getNeurons(const Box& box){
+	QList<Neuron> tmpList;
+	for(int i=0; i<numberOfNeurons; ++i){
+		Point3D tmpPoint(xPosArray[i], yPosArray[i], zPosArray[i]);
+		if( box.contains(tmpPoint) )
+			tmpList.append(Neuron(getNeuronID(i), xPosArray[i], yPosArray[i], zPosArray[i]));
 	}
 	return tmpList;
 }
@@ -302,10 +351,8 @@ bool NeuronGroup::parametersSet(){
 void NeuronGroup::print(){
 	cout<<"------------- Neuron Group: id="<<info.getID()<<"; description="<<info.getDescription().toStdString();
 	cout<<" "<<info.getNeuronType().getDescription().toStdString()<<" -------------"<<endl;
-	NeuronMap::iterator mapEnd = neuronMap->end();
-	for(NeuronMap::iterator iter=neuronMap->begin(); iter != mapEnd; ++iter){
-		iter.value()->print();
-	}
+	for(int i=0; i<numberOfNeurons; ++i)
+		cout<<"Neuron. id: "<<getNeuronID(i)<<endl;
 }
 
 
@@ -315,7 +362,7 @@ void NeuronGroup::print(){
 NeuronPositionIterator NeuronGroup::positionBegin(){
 	if(!positionMapBuilt)
 		buildPositionMap();
-	return neuronPositionMap.begin();
+	return NeuronPositionIterator(this, 0, positionIndexArray);
 }
 
 
@@ -325,7 +372,42 @@ NeuronPositionIterator NeuronGroup::positionBegin(){
 NeuronPositionIterator NeuronGroup::positionEnd(){
 	if(!positionMapBuilt)
 		buildPositionMap();
-	return neuronPositionMap.end();
+	return NeuronPositionIterator(this, numberOfNeurons, positionIndexArray);
+}
+
+
+/*! Enlarges the arrays so that they can hold the specified number of neurons without being reallocated. */
+void NeuronGroup::reserve(int capacity){
+	if(capacity <= neuronCapacity)
+		return;
+
+	//Copy the neurons into the larger arrays
+	float* newXPosArray = new float[capacity];
+	float* newYPosArray = new float[capacity];
+	float* newZPosArray = new float[capacity];
+	for(int i=0; i<numberOfNeurons; ++i){
+		newXPosArray[i] = xPosArray[i];
+		newYPosArray[i] = yPosArray[i];
+		newZPosArray[i] = zPosArray[i];
+	}
+	if(xPosArray != NULL){
+		delete [] xPosArray;
+		delete [] yPosArray;
+		delete [] zPosArray;
+	}
+	xPosArray = newXPosArray;
+	yPosArray = newYPosArray;
+	zPosArray = newZPosArray;
+
+	//Copy the IDs if they are stored
+	if(neuronIDArray != NULL){
+		unsigned int* newNeuronIDArray = new unsigned int[capacity];
+		for(int i=0; i<numberOfNeurons; ++i)
+			newNeuronIDArray[i] = neuronIDArray[i];
+		delete [] neuronIDArray;
+		neuronIDArray = newNeuronIDArray;
+	}
+	neuronCapacity = capacity;
 }
 
 
@@ -347,12 +429,36 @@ void NeuronGroup::setName(const QString& name){
 }
 
 
-/*! Replaces the neuron map with a new neuron map.
-	Neurons are not cleaned up because they might be included in the new map. */
-void NeuronGroup::setNeuronMap(NeuronMap* newMap){
-	delete neuronMap;
-	this->neuronMap = newMap;
-	neuronGroupChanged();
+/*! Replaces the IDs of the neurons, typically with the IDs generated by the database.
+	The list holds the new ID of each neuron in the order of their indexes. */
+void NeuronGroup::setNeuronIDs(const QList<unsigned int>& neuronIDList){
+	if(neuronIDList.size() != numberOfNeurons)
+		throw SpikeStreamException("Number of neuron IDs " + QString::number(neuronIDList.size()) + " does not match size of neuron group: " + QString::number(numberOfNeurons));
+
+	//Go back to continuous IDs and store the IDs if there is a gap in the sequence
+	if(neuronIDArray != NULL){
+		delete [] neuronIDArray;
+		neuronIDArray = NULL;
+	}
+	neuronIndexMap.clear();
+	startNeuronID = neuronIDList.isEmpty() ? 0 : neuronIDList.at(0);
+	for(int i=1; i<numberOfNeurons; ++i){
+		if(neuronIDList.at(i) != startNeuronID + i){
+			storeNeuronIDs();
+			break;
+		}
+	}
+	if(neuronIDArray != NULL){
+		neuronIndexMap.clear();
+		for(int i=0; i<numberOfNeurons; ++i){
+			if(neuronIndexMap.contains(neuronIDList.at(i)))
+				throw SpikeStreamException("Neuron ID " + QString::number(neuronIDList.at(i)) + " occurs more than once.");
+			neuronIDArray[i] = neuronIDList.at(i);
+			neuronIndexMap[neuronIDList.at(i)] = i;
+			if(neuronIDList.at(i) < startNeuronID)
+				startNeuronID = neuronIDList.at(i);
+		}
+	}
 }
 
 
@@ -377,7 +483,7 @@ void NeuronGroup::setParameters(QHash<QString, double>& paramMap){
 
 /*! Returns the number of neurons in the group. */
 int NeuronGroup::size(){
-	return neuronMap->size();
+	return numberOfNeurons;
 }
 
 
@@ -396,3 +502,13 @@ void NeuronGroup::neuronGroupChanged(){
 	calculateBoundingBox = true;
 	positionMapBuilt = false;
 }
+
+
+/*! Stores the IDs of the neurons in an array, which is necessary when they stop running continuously from the start neuron ID. */
+void NeuronGroup::storeNeuronIDs(){
+	neuronIDArray = new unsigned int[neuronCapacity];
+	for(int i=0; i<numberOfNeurons; ++i){
+		neuronIDArray[i] = startNeuronID + i;
+		neuronIndexMap[startNeuronID + i] = i;
+	}
+}
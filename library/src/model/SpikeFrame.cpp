@@ -0,0 +1,57 @@
+//SpikeStream includes
+#include "SpikeFrame.h"
+#include "SpikeStreamException.h"
+using namespace spikestream;
+
+//Other includes
+#include <cstring>
+
+
+/*! Constructor that copies the neuron IDs from an array */
+SpikeFrame::SpikeFrame(unsigned int timeStep, const unsigned int* neuronIDArray, int numberOfNeurons){
+	if(numberOfNeurons < 0)
+		throw SpikeStreamException("Spike frame cannot have a negative number of neurons: " + QString::number(numberOfNeurons));
+
+	this->timeStep = timeStep;
+	this->numberOfNeurons = numberOfNeurons;
+	this->neuronIDArray = NULL;
+	if(numberOfNeurons > 0){
+		this->neuronIDArray = new unsigned int[numberOfNeurons];
+		memcpy(this->neuronIDArray, neuronIDArray, numberOfNeurons * sizeof(unsigned int));
+	}
+}
+
+
+/*! Constructor that copies the neuron IDs from a list */
+SpikeFrame::SpikeFrame(unsigned int timeStep, const QList<unsigned int>& neuronIDList){
+	this->timeStep = timeStep;
+	numberOfNeurons = neuronIDList.size();
+	neuronIDArray = NULL;
+	if(numberOfNeurons > 0){
+		neuronIDArray = new unsigned int[numberOfNeurons];
+		for(int i=0; i<numberOfNeurons; ++i)
+			neuronIDArray[i] = neuronIDList.at(i);
+	}
+}
+
+
+/*! Destructor */
+SpikeFrame::~SpikeFrame(){
+	if(neuronIDArray != NULL)
+		delete [] neuronIDArray;
+}
+
+
+/*-------------------------------------------------------------*/
+/*-------                  PUBLIC METHODS                ------*/
+/*-------------------------------------------------------------*/
+
+/*! Returns a copy of the neuron IDs as a list. */
+QList<unsigned int> SpikeFrame::toList() const{
+	QList<unsigned int> neuronIDList;
+	neuronIDList.reserve(numberOfNeurons);
+	for(int i=0; i<numberOfNeurons; ++i)
+		neuronIDList.append(neuronIDArray[i]);
+	return neuronIDList;
+}
+
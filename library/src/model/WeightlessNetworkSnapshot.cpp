@@ -0,0 +1,127 @@
+//SpikeStream includes
+#include "SpikeStreamException.h"
+#include "WeightlessNetworkSnapshot.h"
+using namespace spikestream;
+
+
+/*! Constructor */
+WeightlessNetworkSnapshot::WeightlessNetworkSnapshot(unsigned int networkID){
+	this->networkID = networkID;
+	trainingArena = NULL;
+	outputArena = NULL;
+	arenaCapacity = 0;
+}
+
+
+/*! Destructor */
+WeightlessNetworkSnapshot::~WeightlessNetworkSnapshot(){
+	//Neurons are deleted before the arena that holds their training data
+	for(QHash<unsigned int, WeightlessNeuron*>::iterator iter = weightlessNeuronMap.begin(); iter != weightlessNeuronMap.end(); ++iter)
+		delete iter.value();
+	weightlessNeuronMap.clear();
+
+	if(trainingArena != NULL)
+		delete [] trainingArena;
+	if(outputArena != NULL)
+		delete [] outputArena;
+}
+
+
+/*-------------------------------------------------------------*/
+/*-------                  PUBLIC METHODS                ------*/
+/*-------------------------------------------------------------*/
+
+/*! Adds a weightless neuron to the snapshot, which takes ownership of it. */
+void WeightlessNetworkSnapshot::addWeightlessNeuron(WeightlessNeuron* neuron){
+	if(weightlessNeuronMap.contains(neuron->getID()))
+		throw SpikeStreamException("Weightless neuron " + QString::number(neuron->getID()) + " has already been added to the snapshot.");
+	if(trainingArena != NULL)
+		throw SpikeStreamException("Neurons cannot be added to the snapshot after the training arena has been allocated.");
+	weightlessNeuronMap[neuron->getID()] = neuron;
+}
+
+
+/*! Allocates a single block of memory for the training data and gives each neuron its part of it.
+	The map contains the number of training patterns of each neuron; neurons that are not in the map
+	have no training data. Should be called after all of the neurons have been added and before any
+	training data is added to them. */
+void WeightlessNetworkSnapshot::allocateTrainingArena(const QHash<unsigned int, int>& patternCountMap){
+	if(trainingArena != NULL)
+		throw SpikeStreamException("Training arena has already been allocated.");
+
+	//Work out the size of the arena
+	int totalWords = 0;
+	arenaCapacity = 0;
+	for(QHash<unsigned int, WeightlessNeuron*>::iterator iter = weightlessNeuronMap.begin(); iter != weightlessNeuronMap.end(); ++iter){
+		int patternCount = patternCountMap.value(iter.key(), 0);
+		totalWords += patternCount * iter.value()->getTrainingWordLength();
+		arenaCapacity += patternCount;
+	}
+	if(arenaCapacity == 0)
+		return;
+
+	//Allocate the arena and share it out between the neurons
+	trainingArena = new uint64_t[totalWords];
+	outputArena = new unsigned char[arenaCapacity];
+	uint64_t* nextPatterns = trainingArena;
+	unsigned char* nextOutputs = outputArena;
+	for(QHash<unsigned int, WeightlessNeuron*>::iterator iter = weightlessNeuronMap.begin(); iter != weightlessNeuronMap.end(); ++iter){
+		int patternCount = patternCountMap.value(iter.key(), 0);
+		if(patternCount == 0)
+			continue;
+		iter.value()->setTrainingStorage(nextPatterns, nextOutputs, patternCount);
+		nextPatterns += patternCount * iter.value()->getTrainingWordLength();
+		nextOutputs += patternCount;
+	}
+}
+
+
+/*! Fills the supplied map with the connections FROM each neuron TO other neurons in the snapshot.
+	Has the same layout as the map filled by NetworkDao::getAllFromConnections. */
+void WeightlessNetworkSnapshot::getAllFromConnections(QHash<unsigned int, QHash<unsigned int, bool> >& connMap) const {
+	connMap.clear();
+	for(QHash<unsigned int, WeightlessNeuron*>::const_iterator iter = weightlessNeuronMap.begin(); iter != weightlessNeuronMap.end(); ++iter)
+		connMap[iter.key()];
+	for(QHash<unsigned int, WeightlessNeuron*>::const_iterator iter = weightlessNeuronMap.begin(); iter != weightlessNeuronMap.end(); ++iter){
+		const QHash<unsigned int, QList<unsigned int> > conMap = iter.value()->getConnectionMap();
+		for(QHash<unsigned int, QList<unsigned int> >::const_iterator conIter = conMap.constBegin(); conIter != conMap.constEnd(); ++conIter)
+			connMap[conIter.key()][iter.key()] = true;
+	}
+}
+
+
+/*! Fills the supplied map with the connections made TO each neuron from other neurons in the snapshot.
+	Has the same layout as the map filled by NetworkDao::getAllToConnections. */
+void WeightlessNetworkSnapshot::getAllToConnections(QHash<unsigned int, QHash<unsigned int, bool> >& connMap) const {
+	connMap.clear();
+	for(QHash<unsigned int, WeightlessNeuron*>::const_iterator iter = weightlessNeuronMap.begin(); iter != weightlessNeuronMap.end(); ++iter){
+		QHash<unsigned int, bool>& toConMap = connMap[iter.key()];
+		const QHash<unsigned int, QList<unsigned int> > conMap = iter.value()->getConnectionMap();
+		for(QHash<unsigned int, QList<unsigned int> >::const_iterator conIter = conMap.constBegin(); conIter != conMap.constEnd(); ++conIter)
+			toConMap[conIter.key()] = true;
+	}
+}
+
+
+/*! Returns the IDs of the neurons in the snapshot in ascending order */
+QList<unsigned int> WeightlessNetworkSnapshot::getNeuronIDs() const {
+	QList<unsigned int> neurIDList = weightlessNeuronMap.keys();
+	qSort(neurIDList);
+	return neurIDList;
+}
+
+
+/*! Returns the weightless neuron with the specified ID */
+WeightlessNeuron* WeightlessNetworkSnapshot::getWeightlessNeuron(unsigned int neuronID) const {
+	if(!weightlessNeuronMap.contains(neuronID))
+		throw SpikeStreamException("Weightless neuron " + QString::number(neuronID) + " cannot be found in network snapshot.");
+	return weightlessNeuronMap.value(neuronID);
+}
+
+
+/*! Sets the generalization of all of the neurons. Should only be called before the snapshot is shared between threads. */
+void WeightlessNetworkSnapshot::setGeneralization(double generalization){
+	for(QHash<unsigned int, WeightlessNeuron*>::iterator iter = weightlessNeuronMap.begin(); iter != weightlessNeuronMap.end(); ++iter)
+		iter.value()->setGeneralization(generalization);
+}
+
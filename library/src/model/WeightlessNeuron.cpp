@@ -1,4 +1,5 @@
 //SpikeStream includes
+#include "RandomStream.h"
 #include "SpikeStreamException.h"
 #include "Util.h"
 #include "WeightlessNeuron.h"
@@ -8,34 +9,108 @@ using namespace spikestream;
 #include <QDebug>
 
 //Other includes
-#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <vector>
 using namespace std;
 
-/*! Copied from NRM.
-	I think this is an array where each number represents the Hamming distance
-	between XORed bytes. So for example, if the two bytes 10000111 and 00000111
-	are XORed, you get the number 10000000, or 128, which should result in 1 when
-	looked up in the array.
-	FIXME: CHECK THIS ARRAY */
-byte lookup[] = {
-	0,1,1,2, 1,2,2,3, 1,2,2,3, 2,3,3,4,
-	1,2,2,3, 2,3,3,4, 2,3,3,4, 3,4,4,5,
-	1,2,2,3, 2,3,3,4, 2,3,3,4, 3,4,4,5,
-	2,3,3,4, 3,4,4,5, 3,4,4,5, 4,5,5,6,
-	1,2,2,3, 2,3,3,4, 2,3,3,4, 3,4,4,5,
-	2,3,3,4, 3,4,4,5, 3,4,4,5, 4,5,5,6,
-	2,3,3,4, 3,4,4,5, 3,4,4,5, 4,5,5,6,
-	3,4,4,5, 4,5,5,6, 4,5,5,6, 5,6,6,7,
-	1,2,2,3, 2,3,3,4, 2,3,3,4, 3,4,4,5,
-	2,3,3,4, 3,4,4,5, 3,4,4,5, 4,5,5,6,
-	2,3,3,4, 3,4,4,5, 3,4,4,5, 4,5,5,6,
-	3,4,4,5, 4,5,5,6, 4,5,5,6, 5,6,6,7,
-	2,3,3,4, 3,4,4,5, 3,4,4,5, 4,5,5,6,
-	3,4,4,5, 4,5,5,6, 4,5,5,6, 5,6,6,7,
-	3,4,4,5, 4,5,5,6, 4,5,5,6, 5,6,6,7,
-	4,5,5,6, 5,6,6,7, 5,6,6,7, 6,7,7,8
-};
+//Hardware popcount and AVX2 are selected at run time on x86 processors
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define SPIKESTREAM_X86_HAMMING
+	#include <immintrin.h>
+#endif
+
+//Maximum number of combinations of unknown inputs worked through by getTransitionProbability before it estimates the result instead
+#define MAX_TRANSITION_COMBINATIONS 1000000
+
+//Number of random completions of the pattern used to estimate a transition probability
+#define NUMBER_OF_TRANSITION_SAMPLES 10000
+
+
+/*! Returns true if the bit at the specified input index is set in the pattern.
+	Patterns hold the input bytes in memory order within their words, so bits are addressed
+	through the bytes to give the same layout on little and big endian processors. */
+static inline bool getPatternBit(const uint64_t* patternWords, int bitIndx){
+	return ( ((const byte*)patternWords)[bitIndx/8] & (1<<(bitIndx%8)) ) != 0;
+}
+
+
+/*! Sets the bit at the specified input index in the pattern */
+static inline void setPatternBit(uint64_t* patternWords, int bitIndx){
+	((byte*)patternWords)[bitIndx/8] |= 1<<(bitIndx%8);
+}
+
+
+/*! Clears the bit at the specified input index in the pattern */
+static inline void clearPatternBit(uint64_t* patternWords, int bitIndx){
+	((byte*)patternWords)[bitIndx/8] &= ~(1<<(bitIndx%8));
+}
+
+
+/*! Returns the number of bits that are set in the word */
+static inline unsigned int popCount64(uint64_t word){
+	#ifdef __GNUC__
+		return __builtin_popcountll(word);
+	#else
+		word = word - ((word >> 1) & 0x5555555555555555ULL);
+		word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+		word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+		return (unsigned int)((word * 0x0101010101010101ULL) >> 56);
+	#endif
+}
+
+
+/*! Returns the Hamming distance between two patterns of the specified number of words.
+	Stops counting once the distance exceeds maxDist. */
+static unsigned int hammingDistanceGeneric(const uint64_t* pattern1, const uint64_t* pattern2, int wordLength, unsigned int maxDist){
+	unsigned int hamDist = 0;
+	for(int i=0; i<wordLength; ++i){
+		hamDist += popCount64(pattern1[i] ^ pattern2[i]);
+		if(hamDist > maxDist)
+			break;
+	}
+	return hamDist;
+}
+
+
+#ifdef SPIKESTREAM_X86_HAMMING
+
+/*! Version of hammingDistanceGeneric compiled to use the POPCNT instruction */
+__attribute__((target("popcnt")))
+static unsigned int hammingDistancePopcnt(const uint64_t* pattern1, const uint64_t* pattern2, int wordLength, unsigned int maxDist){
+	unsigned int hamDist = 0;
+	for(int i=0; i<wordLength; ++i){
+		hamDist += __builtin_popcountll(pattern1[i] ^ pattern2[i]);
+		if(hamDist > maxDist)
+			break;
+	}
+	return hamDist;
+}
+
+
+/*! Returns the Hamming distance between two patterns, processing four words at a time.
+	Bits are counted by looking up each half byte in a table held in a register.
+	The word length must be a multiple of 4. */
+__attribute__((target("avx2")))
+static unsigned int hammingDistanceAVX2(const uint64_t* pattern1, const uint64_t* pattern2, int wordLength, unsigned int maxDist){
+	const __m256i lowMask = _mm256_set1_epi8(0x0f);
+	const __m256i countTable = _mm256_setr_epi8(0,1,1,2, 1,2,2,3, 1,2,2,3, 2,3,3,4, 0,1,1,2, 1,2,2,3, 1,2,2,3, 2,3,3,4);
+	uint64_t blockCounts[4];
+	unsigned int hamDist = 0;
+	for(int i=0; i<wordLength; i += 4){
+		__m256i xorBlock = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)&pattern1[i]), _mm256_loadu_si256((const __m256i*)&pattern2[i]));
+		__m256i lowCounts = _mm256_shuffle_epi8(countTable, _mm256_and_si256(xorBlock, lowMask));
+		__m256i highCounts = _mm256_shuffle_epi8(countTable, _mm256_and_si256(_mm256_srli_epi16(xorBlock, 4), lowMask));
+		_mm256_storeu_si256((__m256i*)blockCounts, _mm256_sad_epu8(_mm256_add_epi8(lowCounts, highCounts), _mm256_setzero_si256()));
+		hamDist += (unsigned int)(blockCounts[0] + blockCounts[1] + blockCounts[2] + blockCounts[3]);
+		if(hamDist > maxDist)
+			break;
+	}
+	return hamDist;
+}
+
+#endif//SPIKESTREAM_X86_HAMMING
 
 
 /*! Constructor */
@@ -58,6 +133,31 @@ WeightlessNeuron::WeightlessNeuron(QHash<unsigned int, QList<unsigned int> >& co
 
 	//Default setting for hamming threshold
 	hammingThreshold = 0;
+
+	/* Patterns are stored in whole 64 bit words. Longer patterns are padded to a multiple
+	   of four words so that they can be compared 256 bits at a time */
+	trainingWordLength = (trainingDataLength - 1 + 7) / 8;
+	if(trainingWordLength == 0)
+		trainingWordLength = 1;
+	else if(trainingWordLength > 4 && trainingWordLength % 4 != 0)
+		trainingWordLength += 4 - trainingWordLength % 4;
+
+	//Training matrix is allocated when the first pattern is added
+	trainingMatrix = NULL;
+	trainingOutputs = NULL;
+	numberOfTrainingPatterns = 0;
+	trainingCapacity = 0;
+	ownsTrainingStorage = true;
+
+	//Select the fastest Hamming distance function for this processor
+	hammingDistance = &hammingDistanceGeneric;
+	#ifdef SPIKESTREAM_X86_HAMMING
+		__builtin_cpu_init();
+		if(trainingWordLength % 4 == 0 && __builtin_cpu_supports("avx2"))
+			hammingDistance = &hammingDistanceAVX2;
+		else if(__builtin_cpu_supports("popcnt"))
+			hammingDistance = &hammingDistancePopcnt;
+	#endif//SPIKESTREAM_X86_HAMMING
 }
 
 
@@ -65,6 +165,10 @@ WeightlessNeuron::WeightlessNeuron(QHash<unsigned int, QList<unsigned int> >& co
 WeightlessNeuron::~WeightlessNeuron(){
 	//Delete the training data
 	resetTraining();
+	if(ownsTrainingStorage && trainingMatrix != NULL)
+		delete [] trainingMatrix;
+	if(ownsTrainingStorage && trainingOutputs != NULL)
+		delete [] trainingOutputs;
 }
 
 
@@ -77,13 +181,36 @@ void WeightlessNeuron::addTraining(QByteArray& newData, unsigned int output){
 	if( (newData.size() + 1) != trainingDataLength)
 		throw SpikeStreamException("New  training data length " + QString::number(newData.size() + 1) + " does not match current training data length " + QString::number(trainingDataLength));
 
-	//Store the data
-	byte* newTrainingArray = new byte[trainingDataLength];
-	newTrainingArray[0] = output;
-	for(int i=1; i<trainingDataLength; ++i){
-		newTrainingArray[i] = newData[i-1];
+	if(output > 1)
+		throw SpikeStreamException("Output of training data not recognized. It should be 1 or 0: " + QString::number(output));
+
+	/* Double the size of the training matrix if it is full.
+	   Storage supplied by another class is copied into memory owned by the neuron */
+	if(numberOfTrainingPatterns == trainingCapacity){
+		int newCapacity = trainingCapacity == 0 ? 4 : trainingCapacity * 2;
+		uint64_t* newTrainingMatrix = new uint64_t[newCapacity * trainingWordLength];
+		byte* newTrainingOutputs = new byte[newCapacity];
+		if(numberOfTrainingPatterns > 0){
+			memcpy(newTrainingMatrix, trainingMatrix, numberOfTrainingPatterns * trainingWordLength * sizeof(uint64_t));
+			memcpy(newTrainingOutputs, trainingOutputs, numberOfTrainingPatterns);
+		}
+		if(ownsTrainingStorage && trainingMatrix != NULL){
+			delete [] trainingMatrix;
+			delete [] trainingOutputs;
+		}
+		trainingMatrix = newTrainingMatrix;
+		trainingOutputs = newTrainingOutputs;
+		trainingCapacity = newCapacity;
+		ownsTrainingStorage = true;
 	}
-	trainingData.append(newTrainingArray);
+
+	//Store the data, leaving the padding at zero
+	uint64_t* newPattern = &trainingMatrix[numberOfTrainingPatterns * trainingWordLength];
+	for(int i=0; i<trainingWordLength; ++i)
+		newPattern[i] = 0;
+	memcpy(newPattern, newData.constData(), newData.size());
+	trainingOutputs[numberOfTrainingPatterns] = output;
+	++numberOfTrainingPatterns;
 }
 
 
@@ -92,80 +219,30 @@ void WeightlessNeuron::addTraining(QByteArray& newData, unsigned int output){
 	1 or 0 depending on whether the stored output matches the specified output.
 	If there is more than one match within the Hamming distance, then a random series of 1's
 	and 0's is output, so the probability of 1 and 0 are both 0.5 */
-double WeightlessNeuron::getFiringStateProbability(byte inPatArr[], int inPatArrLen, int firingState){
+double WeightlessNeuron::getFiringStateProbability(byte inPatArr[], int inPatArrLen, int firingState) const {
 	if(inPatArrLen != (trainingDataLength - 1) )
 		throw SpikeStreamException("Training data length " + QString::number(trainingDataLength-1) + " does not match pattern length " + QString::number(inPatArrLen));
 
-	//Return 0.5 if there is no training data - there will be no matches with the incoming pattern.
-	if(trainingData.size() == 0)
-		return 0.5;
-
-	//Work through all of the training patterns
-	bool firstTime = true;
-	byte currentResponse;
-	unsigned int minDist = hammingThreshold + 1;//Initialise to take account of case where there is no training data
-	byte* trainingPattern;
-	QHash<int, byte> minDistIndxMap;
-	for(int listIndx=0; listIndx<trainingData.size(); ++listIndx){
-		trainingPattern = trainingData[listIndx];
-
-		/* Work through all of the bytes in the input pattern and calculate
-		the total hamming distance between the input pattern and the stored pattern */
-		unsigned int hamDist = 0;
-		for(int i=0; i<inPatArrLen; ++i){
-			hamDist += lookup[inPatArr[i] ^ trainingPattern[i + 1]];
-			if(hamDist > hammingThreshold)
-				break;
-		}
-		currentResponse = trainingPattern[0];
-
-		if(firstTime){
-			minDist = hamDist;
-			minDistIndxMap[listIndx] = currentResponse;
-			firstTime = false;
-		}
-		else{
-			//Set this pattern to be the current minimum
-			if(hamDist < minDist){
-				minDist = hamDist;
-				minDistIndxMap.clear();
-				minDistIndxMap[listIndx] = currentResponse;
-			}
-			//Add the index of this pattern to the map if it has the same Hamming distance
-			else if(hamDist == minDist){
-				minDistIndxMap[listIndx] = currentResponse;
-			}
-		}
-	}
-	//Return 0.5 if there is  no match within the minimum hamming distance
-	if(minDist > hammingThreshold)
-		return 0.5;
+	/* Copy the pattern into words with the same layout as the training matrix. Both hold the bytes in memory order,
+	   so the Hamming distances do not depend on the byte order of the processor */
+	vector<uint64_t> inPatWords(trainingWordLength, 0);
+	memcpy(&inPatWords[0], inPatArr, inPatArrLen);
 
-	//Return 0.5 if there are multiple contradicting matches
-	bool zeroFound = false, oneFound = false;
-	for(QHash<int, byte>::iterator iter = minDistIndxMap.begin(); iter != minDistIndxMap.end(); ++iter){
-		if(iter.value() == 0)
-			zeroFound = true;
-		else if(iter.value() == 1)
-			oneFound = true;
-		else
-			throw SpikeStreamException("Entry in training data not recognized. It should be 1 or 0: " + QString::number(iter.value()));
-
-		//Responses contradict one another
-		if(oneFound && zeroFound)
-			return 0.5;
-	}
-
-	/*One or more best matches have been found with the same output.
-	  Return 1.0 if the output matches the specified firing state or 0.0 otherwise */
-	if(minDistIndxMap.begin().value() == firingState)
-		return 1.0;
-	return 0.0;
+	return getFiringStateProbability(&inPatWords[0], firingState);
 }
 
 
-/*! Returns the probability that the initial pattern led the neuron to be in the specified firing state */
-double WeightlessNeuron::getTransitionProbability(const QList<unsigned int>& neurIDList, const QString& s0Pattern, int firingState){
+/*! Returns the probability that the initial pattern led the neuron to be in the specified firing state.
+	The states of input neurons that are not in the neuron ID list are unknown and every combination of them
+	is equally likely, so the result is the average firing state probability over all completions of the pattern.
+	Instead of evaluating each completion, the unknown inputs are grouped by the bits that the training patterns
+	have at each input. Inputs in the same group affect the Hamming distances in the same way, so only the
+	number of inputs in each group that are set needs to be enumerated, with each count weighted by the number
+	of completions that share it. Combinations that are already beyond the Hamming threshold of every pattern
+	are counted without being enumerated further. The result is equal to evaluating every completion up to
+	floating point rounding. If more than MAX_TRANSITION_COMBINATIONS combinations would have to be worked through,
+	the result is estimated from random completions by sampleTransitionProbability. */
+double WeightlessNeuron::getTransitionProbability(const QList<unsigned int>& neurIDList, const QString& s0Pattern, int firingState) const {
 	//Run checks on the data
 	if(neurIDList.size() != s0Pattern.size())
 		throw SpikeStreamException("Neuron ID list size does not match the size of the s0 pattern.");
@@ -190,51 +267,202 @@ double WeightlessNeuron::getTransitionProbability(const QList<unsigned int>& neu
 	if(missingNeuronCount <0)
 		throw SpikeStreamException("Error in transition probability calculation. Missing neuron count is less than zero.");
 
-	//Array used to select all combinations of missing neurons
-	bool missingNeurSelectionArr[missingNeuronCount];
-
-	//Create array used in the comparison with the stored data in the neuron
-	int inPattArrSize = trainingDataLength - 1;
-	byte inPattArr [inPattArrSize];
-
-	//Variable to sum the output probabilities for each partially random input string
-	double tmpProbOut = 0.0;
-	int randomStringCount = 0;
+	//Every completion has probability 0.5 if there is no training data
+	if(numberOfTrainingPatterns == 0)
+		return 0.5;
 
-	//Work through all firing combinations of the undefined input neurons
-	int numOnes = 0;
-	while(numOnes <= missingNeuronCount){
+	/* Build the known part of the pattern. The mask covers everything apart from the unknown inputs,
+	   including the padding, which is zero in the input patterns */
+	vector<uint64_t> knownMask(trainingWordLength, ~(uint64_t)0);
+	vector<uint64_t> knownValues(trainingWordLength, 0);
+	vector<int> unknownIndexes(numberOfConnections);
+	int numberOfUnknownIndexes = 0;
+	for(int inputIndx=0; inputIndx<numberOfConnections; ++inputIndx){
+		if(firingNeuronIndexMap.contains(inputIndx)){
+			if(firingNeuronIndexMap[inputIndx])
+				setPatternBit(&knownValues[0], inputIndx);
+		}
+		else{
+			clearPatternBit(&knownMask[0], inputIndx);
+			unknownIndexes[numberOfUnknownIndexes] = inputIndx;
+			++numberOfUnknownIndexes;
+		}
+	}
 
-		//Initialize selection array with first combination of 1s and 0s
-		Util::fillSelectionArray(missingNeurSelectionArr, missingNeuronCount, numOnes);
+	//Pattern is complete if every input is known
+	if(numberOfUnknownIndexes == 0)
+		return getFiringStateProbability(&knownValues[0], firingState);
+
+	/* Distance of each training pattern from the known part of the pattern. Patterns that are already
+	   beyond the Hamming threshold can never match, so they are left out */
+	vector<int> candidateIndexes(numberOfTrainingPatterns);
+	vector<int> patternDist(numberOfTrainingPatterns);
+	int numberOfCandidates = 0;
+	for(int patIndx=0; patIndx<numberOfTrainingPatterns; ++patIndx){
+		const uint64_t* trainingPattern = &trainingMatrix[patIndx * trainingWordLength];
+		unsigned int knownDist = 0;
+		for(int i=0; i<trainingWordLength; ++i)
+			knownDist += popCount64((trainingPattern[i] ^ knownValues[i]) & knownMask[i]);
+		if(knownDist <= hammingThreshold){
+			candidateIndexes[numberOfCandidates] = patIndx;
+			patternDist[numberOfCandidates] = knownDist;
+			++numberOfCandidates;
+		}
+	}
+	if(numberOfCandidates == 0)
+		return 0.5;
 
-		bool permutationsComplete = false;
-		while(!permutationsComplete){
-			//Build the input pattern
-			buildInputPattern(inPattArr, inPattArrSize, missingNeurSelectionArr, missingNeuronCount, firingNeuronIndexMap);
+	/* Group the unknown inputs by signature. Bit t of the signature records whether candidate t differs
+	   from the first candidate at that input. Counting the inputs in a group that differ from the first
+	   candidate gives the distance that the group adds to each candidate. */
+	int signatureLength = (numberOfCandidates + 7) / 8;
+	QHash<QByteArray, int> signatureGroupMap;
+	QList<QByteArray> groupSignatures;
+	QList<int> groupSizes;
+	const uint64_t* firstCandidate = &trainingMatrix[candidateIndexes[0] * trainingWordLength];
+	for(int i=0; i<numberOfUnknownIndexes; ++i){
+		bool firstBit = getPatternBit(firstCandidate, unknownIndexes[i]);
+		QByteArray signature(signatureLength, 0);
+		for(int candIndx=1; candIndx<numberOfCandidates; ++candIndx){
+			bool candidateBit = getPatternBit(&trainingMatrix[candidateIndexes[candIndx] * trainingWordLength], unknownIndexes[i]);
+			if(candidateBit != firstBit)
+				signature[candIndx/8] = signature.at(candIndx/8) | (1<<(candIndx%8));
+		}
+		if(signatureGroupMap.contains(signature)){
+			++groupSizes[signatureGroupMap[signature]];
+		}
+		else{
+			signatureGroupMap[signature] = groupSizes.size();
+			groupSignatures.append(signature);
+			groupSizes.append(1);
+		}
+	}
+	int numberOfGroups = groupSizes.size();
+	vector<char> groupBits(numberOfGroups * numberOfCandidates);
+	for(int grpIndx=0; grpIndx<numberOfGroups; ++grpIndx)
+		for(int candIndx=0; candIndx<numberOfCandidates; ++candIndx)
+			groupBits[grpIndx * numberOfCandidates + candIndx] = (groupSignatures[grpIndx].at(candIndx/8) & (1<<(candIndx%8))) != 0;
+
+	/* Binomial coefficients give the number of completions with each count in a group. They overflow a double
+	   for large groups, so they are worked out from log factorials and divided by the number of completions of the group */
+	int maxGroupSize = 0;
+	foreach(int groupSize, groupSizes)
+		if(groupSize > maxGroupSize)
+			maxGroupSize = groupSize;
+	vector<double> logFactorials(maxGroupSize + 1, 0.0);
+	for(int n=2; n<=maxGroupSize; ++n)
+		logFactorials[n] = logFactorials[n-1] + log((double)n);
+	double log2 = log(2.0);
+
+	/* Work through the combinations of counts one group at a time, accumulating the fraction of completions with each outcome.
+	   Each group adds its count to the distance of the candidates that agree with the first candidate at the group and
+	   the rest of its size to the candidates that differ. Distances can only grow as further groups are added, so once every
+	   candidate is beyond the Hamming threshold none of the remaining combinations can match and they are all counted together. */
+	vector<int> groupCounts(numberOfGroups, 0);
+	vector<double> logWeights(numberOfGroups + 1, 0.0);
+	double oneWeight = 0.0, zeroWeight = 0.0, randomWeight = 0.0, totalWeight = 0.0;
+	int numberOfCombinations = 0;
+	int depth = 0;
+	for(int candIndx=0; candIndx<numberOfCandidates; ++candIndx)
+		if(groupBits[candIndx])
+			patternDist[candIndx] += groupSizes[0];
+	while(true){
+		//Give up on an exact result if there are too many combinations to work through
+		++numberOfCombinations;
+		if(numberOfCombinations > MAX_TRANSITION_COMBINATIONS)
+			return sampleTransitionProbability(&knownValues[0], &unknownIndexes[0], numberOfUnknownIndexes, firingState);
+
+		//Fraction of the completions of the groups up to this depth that have these counts
+		int groupSize = groupSizes[depth], groupCount = groupCounts[depth];
+		double logWeight = logWeights[depth] + logFactorials[groupSize] - logFactorials[groupCount] - logFactorials[groupSize - groupCount] - groupSize * log2;
+
+		//Find the outputs of the closest matches within the Hamming threshold
+		int minDist = hammingThreshold;
+		bool matchFound = false, zeroFound = false, oneFound = false;
+		for(int candIndx=0; candIndx<numberOfCandidates; ++candIndx){
+			if(patternDist[candIndx] > minDist)
+				continue;
+			if(patternDist[candIndx] < minDist || !matchFound){
+				minDist = patternDist[candIndx];
+				zeroFound = false;
+				oneFound = false;
+				matchFound = true;
+			}
+			if(trainingOutputs[candidateIndexes[candIndx]])
+				oneFound = true;
+			else
+				zeroFound = true;
+		}
 
-			//Sum the probability that it has the specified output and keep track of the number of calculations
-			tmpProbOut += getFiringStateProbability(inPattArr, inPattArrSize, firingState);
-			++randomStringCount;
+		//Move on to the next group if the outcome still depends on it
+		if(matchFound && depth < numberOfGroups - 1){
+			logWeights[depth + 1] = logWeight;
+			++depth;
+			groupCounts[depth] = 0;
+			const char* candidateBits = &groupBits[depth * numberOfCandidates];
+			for(int candIndx=0; candIndx<numberOfCandidates; ++candIndx)
+				if(candidateBits[candIndx])
+					patternDist[candIndx] += groupSizes[depth];
+			continue;
+		}
 
-			//Change the selection array
-			permutationsComplete = !next_permutation(&missingNeurSelectionArr[0], &missingNeurSelectionArr[missingNeuronCount]);
+		//Every completion of the remaining groups has the same outcome
+		double weight = exp(logWeight);
+		totalWeight += weight;
+		if(!matchFound || (oneFound && zeroFound))
+			randomWeight += weight;
+		else if(oneFound)
+			oneWeight += weight;
+		else
+			zeroWeight += weight;
+
+		//Move on to the next count, returning to earlier groups when all the counts of a group have been used
+		while(depth >= 0 && groupCounts[depth] == groupSizes[depth]){
+			const char* candidateBits = &groupBits[depth * numberOfCandidates];
+			for(int candIndx=0; candIndx<numberOfCandidates; ++candIndx)
+				if(!candidateBits[candIndx])
+					patternDist[candIndx] -= groupSizes[depth];
+			--depth;
 		}
-		++numOnes;
+		if(depth < 0)
+			break;
+		++groupCounts[depth];
+		const char* candidateBits = &groupBits[depth * numberOfCandidates];
+		for(int candIndx=0; candIndx<numberOfCandidates; ++candIndx)
+			patternDist[candIndx] += candidateBits[candIndx] ? -1 : 1;
 	}
 
-	/* Unknown neuron states are random, so each string has the same probability of occurring
-	   So probability of the firing state is the sum of the prob(state occurring) * prob(firing state for that string) */
-	tmpProbOut /= randomStringCount;
-	return tmpProbOut;
+	/* Unknown neuron states are random, so each completion has the same probability of occurring.
+	   Completions with no match or contradictory matches fire with probability 0.5 */
+	double matchWeight = 0.0;
+	if(firingState == 1)
+		matchWeight = oneWeight;
+	else if(firingState == 0)
+		matchWeight = zeroWeight;
+	return (matchWeight + 0.5 * randomWeight) / totalWeight;
+}
+
+
+/*! Returns the output of the training pattern at the specified index */
+byte WeightlessNeuron::getTrainingOutput(int index){
+	if(index < 0 || index >= numberOfTrainingPatterns)
+		throw SpikeStreamException("Training pattern index out of range: " + QString::number(index));
+	return trainingOutputs[index];
+}
+
+
+/*! Returns the input bits of the training pattern at the specified index.
+	The array has the layout of the data passed to addTraining and is trainingDataLength - 1 bytes long. */
+const byte* WeightlessNeuron::getTrainingPattern(int index){
+	if(index < 0 || index >= numberOfTrainingPatterns)
+		throw SpikeStreamException("Training pattern index out of range: " + QString::number(index));
+	return (const byte*)&trainingMatrix[index * trainingWordLength];
 }
 
 
-/*! Clears the training of the neuron */
+/*! Clears the training of the neuron. The memory of the training matrix is kept for reuse. */
 void WeightlessNeuron::resetTraining(){
-	foreach(byte* array, trainingData)
-		delete array;
-	trainingData.clear();
+	numberOfTrainingPatterns = 0;
 }
 
 
@@ -244,41 +472,96 @@ void WeightlessNeuron::setGeneralization(double generalization){
 }
 
 
+/*! Stores the training data in memory supplied by the calling class, which remains responsible for deleting it.
+	The training matrix must have space for capacity * trainingWordLength words and the outputs array space
+	for capacity bytes. Existing training patterns are copied across. If more than capacity patterns are
+	added later, the training data is moved back into memory owned by the neuron. */
+void WeightlessNeuron::setTrainingStorage(uint64_t* trainingMatrix, byte* trainingOutputs, int capacity){
+	if(capacity < numberOfTrainingPatterns)
+		throw SpikeStreamException("Training storage capacity " + QString::number(capacity) + " is less than the number of training patterns " + QString::number(numberOfTrainingPatterns));
+
+	//Copy across the existing training data
+	if(numberOfTrainingPatterns > 0){
+		memcpy(trainingMatrix, this->trainingMatrix, numberOfTrainingPatterns * trainingWordLength * sizeof(uint64_t));
+		memcpy(trainingOutputs, this->trainingOutputs, numberOfTrainingPatterns);
+	}
+
+	//Delete the previous storage if it belongs to this neuron
+	if(ownsTrainingStorage && this->trainingMatrix != NULL){
+		delete [] this->trainingMatrix;
+		delete [] this->trainingOutputs;
+	}
+
+	this->trainingMatrix = trainingMatrix;
+	this->trainingOutputs = trainingOutputs;
+	trainingCapacity = capacity;
+	ownsTrainingStorage = false;
+}
+
+
 /*-------------------------------------------------------------*/
 /*-------                 PRIVATE METHODS                ------*/
 /*-------------------------------------------------------------*/
 
-/*! Constructs a byte array that can be used to compare with the trained arrays stored
-	in the neuron */
-void WeightlessNeuron::buildInputPattern(byte inPatArr[], int inPatArrSize, bool selArr[], int selArrSize, QHash<unsigned int, byte>& firingNeuronIndexMap){
-	//Clear inPatArr
-	for(int i=0; i<inPatArrSize; ++i)
-		inPatArr[i] = 0;
-
-	/* Work through each connection and either populate the input array with the permuted random selection
-	or with the actual firing state of the neuron, which is stored in the firingNeuronIndexMap */
-	int selIndx = 0;
-	for(int inputIndx=0; inputIndx < numberOfConnections; ++inputIndx){
-		if(inputIndx / 8 > inPatArrSize)
-			throw SpikeStreamException("Input pattern array index out of range.");
+/*! Compares a pattern stored in the same word layout as the training matrix with
+	the stored patterns and returns the probability of the specified output.
+	Only the outputs of the closest matches are tracked, so contradictory matches are
+	detected with two flags. */
+double WeightlessNeuron::getFiringStateProbability(const uint64_t inPatWords[], int firingState) const {
+	//Return 0.5 if there is no training data - there will be no matches with the incoming pattern.
+	if(numberOfTrainingPatterns == 0)
+		return 0.5;
 
-		if(firingNeuronIndexMap.contains(inputIndx)){
-			//Set bit in the byte array to 1 or 0 depending on whether it is 1 or 0 in the map of relevant neuron firing states
-			if(firingNeuronIndexMap[inputIndx]){
-				inPatArr[ inputIndx/8 ] |= 1<<(inputIndx % 8);
-			}
+	/* Find the closest patterns within the Hamming threshold. Distance calculations stop once they
+	   exceed the current minimum because those patterns cannot affect the result */
+	unsigned int minDist = hammingThreshold;
+	bool matchFound = false, zeroFound = false, oneFound = false;
+	const uint64_t* trainingPattern = trainingMatrix;
+	for(int patIndx=0; patIndx<numberOfTrainingPatterns; ++patIndx, trainingPattern += trainingWordLength){
+		unsigned int hamDist = hammingDistance(inPatWords, trainingPattern, trainingWordLength, minDist);
+		if(hamDist > minDist)
+			continue;
+
+		//Closer match resets the outputs that have been found
+		if(hamDist < minDist || !matchFound){
+			minDist = hamDist;
+			zeroFound = false;
+			oneFound = false;
+			matchFound = true;
 		}
-		else{
-			if(selIndx >= selArrSize)
-				throw SpikeStreamException("Selection index out of range. Actual=" + QString::number(selIndx) + "; maximum=" + QString::number(selArrSize));
+		if(trainingOutputs[patIndx])
+			oneFound = true;
+		else
+			zeroFound = true;
+	}
 
-			//Set bit in the byte array to 1 if it is set to 1 in selection array
-			if(selArr[selIndx]){
-				inPatArr[ inputIndx/8 ] |= 1<<(inputIndx % 8);
-			}
-			++selIndx;
-		}
+	//Return 0.5 if there is no match within the hamming threshold or if there are multiple contradicting matches
+	if(!matchFound || (oneFound && zeroFound))
+		return 0.5;
+
+	/*One or more best matches have been found with the same output.
+	  Return 1.0 if the output matches the specified firing state or 0.0 otherwise */
+	if( (oneFound ? 1 : 0) == firingState)
+		return 1.0;
+	return 0.0;
+}
+
+
+/*! Estimates the transition probability by averaging the firing state probability over random completions of the known
+	part of the pattern. The random numbers are seeded with the neuron's ID, so the same estimate is returned each time. */
+double WeightlessNeuron::sampleTransitionProbability(const uint64_t knownValues[], const int unknownIndexes[], int numberOfUnknownIndexes, int firingState) const {
+	RandomStream randomStream(id);
+	vector<uint64_t> inPatWords(trainingWordLength);
+	double probabilitySum = 0.0;
+	for(int sampleNum=0; sampleNum<NUMBER_OF_TRANSITION_SAMPLES; ++sampleNum){
+		for(int i=0; i<trainingWordLength; ++i)
+			inPatWords[i] = knownValues[i];
+		for(int i=0; i<numberOfUnknownIndexes; ++i)
+			if(randomStream.nextUInt(2))
+				setPatternBit(&inPatWords[0], unknownIndexes[i]);
+		probabilitySum += getFiringStateProbability(&inPatWords[0], firingState);
 	}
+	return probabilitySum / NUMBER_OF_TRANSITION_SAMPLES;
 }
 
 
@@ -291,21 +574,11 @@ void WeightlessNeuron::printConnectionMap(){
 }
 
 
-/*! Prints out array used to select combinations of undefined neurons */
-void WeightlessNeuron::printSelectionArray(bool selArr[], int arrSize){
-	for(int i=0; i<arrSize; ++i){
-		if(selArr[i])
-			cout<<"1";
-		else
-			cout<<"0";
-	}
-	cout<<endl;
-}
-
-
 /*! Prints out the training of the neuron. */
 void WeightlessNeuron::printTraining(){
-	foreach(byte* byteArr, trainingData)
-		Util::printByteArray(byteArr, trainingDataLength);
+	for(int i=0; i<numberOfTrainingPatterns; ++i){
+		cout<<"Output: "<<(int)trainingOutputs[i]<<"; ";
+		Util::printByteArray((byte*)&trainingMatrix[i * trainingWordLength], trainingDataLength - 1);
+	}
 }
 
@@ -839,10 +839,9 @@ void TestNetworkDao::testGetWeightlessNeuron(){
 		QCOMPARE(conMap.size(), (int)2);
 		QCOMPARE(conMap[testNeurIDList[0]][0], (unsigned int)0);
 		QCOMPARE(conMap[testNeurIDList[4]][0], (unsigned int)1);
-		QList<byte*> trainingDataList = neuron->getTrainingData();
-		QCOMPARE(trainingDataList.size(), (int)2);
-		QVERIFY( bitsEqual(trainingDataList[0], "10000000", 1) );
-		QVERIFY( bitsEqual(trainingDataList[1], "11000000", 1) );
+		QCOMPARE(neuron->getNumberOfTrainingPatterns(), (int)2);
+		QVERIFY( bitsEqual(neuron, 0, "10000000", 1) );
+		QVERIFY( bitsEqual(neuron, 1, "11000000", 1) );
 		delete neuron;
 
 		//Check a second neuron
@@ -851,10 +850,9 @@ void TestNetworkDao::testGetWeightlessNeuron(){
 		QCOMPARE(conMap.size(), (int)2);
 		QCOMPARE(conMap[testNeurIDList[0]][0], (unsigned int)0);
 		QCOMPARE(conMap[testNeurIDList[3]][0], (unsigned int)1);
-		trainingDataList = neuron->getTrainingData();
-		QCOMPARE(trainingDataList.size(), (int)2);
-		QVERIFY( bitsEqual(trainingDataList[0], "00000000", 0) );
-		QVERIFY( bitsEqual(trainingDataList[1], "11000000", 0) );
+		QCOMPARE(neuron->getNumberOfTrainingPatterns(), (int)2);
+		QVERIFY( bitsEqual(neuron, 0, "00000000", 0) );
+		QVERIFY( bitsEqual(neuron, 1, "11000000", 0) );
 		delete neuron;
 	}
 	catch(SpikeStreamException ex){
@@ -866,6 +864,52 @@ void TestNetworkDao::testGetWeightlessNeuron(){
 }
 
 
+void TestNetworkDao::testGetWeightlessNetworkSnapshot(){
+	//Add test networks - only the neurons in the first should be loaded
+	addWeightlessTestNetwork1();
+	addTestNetwork2();
+
+	//Invoke method being tested
+	NetworkDao networkDao(networkDBInfo);
+	try{
+		WeightlessNetworkSnapshot* snapshot = networkDao.getWeightlessNetworkSnapshot(testNetID);
+		QCOMPARE(snapshot->getNetworkID(), testNetID);
+		QCOMPARE(snapshot->getWeightlessNeuronMap().size(), testNeurIDList.size());
+		QCOMPARE(snapshot->getNumberOfTrainingPatterns(), (int)6);
+
+		//Neurons should match those loaded individually
+		WeightlessNeuron* neuron = snapshot->getWeightlessNeuron(testNeurIDList[1]);
+		QHash<unsigned int, QList<unsigned int> > conMap = neuron->getConnectionMap();
+		QCOMPARE(conMap.size(), (int)2);
+		QCOMPARE(conMap[testNeurIDList[0]][0], (unsigned int)0);
+		QCOMPARE(conMap[testNeurIDList[4]][0], (unsigned int)1);
+		QCOMPARE(neuron->getNumberOfTrainingPatterns(), (int)2);
+		QVERIFY( bitsEqual(neuron, 0, "10000000", 1) );
+		QVERIFY( bitsEqual(neuron, 1, "11000000", 1) );
+
+		neuron = snapshot->getWeightlessNeuron(testNeurIDList[2]);
+		conMap = neuron->getConnectionMap();
+		QCOMPARE(conMap.size(), (int)2);
+		QCOMPARE(conMap[testNeurIDList[0]][0], (unsigned int)0);
+		QCOMPARE(conMap[testNeurIDList[3]][0], (unsigned int)1);
+		QCOMPARE(neuron->getNumberOfTrainingPatterns(), (int)2);
+		QVERIFY( bitsEqual(neuron, 0, "00000000", 0) );
+		QVERIFY( bitsEqual(neuron, 1, "11000000", 0) );
+
+		//Neuron without training patterns
+		QCOMPARE(snapshot->getWeightlessNeuron(testNeurIDList[0])->getNumberOfTrainingPatterns(), (int)0);
+
+		delete snapshot;
+	}
+	catch(SpikeStreamException ex){
+		QFAIL(ex.getMessage().toAscii());
+	}
+	catch(...){
+		QFAIL("Unrecognized exception thrown.");
+	}
+}
+
+
 void TestNetworkDao::testGetNeuronGroupID(){
 	//Add test networks - only want to select neurons from the second
 	addTestNetwork1();
@@ -1149,14 +1193,15 @@ void TestNetworkDao::testSetWeight(){
 /*-----              PRIVATE METHODS                   -----*/
 /*----------------------------------------------------------*/
 
-bool TestNetworkDao::bitsEqual(const unsigned char* byteArr, const QString bitPattStr, int output){
-	if(byteArr[0] != output)
+bool TestNetworkDao::bitsEqual(WeightlessNeuron* neuron, int patternIndex, const QString bitPattStr, int output){
+	if(neuron->getTrainingOutput(patternIndex) != output)
 		return false;
 
+	const unsigned char* byteArr = neuron->getTrainingPattern(patternIndex);
 	for(int i=0; i<bitPattStr.length(); ++i){
-		if(bitPattStr[i] == '1' && (byteArr[1 + i/8] & ( 1<<(i % 8) )))//1 is equal
+		if(bitPattStr[i] == '1' && (byteArr[i/8] & ( 1<<(i % 8) )))//1 is equal
 			;//do nothing
-		else if(bitPattStr[i] == '0' && !(byteArr[1 + i/8] & ( 1<<(i % 8) )))//0 is equal
+		else if(bitPattStr[i] == '0' && !(byteArr[i/8] & ( 1<<(i % 8) )))//0 is equal
 			;//Do nothing
 		else
 			return false;//String and byte array do not match
@@ -44,6 +44,7 @@ class TestNetworkDao : public TestDao {
 		void testGetSynapseType();
 		void testGetSynapseTypes();
 		void testGetWeightlessNeuron();
+		void testGetWeightlessNetworkSnapshot();
 		void testIsWeightlessNetwork();
 		void testIsWeightlessNeuron();
 		void testSetConnectionGroupProperties();
@@ -54,7 +55,7 @@ class TestNetworkDao : public TestDao {
 		void testSetWeight();
 
 	private:
-		bool bitsEqual(const unsigned char* byteArr, const QString pattern, int output);
+		bool bitsEqual(WeightlessNeuron* neuron, int patternIndex, const QString pattern, int output);
 };
 
 #endif//TESTNETWORKDAO_H
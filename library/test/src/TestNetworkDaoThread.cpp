@@ -27,24 +27,20 @@ void TestNetworkDaoThread::testAddConnectionGroup(){
 			and we need neuron groups because of foreign key constraints */
 		//Add from neuron group
 		NeuronGroup fromGrp( NeuronGroupInfo(0, "fromNeuronGroup1Name", "fromNeuronGroup1Desc", QHash<QString, double>(), networkDao.getNeuronType(1)));
-		NeuronMap* neurMap = new NeuronMap();
-		(*neurMap)[1] = new Neuron(0, 0, 0);
-		(*neurMap)[2] = new Neuron(0, 1, 0);
-		(*neurMap)[3] = new Neuron(1, 0, 0);
-		(*neurMap)[4] = new Neuron(1, 1, 0);
-		fromGrp.setNeuronMap(neurMap);
+		fromGrp.addNeuron(1, 0, 0, 0);
+		fromGrp.addNeuron(2, 0, 1, 0);
+		fromGrp.addNeuron(3, 1, 0, 0);
+		fromGrp.addNeuron(4, 1, 1, 0);
 		NetworkDaoThread netDaoThread(networkDBInfo);
 		netDaoThread.prepareAddNeuronGroup(netInfo.getID(), &fromGrp);
 		runThread(netDaoThread);
 
 		//Add to neuron group
 		NeuronGroup toGrp( NeuronGroupInfo(0, "toNeuronGroup1Name", "toNeuronGroup1Desc", QHash<QString, double>(), networkDao.getNeuronType(1)) );
-		neurMap = new NeuronMap();
-		(*neurMap)[1] = new Neuron(0, 0, 10);
-		(*neurMap)[2] = new Neuron(0, 3, 10);
-		(*neurMap)[3] = new Neuron(2, 0, 10);
-		(*neurMap)[4] = new Neuron(1, 7, 10);
-		toGrp.setNeuronMap(neurMap);
+		toGrp.addNeuron(1, 0, 0, 10);
+		toGrp.addNeuron(2, 0, 3, 10);
+		toGrp.addNeuron(3, 2, 0, 10);
+		toGrp.addNeuron(4, 1, 7, 10);
 		netDaoThread.prepareAddNeuronGroup(netInfo.getID(), &toGrp);
 		runThread(netDaoThread);
 
@@ -118,11 +114,10 @@ void TestNetworkDaoThread::testAddNeuronGroup(){
 		//Build the neuron group that is to be added
 		QHash<QString, double> paramMap;
 		NeuronGroup neurGrp(NeuronGroupInfo(0, "testNeuronGroup1Name", "testNeuronGroup1Desc", paramMap, neurType));
-		NeuronMap* neurMap = neurGrp.getNeuronMap();
-		(*neurMap)[1] = new Neuron(0, 0, 0);
-		(*neurMap)[2] = new Neuron(0, 1, 0);
-		(*neurMap)[3] = new Neuron(1, 0, 0);
-		(*neurMap)[4] = new Neuron(1, 1, 1);
+		neurGrp.addNeuron(1, 0, 0, 0);
+		neurGrp.addNeuron(2, 0, 1, 0);
+		neurGrp.addNeuron(3, 1, 0, 0);
+		neurGrp.addNeuron(4, 1, 1, 1);
 
 		//Add the neuron group
 		NetworkDaoThread netDaoThread(networkDBInfo);
@@ -358,16 +353,14 @@ void TestNetworkDaoThread::testLoadNeurons(){
 		QCOMPARE(neurGrp2.size(), (int)2);
 
 		//Check the ids and location in neuron group 1 are correct
-		QHash<unsigned int, Neuron*>* neurGrpMap = neurGrp1.getNeuronMap();
-		QCOMPARE((*neurGrpMap)[ testNeurIDList[0] ]->getXPos(), -1.0f);
-		QCOMPARE((*neurGrpMap)[ testNeurIDList[0] ]->getZPos(), -6.0f);
-		QCOMPARE((*neurGrpMap)[ testNeurIDList[2] ]->getYPos(), -4.0f);
+		QCOMPARE(neurGrp1.getNeuronLocation(testNeurIDList[0]).getXPos(), -1.0f);
+		QCOMPARE(neurGrp1.getNeuronLocation(testNeurIDList[0]).getZPos(), -6.0f);
+		QCOMPARE(neurGrp1.getNeuronLocation(testNeurIDList[2]).getYPos(), -4.0f);
 
 		//Check the ids and location in neuron group 2 are correct
-		neurGrpMap = neurGrp2.getNeuronMap();
-		QCOMPARE((*neurGrpMap)[ testNeurIDList[3] ]->getXPos(), 0.0f);
-		QCOMPARE((*neurGrpMap)[ testNeurIDList[3] ]->getZPos(), 10.0f);
-		QCOMPARE((*neurGrpMap)[ testNeurIDList[4] ]->getYPos(), -7.0f);
+		QCOMPARE(neurGrp2.getNeuronLocation(testNeurIDList[3]).getXPos(), 0.0f);
+		QCOMPARE(neurGrp2.getNeuronLocation(testNeurIDList[3]).getZPos(), 10.0f);
+		QCOMPARE(neurGrp2.getNeuronLocation(testNeurIDList[4]).getYPos(), -7.0f);
 	}
 	catch(SpikeStreamException ex){
 		QFAIL(ex.getMessage().toAscii());
@@ -20,8 +20,7 @@ void TestNeuronGroup::testAddLayer(){
 
     neurGrp.addLayer(13, 15, 2, 3, 4);
 
-    NeuronMap* neuronMap = neurGrp.getNeuronMap();
-    QCOMPARE(neuronMap->size(), (int)197);
+    QCOMPARE(neurGrp.size(), (int)197);
 
 	//Group should have a neuron at location (2, 3, 4);
 	QVERIFY(neurGrp.getNeuronIDAtLocation(Point3D(2.0f, 3.0f, 4.0f)) != 0);
@@ -39,8 +38,7 @@ void TestNeuronGroup::testAddNeuron(){
     neurGrp.addNeuron(2334, 2745, 1245);
 
     //Check that map contains three matching neurons
-    NeuronMap* neuronMap = neurGrp.getNeuronMap();
-    QCOMPARE(neuronMap->size(), (int)3);
+    QCOMPARE(neurGrp.size(), (int)3);
 
 	//Check neurons exist at correct locations
 	QVERIFY(neurGrp.getNeuronIDAtLocation(Point3D(23.0f, 27.0f, 12.0f)) != 0);
@@ -75,29 +73,29 @@ void TestNeuronGroup::testGetPositionKey(){
 void TestNeuronGroup::testPositionIterator(){
 	NeuronType neurType(2, "neur type description", "neur type paramTableName", "");
 	NeuronGroup neurGrp( NeuronGroupInfo(0, "no name", "no description", QHash<QString, double>(), neurType) );
-	Neuron* neur5 = neurGrp.addNeuron(23, 27, 14);//Should be 5th
-	Neuron* neur3 = neurGrp.addNeuron(23, 27, 12);//Should be 3rd
-	Neuron* neur2 = neurGrp.addNeuron(23, 26, 13);//Should be 2nd
-	Neuron* neur4 = neurGrp.addNeuron(23, 27, 13);//Should be 4th
-	Neuron* neur1 = neurGrp.addNeuron(22, 26, 14);//Should be 1st
+	int neur5 = neurGrp.addNeuron(23, 27, 14);//Should be 5th
+	int neur3 = neurGrp.addNeuron(23, 27, 12);//Should be 3rd
+	int neur2 = neurGrp.addNeuron(23, 26, 13);//Should be 2nd
+	int neur4 = neurGrp.addNeuron(23, 27, 13);//Should be 4th
+	int neur1 = neurGrp.addNeuron(22, 26, 14);//Should be 1st
 
 	int counter = 1;
 	for(NeuronPositionIterator iter = neurGrp.positionBegin(); iter != neurGrp.positionEnd(); ++iter){
 		switch(counter){
 			case 1:
-				QCOMPARE(iter.value()->getID(), neur1->getID());
+				QCOMPARE(iter.value()->getID(), neurGrp.getNeuronID(neur1));
 			break;
 			case 2:
-				QCOMPARE(iter.value()->getID(), neur2->getID());
+				QCOMPARE(iter.value()->getID(), neurGrp.getNeuronID(neur2));
 			break;
 			case 3:
-				QCOMPARE(iter.value()->getID(), neur3->getID());
+				QCOMPARE(iter.value()->getID(), neurGrp.getNeuronID(neur3));
 			break;
 			case 4:
-				QCOMPARE(iter.value()->getID(), neur4->getID());
+				QCOMPARE(iter.value()->getID(), neurGrp.getNeuronID(neur4));
 			break;
 			case 5:
-				QCOMPARE(iter.value()->getID(), neur5->getID());
+				QCOMPARE(iter.value()->getID(), neurGrp.getNeuronID(neur5));
 			break;
 			default: QFAIL("Iterator out of range");
 		}
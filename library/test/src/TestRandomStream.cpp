@@ -0,0 +1,96 @@
+//SpikeStream includes
+#include "TestRandomStream.h"
+#include "RandomStream.h"
+#include "SpikeStreamException.h"
+using namespace spikestream;
+
+
+void TestRandomStream::testGetNumber(){
+	RandomStream stream(45);
+	uint64_t thirdNumber = stream.getNumber(2);
+	QCOMPARE(stream.getPosition(), (uint64_t)0);
+
+	//Numbers read at random should be the same as the numbers read in order
+	QCOMPARE(stream.nextNumber(), stream.getNumber(0));
+	QCOMPARE(stream.nextNumber(), stream.getNumber(1));
+	QCOMPARE(stream.nextNumber(), thirdNumber);
+	QCOMPARE(stream.getPosition(), (uint64_t)3);
+}
+
+
+void TestRandomStream::testNextDouble(){
+	RandomStream stream(123);
+	double total = 0.0;
+	for(int i=0; i<10000; ++i){
+		double randomDouble = stream.nextDouble();
+		QVERIFY(randomDouble >= 0.0);
+		QVERIFY(randomDouble < 1.0);
+		total += randomDouble;
+	}
+
+	//Mean should be close to 0.5
+	QVERIFY(total / 10000.0 > 0.48);
+	QVERIFY(total / 10000.0 < 0.52);
+}
+
+
+void TestRandomStream::testNextUInt(){
+	RandomStream stream(123);
+	int countArray[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+	for(int i=0; i<10000; ++i){
+		unsigned int randomUInt = stream.nextUInt(10);
+		QVERIFY(randomUInt < 10);
+		++countArray[randomUInt];
+	}
+
+	//Every value should be returned about the same number of times
+	for(int i=0; i<10; ++i){
+		QVERIFY(countArray[i] > 850);
+		QVERIFY(countArray[i] < 1150);
+	}
+
+	//Zero range should throw an exception
+	try{
+		stream.nextUInt(0);
+		QFAIL("Exception should have been thrown for zero range.");
+	}
+	catch(SpikeStreamException&){
+	}
+}
+
+
+void TestRandomStream::testSeed(){
+	//Streams with the same seed should produce the same numbers
+	RandomStream stream1(45), stream2(45), stream3(46);
+	bool streamsDiffer = false;
+	for(int i=0; i<100; ++i){
+		uint64_t number = stream1.nextNumber();
+		QCOMPARE(stream2.nextNumber(), number);
+		if(stream3.nextNumber() != number)
+			streamsDiffer = true;
+	}
+	QVERIFY(streamsDiffer);
+}
+
+
+void TestRandomStream::testSplit(){
+	RandomStream parentStream(45);
+
+	//Child streams should not depend on the position of the parent or on the order in which they are split
+	RandomStream childStream2 = parentStream.split(2);
+	parentStream.nextNumber();
+	RandomStream childStream1 = parentStream.split(1);
+	RandomStream childStream1Copy = RandomStream(45).split(1);
+	for(int i=0; i<100; ++i)
+		QCOMPARE(childStream1.nextNumber(), childStream1Copy.nextNumber());
+
+	//Child streams should differ from each other and from the parent
+	int numberOfMatches = 0;
+	for(int i=0; i<100; ++i){
+		uint64_t number = childStream2.getNumber(i);
+		if(number == childStream1.getNumber(i) || number == parentStream.getNumber(i))
+			++numberOfMatches;
+	}
+	QCOMPARE(numberOfMatches, 0);
+}
+
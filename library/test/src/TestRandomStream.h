@@ -0,0 +1,20 @@
+#ifndef TESTRANDOMSTREAM_H
+#define TESTRANDOMSTREAM_H
+
+//Qt includes
+#include <QTest>
+
+class TestRandomStream : public QObject {
+	Q_OBJECT
+
+	private slots:
+		void testGetNumber();
+		void testNextDouble();
+		void testNextUInt();
+		void testSeed();
+		void testSplit();
+
+};
+
+
+#endif//TESTRANDOMSTREAM_H
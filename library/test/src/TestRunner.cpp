@@ -10,6 +10,7 @@
 #include "TestNeuronGroup.h"
 #include "TestNetworkDao.h"
 #include "TestNetworkDaoThread.h"
+#include "TestRandomStream.h"
 #include "TestXMLParameterParser.h"
 #include "TestUtil.h"
 #include "TestWeightlessNeuron.h"
@@ -57,6 +58,9 @@ void TestRunner::runTests(){
     TestAnalysisDao testAnalysisDao;
     QTest::qExec(&testAnalysisDao);
 
+    TestRandomStream testRandomStream;
+    QTest::qExec(&testRandomStream);
+
     TestUtil testUtil;
     QTest::qExec(&testUtil);
 
@@ -3,6 +3,7 @@
 #include "Util.h"
 using namespace spikestream;
 
+#include <cmath>
 #include <iostream>
 using namespace std;
 
@@ -61,10 +62,9 @@ void TestWeightlessNeuron::testAddTraining(){
     addTraining(tstNeuron, "1111111111", 0);
 
     //Check that training data is present and correct
-    QList<byte*> trainingData = tstNeuron.getTrainingData();
-    QCOMPARE(trainingData.size(), 2);
-    QVERIFY(bitsEqual(trainingData[0], "1010101010", 1));
-    QVERIFY(bitsEqual(trainingData[1], "1111111111", 0));
+    QCOMPARE(tstNeuron.getNumberOfTrainingPatterns(), 2);
+    QVERIFY(bitsEqual(tstNeuron, 0, "1010101010", 1));
+    QVERIFY(bitsEqual(tstNeuron, 1, "1111111111", 0));
 }
 
 
@@ -229,6 +229,148 @@ void TestWeightlessNeuron::testGetTransitionProbability(){
 }
 
 
+void TestWeightlessNeuron::testGetTransitionProbabilityLargeGroup(){
+    //Build a neuron with 1200 connections trained on a single pattern, so all of the unknown inputs are in one group
+    QHash<unsigned int, QList<unsigned int> > connMap;
+    for(int i=0; i<1200; ++i)
+	connMap[i+1].append(i);
+    WeightlessNeuron tstNeuron(connMap, 0);
+    addTraining(tstNeuron, QString(1200, '0'), 1);
+    tstNeuron.setGeneralization(0.5);
+
+    //None of the neurons in the list are connected, so every input is unknown
+    QList<unsigned int> neurIDList;
+    neurIDList.append(5000);
+    try{
+	//Pattern matches when at most 600 of the 1200 inputs are set, otherwise the output is random
+	double oneProbability = tstNeuron.getTransitionProbability(neurIDList, "0", 1);
+	double zeroProbability = tstNeuron.getTransitionProbability(neurIDList, "0", 0);
+	QVERIFY(qAbs(oneProbability - 0.7557570363171506) < 1e-9);
+	QVERIFY(qAbs(zeroProbability - 0.24424296368284934) < 1e-9);
+    }
+    catch(SpikeStreamException& ex){
+	QFAIL(ex.getMessage().toAscii());
+    }
+}
+
+
+void TestWeightlessNeuron::testGetTransitionProbabilityManyGroups(){
+    /* Neurons are trained on the patterns with a single bit set, so every unknown input has a different signature.
+       A pattern with k inputs set is k - 1 from the training patterns that share a set bit and k + 1 from the rest.
+       With 32 inputs and a Hamming threshold of 2, patterns with up to 3 inputs set match and fire, the rest fire at random.
+       Combinations with 4 or more inputs set are beyond the threshold and are not enumerated further, so the result is exact.
+       With 64 inputs and a Hamming threshold of 32 there are too many combinations to work through and the result is estimated. */
+    int numConsArr[] = {32, 64};
+    double generalizationArr[] = {0.95, 0.5};
+    unsigned int thresholdArr[] = {2, 32};
+    double toleranceArr[] = {1e-12, 0.02};
+    QList<unsigned int> neurIDList;
+    neurIDList.append(5000);
+    try{
+	for(int tstNum=0; tstNum<2; ++tstNum){
+	    int numCons = numConsArr[tstNum];
+	    QHash<unsigned int, QList<unsigned int> > connMap;
+	    for(int i=0; i<numCons; ++i)
+		connMap[i+1].append(i);
+	    WeightlessNeuron tstNeuron(connMap, 0);
+	    for(int i=0; i<numCons; ++i){
+		QString trainingPattern(numCons, '0');
+		trainingPattern[i] = '1';
+		addTraining(tstNeuron, trainingPattern, 1);
+	    }
+	    tstNeuron.setGeneralization(generalizationArr[tstNum]);
+	    QCOMPARE(tstNeuron.getHammingThreshold(), thresholdArr[tstNum]);
+
+	    //Fraction of the completions with at most threshold + 1 inputs set
+	    double matchFraction = 0.0, binomialCoefficient = 1.0;
+	    for(unsigned int k=0; k<=thresholdArr[tstNum] + 1; ++k){
+		matchFraction += binomialCoefficient / pow(2.0, numCons);
+		binomialCoefficient = binomialCoefficient * (numCons - k) / (k + 1);
+	    }
+
+	    double oneProbability = tstNeuron.getTransitionProbability(neurIDList, "0", 1);
+	    QVERIFY(qAbs(oneProbability - (matchFraction + 0.5 * (1.0 - matchFraction))) < toleranceArr[tstNum]);
+	    QCOMPARE(tstNeuron.getTransitionProbability(neurIDList, "0", 1), oneProbability);
+	}
+    }
+    catch(SpikeStreamException& ex){
+	QFAIL(ex.getMessage().toAscii());
+    }
+}
+
+
+void TestWeightlessNeuron::testGetTransitionProbabilityMatchesEnumeration(){
+    Util::seedRandom(23);
+    try{
+	for(int tstNum=0; tstNum<200; ++tstNum){
+	    //Build a neuron with random connections, some of which come from the same neuron
+	    int numCons = Util::getRandom(1, 15);
+	    int numInputNeurons = Util::getRandom(1, numCons + 1);
+	    QHash<unsigned int, QList<unsigned int> > connMap;
+	    for(int i=0; i<numCons; ++i)
+		connMap[Util::getRandom(0, numInputNeurons) + 10].append(i);
+	    WeightlessNeuron tstNeuron(connMap, 0);
+	    tstNeuron.setGeneralization(Util::getRandomDouble(0.0, 1.0));
+
+	    //Add random training data
+	    int numPatterns = Util::getRandom(0, 8);
+	    for(int i=0; i<numPatterns; ++i){
+		QString trainingPattern;
+		for(int j=0; j<numCons; ++j)
+		    trainingPattern += Util::getRandom(0, 2) ? "1" : "0";
+		addTraining(tstNeuron, trainingPattern, Util::getRandom(0, 2));
+	    }
+
+	    //Select some of the input neurons and give them a state
+	    QList<unsigned int> neurIDList;
+	    QString s0Patt;
+	    for(int i=0; i<numInputNeurons; ++i){
+		if(Util::getRandom(0, 2)){
+		    neurIDList.append(i + 10);
+		    s0Patt += Util::getRandom(0, 2) ? "1" : "0";
+		}
+	    }
+
+	    //Work out the state of each input and which inputs are unknown
+	    QList<int> unknownIndexes;
+	    QString knownPatt;
+	    for(int i=0; i<numCons; ++i){
+		knownPatt += "0";
+		unknownIndexes.append(i);
+	    }
+	    for(int i=0; i<neurIDList.size(); ++i){
+		foreach(unsigned int pattIndx, connMap[neurIDList[i]]){
+		    knownPatt[pattIndx] = s0Patt[i];
+		    unknownIndexes.removeAll(pattIndx);
+		}
+	    }
+
+	    //Average the firing state probability over every completion of the unknown inputs
+	    double enumProb = 0.0;
+	    int numCompletions = 1<<unknownIndexes.size();
+	    for(int completion=0; completion<numCompletions; ++completion){
+		QString fullPatt = knownPatt;
+		for(int i=0; i<unknownIndexes.size(); ++i)
+		    fullPatt[unknownIndexes[i]] = (completion & 1<<i) ? '1' : '0';
+		byte* inPattern;
+		int arrLen;
+		fillByteArray(inPattern, arrLen, fullPatt);
+		enumProb += tstNeuron.getFiringStateProbability(inPattern, arrLen, 1);
+		delete [] inPattern;
+	    }
+	    enumProb /= numCompletions;
+
+	    //Weights are calculated in log space, so the results agree up to rounding
+QVERIFY(qAbs(tstNeuron.getTransitionProbability(neurIDList, s0Patt, 1) - enumProb) < 1e-12);
+	    QVERIFY(qAbs(tstNeuron.getTransitionProbability(neurIDList, s0Patt, 0) - (1.0 - enumProb)) < 1e-12);
+	}
+    }
+    catch(SpikeStreamException& ex){
+	QFAIL(ex.getMessage().toAscii());
+    }
+}
+
+
 void TestWeightlessNeuron::testSetGeneralization(){
     /* Create connection map and use it to create neuron.
 	neurons with ids 10 ...19 are in their respective positions in the connection map */
@@ -244,6 +386,38 @@ void TestWeightlessNeuron::testSetGeneralization(){
 }
 
 
+void TestWeightlessNeuron::testSetTrainingStorage(){
+    QHash<unsigned int, QList<unsigned int> > connMap;
+    for(int i=0; i<10; ++i){
+	connMap[i+10].append(i);
+    }
+    WeightlessNeuron tstNeuron(connMap, 0);
+
+    //Existing training should be copied into the supplied storage
+    addTraining(tstNeuron, "1010101010", 1);
+    uint64_t* trainingMatrix = new uint64_t[2 * tstNeuron.getTrainingWordLength()];
+    unsigned char* trainingOutputs = new unsigned char[2];
+    tstNeuron.setTrainingStorage(trainingMatrix, trainingOutputs, 2);
+    addTraining(tstNeuron, "1111111111", 0);
+    QCOMPARE(tstNeuron.getNumberOfTrainingPatterns(), 2);
+    QVERIFY(tstNeuron.getTrainingPattern(0) == (const unsigned char*)trainingMatrix);
+    QVERIFY(bitsEqual(tstNeuron, 0, "1010101010", 1));
+    QVERIFY(bitsEqual(tstNeuron, 1, "1111111111", 0));
+
+    //Adding more patterns than the storage can hold should move the training back into the neuron
+    addTraining(tstNeuron, "0000011111", 1);
+    QCOMPARE(tstNeuron.getNumberOfTrainingPatterns(), 3);
+    QVERIFY(tstNeuron.getTrainingPattern(0) != (const unsigned char*)trainingMatrix);
+    QVERIFY(bitsEqual(tstNeuron, 0, "1010101010", 1));
+    QVERIFY(bitsEqual(tstNeuron, 1, "1111111111", 0));
+    QVERIFY(bitsEqual(tstNeuron, 2, "0000011111", 1));
+
+    //Supplied storage is still owned by the test
+    delete [] trainingMatrix;
+    delete [] trainingOutputs;
+}
+
+
 
 
 /*-------------------------------------------------------*/
@@ -265,14 +439,15 @@ void TestWeightlessNeuron::addTraining(WeightlessNeuron& neuron, QString trainin
 }
 
 
-bool TestWeightlessNeuron::bitsEqual(unsigned char* byteArr, QString bitPattStr, int output){
-    if(byteArr[0] != output)
+bool TestWeightlessNeuron::bitsEqual(WeightlessNeuron& neuron, int patternIndex, QString bitPattStr, int output){
+    if(neuron.getTrainingOutput(patternIndex) != output)
 	return false;
 
+    const unsigned char* byteArr = neuron.getTrainingPattern(patternIndex);
     for(int i=0; i<bitPattStr.length(); ++i){
-	if(bitPattStr[i] == '1' && (byteArr[1 + i/8] & ( 1<<(i % 8) )))//1 is equal
+	if(bitPattStr[i] == '1' && (byteArr[i/8] & ( 1<<(i % 8) )))//1 is equal
 	    ;//do nothing
-	else if(bitPattStr[i] == '0' && !(byteArr[1 + i/8] & ( 1<<(i % 8) )))//0 is equal
+	else if(bitPattStr[i] == '0' && !(byteArr[i/8] & ( 1<<(i % 8) )))//0 is equal
 	    ;//Do nothing
 	else
 	    return false;//String and byte array do not match
@@ -15,11 +15,15 @@ class TestWeightlessNeuron : public QObject {
 	void testAddTraining();
 	void testGetFiringStateProbability();
 	void testGetTransitionProbability();
+	void testGetTransitionProbabilityLargeGroup();
+	void testGetTransitionProbabilityManyGroups();
+	void testGetTransitionProbabilityMatchesEnumeration();
 	void testSetGeneralization();
+	void testSetTrainingStorage();
 
     private:
 	void addTraining(WeightlessNeuron& neuron, QString trainingPattern, int output);
-	bool bitsEqual(unsigned char* byteArr, QString bitPattStr, int output);
+	bool bitsEqual(WeightlessNeuron& neuron, int patternIndex, QString bitPattStr, int output);
 	void fillByteArray(unsigned char*& byteArr, int& arrLen, QString byteStr);
 };
 
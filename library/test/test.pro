@@ -41,6 +41,7 @@ HEADERS += src/TestRunner.h \
 			src/TestNeuronGroup.h \
 			src/TestArchiveDao.h \
 			src/TestAnalysisDao.h \
+			src/TestRandomStream.h \
 			src/TestUtil.h \
 			src/TestWeightlessNeuron.h \
 			src/TestMemory.h
@@ -56,6 +57,7 @@ SOURCES += src/Main.cpp \
 			src/TestNeuronGroup.cpp \
 			src/TestArchiveDao.cpp \
 			src/TestAnalysisDao.cpp \
+			src/TestRandomStream.cpp \
 			src/TestUtil.cpp \
 			src/TestWeightlessNeuron.cpp \
 			src/TestMemory.cpp
@@ -53,7 +53,7 @@ void FullyConnectedNetworksBuilder::run(){
 		emit progress(0, 4);
 
 		//Add nework with training so each neuron fires when 100% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n100% training.");
 		addTraining(100);
 
@@ -62,7 +62,7 @@ void FullyConnectedNetworksBuilder::run(){
 			return;
 
 		//Add nework with training so each neuron fires when 100% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n75% training.");
 		addTraining(75);
 
@@ -71,7 +71,7 @@ void FullyConnectedNetworksBuilder::run(){
 			return;
 
 		//Add nework with training so each neuron fires when 100% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n50% training.");
 		addTraining(50);
 
@@ -80,7 +80,7 @@ void FullyConnectedNetworksBuilder::run(){
 			return;
 
 		//Add nework with training so each neuron fires when 100% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n25% training.");
 		addTraining(25);
 		emit progress(4, 4);
@@ -115,7 +115,7 @@ void FullyConnectedNetworksBuilder::addBasicNetwork(const QString& networkName,
 	//Build neuron group - store neurons in list and then put ids in map
 	QHash<QString, double> paramMap;
 	NeuronGroup neuronGroup(NeuronGroupInfo(0, "Neuron group 1", "Main neuron group", paramMap, networkDao->getNeuronType(NEURON_TYPE_ID)));
-	QList<Neuron*> neuronList;
+	QList<int> neuronList;
 	neuronList.append(neuronGroup.addNeuron(3, 1, 1));
 	neuronList.append(neuronGroup.addNeuron(4, 1, 1));
 	neuronList.append(neuronGroup.addNeuron(5, 2, 1));
@@ -136,7 +136,7 @@ void FullyConnectedNetworksBuilder::addBasicNetwork(const QString& networkName,
 	runThread(netDaoThread);
 	neuronGroupID = neuronGroup.getID();
 	for(int i=0; i<neuronList.size(); ++i)
-		neuronMap[i+1] = neuronList.at(i)->getID();
+		neuronMap[i+1] = neuronGroup.getNeuronID(neuronList.at(i));
 
 	//Add the connections
 	addConnections();
@@ -267,7 +267,7 @@ QString FullyConnectedNetworksBuilder::getFiringNeuronStr(unsigned int percentNe
 	int numNeurs = (int) rint( 12.0 * ((double)percentNeurons / 100.0 ) );
 	QHash<unsigned int, bool> selectionMap;
 	while(selectionMap.size() < numNeurs){
-		int newIndex = rand() % 12 + 1;
+		int newIndex = randomStream.nextUInt(12) + 1;
 		selectionMap[newIndex] = true;//Duplicates do not matter because they do not increase the size of the map
 	}
 
@@ -287,7 +287,7 @@ QList<unsigned int> FullyConnectedNetworksBuilder::getRandomFromNeuronIDs(unsign
 	QHash<unsigned int, bool> selectionMap;
 	while (selectionMap.size() < numFromCons){
 		//Fill map with indexes of selected neurons
-		unsigned int tmpNeurID = rand() % 12 + 1;
+		unsigned int tmpNeurID = randomStream.nextUInt(12) + 1;
 		if(tmpNeurID != toNeuronID)
 			selectionMap[tmpNeurID] = true;
 	}
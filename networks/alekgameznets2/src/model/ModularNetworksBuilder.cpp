@@ -56,7 +56,7 @@ void ModularNetworksBuilder::run(){
 		emit progress(0, 4);
 
 		//Add nework with training so each neuron fires when 100% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n100% training");
 		addTraining(100);
 
@@ -65,7 +65,7 @@ void ModularNetworksBuilder::run(){
 			return;
 
 		//Add nework with training so each neuron fires when 75% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n75% training");
 		addTraining(75);
 
@@ -74,7 +74,7 @@ void ModularNetworksBuilder::run(){
 			return;
 
 		//Add nework with training so each neuron fires when 50% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n50% training");
 		addTraining(50);
 
@@ -83,7 +83,7 @@ void ModularNetworksBuilder::run(){
 			return;
 
 		//Add nework with training so each neuron fires when 25% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n25% training");
 		addTraining(25);
 		emit progress(4, 4);
@@ -118,7 +118,7 @@ void ModularNetworksBuilder::addBasicNetwork(const QString& networkName, const Q
 	//Build neuron group - store neurons in list and then put ids in map
 	QHash<QString, double> paramMap;
 	NeuronGroup neuronGroup(NeuronGroupInfo(0, "Neuron group 1", "Main neuron group", paramMap, networkDao->getNeuronType(NEURON_TYPE_ID)));
-	QList<Neuron*> neuronList;
+	QList<int> neuronList;
 	neuronList.append(neuronGroup.addNeuron(1, 5, 1));
 	neuronList.append(neuronGroup.addNeuron(2, 5, 1));
 	neuronList.append(neuronGroup.addNeuron(2, 6, 1));
@@ -139,7 +139,7 @@ void ModularNetworksBuilder::addBasicNetwork(const QString& networkName, const Q
 	runThread(netDaoThread);
 	neuronGroupID = neuronGroup.getID();
 	for(int i=0; i<neuronList.size(); ++i)
-		neuronMap[i+1] = neuronList.at(i)->getID();
+		neuronMap[i+1] = neuronGroup.getNeuronID(neuronList.at(i));
 
 	//Add the connections
 	addConnections();
@@ -212,19 +212,19 @@ void ModularNetworksBuilder::addFiringPatterns(){
 
 	//Second firing pattern has 1 randomly selected neuron firing in each module
 	QString firingStr = "";
-	firingStr += QString::number(neuronMap[rand() % 4 + 1]) + ",";
-	firingStr += QString::number(neuronMap[rand() % 4 + 5]) + ",";
-	firingStr += QString::number(neuronMap[rand() % 4 + 9]);
+	firingStr += QString::number(neuronMap[randomStream.nextUInt(4) + 1]) + ",";
+	firingStr += QString::number(neuronMap[randomStream.nextUInt(4) + 5]) + ",";
+	firingStr += QString::number(neuronMap[randomStream.nextUInt(4) + 9]);
 	archiveDao->addArchiveData(archiveInfo.getID(), 2, firingStr);
 
 	//Third firing pattern has 2 randomly selected neurons firing in each module
-	firingStr = QString::number(neuronMap[rand() % 2 + 1]) + "," + QString::number(neuronMap[rand() % 2 + 3]) + ",";
-	firingStr += QString::number(neuronMap[rand() % 2 + 5]) + "," + QString::number(neuronMap[rand() % 2 + 7]) + ",";
-	firingStr += QString::number(neuronMap[rand() % 2 + 9]) + "," + QString::number(neuronMap[rand() % 2 + 11]);
+	firingStr = QString::number(neuronMap[randomStream.nextUInt(2) + 1]) + "," + QString::number(neuronMap[randomStream.nextUInt(2) + 3]) + ",";
+	firingStr += QString::number(neuronMap[randomStream.nextUInt(2) + 5]) + "," + QString::number(neuronMap[randomStream.nextUInt(2) + 7]) + ",";
+	firingStr += QString::number(neuronMap[randomStream.nextUInt(2) + 9]) + "," + QString::number(neuronMap[randomStream.nextUInt(2) + 11]);
 	archiveDao->addArchiveData(archiveInfo.getID(), 3, firingStr);
 
 	//Fourth firing pattern has 1 randomly selected neuron that does NOT fire in each module
-	unsigned int notFire1 = rand() % 4 + 1, notFire2 =  rand() % 4 + 5, notFire3 =  rand() % 4 + 11;
+	unsigned int notFire1 = randomStream.nextUInt(4) + 1, notFire2 =  randomStream.nextUInt(4) + 5, notFire3 =  randomStream.nextUInt(4) + 11;
 	firingStr = "";
 	for(unsigned int neurIndx = 1; neurIndx <= 12; ++neurIndx){
 		if(neurIndx != notFire1 && neurIndx != notFire2 && neurIndx != notFire3)
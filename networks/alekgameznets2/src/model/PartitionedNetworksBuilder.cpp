@@ -52,7 +52,7 @@ void PartitionedNetworksBuilder::run(){
 		emit progress(0, 4);
 
 		//Add nework with training so each neuron fires when 100% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n100% training");
 		addTraining(100);
 
@@ -61,7 +61,7 @@ void PartitionedNetworksBuilder::run(){
 			return;
 
 		//Add nework with training so each neuron fires when 75% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n75% training");
 		addTraining(75);
 
@@ -70,7 +70,7 @@ void PartitionedNetworksBuilder::run(){
 			return;
 
 		//Add nework with training so each neuron fires when 50% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n50% training");
 		addTraining(50);
 
@@ -79,7 +79,7 @@ void PartitionedNetworksBuilder::run(){
 			return;
 
 		//Add nework with training so each neuron fires when 25% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n25% training");
 		addTraining(25);
 		emit progress(4, 4);
@@ -114,7 +114,7 @@ void PartitionedNetworksBuilder::addBasicNetwork(const QString& networkName, con
 	//Build neuron group - store neurons in list and then put ids in map
 	QHash<QString, double> paramMap;
 	NeuronGroup neuronGroup(NeuronGroupInfo(0, "Neuron group 1", "Main neuron group", paramMap, networkDao->getNeuronType(NEURON_TYPE_ID)));
-	QList<Neuron*> neuronList;
+	QList<int> neuronList;
 	neuronList.append(neuronGroup.addNeuron(2, 1, 1));
 	neuronList.append(neuronGroup.addNeuron(3, 1, 1));
 	neuronList.append(neuronGroup.addNeuron(4, 2, 1));
@@ -135,7 +135,7 @@ void PartitionedNetworksBuilder::addBasicNetwork(const QString& networkName, con
 	runThread(netDaoThread);
 	neuronGroupID = neuronGroup.getID();
 	for(int i=0; i<neuronList.size(); ++i)
-		neuronMap[i+1] = neuronList.at(i)->getID();
+		neuronMap[i+1] = neuronGroup.getNeuronID(neuronList.at(i));
 
 	//Add the connections
 	addConnections();
@@ -269,7 +269,7 @@ QString PartitionedNetworksBuilder::getFiringNeuronStr(unsigned int percentNeuro
 	int numNeurs = (int) rint( 12.0 * ((double)percentNeurons / 100.0 ) );
 	QHash<unsigned int, bool> selectionMap;
 	while(selectionMap.size() < numNeurs){
-		int newIndex = rand() % 12 + 1;
+		int newIndex = randomStream.nextUInt(12) + 1;
 		selectionMap[newIndex] = true;//Duplicates do not matter because they do not increase the size of the map
 	}
 
@@ -291,9 +291,9 @@ QList<unsigned int> PartitionedNetworksBuilder::getRandomFromNeuronIDs(unsigned
 		//Fill map with indexes of selected neurons. Connect 1st 6 neurons together and second 6 neurons together
 		unsigned int tmpNeurID;
 		if(toNeuronID >=7)
-			tmpNeurID = rand() % 6 + 7;
+			tmpNeurID = randomStream.nextUInt(6) + 7;
 		else
-			tmpNeurID = rand() % 6 + 1;
+			tmpNeurID = randomStream.nextUInt(6) + 1;
 
 		if(tmpNeurID != toNeuronID)
 			selectionMap[tmpNeurID] = true;
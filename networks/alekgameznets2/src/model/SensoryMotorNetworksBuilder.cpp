@@ -55,7 +55,7 @@ void SensoryMotorNetworksBuilder::run(){
 		emit progress(0, 1);
 
 		//Add nework
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription);
 
 		emit progress(1, 1);
@@ -90,7 +90,7 @@ void SensoryMotorNetworksBuilder::addBasicNetwork(const QString& networkName, co
 	//Build neuron group - store neurons in list and then put ids in map
 	QHash<QString, double> paramMap;
 	NeuronGroup neuronGroup(NeuronGroupInfo(0, "Neuron group 1", "Main neuron group", paramMap, networkDao->getNeuronType(NEURON_TYPE_ID)));
-	QList<Neuron*> neuronList;
+	QList<int> neuronList;
 	//Bottom input layer
 	neuronList.append(neuronGroup.addNeuron(1.5, 1, 1));//1
 	neuronList.append(neuronGroup.addNeuron(2.5, 1, 1));//2
@@ -116,7 +116,7 @@ void SensoryMotorNetworksBuilder::addBasicNetwork(const QString& networkName, co
 	runThread(netDaoThread);
 	neuronGroupID = neuronGroup.getID();
 	for(int i=0; i<neuronList.size(); ++i)
-		neuronMap[i+1] = neuronList.at(i)->getID();
+		neuronMap[i+1] = neuronGroup.getNeuronID(neuronList.at(i));
 
 	//Add the connections
 	addConnections();
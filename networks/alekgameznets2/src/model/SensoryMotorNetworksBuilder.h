@@ -3,6 +3,7 @@
 
 //SpikeStream includes
 #include "NetworksBuilder.h"
+#include "RandomStream.h"
 
 //Qt includes
 #include <QWidget>
@@ -45,6 +46,9 @@ namespace spikestream {
 			/*! Pointer to bool controlling stop in the invoking thread */
 			const bool* stop;
 
+			/*! Seeded stream of random numbers used to select connections and firing neurons */
+			RandomStream randomStream;
+
 			/*! Holds all of the connections to neurons */
 			QList<unsigned>* conListArray;
 
@@ -56,7 +56,7 @@ void SensoryNetworksBuilder::run(){
 		emit progress(0, 4);
 
 		//Add nework with training so each neuron fires when 100% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n100% training");
 		addTraining(100);
 
@@ -65,7 +65,7 @@ void SensoryNetworksBuilder::run(){
 			return;
 
 		//Add nework with training so each neuron fires when 75% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n75% training");
 		addTraining(75);
 
@@ -74,7 +74,7 @@ void SensoryNetworksBuilder::run(){
 			return;
 
 		//Add nework with training so each neuron fires when 50% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n50% training");
 		addTraining(50);
 
@@ -83,7 +83,7 @@ void SensoryNetworksBuilder::run(){
 			return;
 
 		//Add nework with training so each neuron fires when 25% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n25% training");
 		addTraining(25);
 		emit progress(4, 4);
@@ -118,7 +118,7 @@ void SensoryNetworksBuilder::addBasicNetwork(const QString& networkName, const Q
 	//Build neuron group - store neurons in list and then put ids in map
 	QHash<QString, double> paramMap;
 	NeuronGroup neuronGroup(NeuronGroupInfo(0, "Neuron group 1", "Main neuron group", paramMap, networkDao->getNeuronType(NEURON_TYPE_ID)));
-	QList<Neuron*> neuronList;
+	QList<int> neuronList;
 	neuronList.append(neuronGroup.addNeuron(3, 1, 1));
 	neuronList.append(neuronGroup.addNeuron(5, 2, 1));
 	neuronList.append(neuronGroup.addNeuron(5, 7, 1));
@@ -139,7 +139,7 @@ void SensoryNetworksBuilder::addBasicNetwork(const QString& networkName, const Q
 	runThread(netDaoThread);
 	neuronGroupID = neuronGroup.getID();
 	for(int i=0; i<neuronList.size(); ++i)
-		neuronMap[i+1] = neuronList.at(i)->getID();
+		neuronMap[i+1] = neuronGroup.getNeuronID(neuronList.at(i));
 
 	//Add the connections
 	addConnections();
@@ -200,7 +200,7 @@ void SensoryNetworksBuilder::addFiringPatterns(){
 	QString firingStr = "";
 	QHash<unsigned int, bool> selectionMap;
 	while(selectionMap.size() < 3){
-		selectionMap[ neuronMap[rand() % 6 + 7] ] = true;
+		selectionMap[ neuronMap[randomStream.nextUInt(6) + 7] ] = true;
 	}
 	for(QHash<unsigned int, bool>::iterator iter = selectionMap.begin(); iter != selectionMap.end(); ++iter)
 		firingStr += QString::number(iter.key()) + ",";
@@ -211,7 +211,7 @@ void SensoryNetworksBuilder::addFiringPatterns(){
 	firingStr = "";
 	selectionMap.clear();
 	while(selectionMap.size() < 3){
-		selectionMap[ neuronMap[rand() % 6 + 1] ] = true;
+		selectionMap[ neuronMap[randomStream.nextUInt(6) + 1] ] = true;
 	}
 	for(QHash<unsigned int, bool>::iterator iter = selectionMap.begin(); iter != selectionMap.end(); ++iter)
 		firingStr += QString::number(iter.key()) + ",";
@@ -236,7 +236,7 @@ void SensoryNetworksBuilder::addFiringPatterns(){
 	firingStr = "";
 	selectionMap.clear();
 	while(selectionMap.size() < 6){
-		selectionMap[ neuronMap[rand() % 12 + 1] ] = true;
+		selectionMap[ neuronMap[randomStream.nextUInt(12) + 1] ] = true;
 	}
 	for(QHash<unsigned int, bool>::iterator iter = selectionMap.begin(); iter != selectionMap.end(); ++iter)
 		firingStr += QString::number(iter.key()) + ",";
@@ -47,7 +47,7 @@ void TestPartitionedNetworksBuilder::run(){
 		emit progress(0, 4);
 
 		//Add nework with training so each neuron fires when 100% of its input neurons are firing
-		srand(123456789);//Seed the random number generator
+		randomStream = RandomStream(123456789);//Seed the random number generator
 		addBasicNetwork(networkName, networkDescription + " \n100% training");
 		addTraining(100);
 
@@ -80,7 +80,7 @@ void TestPartitionedNetworksBuilder::addBasicNetwork(const QString& networkName,
 	//Build neuron group - store neurons in list and then put ids in map
 	QHash<QString, double> paramMap;
 	NeuronGroup neuronGroup(NeuronGroupInfo(0, "Neuron group 1", "Main neuron group", paramMap, networkDao->getNeuronType(2)));
-	QList<Neuron*> neuronList;
+	QList<int> neuronList;
 	neuronList.append(neuronGroup.addNeuron(2, 1, 1));
 	neuronList.append(neuronGroup.addNeuron(3, 1, 1));
 	neuronList.append(neuronGroup.addNeuron(3, 3, 1));
@@ -99,7 +99,7 @@ void TestPartitionedNetworksBuilder::addBasicNetwork(const QString& networkName,
 	runThread(netDaoThread);
 	neuronGroupID = neuronGroup.getID();
 	for(int i=0; i<neuronList.size(); ++i)
-		neuronMap[i+1] = neuronList.at(i)->getID();
+		neuronMap[i+1] = neuronGroup.getNeuronID(neuronList.at(i));
 
 	//Add the connections
 	addConnections();
@@ -233,7 +233,7 @@ QString TestPartitionedNetworksBuilder::getFiringNeuronStr(unsigned int percentN
 	int numNeurs = (int) rint((double)numberOfNeurons * ((double)percentNeurons / 100.0 ) );
 	QHash<unsigned int, bool> selectionMap;
 	while(selectionMap.size() < numNeurs){
-		int newIndex = rand() % numberOfNeurons + 1;
+		int newIndex = randomStream.nextUInt(numberOfNeurons) + 1;
 		selectionMap[newIndex] = true;//Duplicates do not matter because they do not increase the size of the map
 	}
 
@@ -255,9 +255,9 @@ QList<unsigned int> TestPartitionedNetworksBuilder::getRandomFromNeuronIDs(unsig
 		//Fill map with indexes of selected neurons. Connect 1st 5 neurons together and second 5 neurons together
 		unsigned int tmpNeurID;
 		if(toNeuronID >= (numberOfNeurons/2 + 1))
-			tmpNeurID = rand() % (numberOfNeurons/2) + (numberOfNeurons/2 + 1);
+			tmpNeurID = randomStream.nextUInt(numberOfNeurons/2) + (numberOfNeurons/2 + 1);
 		else
-			tmpNeurID = rand() % (numberOfNeurons/2)  + 1;
+			tmpNeurID = randomStream.nextUInt(numberOfNeurons/2)  + 1;
 
 		if(tmpNeurID != toNeuronID)
 			selectionMap[tmpNeurID] = true;
@@ -47,10 +47,10 @@ void AleksanderNetworksBuilder::add4NeuronNetwork1(const QString& networkName, c
 	ConnectionGroup connGrp(connGrpInfo);
 
 	//Add connections
-	unsigned abCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[2]->getID(),  0,  0);//A->B
-	unsigned baCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[1]->getID(),  0,  0);//B->A
-	unsigned cdCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[4]->getID(),  0,  0);//C->D
-	unsigned dcCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[3]->getID(),  0,  0);//D->C
+	unsigned abCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//A->B
+	unsigned baCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//B->A
+	unsigned cdCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//C->D
+	unsigned dcCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//D->C
 	addConnectionGroup(networkID, connGrp);
 
 	//Add weightless connections. Only 1 connection per neuron, so pattern index is zero in all cases
@@ -60,14 +60,14 @@ void AleksanderNetworksBuilder::add4NeuronNetwork1(const QString& networkName, c
 	networkDao->addWeightlessConnection(connGrp[cdCon].getID(), 0);
 
 	//Add training
-	addTraining(neuronMap[1]->getID(), "0", 0);
-	addTraining(neuronMap[1]->getID(), "1", 1);
-	addTraining(neuronMap[2]->getID(), "0", 0);
-	addTraining(neuronMap[2]->getID(), "1", 1);
-	addTraining(neuronMap[3]->getID(), "0", 0);
-	addTraining(neuronMap[3]->getID(), "1", 1);
-	addTraining(neuronMap[4]->getID(), "0", 0);
-	addTraining(neuronMap[4]->getID(), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "1", 1);
 }
 
 
@@ -83,11 +83,11 @@ void AleksanderNetworksBuilder::add4NeuronNetwork2_AND(const QString& networkNam
 	ConnectionGroup connGrp(connGrpInfo);
 
 	//Add connections
-	unsigned abCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[2]->getID(),  0,  0);//A->B
-	unsigned acCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[3]->getID(),  0,  0);//A->C
-	unsigned baCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[1]->getID(),  0,  0);//B->A
-	unsigned cdCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[4]->getID(),  0,  0);//C->D
-	unsigned dcCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[3]->getID(),  0,  0);//D->C
+	unsigned abCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//A->B
+	unsigned acCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//A->C
+	unsigned baCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//B->A
+	unsigned cdCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//C->D
+	unsigned dcCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//D->C
 	addConnectionGroup(networkID, connGrp);
 
 	//Add weightless connections.1 connection to A, B and D
@@ -100,16 +100,16 @@ void AleksanderNetworksBuilder::add4NeuronNetwork2_AND(const QString& networkNam
 	networkDao->addWeightlessConnection(connGrp[dcCon].getID(), 1);
 
 	//Add AND training. C has two inputs, the rest have one.
-	addTraining(neuronMap[1]->getID(), "0", 0);
-	addTraining(neuronMap[1]->getID(), "1", 1);
-	addTraining(neuronMap[2]->getID(), "0", 0);
-	addTraining(neuronMap[2]->getID(), "1", 1);
-	addTraining(neuronMap[3]->getID(), "00", 0);
-	addTraining(neuronMap[3]->getID(), "01", 0);
-	addTraining(neuronMap[3]->getID(), "10", 0);
-	addTraining(neuronMap[3]->getID(), "11", 1);
-	addTraining(neuronMap[4]->getID(), "0", 0);
-	addTraining(neuronMap[4]->getID(), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "01", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "10", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "11", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "1", 1);
 }
 
 
@@ -125,11 +125,11 @@ void AleksanderNetworksBuilder::add4NeuronNetwork2_XOR(const QString& networkNam
 	ConnectionGroup connGrp(connGrpInfo);
 
 	//Add connections
-	unsigned abCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[2]->getID(),  0,  0);//A->B
-	unsigned acCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[3]->getID(),  0,  0);//A->C
-	unsigned baCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[1]->getID(),  0,  0);//B->A
-	unsigned cdCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[4]->getID(),  0,  0);//C->D
-	unsigned dcCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[3]->getID(),  0,  0);//D->C
+	unsigned abCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//A->B
+	unsigned acCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//A->C
+	unsigned baCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//B->A
+	unsigned cdCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//C->D
+	unsigned dcCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//D->C
 	addConnectionGroup(networkID, connGrp);
 
 	//Add weightless connections.1 connection to A, B and D
@@ -142,16 +142,16 @@ void AleksanderNetworksBuilder::add4NeuronNetwork2_XOR(const QString& networkNam
 	networkDao->addWeightlessConnection(connGrp[dcCon].getID(), 1);
 
 	//Add XOR training. C has two inputs, the rest have one.
-	addTraining(neuronMap[1]->getID(), "0", 0);
-	addTraining(neuronMap[1]->getID(), "1", 1);
-	addTraining(neuronMap[2]->getID(), "0", 0);
-	addTraining(neuronMap[2]->getID(), "1", 1);
-	addTraining(neuronMap[3]->getID(), "00", 0);
-	addTraining(neuronMap[3]->getID(), "01", 1);
-	addTraining(neuronMap[3]->getID(), "10", 1);
-	addTraining(neuronMap[3]->getID(), "11", 0);
-	addTraining(neuronMap[4]->getID(), "0", 0);
-	addTraining(neuronMap[4]->getID(), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "01", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "10", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "11", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "1", 1);
 }
 
 
@@ -167,12 +167,12 @@ void AleksanderNetworksBuilder::add4NeuronNetwork3_AND(const QString& networkNam
 	ConnectionGroup connGrp(connGrpInfo);
 
 	//Add connections
-	unsigned abCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[2]->getID(),  0,  0);//A->B
-	unsigned acCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[3]->getID(),  0,  0);//A->C
-	unsigned baCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[1]->getID(),  0,  0);//B->A
-	unsigned caCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[1]->getID(),  0,  0);//C->A
-	unsigned cdCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[4]->getID(),  0,  0);//C->D
-	unsigned dcCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[3]->getID(),  0,  0);//D->C
+	unsigned abCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//A->B
+	unsigned acCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//A->C
+	unsigned baCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//B->A
+	unsigned caCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//C->A
+	unsigned cdCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//C->D
+	unsigned dcCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//D->C
 	addConnectionGroup(networkID, connGrp);
 
 	//Add weightless connections.1 connection to B and D
@@ -186,18 +186,18 @@ void AleksanderNetworksBuilder::add4NeuronNetwork3_AND(const QString& networkNam
 	networkDao->addWeightlessConnection(connGrp[dcCon].getID(), 1);
 
 	//Add AND training.A and C have two inputs, the rest have one.
-	addTraining(neuronMap[1]->getID(), "00", 0);
-	addTraining(neuronMap[1]->getID(), "01", 0);
-	addTraining(neuronMap[1]->getID(), "10", 0);
-	addTraining(neuronMap[1]->getID(), "11", 1);
-	addTraining(neuronMap[2]->getID(), "0", 0);
-	addTraining(neuronMap[2]->getID(), "1", 1);
-	addTraining(neuronMap[3]->getID(), "00", 0);
-	addTraining(neuronMap[3]->getID(), "01", 0);
-	addTraining(neuronMap[3]->getID(), "10", 0);
-	addTraining(neuronMap[3]->getID(), "11", 1);
-	addTraining(neuronMap[4]->getID(), "0", 0);
-	addTraining(neuronMap[4]->getID(), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "01", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "10", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "11", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "01", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "10", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "11", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "1", 1);
 }
 
 
@@ -213,12 +213,12 @@ void AleksanderNetworksBuilder::add4NeuronNetwork3_XOR(const QString& networkNam
 	ConnectionGroup connGrp(connGrpInfo);
 
 	//Add connections
-	unsigned abCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[2]->getID(),  0,  0);//A->B
-	unsigned acCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[3]->getID(),  0,  0);//A->C
-	unsigned baCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[1]->getID(),  0,  0);//B->A
-	unsigned caCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[1]->getID(),  0,  0);//C->A
-	unsigned cdCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[4]->getID(),  0,  0);//C->D
-	unsigned dcCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[3]->getID(),  0,  0);//D->C
+	unsigned abCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//A->B
+	unsigned acCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//A->C
+	unsigned baCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//B->A
+	unsigned caCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//C->A
+	unsigned cdCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//C->D
+	unsigned dcCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//D->C
 	addConnectionGroup(networkID, connGrp);
 
 	//Add weightless connections.1 connection to B and D
@@ -232,18 +232,18 @@ void AleksanderNetworksBuilder::add4NeuronNetwork3_XOR(const QString& networkNam
 	networkDao->addWeightlessConnection(connGrp[dcCon].getID(), 1);
 
 	//Add XOR training.A and C have two inputs, the rest have one.
-	addTraining(neuronMap[1]->getID(), "00", 0);
-	addTraining(neuronMap[1]->getID(), "01", 1);
-	addTraining(neuronMap[1]->getID(), "10", 1);
-	addTraining(neuronMap[1]->getID(), "11", 0);
-	addTraining(neuronMap[2]->getID(), "0", 0);
-	addTraining(neuronMap[2]->getID(), "1", 1);
-	addTraining(neuronMap[3]->getID(), "00", 0);
-	addTraining(neuronMap[3]->getID(), "01", 1);
-	addTraining(neuronMap[3]->getID(), "10", 1);
-	addTraining(neuronMap[3]->getID(), "11", 0);
-	addTraining(neuronMap[4]->getID(), "0", 0);
-	addTraining(neuronMap[4]->getID(), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "01", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "10", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "11", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "1", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "01", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "10", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "11", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "0", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "1", 1);
 }
 
 
@@ -260,14 +260,14 @@ void AleksanderNetworksBuilder::add4NeuronNetwork4_AND(const QString& networkNam
 	ConnectionGroup connGrp(connGrpInfo);
 
 	//Add connections
-	unsigned abCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[2]->getID(),  0,  0);//A->B
-	unsigned acCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[3]->getID(),  0,  0);//A->C
-	unsigned baCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[1]->getID(),  0,  0);//B->A
-	unsigned bdCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[4]->getID(),  0,  0);//B->D
-	unsigned caCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[1]->getID(),  0,  0);//C->A
-	unsigned cdCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[4]->getID(),  0,  0);//C->D
-	unsigned dbCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[2]->getID(),  0,  0);//D->B
-	unsigned dcCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[3]->getID(),  0,  0);//D->C
+	unsigned abCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//A->B
+	unsigned acCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//A->C
+	unsigned baCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//B->A
+	unsigned bdCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//B->D
+	unsigned caCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//C->A
+	unsigned cdCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//C->D
+	unsigned dbCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//D->B
+	unsigned dcCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//D->C
 	addConnectionGroup(networkID, connGrp);
 
 	//Add weightless connections. All neurons have two connections
@@ -281,22 +281,22 @@ void AleksanderNetworksBuilder::add4NeuronNetwork4_AND(const QString& networkNam
 	networkDao->addWeightlessConnection(connGrp[cdCon].getID(), 1);
 
 	//Add AND training. All neurons have two inputs
-	addTraining(neuronMap[1]->getID(), "00", 0);
-	addTraining(neuronMap[1]->getID(), "01", 0);
-	addTraining(neuronMap[1]->getID(), "10", 0);
-	addTraining(neuronMap[1]->getID(), "11", 1);
-	addTraining(neuronMap[2]->getID(), "00", 0);
-	addTraining(neuronMap[2]->getID(), "01", 0);
-	addTraining(neuronMap[2]->getID(), "10", 0);
-	addTraining(neuronMap[2]->getID(), "11", 1);
-	addTraining(neuronMap[3]->getID(), "00", 0);
-	addTraining(neuronMap[3]->getID(), "01", 0);
-	addTraining(neuronMap[3]->getID(), "10", 0);
-	addTraining(neuronMap[3]->getID(), "11", 1);
-	addTraining(neuronMap[4]->getID(), "00", 0);
-	addTraining(neuronMap[4]->getID(), "01", 0);
-	addTraining(neuronMap[4]->getID(), "10", 0);
-	addTraining(neuronMap[4]->getID(), "11", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "01", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "10", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "11", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "01", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "10", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "11", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "01", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "10", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "11", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "01", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "10", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "11", 1);
 }
 
 
@@ -312,14 +312,14 @@ void AleksanderNetworksBuilder::add4NeuronNetwork4_XOR(const QString& networkNam
 	ConnectionGroup connGrp(connGrpInfo);
 
 	//Add connections
-	unsigned abCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[2]->getID(),  0,  0);//A->B
-	unsigned acCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[3]->getID(),  0,  0);//A->C
-	unsigned baCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[1]->getID(),  0,  0);//B->A
-	unsigned bdCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[4]->getID(),  0,  0);//B->D
-	unsigned caCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[1]->getID(),  0,  0);//C->A
-	unsigned cdCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[4]->getID(),  0,  0);//C->D
-	unsigned dbCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[2]->getID(),  0,  0);//D->B
-	unsigned dcCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[3]->getID(),  0,  0);//D->C
+	unsigned abCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//A->B
+	unsigned acCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//A->C
+	unsigned baCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//B->A
+	unsigned bdCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//B->D
+	unsigned caCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//C->A
+	unsigned cdCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//C->D
+	unsigned dbCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//D->B
+	unsigned dcCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//D->C
 	addConnectionGroup(networkID, connGrp);
 
 	//Add weightless connections. All neurons have two connections
@@ -333,22 +333,22 @@ void AleksanderNetworksBuilder::add4NeuronNetwork4_XOR(const QString& networkNam
 	networkDao->addWeightlessConnection(connGrp[cdCon].getID(), 1);
 
 	//Add AND training. All neurons have two inputs
-	addTraining(neuronMap[1]->getID(), "00", 0);
-	addTraining(neuronMap[1]->getID(), "01", 1);
-	addTraining(neuronMap[1]->getID(), "10", 1);
-	addTraining(neuronMap[1]->getID(), "11", 0);
-	addTraining(neuronMap[2]->getID(), "00", 0);
-	addTraining(neuronMap[2]->getID(), "01", 1);
-	addTraining(neuronMap[2]->getID(), "10", 1);
-	addTraining(neuronMap[2]->getID(), "11", 0);
-	addTraining(neuronMap[3]->getID(), "00", 0);
-	addTraining(neuronMap[3]->getID(), "01", 1);
-	addTraining(neuronMap[3]->getID(), "10", 1);
-	addTraining(neuronMap[3]->getID(), "11", 0);
-	addTraining(neuronMap[4]->getID(), "00", 0);
-	addTraining(neuronMap[4]->getID(), "01", 1);
-	addTraining(neuronMap[4]->getID(), "10", 1);
-	addTraining(neuronMap[4]->getID(), "11", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "01", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "10", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "11", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "01", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "10", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "11", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "01", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "10", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "11", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "00", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "01", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "10", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "11", 0);
 }
 
 
@@ -364,18 +364,18 @@ void AleksanderNetworksBuilder::add4NeuronNetwork5_AND(const QString& networkNam
 	ConnectionGroup connGrp(connGrpInfo);
 
 	//Add connections. Each neuron has three connections to it
-	unsigned abCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[2]->getID(),  0,  0);//A->B
-	unsigned acCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[3]->getID(),  0,  0);//A->C
-	unsigned adCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[4]->getID(),  0,  0);//A->D
-	unsigned baCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[1]->getID(),  0,  0);//B->A
-	unsigned bcCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[3]->getID(),  0,  0);//B->C
-	unsigned bdCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[4]->getID(),  0,  0);//B->D
-	unsigned caCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[1]->getID(),  0,  0);//C->A
-	unsigned cbCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[2]->getID(),  0,  0);//C->B
-	unsigned cdCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[4]->getID(),  0,  0);//C->D
-	unsigned daCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[1]->getID(),  0,  0);//D->A
-	unsigned dbCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[2]->getID(),  0,  0);//D->B
-	unsigned dcCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[3]->getID(),  0,  0);//D->C
+	unsigned abCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//A->B
+	unsigned acCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//A->C
+	unsigned adCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//A->D
+	unsigned baCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//B->A
+	unsigned bcCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//B->C
+	unsigned bdCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//B->D
+	unsigned caCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//C->A
+	unsigned cbCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//C->B
+	unsigned cdCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//C->D
+	unsigned daCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//D->A
+	unsigned dbCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//D->B
+	unsigned dcCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//D->C
 	addConnectionGroup(networkID, connGrp);
 
 	//Add weightless connections. All neurons have three connections
@@ -393,41 +393,41 @@ void AleksanderNetworksBuilder::add4NeuronNetwork5_AND(const QString& networkNam
 	networkDao->addWeightlessConnection(connGrp[cdCon].getID(), 2);
 
 	//Add AND training. All neurons have three inputs
-	addTraining(neuronMap[1]->getID(), "000", 0);
-	addTraining(neuronMap[1]->getID(), "001", 0);
-	addTraining(neuronMap[1]->getID(), "010", 0);
-	addTraining(neuronMap[1]->getID(), "100", 0);
-	addTraining(neuronMap[1]->getID(), "011", 0);
-	addTraining(neuronMap[1]->getID(), "110", 0);
-	addTraining(neuronMap[1]->getID(), "101", 0);
-	addTraining(neuronMap[1]->getID(), "111", 1);
-
-	addTraining(neuronMap[2]->getID(), "000", 0);
-	addTraining(neuronMap[2]->getID(), "001", 0);
-	addTraining(neuronMap[2]->getID(), "010", 0);
-	addTraining(neuronMap[2]->getID(), "100", 0);
-	addTraining(neuronMap[2]->getID(), "011", 0);
-	addTraining(neuronMap[2]->getID(), "110", 0);
-	addTraining(neuronMap[2]->getID(), "101", 0);
-	addTraining(neuronMap[2]->getID(), "111", 1);
-
-	addTraining(neuronMap[3]->getID(), "000", 0);
-	addTraining(neuronMap[3]->getID(), "001", 0);
-	addTraining(neuronMap[3]->getID(), "010", 0);
-	addTraining(neuronMap[3]->getID(), "100", 0);
-	addTraining(neuronMap[3]->getID(), "011", 0);
-	addTraining(neuronMap[3]->getID(), "110", 0);
-	addTraining(neuronMap[3]->getID(), "101", 0);
-	addTraining(neuronMap[3]->getID(), "111", 1);
-
-	addTraining(neuronMap[4]->getID(), "000", 0);
-	addTraining(neuronMap[4]->getID(), "001", 0);
-	addTraining(neuronMap[4]->getID(), "010", 0);
-	addTraining(neuronMap[4]->getID(), "100", 0);
-	addTraining(neuronMap[4]->getID(), "011", 0);
-	addTraining(neuronMap[4]->getID(), "110", 0);
-	addTraining(neuronMap[4]->getID(), "101", 0);
-	addTraining(neuronMap[4]->getID(), "111", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "000", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "001", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "010", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "100", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "011", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "110", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "101", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "111", 1);
+
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "000", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "001", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "010", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "100", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "011", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "110", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "101", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "111", 1);
+
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "000", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "001", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "010", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "100", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "011", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "110", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "101", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "111", 1);
+
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "000", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "001", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "010", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "100", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "011", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "110", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "101", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "111", 1);
 }
 
 
@@ -443,18 +443,18 @@ void AleksanderNetworksBuilder::add4NeuronNetwork5_XOR(const QString& networkNam
 	ConnectionGroup connGrp(connGrpInfo);
 
 	//Add connections. Each neuron has three connections to it
-	unsigned abCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[2]->getID(),  0,  0);//A->B
-	unsigned acCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[3]->getID(),  0,  0);//A->C
-	unsigned adCon = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[4]->getID(),  0,  0);//A->D
-	unsigned baCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[1]->getID(),  0,  0);//B->A
-	unsigned bcCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[3]->getID(),  0,  0);//B->C
-	unsigned bdCon = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[4]->getID(),  0,  0);//B->D
-	unsigned caCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[1]->getID(),  0,  0);//C->A
-	unsigned cbCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[2]->getID(),  0,  0);//C->B
-	unsigned cdCon = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[4]->getID(),  0,  0);//C->D
-	unsigned daCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[1]->getID(),  0,  0);//D->A
-	unsigned dbCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[2]->getID(),  0,  0);//D->B
-	unsigned dcCon = connGrp.addConnection(neuronMap[4]->getID(), neuronMap[3]->getID(),  0,  0);//D->C
+	unsigned abCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//A->B
+	unsigned acCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//A->C
+	unsigned adCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[1]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//A->D
+	unsigned baCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//B->A
+	unsigned bcCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//B->C
+	unsigned bdCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[2]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//B->D
+	unsigned caCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//C->A
+	unsigned cbCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//C->B
+	unsigned cdCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[3]), neuronGroup->getNeuronID(neuronMap[4]),  0,  0);//C->D
+	unsigned daCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[1]),  0,  0);//D->A
+	unsigned dbCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[2]),  0,  0);//D->B
+	unsigned dcCon = connGrp.addConnection(neuronGroup->getNeuronID(neuronMap[4]), neuronGroup->getNeuronID(neuronMap[3]),  0,  0);//D->C
 	addConnectionGroup(networkID, connGrp);
 
 	//Add weightless connections. All neurons have three connections
@@ -472,41 +472,41 @@ void AleksanderNetworksBuilder::add4NeuronNetwork5_XOR(const QString& networkNam
 	networkDao->addWeightlessConnection(connGrp[cdCon].getID(), 2);
 
 	//Add XOR training. All neurons have three inputs
-	addTraining(neuronMap[1]->getID(), "000", 0);
-	addTraining(neuronMap[1]->getID(), "001", 1);
-	addTraining(neuronMap[1]->getID(), "010", 1);
-	addTraining(neuronMap[1]->getID(), "100", 1);
-	addTraining(neuronMap[1]->getID(), "011", 0);
-	addTraining(neuronMap[1]->getID(), "110", 0);
-	addTraining(neuronMap[1]->getID(), "101", 0);
-	addTraining(neuronMap[1]->getID(), "111", 0);
-
-	addTraining(neuronMap[2]->getID(), "000", 0);
-	addTraining(neuronMap[2]->getID(), "001", 1);
-	addTraining(neuronMap[2]->getID(), "010", 1);
-	addTraining(neuronMap[2]->getID(), "100", 1);
-	addTraining(neuronMap[2]->getID(), "011", 0);
-	addTraining(neuronMap[2]->getID(), "110", 0);
-	addTraining(neuronMap[2]->getID(), "101", 0);
-	addTraining(neuronMap[2]->getID(), "111", 0);
-
-	addTraining(neuronMap[3]->getID(), "000", 0);
-	addTraining(neuronMap[3]->getID(), "001", 1);
-	addTraining(neuronMap[3]->getID(), "010", 1);
-	addTraining(neuronMap[3]->getID(), "100", 1);
-	addTraining(neuronMap[3]->getID(), "011", 0);
-	addTraining(neuronMap[3]->getID(), "110", 0);
-	addTraining(neuronMap[3]->getID(), "101", 0);
-	addTraining(neuronMap[3]->getID(), "111", 0);
-
-	addTraining(neuronMap[4]->getID(), "000", 0);
-	addTraining(neuronMap[4]->getID(), "001", 1);
-	addTraining(neuronMap[4]->getID(), "010", 1);
-	addTraining(neuronMap[4]->getID(), "100", 1);
-	addTraining(neuronMap[4]->getID(), "011", 0);
-	addTraining(neuronMap[4]->getID(), "110", 0);
-	addTraining(neuronMap[4]->getID(), "101", 0);
-	addTraining(neuronMap[4]->getID(), "111", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "000", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "001", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "010", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "100", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "011", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "110", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "101", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[1]), "111", 0);
+
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "000", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "001", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "010", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "100", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "011", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "110", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "101", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[2]), "111", 0);
+
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "000", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "001", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "010", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "100", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "011", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "110", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "101", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[3]), "111", 0);
+
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "000", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "001", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "010", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "100", 1);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "011", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "110", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "101", 0);
+	addTraining(neuronGroup->getNeuronID(neuronMap[4]), "111", 0);
 }
 
 
@@ -558,10 +558,10 @@ void AleksanderNetworksBuilder::add4NeuronBasicNetwork(const QString& networkNam
 }
 
 
-void AleksanderNetworksBuilder::add4NeuronFiringPatterns(unsigned int networkID, NeuronMap& neuronMap){
+void AleksanderNetworksBuilder::add4NeuronFiringPatterns(unsigned int networkID, QHash<unsigned int, int>& neuronMap){
 	//Easy to use neuron ids
-	QString neurID1 = QString::number(neuronMap[1]->getID()), neurID2 = QString::number(neuronMap[2]->getID());
-	QString neurID3 = QString::number(neuronMap[3]->getID()), neurID4 = QString::number(neuronMap[4]->getID());
+	QString neurID1 = QString::number(neuronGroup->getNeuronID(neuronMap[1])), neurID2 = QString::number(neuronGroup->getNeuronID(neuronMap[2]));
+	QString neurID3 = QString::number(neuronGroup->getNeuronID(neuronMap[3])), neurID4 = QString::number(neuronGroup->getNeuronID(neuronMap[4]));
 
 	//Create archive
 	ArchiveInfo archiveInfo(0, networkID, QDateTime::currentDateTime().toTime_t(), "Complete set of 4 neuron firing patterns");
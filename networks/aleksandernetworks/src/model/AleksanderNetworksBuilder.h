@@ -27,8 +27,8 @@ namespace spikestream {
 
 		private:
 			//====================  VARIABLES  ========================
-			/*! Map holding neurons in the network */
-			QHash<unsigned int, Neuron*> neuronMap;
+			/*! Map holding the index in the neuron group of each neuron in the network */
+			QHash<unsigned int, int> neuronMap;
 
 			/*! Aleksander networks consist of a single neuron group */
 			NeuronGroup* neuronGroup;
@@ -38,7 +38,7 @@ namespace spikestream {
 
 			//======================  METHODS  ========================
 			void add4NeuronBasicNetwork(const QString& networkName, const QString& networkDescription);
-			void add4NeuronFiringPatterns(unsigned int networkID, NeuronMap& neuronMap);
+			void add4NeuronFiringPatterns(unsigned int networkID, QHash<unsigned int, int>& neuronMap);
 			void reset();
 	};
 
@@ -126,8 +126,8 @@ void ConnectionGroupBuilder::addConnections(Network* network, int nodeIndex, urn
 
 	//Create the excitatory connections within and between nodes
 	double randomNum, previousThreshold;
-	for(NeuronMap::iterator fromIter = excitNeurGrp->begin(); fromIter != excitNeurGrp->end() && !*stopThread; ++fromIter){
-		for(NeuronMap::iterator toIter = excitNeurGrp->begin(); toIter != excitNeurGrp->end() && !*stopThread; ++toIter){
+	for(NeuronIterator fromIter = excitNeurGrp->begin(); fromIter != excitNeurGrp->end() && !*stopThread; ++fromIter){
+		for(NeuronIterator toIter = excitNeurGrp->begin(); toIter != excitNeurGrp->end() && !*stopThread; ++toIter){
 			//Get random number between 0 and 1.0
 			randomNum = ranNumGen();
 
@@ -201,22 +201,22 @@ void ConnectionGroupBuilder::addInhibitoryConnections(Network* network, NeuronGr
 	newConGrpList.append(inhibInhibConGrp);
 
 	//Add excitatory-inhibitory connections
-	for(NeuronMap::iterator fromIter = excitNeurGrp->begin(); fromIter != excitNeurGrp->end() && !*stopThread; ++fromIter){
-		for(NeuronMap::iterator toIter = inhibNeurGrp->begin(); toIter != inhibNeurGrp->end() && !*stopThread; ++toIter){
+	for(NeuronIterator fromIter = excitNeurGrp->begin(); fromIter != excitNeurGrp->end() && !*stopThread; ++fromIter){
+		for(NeuronIterator toIter = inhibNeurGrp->begin(); toIter != inhibNeurGrp->end() && !*stopThread; ++toIter){
 			excitInhibConGrp->addConnection(fromIter.key(), toIter.key(), getIntraDelay(ranNumGen()), getExcitatoryWeight(ranNumGen()));
 		}
 	}
 
 	//Add inhibitory-excitatory connections
-	for(NeuronMap::iterator fromIter = inhibNeurGrp->begin(); fromIter != inhibNeurGrp->end() && !*stopThread; ++fromIter){
-		for(NeuronMap::iterator toIter = excitNeurGrp->begin(); toIter != excitNeurGrp->end() && !*stopThread; ++toIter){
+	for(NeuronIterator fromIter = inhibNeurGrp->begin(); fromIter != inhibNeurGrp->end() && !*stopThread; ++fromIter){
+		for(NeuronIterator toIter = excitNeurGrp->begin(); toIter != excitNeurGrp->end() && !*stopThread; ++toIter){
 			inhibExcitConGrp->addConnection(fromIter.key(), toIter.key(), getIntraDelay(ranNumGen()), getInhibitoryWeight(ranNumGen()));
 		}
 	}
 
 	//Add inhibitory-inhibitory connections
-	for(NeuronMap::iterator fromIter = inhibNeurGrp->begin(); fromIter != inhibNeurGrp->end() && !*stopThread; ++fromIter){
-		for(NeuronMap::iterator toIter = inhibNeurGrp->begin(); toIter != inhibNeurGrp->end() && !*stopThread; ++toIter){
+	for(NeuronIterator fromIter = inhibNeurGrp->begin(); fromIter != inhibNeurGrp->end() && !*stopThread; ++fromIter){
+		for(NeuronIterator toIter = inhibNeurGrp->begin(); toIter != inhibNeurGrp->end() && !*stopThread; ++toIter){
 			inhibInhibConGrp->addConnection(fromIter.key(), toIter.key(), getIntraDelay(ranNumGen()), getInhibitoryWeight(ranNumGen()));
 		}
 	}
@@ -316,7 +316,7 @@ unsigned ConnectionGroupBuilder::getRandomExcitatoryNeuronID(int index){
 
 	NeuronGroup* neurGrp = excitNeurGrpList.at(index);
 	unsigned ranIndx = Util::getRandomUInt(0, neurGrp->size() - 1);
-	return neurGrp->getNeuronMap()->values().at(ranIndx)->getID();
+	return neurGrp->getNeuronID(ranIndx);
 }
 
 
@@ -34,9 +34,11 @@ win32{
 #---                 FILES                  ---#
 #----------------------------------------------#
 HEADERS = src/gui/IzhikevichNetworksWidget.h \
-			src/model/IzhikevichNetworkBuilder.h
+			src/model/IzhikevichNetworkBuilder.h \
+			src/model/PolychronizationRowThread.h
 
 SOURCES = src/gui/IzhikevichNetworksWidget.cpp \
-			src/model/IzhikevichNetworkBuilder.cpp
+			src/model/IzhikevichNetworkBuilder.cpp \
+			src/model/PolychronizationRowThread.cpp
 
 
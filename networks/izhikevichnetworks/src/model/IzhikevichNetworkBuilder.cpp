@@ -4,6 +4,8 @@
 #include "NetworkInfo.h"
 #include "NeuronGroupInfo.h"
 #include "NeuronGroup.h"
+#include "PolychronizationRowThread.h"
+#include "RandomStream.h"
 #include "SpikeStreamException.h"
 #include "SpikeStreamIOException.h"
 #include "Util.h"
@@ -13,9 +15,6 @@ using namespace spikestream;
 #include <algorithm>
 using namespace std;
 
-/*! Random integer between 0 and max-1 */
-#define getrandom(max1) ((rand()%(int)((max1))))
-
 /*! Enables debuggging output */
 //#define DEBUG
 
@@ -91,7 +90,7 @@ void IzhikevichNetworkBuilder::addPolychronizationNetwork(){
 	const	int		N  = Ne+Ni;		// total number of neurons
 	const	int		M  = 100;		// the number of synapses per neuron
 	const	int		D  = 20;		// maximal axonal conduction delay
-	int		post[N][M];				// indeces of postsynaptic neurons
+	vector<int>	postVector(N*M);	// indeces of postsynaptic neurons, M for each neuron
 //	float	s[N][M], sd[N][M];		// matrix of synaptic weights and their derivatives
 //	short	delays_length[N][D];	// distribution of delays
 //	short	delays[N][D][M];		// arrangement of delays
@@ -118,38 +117,33 @@ void IzhikevichNetworkBuilder::addPolychronizationNetwork(){
 	for(int i=0; i<synTypeList.size(); ++i)
 		defaultParameterMaps[synTypeList.at(i).getID()] = networkDao.getDefaultSynapseParameters(synTypeList.at(i).getID());
 
-	//Initialize seed
-	int randomSeed = 45;
-	srand(randomSeed);
-
-	//Create connection pattern
-	int exists, r;
-	for (int i=0;i<N;i++){//Work through neurons
-		for (int j=0;j<M;j++) {//Work through all connections per neuron
-			do {
-				exists = 0;		// avoid multiple synapses
-
-				//Excitatory neurons connect to any neurons
-				if (i<Ne)
-					r = getrandom(N);
-
-				//Inhibitory neurons only connect to excitatory neurons
-				else
-					r = getrandom(Ne);// inh -> exc only
-
-				//Check for self connections
-				if (r==i)
-					exists=1;									// no self-synapses
-
-				//Check to see if synapse already exists
-				for (int k=0;k<j;k++)
-					if (post[i][k]==r)
-						exists = 1;	// synapse already exists
-			}
-			while (exists == 1);
-			post[i][j]=r;//Neuron number i, connecion number j connects to neuron number r
+	//Create connection pattern, sharing the neurons out between threads
+	RandomStream seedStream(45);
+	int numberOfThreads = QThread::idealThreadCount();
+	if(numberOfThreads > N)
+		numberOfThreads = N;
+	if(numberOfThreads < 1)
+		numberOfThreads = 1;
+	QList<PolychronizationRowThread*> rowThreadList;
+	for(int i=0; i<numberOfThreads; ++i){
+		PolychronizationRowThread* rowThread = new PolychronizationRowThread(seedStream, Ne, N, M, N * i / numberOfThreads, N * (i + 1) / numberOfThreads, postVector, &stopThread);
+		rowThreadList.append(rowThread);
+		rowThread->start();
+	}
+
+	//Wait for the threads to finish, reporting progress
+	foreach(PolychronizationRowThread* rowThread, rowThreadList){
+		while(!rowThread->wait(200)){
+			int rowsCompleted = 0;
+			foreach(PolychronizationRowThread* tmpThread, rowThreadList)
+				rowsCompleted += tmpThread->getRowsCompleted();
+			emit progress(rowsCompleted, 2 * N, "Creating connection pattern...");
 		}
 	}
+	foreach(PolychronizationRowThread* rowThread, rowThreadList)
+		delete rowThread;
+	if(stopThread)
+		return;
 
 	//Create excitatory and inhibitory neuron groups
 	QHash<QString, double> parameterMap;
@@ -167,14 +161,14 @@ void IzhikevichNetworkBuilder::addPolychronizationNetwork(){
 	float xSpacing = 1.0f, ySpacing = 1.0f, zSpacing = 1.0f;
 	float xPos, yPos, zPos;
 	unsigned numXNeur = 10, numYNeur = 10, numZNeur = 8, neurCtr = 0;
-	Neuron* neuronArray[N];
+	int neuronIndexArray[N];//Index of each neuron in its neuron group
 	for(unsigned xCntr = 0; xCntr < numXNeur; ++xCntr){
 		for(unsigned yCntr = 0; yCntr < numYNeur; ++yCntr){
 			for(unsigned zCntr = 0; zCntr < numZNeur; ++zCntr){
 				xPos = xStart + xCntr*xSpacing;
 				yPos = yStart + yCntr*ySpacing;
 				zPos = zStart + zCntr*zSpacing;
-				neuronArray[neurCtr] = exNeurGrp->addNeuron(xPos, yPos, zPos);
+				neuronIndexArray[neurCtr] = exNeurGrp->addNeuron(xPos, yPos, zPos);
 				#ifdef DEBUG
 					(*logTextStream)<<"nemo_add_neuron(nemoNetwork, "<<neurCtr<<", 0.02, 0.2, -65, 8, -13, -65, 0);"<<endl;
 				#endif//DEBUG
@@ -196,7 +190,7 @@ void IzhikevichNetworkBuilder::addPolychronizationNetwork(){
 				xPos = xStart + xCntr*xSpacing;
 				yPos = yStart + yCntr*ySpacing;
 				zPos = zStart + zCntr*zSpacing;
-				neuronArray[neurCtr] = inhibNeurGrp->addNeuron(xPos, yPos, zPos);
+				neuronIndexArray[neurCtr] = inhibNeurGrp->addNeuron(xPos, yPos, zPos);
 				#ifdef DEBUG
 					(*logTextStream)<<"nemo_add_neuron(nemoNetwork, "<<neurCtr<<", 0.1, 0.2, -65, 2, -13, -65, 0);"<<endl;
 				#endif//DEBUG
@@ -229,31 +223,31 @@ void IzhikevichNetworkBuilder::addPolychronizationNetwork(){
 	conParamMap["Learning"] = 0.0;
 	inhibExcitConGrp->setParameters(conParamMap);
 
-	//Add connections
+	//Add connections in the order of the presynaptic neurons, so that the temporary connection IDs are the same on every build
 	int mOverD = M/D, toNeurIdx;
 	for(int fromNeurIdx=0; fromNeurIdx<N; ++fromNeurIdx){
 		for (int conIdx=0; conIdx<M;++conIdx){//Work through all the connections
 			//Find index of to connection
-			toNeurIdx = post[fromNeurIdx][conIdx];
+			toNeurIdx = postVector[fromNeurIdx*M + conIdx];
 
 			//Couple of checks
 			if(toNeurIdx >= N)
 				throw SpikeStreamException("To neuron index is out of range: " + QString::number(toNeurIdx));
 
 			if(fromNeurIdx < Ne && toNeurIdx < Ne){
-				excitExcitConGrp->addConnection(neuronArray[fromNeurIdx]->getID(), neuronArray[toNeurIdx]->getID(), 1 + conIdx / mOverD, 0.6);
+				excitExcitConGrp->addConnection(exNeurGrp->getNeuronID(neuronIndexArray[fromNeurIdx]), exNeurGrp->getNeuronID(neuronIndexArray[toNeurIdx]), 1 + conIdx / mOverD, 0.6);
 				#ifdef DEBUG
 					(*logTextStream)<<"nemo_add_synapse(nemoNetwork, "<<fromNeurIdx<<", "<<toNeurIdx<<", "<<(1 + conIdx / mOverD)<<", 6, 1, &newNemoSynapseID);"<<endl;
 				#endif//DEBUG
 			}
 			else if(fromNeurIdx < Ne && toNeurIdx >= Ne){
-				excitInhibConGrp->addConnection(neuronArray[fromNeurIdx]->getID(), neuronArray[toNeurIdx]->getID(), 1+ conIdx / mOverD, 0.6);
+				excitInhibConGrp->addConnection(exNeurGrp->getNeuronID(neuronIndexArray[fromNeurIdx]), inhibNeurGrp->getNeuronID(neuronIndexArray[toNeurIdx]), 1+ conIdx / mOverD, 0.6);
 				#ifdef DEBUG
 					(*logTextStream)<<"nemo_add_synapse(nemoNetwork, "<<fromNeurIdx<<", "<<toNeurIdx<<", "<<(1 + conIdx / mOverD)<<", 6, 1, &newNemoSynapseID);"<<endl;
 				#endif//DEBUG
 			}
 			else if(fromNeurIdx >= Ne && toNeurIdx < Ne){
-				inhibExcitConGrp->addConnection(neuronArray[fromNeurIdx]->getID(), neuronArray[toNeurIdx]->getID(), 1, -0.5);
+				inhibExcitConGrp->addConnection(inhibNeurGrp->getNeuronID(neuronIndexArray[fromNeurIdx]), exNeurGrp->getNeuronID(neuronIndexArray[toNeurIdx]), 1, -0.5);
 				#ifdef DEBUG
 					(*logTextStream)<<"nemo_add_synapse(nemoNetwork, "<<fromNeurIdx<<", "<<toNeurIdx<<", 1, -5, 0, &newNemoSynapseID);"<<endl;
 				#endif//DEBUG
@@ -261,6 +255,8 @@ void IzhikevichNetworkBuilder::addPolychronizationNetwork(){
 			else
 				throw SpikeStreamException("Condition not recognized.");
 		}
+		if(fromNeurIdx % 100 == 0)
+			emit progress(N + fromNeurIdx, 2 * N, "Adding connections...");
 	}
 
 	//Add connection groups to network
@@ -0,0 +1,56 @@
+//SpikeStream includes
+#include "PolychronizationRowThread.h"
+using namespace spikestream;
+
+
+/*! Constructor */
+PolychronizationRowThread::PolychronizationRowThread(const RandomStream& seedStream, int numberOfExcitatoryNeurons, int numberOfNeurons, int connectionsPerNeuron, int startFromIndex, int endFromIndex, vector<int>& postVector, bool* stop) :
+		seedStream(seedStream), postVector(postVector) {
+	this->numberOfExcitatoryNeurons = numberOfExcitatoryNeurons;
+	this->numberOfNeurons = numberOfNeurons;
+	this->connectionsPerNeuron = connectionsPerNeuron;
+	this->startFromIndex = startFromIndex;
+	this->endFromIndex = endFromIndex;
+	this->stop = stop;
+	rowsCompleted = 0;
+}
+
+
+/*! Destructor */
+PolychronizationRowThread::~PolychronizationRowThread(){
+}
+
+
+/*----------------------------------------------------------*/
+/*-----                 PUBLIC METHODS                 -----*/
+/*----------------------------------------------------------*/
+
+/*! Run method inherited from QThread.
+	Fills in the postsynaptic neurons of each neuron in the range. */
+void PolychronizationRowThread::run(){
+	rowsCompleted = 0;
+	for(int i = startFromIndex; i < endFromIndex && !*stop; ++i){
+		RandomStream rowStream = seedStream.split(i);
+		int* post = &postVector[(size_t)i * connectionsPerNeuron];
+		for(int j=0; j<connectionsPerNeuron; ++j){
+			int r;
+			bool exists;
+			do{
+				//Excitatory neurons connect to any neurons; inhibitory neurons only connect to excitatory neurons
+				if(i < numberOfExcitatoryNeurons)
+					r = rowStream.nextUInt(numberOfNeurons);
+				else
+					r = rowStream.nextUInt(numberOfExcitatoryNeurons);
+
+				//Avoid self connections and multiple synapses
+				exists = r == i;
+				for(int k=0; k<j && !exists; ++k)
+					if(post[k] == r)
+						exists = true;
+			}
+			while(exists);
+			post[j] = r;
+		}
+		++rowsCompleted;
+	}
+}
@@ -0,0 +1,63 @@
+#ifndef POLYCHRONIZATIONROWTHREAD_H
+#define POLYCHRONIZATIONROWTHREAD_H
+
+//SpikeStream includes
+#include "RandomStream.h"
+
+//Qt includes
+#include <QThread>
+
+//Other includes
+#include <vector>
+using namespace std;
+
+namespace spikestream {
+
+	/*! Chooses the postsynaptic neurons of a range of neurons in the polychronization network.
+		Excitatory neurons connect to any neuron and inhibitory neurons only connect to excitatory neurons,
+		without self connections or repeated connections. The random numbers of each presynaptic neuron are
+		split from the seed stream using the index of the neuron, so the network does not depend on how
+		the neurons are shared out between threads. */
+	class PolychronizationRowThread : public QThread {
+		Q_OBJECT
+
+		public:
+			PolychronizationRowThread(const RandomStream& seedStream, int numberOfExcitatoryNeurons, int numberOfNeurons, int connectionsPerNeuron, int startFromIndex, int endFromIndex, vector<int>& postVector, bool* stop);
+			~PolychronizationRowThread();
+			int getRowsCompleted() { return rowsCompleted; }
+			void run();
+
+		private:
+			//========================  VARIABLES  ========================
+			/*! Stream that is split with the index of each presynaptic neuron */
+			RandomStream seedStream;
+
+			/*! Number of excitatory neurons, which come before the inhibitory neurons */
+			int numberOfExcitatoryNeurons;
+
+			/*! Total number of neurons in the network */
+			int numberOfNeurons;
+
+			/*! Number of postsynaptic neurons of each neuron */
+			int connectionsPerNeuron;
+
+			/*! Index of the first neuron whose postsynaptic neurons are chosen by this thread */
+			int startFromIndex;
+
+			/*! Index after the last neuron whose postsynaptic neurons are chosen by this thread */
+			int endFromIndex;
+
+			/*! Index of the postsynaptic neurons of each neuron, with connectionsPerNeuron entries for each neuron.
+				Shared with the other threads, which fill in different rows. */
+			vector<int>& postVector;
+
+			/*! Stops the thread when set to true. Shared with the thread that launched this one */
+			bool* stop;
+
+			/*! Number of rows that have been filled in */
+			volatile int rowsCompleted;
+	};
+
+}
+
+#endif//POLYCHRONIZATIONROWTHREAD_H
@@ -60,17 +60,17 @@ void TononiNetworkBuilder::addBalduzziTononiFigure5(const QString& networkName,
     //Build neuron group - keep references to neurons
     QHash<QString, double> paramMap;
 	NeuronGroup neurGrp(NeuronGroupInfo(0, "Neuron group 1", "Main neuron group", paramMap, networkDao->getNeuronType(NEURON_TYPE_ID)));
-    Neuron* neur1 = neurGrp.addNeuron(1, 1, 1);
-    Neuron* neur2 = neurGrp.addNeuron(2, 2, 1);
-    Neuron* neur3 = neurGrp.addNeuron(3, 3, 1);
-    Neuron* neur4 = neurGrp.addNeuron(4, 4, 1);
-    Neuron* neur5 = neurGrp.addNeuron(4, 2, 1);
-    Neuron* neur6 = neurGrp.addNeuron(5, 3, 1);
-    Neuron* neur7 = neurGrp.addNeuron(6, 4, 1);
-    Neuron* neur8 = neurGrp.addNeuron(6, 2, 1);
-    Neuron* neur9 = neurGrp.addNeuron(7, 5, 1);
-    Neuron* neur10 = neurGrp.addNeuron(7, 3, 1);
-    Neuron* neur11 = neurGrp.addNeuron(8, 6, 1);
+    int neur1 = neurGrp.addNeuron(1, 1, 1);
+    int neur2 = neurGrp.addNeuron(2, 2, 1);
+    int neur3 = neurGrp.addNeuron(3, 3, 1);
+    int neur4 = neurGrp.addNeuron(4, 4, 1);
+    int neur5 = neurGrp.addNeuron(4, 2, 1);
+    int neur6 = neurGrp.addNeuron(5, 3, 1);
+    int neur7 = neurGrp.addNeuron(6, 4, 1);
+    int neur8 = neurGrp.addNeuron(6, 2, 1);
+    int neur9 = neurGrp.addNeuron(7, 5, 1);
+    int neur10 = neurGrp.addNeuron(7, 3, 1);
+    int neur11 = neurGrp.addNeuron(8, 6, 1);
 
     //Add the neuron group
     DBInfo netDBInfo = networkDao->getDBInfo();
@@ -84,50 +84,50 @@ void TononiNetworkBuilder::addBalduzziTononiFigure5(const QString& networkName,
 
     //Add connections
     //2->1	3->2
-	unsigned con21 = connGrp.addConnection(neur2->getID(), neur1->getID(),  0,  0);
-	unsigned con32 = connGrp.addConnection(neur3->getID(), neur2->getID(),  0,  0);
+	unsigned con21 = connGrp.addConnection(neurGrp.getNeuronID(neur2), neurGrp.getNeuronID(neur1),  0,  0);
+	unsigned con32 = connGrp.addConnection(neurGrp.getNeuronID(neur3), neurGrp.getNeuronID(neur2),  0,  0);
 
     //3->4	3->5	3->6
-	unsigned con34 = connGrp.addConnection(neur3->getID(), neur4->getID(),  0,  0);
-	unsigned con35 = connGrp.addConnection(neur3->getID(), neur5->getID(),  0,  0);
-	unsigned con36 = connGrp.addConnection(neur3->getID(), neur6->getID(),  0,  0);
+	unsigned con34 = connGrp.addConnection(neurGrp.getNeuronID(neur3), neurGrp.getNeuronID(neur4),  0,  0);
+	unsigned con35 = connGrp.addConnection(neurGrp.getNeuronID(neur3), neurGrp.getNeuronID(neur5),  0,  0);
+	unsigned con36 = connGrp.addConnection(neurGrp.getNeuronID(neur3), neurGrp.getNeuronID(neur6),  0,  0);
 
     //4->3	4->5	4->6
-	unsigned con43 = connGrp.addConnection(neur4->getID(), neur3->getID(),  0,  0);
-	unsigned con45 = connGrp.addConnection(neur4->getID(), neur5->getID(),  0,  0);
-	unsigned con46 = connGrp.addConnection(neur4->getID(), neur6->getID(),  0,  0);
+	unsigned con43 = connGrp.addConnection(neurGrp.getNeuronID(neur4), neurGrp.getNeuronID(neur3),  0,  0);
+	unsigned con45 = connGrp.addConnection(neurGrp.getNeuronID(neur4), neurGrp.getNeuronID(neur5),  0,  0);
+	unsigned con46 = connGrp.addConnection(neurGrp.getNeuronID(neur4), neurGrp.getNeuronID(neur6),  0,  0);
 
     //5->3	5->4	5->6
-	unsigned con53 = connGrp.addConnection(neur5->getID(), neur3->getID(),  0,  0);
-	unsigned con54 = connGrp.addConnection(neur5->getID(), neur4->getID(),  0,  0);
-	unsigned con56 = connGrp.addConnection(neur5->getID(), neur6->getID(),  0,  0);
+	unsigned con53 = connGrp.addConnection(neurGrp.getNeuronID(neur5), neurGrp.getNeuronID(neur3),  0,  0);
+	unsigned con54 = connGrp.addConnection(neurGrp.getNeuronID(neur5), neurGrp.getNeuronID(neur4),  0,  0);
+	unsigned con56 = connGrp.addConnection(neurGrp.getNeuronID(neur5), neurGrp.getNeuronID(neur6),  0,  0);
 
     //6->3	6->4	6->5	6->7	6->8	6->10
-	unsigned con63 = connGrp.addConnection(neur6->getID(), neur3->getID(),  0,  0);
-	unsigned con64 = connGrp.addConnection(neur6->getID(), neur4->getID(),  0,  0);
-	unsigned con65 = connGrp.addConnection(neur6->getID(), neur5->getID(),  0,  0);
-	unsigned con67 = connGrp.addConnection(neur6->getID(), neur7->getID(),  0,  0);
-	unsigned con68 = connGrp.addConnection(neur6->getID(), neur8->getID(),  0,  0);
-	unsigned con610 = connGrp.addConnection(neur6->getID(), neur10->getID(),  0,  0);
+	unsigned con63 = connGrp.addConnection(neurGrp.getNeuronID(neur6), neurGrp.getNeuronID(neur3),  0,  0);
+	unsigned con64 = connGrp.addConnection(neurGrp.getNeuronID(neur6), neurGrp.getNeuronID(neur4),  0,  0);
+	unsigned con65 = connGrp.addConnection(neurGrp.getNeuronID(neur6), neurGrp.getNeuronID(neur5),  0,  0);
+	unsigned con67 = connGrp.addConnection(neurGrp.getNeuronID(neur6), neurGrp.getNeuronID(neur7),  0,  0);
+	unsigned con68 = connGrp.addConnection(neurGrp.getNeuronID(neur6), neurGrp.getNeuronID(neur8),  0,  0);
+	unsigned con610 = connGrp.addConnection(neurGrp.getNeuronID(neur6), neurGrp.getNeuronID(neur10),  0,  0);
 
     //7->6	7->8	7->10
-	unsigned con76 = connGrp.addConnection(neur7->getID(), neur6->getID(),  0,  0);
-	unsigned con78 = connGrp.addConnection(neur7->getID(), neur8->getID(),  0,  0);
-	unsigned con710 = connGrp.addConnection(neur7->getID(), neur10->getID(),  0,  0);
+	unsigned con76 = connGrp.addConnection(neurGrp.getNeuronID(neur7), neurGrp.getNeuronID(neur6),  0,  0);
+	unsigned con78 = connGrp.addConnection(neurGrp.getNeuronID(neur7), neurGrp.getNeuronID(neur8),  0,  0);
+	unsigned con710 = connGrp.addConnection(neurGrp.getNeuronID(neur7), neurGrp.getNeuronID(neur10),  0,  0);
 
     //8->6	8->7	8->10
-	unsigned con86 = connGrp.addConnection(neur8->getID(), neur6->getID(),  0,  0);
-	unsigned con87 = connGrp.addConnection(neur8->getID(), neur7->getID(),  0,  0);
-	unsigned con810 = connGrp.addConnection(neur8->getID(), neur10->getID(),  0,  0);
+	unsigned con86 = connGrp.addConnection(neurGrp.getNeuronID(neur8), neurGrp.getNeuronID(neur6),  0,  0);
+	unsigned con87 = connGrp.addConnection(neurGrp.getNeuronID(neur8), neurGrp.getNeuronID(neur7),  0,  0);
+	unsigned con810 = connGrp.addConnection(neurGrp.getNeuronID(neur8), neurGrp.getNeuronID(neur10),  0,  0);
 
     //10->6	10->7	10->8
-	unsigned con106 = connGrp.addConnection(neur10->getID(), neur6->getID(),  0,  0);
-	unsigned con107 = connGrp.addConnection(neur10->getID(), neur7->getID(),  0,  0);
-	unsigned con108 = connGrp.addConnection(neur10->getID(), neur8->getID(),  0,  0);
+	unsigned con106 = connGrp.addConnection(neurGrp.getNeuronID(neur10), neurGrp.getNeuronID(neur6),  0,  0);
+	unsigned con107 = connGrp.addConnection(neurGrp.getNeuronID(neur10), neurGrp.getNeuronID(neur7),  0,  0);
+	unsigned con108 = connGrp.addConnection(neurGrp.getNeuronID(neur10), neurGrp.getNeuronID(neur8),  0,  0);
 
     //9->7	11->9
-	unsigned con97 = connGrp.addConnection(neur9->getID(), neur7->getID(),  0,  0);
-	unsigned con119 = connGrp.addConnection(neur11->getID(), neur9->getID(),  0,  0);
+	unsigned con97 = connGrp.addConnection(neurGrp.getNeuronID(neur9), neurGrp.getNeuronID(neur7),  0,  0);
+	unsigned con119 = connGrp.addConnection(neurGrp.getNeuronID(neur11), neurGrp.getNeuronID(neur9),  0,  0);
 
     netDaoThread.prepareAddConnectionGroup(netInfo.getID(), &connGrp);
     runThread(netDaoThread);
@@ -184,16 +184,16 @@ void TononiNetworkBuilder::addBalduzziTononiFigure5(const QString& networkName,
     //No connections to 11
 
     //Add training - Elements are parity gates that fire when they receive an odd number of spikes
-    addParityGateTraining(neur1->getID(), 1);
-    addParityGateTraining(neur2->getID(), 1);
-    addParityGateTraining(neur3->getID(), 3);
-    addParityGateTraining(neur4->getID(), 3);
-    addParityGateTraining(neur5->getID(), 3);
-    addParityGateTraining(neur6->getID(), 6);
-    addParityGateTraining(neur7->getID(), 4);
-    addParityGateTraining(neur8->getID(), 3);
-    addParityGateTraining(neur9->getID(), 1);
-    addParityGateTraining(neur10->getID(), 3);
+    addParityGateTraining(neurGrp.getNeuronID(neur1), 1);
+    addParityGateTraining(neurGrp.getNeuronID(neur2), 1);
+    addParityGateTraining(neurGrp.getNeuronID(neur3), 3);
+    addParityGateTraining(neurGrp.getNeuronID(neur4), 3);
+    addParityGateTraining(neurGrp.getNeuronID(neur5), 3);
+    addParityGateTraining(neurGrp.getNeuronID(neur6), 6);
+    addParityGateTraining(neurGrp.getNeuronID(neur7), 4);
+    addParityGateTraining(neurGrp.getNeuronID(neur8), 3);
+    addParityGateTraining(neurGrp.getNeuronID(neur9), 1);
+    addParityGateTraining(neurGrp.getNeuronID(neur10), 3);
 
     //Add Archive to hold firing patterns
     ArchiveInfo archiveInfo(0, netInfo.getID(), QDateTime::currentDateTime().toTime_t(), "Single firing pattern present in Balduzzi and Tononi (2008), Figure 5");
@@ -217,7 +217,7 @@ void TononiNetworkBuilder::addBalduzziTononiFigure6(const QString& networkName,
     //Build neuron group - store neurons in order in a list
     QHash<QString, double> paramMap;
 	NeuronGroup neurGrp(NeuronGroupInfo(0, "Neuron group 1", "Main neuron group", paramMap, networkDao->getNeuronType(NEURON_TYPE_ID)));
-    NeuronMap neuronMap;
+    QHash<unsigned int, int> neuronMap;
     neuronMap[1] = neurGrp.addNeuron(1, 2, 1);
     neuronMap[2] = neurGrp.addNeuron(3, 2, 1);
     neuronMap[3] = neurGrp.addNeuron(2, 1, 1);
@@ -236,15 +236,15 @@ void TononiNetworkBuilder::addBalduzziTononiFigure6(const QString& networkName,
     ConnectionGroup connGrp(connGrpInfo);
 
     //Add connections
-	unsigned con12 = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[2]->getID(),  0,  0);
-	unsigned con13 = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[3]->getID(),  0,  0);
-	unsigned con14 = connGrp.addConnection(neuronMap[1]->getID(), neuronMap[4]->getID(),  0,  0);
-	unsigned con21 = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[1]->getID(),  0,  0);
-	unsigned con23 = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[3]->getID(),  0,  0);
-	unsigned con25 = connGrp.addConnection(neuronMap[2]->getID(), neuronMap[5]->getID(),  0,  0);
-	unsigned con31 = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[1]->getID(),  0,  0);
-	unsigned con32 = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[2]->getID(),  0,  0);
-	unsigned con36 = connGrp.addConnection(neuronMap[3]->getID(), neuronMap[6]->getID(),  0,  0);
+	unsigned con12 = connGrp.addConnection(neurGrp.getNeuronID(neuronMap[1]), neurGrp.getNeuronID(neuronMap[2]),  0,  0);
+	unsigned con13 = connGrp.addConnection(neurGrp.getNeuronID(neuronMap[1]), neurGrp.getNeuronID(neuronMap[3]),  0,  0);
+	unsigned con14 = connGrp.addConnection(neurGrp.getNeuronID(neuronMap[1]), neurGrp.getNeuronID(neuronMap[4]),  0,  0);
+	unsigned con21 = connGrp.addConnection(neurGrp.getNeuronID(neuronMap[2]), neurGrp.getNeuronID(neuronMap[1]),  0,  0);
+	unsigned con23 = connGrp.addConnection(neurGrp.getNeuronID(neuronMap[2]), neurGrp.getNeuronID(neuronMap[3]),  0,  0);
+	unsigned con25 = connGrp.addConnection(neurGrp.getNeuronID(neuronMap[2]), neurGrp.getNeuronID(neuronMap[5]),  0,  0);
+	unsigned con31 = connGrp.addConnection(neurGrp.getNeuronID(neuronMap[3]), neurGrp.getNeuronID(neuronMap[1]),  0,  0);
+	unsigned con32 = connGrp.addConnection(neurGrp.getNeuronID(neuronMap[3]), neurGrp.getNeuronID(neuronMap[2]),  0,  0);
+	unsigned con36 = connGrp.addConnection(neurGrp.getNeuronID(neuronMap[3]), neurGrp.getNeuronID(neuronMap[6]),  0,  0);
 
     netDaoThread.prepareAddConnectionGroup(netInfo.getID(), &connGrp);
     runThread(netDaoThread);
@@ -272,29 +272,29 @@ void TononiNetworkBuilder::addBalduzziTononiFigure6(const QString& networkName,
 	networkDao->addWeightlessConnection(connGrp[con36].getID(), 0);
 
     //Add training - 1,2,3 are ANDs; 4,5,6 copy the output of 1,2,3
-    addTraining(neuronMap[1]->getID(), "00", 0);
-    addTraining(neuronMap[1]->getID(), "01", 0);
-    addTraining(neuronMap[1]->getID(), "10", 0);
-    addTraining(neuronMap[1]->getID(), "11", 1);
+    addTraining(neurGrp.getNeuronID(neuronMap[1]), "00", 0);
+    addTraining(neurGrp.getNeuronID(neuronMap[1]), "01", 0);
+    addTraining(neurGrp.getNeuronID(neuronMap[1]), "10", 0);
+    addTraining(neurGrp.getNeuronID(neuronMap[1]), "11", 1);
 
-    addTraining(neuronMap[2]->getID(), "00", 0);
-    addTraining(neuronMap[2]->getID(), "01", 0);
-    addTraining(neuronMap[2]->getID(), "10", 0);
-    addTraining(neuronMap[2]->getID(), "11", 1);
+    addTraining(neurGrp.getNeuronID(neuronMap[2]), "00", 0);
+    addTraining(neurGrp.getNeuronID(neuronMap[2]), "01", 0);
+    addTraining(neurGrp.getNeuronID(neuronMap[2]), "10", 0);
+    addTraining(neurGrp.getNeuronID(neuronMap[2]), "11", 1);
 
-    addTraining(neuronMap[3]->getID(), "00", 0);
-    addTraining(neuronMap[3]->getID(), "01", 0);
-    addTraining(neuronMap[3]->getID(), "10", 0);
-    addTraining(neuronMap[3]->getID(), "11", 1);
+    addTraining(neurGrp.getNeuronID(neuronMap[3]), "00", 0);
+    addTraining(neurGrp.getNeuronID(neuronMap[3]), "01", 0);
+    addTraining(neurGrp.getNeuronID(neuronMap[3]), "10", 0);
+    addTraining(neurGrp.getNeuronID(neuronMap[3]), "11", 1);
 
-    addTraining(neuronMap[4]->getID(), "0", 0);
-    addTraining(neuronMap[4]->getID(), "1", 1);
+    addTraining(neurGrp.getNeuronID(neuronMap[4]), "0", 0);
+    addTraining(neurGrp.getNeuronID(neuronMap[4]), "1", 1);
 
-    addTraining(neuronMap[5]->getID(), "0", 0);
-    addTraining(neuronMap[5]->getID(), "1", 1);
+    addTraining(neurGrp.getNeuronID(neuronMap[5]), "0", 0);
+    addTraining(neurGrp.getNeuronID(neuronMap[5]), "1", 1);
 
-    addTraining(neuronMap[6]->getID(), "0", 0);
-    addTraining(neuronMap[6]->getID(), "1", 1);
+    addTraining(neurGrp.getNeuronID(neuronMap[6]), "0", 0);
+    addTraining(neurGrp.getNeuronID(neuronMap[6]), "1", 1);
 
     //Add Archive to hold firing patterns
     ArchiveInfo archiveInfo(0, netInfo.getID(), QDateTime::currentDateTime().toTime_t(), "Single firing pattern present in Balduzzi and Tononi (2008), Figure 6");
@@ -304,7 +304,7 @@ void TononiNetworkBuilder::addBalduzziTononiFigure6(const QString& networkName,
 	archiveDao->addArchiveData(
 	    archiveInfo.getID(),
 	    1,//Time step 1
-	    QString::number(neuronMap[3]->getID()) + "," + QString::number(neuronMap[4]->getID()) + "," + QString::number(neuronMap[5]->getID()) //001110
+	    QString::number(neurGrp.getNeuronID(neuronMap[3])) + "," + QString::number(neurGrp.getNeuronID(neuronMap[4])) + "," + QString::number(neurGrp.getNeuronID(neuronMap[5])) //001110
     );
 }
 
@@ -324,14 +324,14 @@ void TononiNetworkBuilder::addBalduzziTononiFigure12(const QString& networkName,
     //Build neuron group - keep references to neurons
     QHash<QString, double> paramMap;
 	NeuronGroup neurGrp(NeuronGroupInfo(0, "Neuron group 1", "Main neuron group", paramMap, networkDao->getNeuronType(NEURON_TYPE_ID)));
-    Neuron* neur1 = neurGrp.addNeuron(2, 4, 1);
-    Neuron* neur2 = neurGrp.addNeuron(3, 4, 1);
-    Neuron* neur3 = neurGrp.addNeuron(4, 3, 1);
-    Neuron* neur4 = neurGrp.addNeuron(4, 2, 1);
-    Neuron* neur5 = neurGrp.addNeuron(3, 1, 1);
-    Neuron* neur6 = neurGrp.addNeuron(2, 1, 1);
-    Neuron* neur7 = neurGrp.addNeuron(1, 2, 1);
-    Neuron* neur8 = neurGrp.addNeuron(1, 3, 1);
+    int neur1 = neurGrp.addNeuron(2, 4, 1);
+    int neur2 = neurGrp.addNeuron(3, 4, 1);
+    int neur3 = neurGrp.addNeuron(4, 3, 1);
+    int neur4 = neurGrp.addNeuron(4, 2, 1);
+    int neur5 = neurGrp.addNeuron(3, 1, 1);
+    int neur6 = neurGrp.addNeuron(2, 1, 1);
+    int neur7 = neurGrp.addNeuron(1, 2, 1);
+    int neur8 = neurGrp.addNeuron(1, 3, 1);
 
     //Add the neuron group
     DBInfo netDBInfo = networkDao->getDBInfo();
@@ -344,20 +344,20 @@ void TononiNetworkBuilder::addBalduzziTononiFigure12(const QString& networkName,
     ConnectionGroup connGrp(connGrpInfo);
 
     //Add connections
-	unsigned con17 = connGrp.addConnection(neur1->getID(), neur7->getID(),  0,  0);
-	unsigned con21 = connGrp.addConnection(neur2->getID(), neur1->getID(),  0,  0);
-	unsigned con34 = connGrp.addConnection(neur3->getID(), neur4->getID(),  0,  0);
-	unsigned con37 = connGrp.addConnection(neur3->getID(), neur7->getID(),  0,  0);
+	unsigned con17 = connGrp.addConnection(neurGrp.getNeuronID(neur1), neurGrp.getNeuronID(neur7),  0,  0);
+	unsigned con21 = connGrp.addConnection(neurGrp.getNeuronID(neur2), neurGrp.getNeuronID(neur1),  0,  0);
+	unsigned con34 = connGrp.addConnection(neurGrp.getNeuronID(neur3), neurGrp.getNeuronID(neur4),  0,  0);
+	unsigned con37 = connGrp.addConnection(neurGrp.getNeuronID(neur3), neurGrp.getNeuronID(neur7),  0,  0);
 
-	unsigned con38 = connGrp.addConnection(neur3->getID(), neur8->getID(),  0,  0);
-	unsigned con42 = connGrp.addConnection(neur4->getID(), neur2->getID(),  0,  0);
-	unsigned con54 = connGrp.addConnection(neur5->getID(), neur4->getID(),  0,  0);
-	unsigned con62 = connGrp.addConnection(neur6->getID(), neur2->getID(),  0,  0);
+	unsigned con38 = connGrp.addConnection(neurGrp.getNeuronID(neur3), neurGrp.getNeuronID(neur8),  0,  0);
+	unsigned con42 = connGrp.addConnection(neurGrp.getNeuronID(neur4), neurGrp.getNeuronID(neur2),  0,  0);
+	unsigned con54 = connGrp.addConnection(neurGrp.getNeuronID(neur5), neurGrp.getNeuronID(neur4),  0,  0);
+	unsigned con62 = connGrp.addConnection(neurGrp.getNeuronID(neur6), neurGrp.getNeuronID(neur2),  0,  0);
 
-	unsigned con65 = connGrp.addConnection(neur6->getID(), neur5->getID(),  0,  0);
-	unsigned con78 = connGrp.addConnection(neur7->getID(), neur8->getID(),  0,  0);
-	unsigned con81 = connGrp.addConnection(neur8->getID(), neur1->getID(),  0,  0);
-	unsigned con85 = connGrp.addConnection(neur8->getID(), neur5->getID(),  0,  0);
+	unsigned con65 = connGrp.addConnection(neurGrp.getNeuronID(neur6), neurGrp.getNeuronID(neur5),  0,  0);
+	unsigned con78 = connGrp.addConnection(neurGrp.getNeuronID(neur7), neurGrp.getNeuronID(neur8),  0,  0);
+	unsigned con81 = connGrp.addConnection(neurGrp.getNeuronID(neur8), neurGrp.getNeuronID(neur1),  0,  0);
+	unsigned con85 = connGrp.addConnection(neurGrp.getNeuronID(neur8), neurGrp.getNeuronID(neur5),  0,  0);
 
     netDaoThread.prepareAddConnectionGroup(netInfo.getID(), &connGrp);
     runThread(netDaoThread);
@@ -392,35 +392,35 @@ void TononiNetworkBuilder::addBalduzziTononiFigure12(const QString& networkName,
 	networkDao->addWeightlessConnection(connGrp[con78].getID(), 1);
 
     //Add training - all are ANDs, but 3 and 6 don't receive any connections, so don't need training
-    addTraining(neur1->getID(), "00", 0);
-    addTraining(neur1->getID(), "01", 0);
-    addTraining(neur1->getID(), "10", 0);
-    addTraining(neur1->getID(), "11", 1);
-
-    addTraining(neur2->getID(), "00", 0);
-    addTraining(neur2->getID(), "01", 0);
-    addTraining(neur2->getID(), "10", 0);
-    addTraining(neur2->getID(), "11", 1);
-
-    addTraining(neur4->getID(), "00", 0);
-    addTraining(neur4->getID(), "01", 0);
-    addTraining(neur4->getID(), "10", 0);
-    addTraining(neur4->getID(), "11", 1);
-
-    addTraining(neur5->getID(), "00", 0);
-    addTraining(neur5->getID(), "01", 0);
-    addTraining(neur5->getID(), "10", 0);
-    addTraining(neur5->getID(), "11", 1);
-
-    addTraining(neur7->getID(), "00", 0);
-    addTraining(neur7->getID(), "01", 0);
-    addTraining(neur7->getID(), "10", 0);
-    addTraining(neur7->getID(), "11", 1);
-
-    addTraining(neur8->getID(), "00", 0);
-    addTraining(neur8->getID(), "01", 0);
-    addTraining(neur8->getID(), "10", 0);
-    addTraining(neur8->getID(), "11", 1);
+    addTraining(neurGrp.getNeuronID(neur1), "00", 0);
+    addTraining(neurGrp.getNeuronID(neur1), "01", 0);
+    addTraining(neurGrp.getNeuronID(neur1), "10", 0);
+    addTraining(neurGrp.getNeuronID(neur1), "11", 1);
+
+    addTraining(neurGrp.getNeuronID(neur2), "00", 0);
+    addTraining(neurGrp.getNeuronID(neur2), "01", 0);
+    addTraining(neurGrp.getNeuronID(neur2), "10", 0);
+    addTraining(neurGrp.getNeuronID(neur2), "11", 1);
+
+    addTraining(neurGrp.getNeuronID(neur4), "00", 0);
+    addTraining(neurGrp.getNeuronID(neur4), "01", 0);
+    addTraining(neurGrp.getNeuronID(neur4), "10", 0);
+    addTraining(neurGrp.getNeuronID(neur4), "11", 1);
+
+    addTraining(neurGrp.getNeuronID(neur5), "00", 0);
+    addTraining(neurGrp.getNeuronID(neur5), "01", 0);
+    addTraining(neurGrp.getNeuronID(neur5), "10", 0);
+    addTraining(neurGrp.getNeuronID(neur5), "11", 1);
+
+    addTraining(neurGrp.getNeuronID(neur7), "00", 0);
+    addTraining(neurGrp.getNeuronID(neur7), "01", 0);
+    addTraining(neurGrp.getNeuronID(neur7), "10", 0);
+    addTraining(neurGrp.getNeuronID(neur7), "11", 1);
+
+    addTraining(neurGrp.getNeuronID(neur8), "00", 0);
+    addTraining(neurGrp.getNeuronID(neur8), "01", 0);
+    addTraining(neurGrp.getNeuronID(neur8), "10", 0);
+    addTraining(neurGrp.getNeuronID(neur8), "11", 1);
 
     //Add Archive to hold firing patterns
     ArchiveInfo archiveInfo(0, netInfo.getID(), QDateTime::currentDateTime().toTime_t(), "Single firing pattern present in Balduzzi and Tononi (2008), Figure 12");
@@ -430,7 +430,7 @@ void TononiNetworkBuilder::addBalduzziTononiFigure12(const QString& networkName,
 	archiveDao->addArchiveData(
 	    archiveInfo.getID(),
 	    1,//Time step 1
-	    QString::number(neur4->getID()) + "," + QString::number(neur5->getID()) //000110000
+	    QString::number(neurGrp.getNeuronID(neur4)) + "," + QString::number(neurGrp.getNeuronID(neur5)) //000110000
     );
 }
 
@@ -460,18 +460,18 @@ void TononiNetworkBuilder::addBalduzziTononiFigure13(const QString& networkName,
     //Build neuron group - keep references to neurons
     QHash<QString, double> paramMap;
 	NeuronGroup neurGrp(NeuronGroupInfo(0, "Neuron group 1", "Main neuron group", paramMap, networkDao->getNeuronType(NEURON_TYPE_ID)));
-    Neuron* neur1 = neurGrp.addNeuron(1, 4, 1);
-    Neuron* neur2 = neurGrp.addNeuron(3, 4, 1);
-    Neuron* neur3 = neurGrp.addNeuron(2, 3, 1);
-    Neuron* neur4 = neurGrp.addNeuron(5, 4, 1);
-    Neuron* neur5 = neurGrp.addNeuron(7, 4, 1);
-    Neuron* neur6 = neurGrp.addNeuron(6, 3, 1);
-    Neuron* neur7 = neurGrp.addNeuron(6, 2, 1);
-    Neuron* neur8 = neurGrp.addNeuron(7, 1, 1);
-    Neuron* neur9 = neurGrp.addNeuron(5, 1, 1);
-    Neuron* neur10 = neurGrp.addNeuron(2, 2, 1);
-    Neuron* neur11 = neurGrp.addNeuron(3, 1, 1);
-    Neuron* neur12 = neurGrp.addNeuron(1, 1, 1);
+    int neur1 = neurGrp.addNeuron(1, 4, 1);
+    int neur2 = neurGrp.addNeuron(3, 4, 1);
+    int neur3 = neurGrp.addNeuron(2, 3, 1);
+    int neur4 = neurGrp.addNeuron(5, 4, 1);
+    int neur5 = neurGrp.addNeuron(7, 4, 1);
+    int neur6 = neurGrp.addNeuron(6, 3, 1);
+    int neur7 = neurGrp.addNeuron(6, 2, 1);
+    int neur8 = neurGrp.addNeuron(7, 1, 1);
+    int neur9 = neurGrp.addNeuron(5, 1, 1);
+    int neur10 = neurGrp.addNeuron(2, 2, 1);
+    int neur11 = neurGrp.addNeuron(3, 1, 1);
+    int neur12 = neurGrp.addNeuron(1, 1, 1);
 
     //Add the neuron group
     DBInfo netDBInfo = networkDao->getDBInfo();
@@ -484,60 +484,60 @@ void TononiNetworkBuilder::addBalduzziTononiFigure13(const QString& networkName,
     ConnectionGroup connGrp(connGrpInfo);
 
     //1->2	1->3
-	unsigned con12 = connGrp.addConnection(neur1->getID(), neur2->getID(),  0,  0);
-	unsigned con13 = connGrp.addConnection(neur1->getID(), neur3->getID(),  0,  0);
+	unsigned con12 = connGrp.addConnection(neurGrp.getNeuronID(neur1), neurGrp.getNeuronID(neur2),  0,  0);
+	unsigned con13 = connGrp.addConnection(neurGrp.getNeuronID(neur1), neurGrp.getNeuronID(neur3),  0,  0);
 
     //2->1	2->3
-	unsigned con21 = connGrp.addConnection(neur2->getID(), neur1->getID(),  0,  0);
-	unsigned con23 = connGrp.addConnection(neur2->getID(), neur3->getID(),  0,  0);
+	unsigned con21 = connGrp.addConnection(neurGrp.getNeuronID(neur2), neurGrp.getNeuronID(neur1),  0,  0);
+	unsigned con23 = connGrp.addConnection(neurGrp.getNeuronID(neur2), neurGrp.getNeuronID(neur3),  0,  0);
 
     //3->1	3->2	3->6	3->7
-	unsigned con31 = connGrp.addConnection(neur3->getID(), neur1->getID(),  0,  0);
-	unsigned con32 = connGrp.addConnection(neur3->getID(), neur2->getID(),  0,  0);
-	unsigned con36 = connGrp.addConnection(neur3->getID(), neur6->getID(),  0,  0);
-	unsigned con37 = connGrp.addConnection(neur3->getID(), neur7->getID(),  0,  0);
+	unsigned con31 = connGrp.addConnection(neurGrp.getNeuronID(neur3), neurGrp.getNeuronID(neur1),  0,  0);
+	unsigned con32 = connGrp.addConnection(neurGrp.getNeuronID(neur3), neurGrp.getNeuronID(neur2),  0,  0);
+	unsigned con36 = connGrp.addConnection(neurGrp.getNeuronID(neur3), neurGrp.getNeuronID(neur6),  0,  0);
+	unsigned con37 = connGrp.addConnection(neurGrp.getNeuronID(neur3), neurGrp.getNeuronID(neur7),  0,  0);
 
     //4->5	4->6
-	unsigned con45 = connGrp.addConnection(neur4->getID(), neur5->getID(),  0,  0);
-	unsigned con46 = connGrp.addConnection(neur4->getID(), neur6->getID(),  0,  0);
+	unsigned con45 = connGrp.addConnection(neurGrp.getNeuronID(neur4), neurGrp.getNeuronID(neur5),  0,  0);
+	unsigned con46 = connGrp.addConnection(neurGrp.getNeuronID(neur4), neurGrp.getNeuronID(neur6),  0,  0);
 
     //5->4	5->6
-	unsigned con54 = connGrp.addConnection(neur5->getID(), neur4->getID(),  0,  0);
-	unsigned con56 = connGrp.addConnection(neur5->getID(), neur6->getID(),  0,  0);
+	unsigned con54 = connGrp.addConnection(neurGrp.getNeuronID(neur5), neurGrp.getNeuronID(neur4),  0,  0);
+	unsigned con56 = connGrp.addConnection(neurGrp.getNeuronID(neur5), neurGrp.getNeuronID(neur6),  0,  0);
 
     //6->3	6->4	6->5	6->10
-	unsigned con63 = connGrp.addConnection(neur6->getID(), neur3->getID(),  0,  0);
-	unsigned con64 = connGrp.addConnection(neur6->getID(), neur4->getID(),  0,  0);
-	unsigned con65 = connGrp.addConnection(neur6->getID(), neur5->getID(),  0,  0);
-	unsigned con610 = connGrp.addConnection(neur6->getID(), neur10->getID(),  0,  0);
+	unsigned con63 = connGrp.addConnection(neurGrp.getNeuronID(neur6), neurGrp.getNeuronID(neur3),  0,  0);
+	unsigned con64 = connGrp.addConnection(neurGrp.getNeuronID(neur6), neurGrp.getNeuronID(neur4),  0,  0);
+	unsigned con65 = connGrp.addConnection(neurGrp.getNeuronID(neur6), neurGrp.getNeuronID(neur5),  0,  0);
+	unsigned con610 = connGrp.addConnection(neurGrp.getNeuronID(neur6), neurGrp.getNeuronID(neur10),  0,  0);
 
     //7->3	7->8	7->9	7->10
-	unsigned con73 = connGrp.addConnection(neur7->getID(), neur3->getID(),  0,  0);
-	unsigned con78 = connGrp.addConnection(neur7->getID(), neur8->getID(),  0,  0);
-	unsigned con79 = connGrp.addConnection(neur7->getID(), neur9->getID(),  0,  0);
-	unsigned con710 = connGrp.addConnection(neur7->getID(), neur10->getID(),  0,  0);
+	unsigned con73 = connGrp.addConnection(neurGrp.getNeuronID(neur7), neurGrp.getNeuronID(neur3),  0,  0);
+	unsigned con78 = connGrp.addConnection(neurGrp.getNeuronID(neur7), neurGrp.getNeuronID(neur8),  0,  0);
+	unsigned con79 = connGrp.addConnection(neurGrp.getNeuronID(neur7), neurGrp.getNeuronID(neur9),  0,  0);
+	unsigned con710 = connGrp.addConnection(neurGrp.getNeuronID(neur7), neurGrp.getNeuronID(neur10),  0,  0);
 
     //8->7	8->9
-	unsigned con87 = connGrp.addConnection(neur8->getID(), neur7->getID(),  0,  0);
-	unsigned con89 = connGrp.addConnection(neur8->getID(), neur9->getID(),  0,  0);
+	unsigned con87 = connGrp.addConnection(neurGrp.getNeuronID(neur8), neurGrp.getNeuronID(neur7),  0,  0);
+	unsigned con89 = connGrp.addConnection(neurGrp.getNeuronID(neur8), neurGrp.getNeuronID(neur9),  0,  0);
 
     //9->7	9->8
-	unsigned con97 = connGrp.addConnection(neur9->getID(), neur7->getID(),  0,  0);
-	unsigned con98 = connGrp.addConnection(neur9->getID(), neur8->getID(),  0,  0);
+	unsigned con97 = connGrp.addConnection(neurGrp.getNeuronID(neur9), neurGrp.getNeuronID(neur7),  0,  0);
+	unsigned con98 = connGrp.addConnection(neurGrp.getNeuronID(neur9), neurGrp.getNeuronID(neur8),  0,  0);
 
     //10->6	10->7	10->11	10->12
-	unsigned con106 = connGrp.addConnection(neur10->getID(), neur6->getID(),  0,  0);
-	unsigned con107 = connGrp.addConnection(neur10->getID(), neur7->getID(),  0,  0);
-	unsigned con1011 = connGrp.addConnection(neur10->getID(), neur11->getID(),  0,  0);
-	unsigned con1012 = connGrp.addConnection(neur10->getID(), neur12->getID(),  0,  0);
+	unsigned con106 = connGrp.addConnection(neurGrp.getNeuronID(neur10), neurGrp.getNeuronID(neur6),  0,  0);
+	unsigned con107 = connGrp.addConnection(neurGrp.getNeuronID(neur10), neurGrp.getNeuronID(neur7),  0,  0);
+	unsigned con1011 = connGrp.addConnection(neurGrp.getNeuronID(neur10), neurGrp.getNeuronID(neur11),  0,  0);
+	unsigned con1012 = connGrp.addConnection(neurGrp.getNeuronID(neur10), neurGrp.getNeuronID(neur12),  0,  0);
 
     //11->10	11->12
-	unsigned con1110 = connGrp.addConnection(neur11->getID(), neur10->getID(),  0,  0);
-	unsigned con1112 = connGrp.addConnection(neur11->getID(), neur12->getID(),  0,  0);
+	unsigned con1110 = connGrp.addConnection(neurGrp.getNeuronID(neur11), neurGrp.getNeuronID(neur10),  0,  0);
+	unsigned con1112 = connGrp.addConnection(neurGrp.getNeuronID(neur11), neurGrp.getNeuronID(neur12),  0,  0);
 
     //12->10	12->11
-	unsigned con1210 = connGrp.addConnection(neur12->getID(), neur10->getID(),  0,  0);
-	unsigned con1211 = connGrp.addConnection(neur12->getID(), neur11->getID(),  0,  0);
+	unsigned con1210 = connGrp.addConnection(neurGrp.getNeuronID(neur12), neurGrp.getNeuronID(neur10),  0,  0);
+	unsigned con1211 = connGrp.addConnection(neurGrp.getNeuronID(neur12), neurGrp.getNeuronID(neur11),  0,  0);
 
     netDaoThread.prepareAddConnectionGroup(netInfo.getID(), &connGrp);
     runThread(netDaoThread);
@@ -601,18 +601,18 @@ void TononiNetworkBuilder::addBalduzziTononiFigure13(const QString& networkName,
 	networkDao->addWeightlessConnection(connGrp[con1112].getID(), 1);
 
     //Add training - Elements fire when they receive two or more spikes
-    addTwoOrMoreTraining(neur1->getID(), 2);
-    addTwoOrMoreTraining(neur2->getID(), 2);
-    addTwoOrMoreTraining(neur3->getID(), 4);
-    addTwoOrMoreTraining(neur4->getID(), 2);
-    addTwoOrMoreTraining(neur5->getID(), 2);
-    addTwoOrMoreTraining(neur6->getID(), 4);
-    addTwoOrMoreTraining(neur7->getID(), 4);
-    addTwoOrMoreTraining(neur8->getID(), 2);
-    addTwoOrMoreTraining(neur9->getID(), 2);
-    addTwoOrMoreTraining(neur10->getID(), 4);
-    addTwoOrMoreTraining(neur11->getID(), 2);
-    addTwoOrMoreTraining(neur12->getID(), 2);
+    addTwoOrMoreTraining(neurGrp.getNeuronID(neur1), 2);
+    addTwoOrMoreTraining(neurGrp.getNeuronID(neur2), 2);
+    addTwoOrMoreTraining(neurGrp.getNeuronID(neur3), 4);
+    addTwoOrMoreTraining(neurGrp.getNeuronID(neur4), 2);
+    addTwoOrMoreTraining(neurGrp.getNeuronID(neur5), 2);
+    addTwoOrMoreTraining(neurGrp.getNeuronID(neur6), 4);
+    addTwoOrMoreTraining(neurGrp.getNeuronID(neur7), 4);
+    addTwoOrMoreTraining(neurGrp.getNeuronID(neur8), 2);
+    addTwoOrMoreTraining(neurGrp.getNeuronID(neur9), 2);
+    addTwoOrMoreTraining(neurGrp.getNeuronID(neur10), 4);
+    addTwoOrMoreTraining(neurGrp.getNeuronID(neur11), 2);
+    addTwoOrMoreTraining(neurGrp.getNeuronID(neur12), 2);
 
     //Add Archive to hold firing patterns
     ArchiveInfo archiveInfo(0, netInfo.getID(), QDateTime::currentDateTime().toTime_t(), "Single firing pattern present in Balduzzi and Tononi (2008), Figure 5");
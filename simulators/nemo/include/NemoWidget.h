@@ -70,7 +70,7 @@ namespace spikestream {
 			void unloadSimulation(bool confirmWithUser=true);
 			void updateProgress(int stepsCompleted, int totalSteps);
 			void updateTimeStep(unsigned int timeStep);
-			void updateTimeStep(unsigned int timeStep, const QList<unsigned>& neuronIDList);
+			void updateTimeStep(const SpikeFramePtr& spikeFrame);
 			void updateTimeStep(unsigned int timeStep, const QHash<unsigned, float>& membranePotentialMap);
 
 		private:
@@ -162,8 +162,8 @@ namespace spikestream {
 			/*! Records if task has been cancelled */
 			bool taskCancelled;
 
-			/*! The colour of neurons that are currently firing */
-			RGBColor* neuronColor;
+			/*! Index in the network display's palette of the colour of neurons that are currently firing */
+			unsigned char firingNeuronColorIndex;
 
 			/*! Timer to check on loading progress */
 			QTimer* loadingTimer;
@@ -209,9 +209,16 @@ namespace spikestream {
 			/*! Map linking file path with patterns */
 			QHash<QString, Pattern> patternMap;
 
-			/*! Map with colours for plotting heat maps.
-				indexes range from 0 to 10 inclusive with increasing temperature. */
-			QHash<int, RGBColor*> heatColorMap;
+			/*! Lowest membrane potential in the membrane potential colour table */
+			static const int MIN_MEM_POT_COLOR = -90;
+
+			/*! Number of entries in the membrane potential colour table */
+			static const int MEM_POT_COLOR_TABLE_SIZE = 112;
+
+			/*! Table holding the index in the network display's palette of the heat map colour of each membrane potential.
+				Entry i holds the colour of potentials from MIN_MEM_POT_COLOR + i up to MIN_MEM_POT_COLOR + i + 1.
+				Potentials outside the table have the colour of the first or last entry. */
+			unsigned char memPotColorIndexArray[MEM_POT_COLOR_TABLE_SIZE];
 
 			/*! Counter used to give a unique name to the raster dialogs */
 			unsigned rasterDialogCtr;
@@ -223,9 +230,9 @@ namespace spikestream {
 			/*! Button to plot membrane potential graph for selected neuron */
 			QPushButton* memPotGraphButton;
 
-			/*! Map of the currently open membrane potential graph dialogs
-				The key is the unique id from the counter. */
-			QHash<unsigned,  MembranePotentialGraphDialog*> memPotGraphDialogMap;
+			/*! The open membrane potential graph dialog, which plots all of the neurons that have been selected.
+				NULL if the dialog is not open. */
+			MembranePotentialGraphDialog* memPotGraphDialog;
 
 			//=======================  METHODS  =========================
 			bool checkForErrors();
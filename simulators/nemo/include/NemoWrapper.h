@@ -9,6 +9,7 @@
 #include "NetworkDao.h"
 #include "ParameterInfo.h"
 #include "Pattern.h"
+#include "SpikeFrame.h"
 #include "SpikeStreamTypes.h"
 
 //Qt includes
@@ -42,7 +43,7 @@ namespace spikestream {
 			unsigned getArchiveID() { return archiveInfo.getID(); }
 			int getCurrentTask() { return currentTaskID; }
 			QString getErrorMessage() { return errorMessage; }
-			QList<neurid_t> getFiringNeuronIDs() { return firingNeuronList; }
+			QList<neurid_t> getFiringNeuronIDs();
 			nemo_configuration_t getNemoConfig(){ return nemoConfig; }
 			unsigned getSTDPFunctionID() { return stdpFunctionID; }
 			timestep_t getTimeStep() { return timeStepCounter; }
@@ -108,7 +109,7 @@ namespace spikestream {
 			void progress(int stepsComplete, int totalSteps);
 			void simulationStopped();
 			void timeStepChanged(unsigned int timeStep);
-			void timeStepChanged(unsigned int timeStep, const QList<unsigned>& neuronIDList);
+			void timeStepChanged(const SpikeFramePtr& spikeFrame);
 			void timeStepChanged(unsigned int timeStep, const QHash<unsigned, float>& membranePotentialMap);
 
 
@@ -189,7 +190,11 @@ namespace spikestream {
 			/*! ID of the STDP function */
 			unsigned stdpFunctionID;
 
-			/*! List of neurons that are firing at the current time step */
+			/*! Neurons that are firing at the current time step. The frame is shared with the classes that display the firing neurons */
+			SpikeFramePtr spikeFrame;
+
+			/*! List of neurons that are firing at the current time step. Only filled when the firing neurons
+				are archived or passed to device managers */
 			QList<neurid_t> firingNeuronList;
 
 			/*! Map of neuron groups to inject firing noise into at the next time step.
@@ -92,7 +92,6 @@ HEADERS += include/NemoWrapper.h \
 			include/StandardSTDPFunction.h \
 			include/AbstractSTDPFunction.h \
 			include/Pattern.h \
-			include/RasterModel.h \
 			include/StepSTDPFunction.h
 SOURCES += src/model/NemoWrapper.cpp \
 			src/model/NemoLoader.cpp \
@@ -100,13 +99,6 @@ SOURCES += src/model/NemoWrapper.cpp \
 			src/model/StandardSTDPFunction.cpp \
 			src/model/AbstractSTDPFunction.cpp \
 			src/model/Pattern.cpp \
-			src/model/RasterModel.cpp \
 			src/model/StepSTDPFunction.cpp
 
-#----------------------------------------------#
-#-----               View                 -----#
-#----------------------------------------------#
-HEADERS += include/RasterView.h
-SOURCES += src/views/RasterView.cpp
-
 
@@ -22,6 +22,9 @@ using namespace spikestream;
 #include <QMessageBox>
 #include <QMutexLocker>
 
+//Other includes
+#include <cmath>
+
 /*! String user selects to load a pattern */
 #define LOAD_PATTERN_STRING "Load Pattern"
 
@@ -47,9 +50,12 @@ extern "C" {
 /*! Constructor */
 NemoWidget::NemoWidget(QWidget* parent) : QWidget(parent) {
 	//Register types to enable signals and slots to work
-	qRegisterMetaType< QList<unsigned> >("QList<unsigned>");
+	qRegisterMetaType<SpikeFramePtr>("SpikeFramePtr");
 	qRegisterMetaType< QHash<unsigned, float> >("QHash<unsigned, float>");
 
+	//Membrane potential graph dialog is created when it is first needed
+	memPotGraphDialog = NULL;
+
 	//Create colours to be used for membrane potential
 	createMembranePotentialColors();
 
@@ -247,7 +253,7 @@ NemoWidget::NemoWidget(QWidget* parent) : QWidget(parent) {
 	connect(nemoWrapper, SIGNAL(progress(int,int)), this, SLOT(updateProgress(int, int)), Qt::QueuedConnection);
 	connect(nemoWrapper, SIGNAL(simulationStopped()), this, SLOT(simulationStopped()), Qt::QueuedConnection);
 	connect(nemoWrapper, SIGNAL(timeStepChanged(unsigned)), this, SLOT(updateTimeStep(unsigned)), Qt::QueuedConnection);
-	connect(nemoWrapper, SIGNAL(timeStepChanged(unsigned, const QList<unsigned>&)), this, SLOT(updateTimeStep(unsigned, const QList<unsigned>&)), Qt::QueuedConnection);
+	connect(nemoWrapper, SIGNAL(timeStepChanged(const SpikeFramePtr&)), this, SLOT(updateTimeStep(const SpikeFramePtr&)), Qt::QueuedConnection);
 	connect(nemoWrapper, SIGNAL(timeStepChanged(unsigned, const QHash<unsigned, float>&)), this, SLOT(updateTimeStep(unsigned, const QHash<unsigned, float>&)), Qt::QueuedConnection);
 
 	//Pass device managers to NeMo wrapper
@@ -283,9 +289,6 @@ NemoWidget::NemoWidget(QWidget* parent) : QWidget(parent) {
 /*! Destructor */
 NemoWidget::~NemoWidget(){
 	delete nemoWrapper;
-	for(QHash<int, RGBColor*>::iterator iter = heatColorMap.begin(); iter != heatColorMap.end(); ++iter)
-		delete iter.value();
-	heatColorMap.clear();
 }
 
 
@@ -457,13 +460,12 @@ void NemoWidget::checkSaveWeightsProgress(){
 /*! Deletes the raster plot dialog that invoked this slot.
 	Should be triggered when the plot dialog is closed.  */
 void NemoWidget::deleteMembranePotentialGraphDialog(int){
-	unsigned tmpID = sender()->objectName().toUInt();
-	qDebug()<<"Deleting Membrane potential graph dialog with ID: "<<tmpID;
-	if(!memPotGraphDialogMap.contains(tmpID)){
-		qCritical()<<"Raster dialog not found: ID="<<tmpID;
+	qDebug()<<"Deleting Membrane potential graph dialog";
+	if(sender() != memPotGraphDialog){
+		qCritical()<<"Membrane potential graph dialog not found.";
 		return;
 	}
-	memPotGraphDialogMap.remove(tmpID);
+	memPotGraphDialog = NULL;
 }
 
 
@@ -578,7 +580,7 @@ void NemoWidget::loadSimulation(){
 
 	try{
 		//Store the current neuron colour for monitoring
-		neuronColor = Globals::getNetworkDisplay()->getSimulationFiringNeuronColor();
+		firingNeuronColorIndex = Globals::getNetworkDisplay()->addPaletteColor(*Globals::getNetworkDisplay()->getSimulationFiringNeuronColor());
 
 		//Start loading of simulation
 		taskCancelled = false;
@@ -600,8 +602,8 @@ void NemoWidget::loadSimulation(){
 
 
 
-/*! Called when the raster button is clicked.
-	Launches a dialog to select the  neuron groups to monitor and then launches a raster plot dialog. */
+/*! Called when the membrane potential graph button is clicked.
+	Plots the selected neuron in the open membrane potential graph dialog, launching the dialog if it is not open. */
 void NemoWidget::memPotGraphButtonClicked(){
 	//Get ID of current neuron
 	neurid_t neurID = Globals::getNetworkDisplay()->getSingleNeuronID();
@@ -610,21 +612,18 @@ void NemoWidget::memPotGraphButtonClicked(){
 		return;
 	}
 
-	//Do nothing if we are already monitoring this neuron
-	if(memPotGraphDialogMap.contains(neurID)){
-		qDebug()<<"Already monitoring this neuron";
-		return;
-	}
-
 	try{
-		//Create raster dialog
-		MembranePotentialGraphDialog* memPotDlg = new MembranePotentialGraphDialog(neurID, this);
-		memPotDlg->setObjectName(QString::number(neurID));
-		connect(memPotDlg, SIGNAL(finished(int)), this, SLOT(deleteMembranePotentialGraphDialog(int)));
-		memPotDlg->show();
+		//Add the neuron to the open graph, which ignores neurons that it is already plotting
+		if(memPotGraphDialog != NULL){
+			memPotGraphDialog->addNeuron(neurID);
+			memPotGraphDialog->raise();
+			return;
+		}
 
-		//Store details so that we can update it
-		memPotGraphDialogMap[neurID] = memPotDlg;
+		//Create graph dialog and store it so that we can update it
+		memPotGraphDialog = new MembranePotentialGraphDialog(neurID, this);
+		connect(memPotGraphDialog, SIGNAL(finished(int)), this, SLOT(deleteMembranePotentialGraphDialog(int)));
+		memPotGraphDialog->show();
 	}
 	catch(SpikeStreamException& ex){
 		qCritical()<<ex.getMessage();
@@ -688,8 +687,7 @@ void NemoWidget::monitorNeuronsStateChanged(int monitorType){
 		}
 
 		//Clear current highlights
-		QHash<unsigned int, RGBColor*>* newHighlightMap = new QHash<unsigned int, RGBColor*>();
-		Globals::getNetworkDisplay()->setNeuronColorMap(newHighlightMap);
+		Globals::getNetworkDisplay()->clearNeuronColors();
 	}
 	catch(SpikeStreamException& ex){
 		qCritical()<<ex.getMessage();
@@ -882,22 +880,21 @@ void NemoWidget::updateTimeStep(unsigned int timeStep){
 
 /*! Called when the simulation has advanced one time step.
 	This version of the method updates the time step and firing neuron IDs. */
-void NemoWidget::updateTimeStep(unsigned int timeStep, const QList<unsigned>& neuronIDList){
-	timeStepLabel->setText(QString::number(timeStep));
+void NemoWidget::updateTimeStep(const SpikeFramePtr& spikeFrame){
+	timeStepLabel->setText(QString::number(spikeFrame->getTimeStep()));
 
-	//Fill map with neuron ids
-	QHash<unsigned int, RGBColor*>* newHighlightMap = new QHash<unsigned int, RGBColor*>();
-	QList<unsigned>::const_iterator endList = neuronIDList.end();
-	for(QList<unsigned>::const_iterator iter = neuronIDList.begin(); iter != endList; ++iter){
-		(*newHighlightMap)[*iter] = neuronColor;
+	//Colour the firing neurons, reusing the colour indexes from the previous time step
+	NetworkDisplay* netDisplay = Globals::getNetworkDisplay();
+	netDisplay->clearNeuronColorIndexes();
+	const unsigned* endFrame = spikeFrame->end();
+	for(const unsigned* iter = spikeFrame->begin(); iter != endFrame; ++iter){
+		netDisplay->setNeuronColorIndex(*iter, firingNeuronColorIndex);
 	}
-
-	//Set highlight map in network display
-	Globals::getNetworkDisplay()->setNeuronColorMap(newHighlightMap);
+	netDisplay->neuronColorsChanged();
 
 	//Update spike rasters
 	for(QHash<unsigned, SpikeRasterDialog*>::iterator iter = rasterDialogMap.begin(); iter != rasterDialogMap.end(); ++iter)
-		iter.value()->addData(neuronIDList, timeStep);
+		iter.value()->addData(*spikeFrame);
 
 	//Allow simulation to proceed on to next step
 	nemoWrapper->clearWaitForGraphics();
@@ -909,46 +906,28 @@ void NemoWidget::updateTimeStep(unsigned int timeStep, const QList<unsigned>& ne
 void NemoWidget::updateTimeStep(unsigned int timeStep, const QHash<unsigned, float>& membranePotentialMap){
 	timeStepLabel->setText(QString::number(timeStep));
 
-	//Fill map with appropriate colours depending on membrane potential.
-	float tmpMemPot = 0.0f;
-	QHash<unsigned int, RGBColor*>* newHighlightMap = new QHash<unsigned int, RGBColor*>();
+	//Set the colour of each neuron from the table of membrane potential colours
+	NetworkDisplay* netDisplay = Globals::getNetworkDisplay();
+	netDisplay->clearNeuronColorIndexes();
+	float tablePosition;
 	QHash<unsigned, float>::const_iterator endMap = membranePotentialMap.end();
 	for(QHash<unsigned, float>::const_iterator iter = membranePotentialMap.begin(); iter != endMap; ++iter){
 		//Update 3D display
-		tmpMemPot = iter.value();
-		if(tmpMemPot < -89.0f)
-			(*newHighlightMap)[iter.key()] = heatColorMap[-1];
-		else if(tmpMemPot < -78.0f)
-			(*newHighlightMap)[iter.key()] = heatColorMap[0];
-		else if(tmpMemPot < -67.0f)
-			(*newHighlightMap)[iter.key()] = heatColorMap[1];
-		else if(tmpMemPot < -56.0f)
-			(*newHighlightMap)[iter.key()] = heatColorMap[2];
-		else if(tmpMemPot < -45.0f)
-			(*newHighlightMap)[iter.key()] = heatColorMap[3];
-		else if(tmpMemPot < -34.0f)
-			(*newHighlightMap)[iter.key()] = heatColorMap[4];
-		else if(tmpMemPot < -23.0f)
-			(*newHighlightMap)[iter.key()] = heatColorMap[5];
-		else if(tmpMemPot < -12.0f)
-			(*newHighlightMap)[iter.key()] = heatColorMap[6];
-		else if(tmpMemPot < -1.0f)
-			(*newHighlightMap)[iter.key()] = heatColorMap[7];
-		else if(tmpMemPot < 10.0f)
-			(*newHighlightMap)[iter.key()] = heatColorMap[8];
-		else if(tmpMemPot < 21.0f)
-			(*newHighlightMap)[iter.key()] = heatColorMap[9];
+		tablePosition = floor(iter.value()) - MIN_MEM_POT_COLOR;
+		if(tablePosition <= 0.0f)
+			netDisplay->setNeuronColorIndex(iter.key(), memPotColorIndexArray[0]);
+		else if(tablePosition >= MEM_POT_COLOR_TABLE_SIZE - 1)
+			netDisplay->setNeuronColorIndex(iter.key(), memPotColorIndexArray[MEM_POT_COLOR_TABLE_SIZE - 1]);
 		else
-			(*newHighlightMap)[iter.key()] = heatColorMap[10];
-
-		//Update graphs
-		if(memPotGraphDialogMap.contains(iter.key())){
-			memPotGraphDialogMap[iter.key()]->addData(iter.value(), timeStep);
-		}
+			netDisplay->setNeuronColorIndex(iter.key(), memPotColorIndexArray[(int)tablePosition]);
 	}
 
-	//Set network display
-	Globals::getNetworkDisplay()->setNeuronColorMap(newHighlightMap);
+	//Update graph, which reads the potentials of its neurons from the map
+	if(memPotGraphDialog != NULL)
+		memPotGraphDialog->addData(membranePotentialMap, timeStep);
+
+	//Update network display
+	netDisplay->neuronColorsChanged();
 
 	//Allow simulation to proceed on to next step
 	nemoWrapper->clearWaitForGraphics();
@@ -1085,7 +1064,7 @@ void NemoWidget::unloadSimulation(bool confirmWithUser){
 	Globals::setSimulation(NULL);
 
 	//Clear network display
-	Globals::getNetworkDisplay()->setNeuronColorMap(new QHash<unsigned int, RGBColor*>());
+	Globals::getNetworkDisplay()->clearNeuronColors();
 
 	//Set buttons appropriately
 	loadButton->setEnabled(true);
@@ -1116,11 +1095,11 @@ void NemoWidget::unloadSimulation(bool confirmWithUser){
 	}
 	rasterDialogMap.clear();
 
-	//Clean up any membrane potential plots
-	for(QHash<unsigned, MembranePotentialGraphDialog*>::iterator iter = memPotGraphDialogMap.begin(); iter != memPotGraphDialogMap.end(); ++iter){
-		delete iter.value();
+	//Clean up the membrane potential plot
+	if(memPotGraphDialog != NULL){
+		delete memPotGraphDialog;
+		memPotGraphDialog = NULL;
 	}
-	memPotGraphDialogMap.clear();
 }
 
 
@@ -1174,32 +1153,35 @@ void NemoWidget::checkWidgetEnabled(){
 }
 
 
-/*! Builds a set of colours for use when displaying the membrane potential. */
+/*! Adds the colours used to display the membrane potential to the network display's palette and
+	fills in the table linking each membrane potential with its colour. */
 void NemoWidget::createMembranePotentialColors(){
-		heatColorMap[-1] = new RGBColor(0.0f, 0.0f, 0.0f);
-		Globals::getNetworkDisplay()->addDefaultColor(heatColorMap[-1]);
-		heatColorMap[0] = new RGBColor(HEAT_COLOR_0);
-		Globals::getNetworkDisplay()->addDefaultColor(heatColorMap[0]);
-		heatColorMap[1] = new RGBColor(HEAT_COLOR_1);
-		Globals::getNetworkDisplay()->addDefaultColor(heatColorMap[1]);
-		heatColorMap[2] = new RGBColor(HEAT_COLOR_2);
-		Globals::getNetworkDisplay()->addDefaultColor(heatColorMap[2]);
-		heatColorMap[3] = new RGBColor(HEAT_COLOR_3);
-		Globals::getNetworkDisplay()->addDefaultColor(heatColorMap[3]);
-		heatColorMap[4] = new RGBColor(HEAT_COLOR_4);
-		Globals::getNetworkDisplay()->addDefaultColor(heatColorMap[4]);
-		heatColorMap[5] = new RGBColor(HEAT_COLOR_5);
-		Globals::getNetworkDisplay()->addDefaultColor(heatColorMap[5]);
-		heatColorMap[6] = new RGBColor(HEAT_COLOR_6);
-		Globals::getNetworkDisplay()->addDefaultColor(heatColorMap[6]);
-		heatColorMap[7] = new RGBColor(HEAT_COLOR_7);
-		Globals::getNetworkDisplay()->addDefaultColor(heatColorMap[7]);
-		heatColorMap[8] = new RGBColor(HEAT_COLOR_8);
-		Globals::getNetworkDisplay()->addDefaultColor(heatColorMap[8]);
-		heatColorMap[9] = new RGBColor(HEAT_COLOR_9);
-		Globals::getNetworkDisplay()->addDefaultColor(heatColorMap[9]);
-		heatColorMap[10] = new RGBColor(HEAT_COLOR_10);
-		Globals::getNetworkDisplay()->addDefaultColor(heatColorMap[10]);
+	//Add the heat map colours to the palette. Entry 0 is used for the lowest potentials.
+	NetworkDisplay* netDisplay = Globals::getNetworkDisplay();
+	unsigned char heatColorIndexes[12];
+	heatColorIndexes[0] = netDisplay->addPaletteColor(RGBColor(0.0f, 0.0f, 0.0f));
+	heatColorIndexes[1] = netDisplay->addPaletteColor(RGBColor(HEAT_COLOR_0));
+	heatColorIndexes[2] = netDisplay->addPaletteColor(RGBColor(HEAT_COLOR_1));
+	heatColorIndexes[3] = netDisplay->addPaletteColor(RGBColor(HEAT_COLOR_2));
+	heatColorIndexes[4] = netDisplay->addPaletteColor(RGBColor(HEAT_COLOR_3));
+	heatColorIndexes[5] = netDisplay->addPaletteColor(RGBColor(HEAT_COLOR_4));
+	heatColorIndexes[6] = netDisplay->addPaletteColor(RGBColor(HEAT_COLOR_5));
+	heatColorIndexes[7] = netDisplay->addPaletteColor(RGBColor(HEAT_COLOR_6));
+	heatColorIndexes[8] = netDisplay->addPaletteColor(RGBColor(HEAT_COLOR_7));
+	heatColorIndexes[9] = netDisplay->addPaletteColor(RGBColor(HEAT_COLOR_8));
+	heatColorIndexes[10] = netDisplay->addPaletteColor(RGBColor(HEAT_COLOR_9));
+	heatColorIndexes[11] = netDisplay->addPaletteColor(RGBColor(HEAT_COLOR_10));
+
+	/* The colours change every 11 mV starting at -89 mV. The boundaries are whole numbers,
+		so every potential in an entry of the table has the same colour. */
+	for(int i=0; i<MEM_POT_COLOR_TABLE_SIZE; ++i){
+		int memPot = MIN_MEM_POT_COLOR + i;
+		int heatIndex = 0;
+		if(memPot >= -89)
+			heatIndex = qMin((memPot + 89) / 11 + 1, 11);
+		memPotColorIndexArray[i] = heatColorIndexes[heatIndex];
+	}
+	firingNeuronColorIndex = 0;
 }
 
 
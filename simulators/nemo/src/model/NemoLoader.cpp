@@ -154,7 +154,7 @@ void NemoLoader::addExcitatoryNeuronGroup(NeuronGroup* neuronGroup, nemo_network
 
 	//Add neurons to the network
 	float c, d, u, rand1, rand2;
-	for(NeuronMap::iterator iter = neuronGroup->begin(); iter != neuronGroup->end(); ++iter){
+	for(NeuronIterator iter = neuronGroup->begin(); iter != neuronGroup->end(); ++iter){
 		//Calculate random parameters
 		rand1 = ranNumGen();
 		rand2 = ranNumGen();
@@ -164,9 +164,9 @@ void NemoLoader::addExcitatoryNeuronGroup(NeuronGroup* neuronGroup, nemo_network
 
 		//Add the neuron to the network
 		#ifdef DEBUG_NEURONS
-			(*logTextStream)<<"nemo_add_neuron(nemoNetwork, "<<iter.value()->getID()<<", "<<a<<", "<<b<<", "<<c<<", "<<d<<", "<<u<<", "<<v<<", "<<sigma<<");"<<endl;
+			(*logTextStream)<<"nemo_add_neuron(nemoNetwork, "<<iter.key()<<", "<<a<<", "<<b<<", "<<c<<", "<<d<<", "<<u<<", "<<v<<", "<<sigma<<");"<<endl;
 		#endif//DEBUG_NEURONS
-		nemo_status_t result = nemo_add_neuron_iz(nemoNetwork, iter.value()->getID(), a, b, c, d, u, v, sigma);
+		nemo_status_t result = nemo_add_neuron_iz(nemoNetwork, iter.key(), a, b, c, d, u, v, sigma);
 		if(result != NEMO_OK)
 			throw SpikeStreamException("Error code returned from Nemo when adding neuron." + QString(nemo_strerror()));
 	}
@@ -186,7 +186,7 @@ void NemoLoader::addInhibitoryNeuronGroup(NeuronGroup* neuronGroup, nemo_network
 
 	//Add neurons to the network
 	float a, b, u, rand1, rand2;
-	for(NeuronMap::iterator iter = neuronGroup->begin(); iter != neuronGroup->end(); ++iter){
+	for(NeuronIterator iter = neuronGroup->begin(); iter != neuronGroup->end(); ++iter){
 		//Calculate random parameters
 		rand1 = ranNumGen();
 		rand2 = ranNumGen();
@@ -196,9 +196,9 @@ void NemoLoader::addInhibitoryNeuronGroup(NeuronGroup* neuronGroup, nemo_network
 
 		//Add neuron to the network
 		#ifdef DEBUG_NEURONS
-			(*logTextStream)<<"nemo_add_neuron(nemoNetwork, "<<iter.value()->getID()<<", "<<a<<", "<<b<<", "<<v<<", "<<d<<", "<<u<<", "<<v<<", "<<sigma<<");"<<endl;
+			(*logTextStream)<<"nemo_add_neuron(nemoNetwork, "<<iter.key()<<", "<<a<<", "<<b<<", "<<v<<", "<<d<<", "<<u<<", "<<v<<", "<<sigma<<");"<<endl;
 		#endif//DEBUG_NEURONS
-		nemo_status_t result = nemo_add_neuron_iz(nemoNetwork, iter.value()->getID(), a, b, v, d, u, v, sigma);
+		nemo_status_t result = nemo_add_neuron_iz(nemoNetwork, iter.key(), a, b, v, d, u, v, sigma);
 		if(result != NEMO_OK)
 			throw SpikeStreamException("Error code returned from Nemo when adding neuron." + QString(nemo_strerror()));
 	}
@@ -89,6 +89,15 @@ void NemoWrapper::cancelSaveWeights(){
 }
 
 
+/*! Returns the neurons that fired at the last time step. These are only extracted when the firing neurons
+	are monitored, archived, passed to device managers or update firing neurons is set. */
+QList<neurid_t> NemoWrapper::getFiringNeuronIDs(){
+	if(spikeFrame.isNull())
+		return QList<neurid_t>();
+	return spikeFrame->toList();
+}
+
+
 /*! Returns true if simulation is currently being played */
 bool NemoWrapper::isSimulationRunning(){
 	if(currentTaskID == RUN_SIMULATION_TASK || currentTaskID == STEP_SIMULATION_TASK)
@@ -435,10 +444,10 @@ void NemoWrapper::setFiringInjectionPattern(const Pattern& pattern, unsigned neu
 	Pattern alignedPattern( pattern.getAlignedPattern(neurGrp->getBoundingBox()) );
 
 	//Add neurons that are contained within the pattern
-	NeuronMap::iterator neuronMapEnd = neurGrp->end();
-	for(NeuronMap::iterator iter = neurGrp->begin(); iter != neuronMapEnd; ++iter){
-		if(alignedPattern.contains( (*iter)->getLocation() ) ){
-			injectionPatternVector.push_back( (*iter)->getID());
+	NeuronIterator neuronMapEnd = neurGrp->end();
+	for(NeuronIterator iter = neurGrp->begin(); iter != neuronMapEnd; ++iter){
+		if(alignedPattern.contains( iter.value()->getLocation() ) ){
+			injectionPatternVector.push_back( iter.key());
 		}
 	}
 	//Release mutex
@@ -459,10 +468,10 @@ void NemoWrapper::setCurrentInjectionPattern(const Pattern& pattern, float curre
 	Pattern alignedPattern( pattern.getAlignedPattern(neurGrp->getBoundingBox()) );
 
 	//Add neurons that are contained within the pattern
-	NeuronMap::iterator neuronMapEnd = neurGrp->end();
-	for(NeuronMap::iterator iter = neurGrp->begin(); iter != neuronMapEnd; ++iter){
-		if(alignedPattern.contains( (*iter)->getLocation() ) ){
-			injectionCurrentNeurIDVector.push_back( (*iter)->getID());
+	NeuronIterator neuronMapEnd = neurGrp->end();
+	for(NeuronIterator iter = neurGrp->begin(); iter != neuronMapEnd; ++iter){
+		if(alignedPattern.contains( iter.value()->getLocation() ) ){
+			injectionCurrentNeurIDVector.push_back( iter.key());
 			injectionCurrentVector.push_back(current);
 		}
 	}
@@ -734,8 +743,8 @@ void NemoWrapper::getMembranePotential(){
 	float tmpMemPot, maxMemPot = 0.0f, minMemPot = 0.0f;
 	QList<NeuronGroup*> neurGrpList = Globals::getNetwork()->getNeuronGroups();
 	for(int i=0; i<neurGrpList.size(); ++i){
-		NeuronMap::iterator neurGrpListEnd = neurGrpList.at(i)->end();
-		for(NeuronMap::iterator iter = neurGrpList.at(i)->begin(); iter != neurGrpListEnd; ++iter){
+		NeuronIterator neurGrpListEnd = neurGrpList.at(i)->end();
+		for(NeuronIterator iter = neurGrpList.at(i)->begin(); iter != neurGrpListEnd; ++iter){
 			checkNemoOutput(nemo_get_membrane_potential(nemoSimulation, iter.key(), &tmpMemPot), "Error getting membrane potential.");
 			membranePotentialMap[iter.key()] = tmpMemPot;
 			if(tmpMemPot > maxMemPot)
@@ -919,8 +928,8 @@ void NemoWrapper::setExcitatoryNeuronParameters(NeuronGroup* neuronGroup){
 
 	//Set parameters in the neurons
 	float c, d, u, rand1, rand2;
-	NeuronMap::iterator neurGrpEnd = neuronGroup->end();
-	for(NeuronMap::iterator iter = neuronGroup->begin(); iter != neurGrpEnd; ++iter){
+	NeuronIterator neurGrpEnd = neuronGroup->end();
+	for(NeuronIterator iter = neuronGroup->begin(); iter != neurGrpEnd; ++iter){
 		//Get random numbers
 		rand1 = ranNumGen();
 		rand2 = ranNumGen();
@@ -964,8 +973,8 @@ void NemoWrapper::setInhibitoryNeuronParameters(NeuronGroup* neuronGroup){
 
 	//Set parameters in the neurons
 	float a, b, u, rand1, rand2;
-	NeuronMap::iterator neurGrpEnd = neuronGroup->end();
-	for(NeuronMap::iterator iter = neuronGroup->begin(); iter != neurGrpEnd; ++iter){
+	NeuronIterator neurGrpEnd = neuronGroup->end();
+	for(NeuronIterator iter = neuronGroup->begin(); iter != neurGrpEnd; ++iter){
 		//Get random numbers
 		rand1 = ranNumGen();
 		rand2 = ranNumGen();
@@ -992,6 +1001,7 @@ void NemoWrapper::setInhibitoryNeuronParameters(NeuronGroup* neuronGroup){
 void NemoWrapper::stepNemo(){
 	unsigned *firedArray, numFiredNeurons = 0, numCurrentNeurons = 0;
 	size_t firedCount;
+	spikeFrame.clear();
 	firingNeuronList.clear();
 
 	//---------------------------------------
@@ -1054,9 +1064,14 @@ void NemoWrapper::stepNemo(){
 	//        Pass list of firing neurons to other classes
 	//---------------------------------------------------------
 	if(archiveMode || (monitorFiringNeurons && monitor) || !deviceManagerList.isEmpty() || updateFiringNeurons){
-		//Add firing neuron ids to list
-		for(unsigned i=0; i<firedCount; ++i)
-			firingNeuronList.append(firedArray[i]);
+		//Copy the firing neurons once into a frame that is shared with the classes displaying them
+		spikeFrame = SpikeFramePtr(new SpikeFrame(timeStepCounter, firedArray, (int)firedCount));
+
+		//The archive and the device managers take the firing neurons as a list
+		if(archiveMode || !deviceManagerList.isEmpty()){
+			for(unsigned i=0; i<firedCount; ++i)
+				firingNeuronList.append(firedArray[i]);
+		}
 		#ifdef DEBUG_STEP
 			if(firedCount > 0)
 				qDebug()<<"Number of firing neurons: "<<firedCount;
@@ -1125,7 +1140,7 @@ void NemoWrapper::stepNemo(){
 
 		//Inform listening classes that this time step has been processed
 		if(monitorFiringNeurons)
-			emit timeStepChanged(timeStepCounter, firingNeuronList);
+			emit timeStepChanged(spikeFrame);
 		else if (monitorMembranePotential)
 			emit timeStepChanged(timeStepCounter, membranePotentialMap);
 		else
@@ -6,7 +6,7 @@ SUBDIRS =   library applicationlibrary application
 
 
 #================  ANALYSIS PLUGINS  =================
-SUBDIRS += analysis/statebasedphi analysis/liveliness
+SUBDIRS += analysis/statebasedphi analysis/liveliness analysis/transferentropy
 
 
 #================  NETWORKS PLUGINS  =================
@@ -38,7 +38,12 @@ SUBDIRS += installation/dbconfigtool
 #SUBDIRS += library/test
 #SUBDIRS += analysis/liveliness/test
 #SUBDIRS += analysis/statebasedphi/test
+SUBDIRS += analysis/transferentropy/test
 #SUBDIRS += networks/nrmimporter/test
 #SUBDIRS += simulators/nemo/test
 
 
+#=================  BENCHMARKS  ===================
+#SUBDIRS += library/benchmark
+
+